@@ -10,6 +10,7 @@
 #include <Beam/ServiceLocator/AuthenticationServletAdapter.hpp>
 #include <Beam/Services/ServiceProtocolServletContainer.hpp>
 #include <Beam/TimeService/LiveTimer.hpp>
+#include <Beam/TimeService/LocalTimeClient.hpp>
 #include <Beam/Utilities/ApplicationInterrupt.hpp>
 #include <Beam/Utilities/Expect.hpp>
 #include <Beam/Utilities/YamlConfig.hpp>
@@ -27,7 +28,7 @@ using namespace Nexus;
 namespace {
   using ChartingServletContainer =
     ServiceProtocolServletContainer<MetaAuthenticationServletAdapter<
-      MetaChartingServlet<ApplicationMarketDataClient*>,
+      MetaChartingServlet<ApplicationMarketDataClient*, LocalTimeClient>,
       ApplicationServiceLocatorClient*>, TcpServerSocket,
       BinarySender<SharedBuffer>, SizeDeclarativeEncoder<ZLibEncoder>,
       std::shared_ptr<LiveTimer>>;
@@ -49,7 +50,7 @@ int main(int argc, const char** argv) {
     auto market_data_client =
       ApplicationMarketDataClient(Ref(service_locator_client));
     auto charting_server = ChartingServletContainer(
-      init(&service_locator_client, init(&market_data_client)),
+      init(&service_locator_client, init(&market_data_client, init())),
       init(service_config.m_interface),
       std::bind(factory<std::shared_ptr<LiveTimer>>(), seconds(10)));
     add(service_locator_client, service_config);
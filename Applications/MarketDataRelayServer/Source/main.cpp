@@ -17,6 +17,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/throw_exception.hpp>
 #include "Nexus/AdministrationService/ApplicationDefinitions.hpp"
+#include "Nexus/AdministrationService/CachedAdministrationClient.hpp"
 #include "Nexus/DefinitionsService/ApplicationDefinitions.hpp"
 #include "Nexus/MarketDataService/ApplicationDefinitions.hpp"
 #include "Nexus/MarketDataService/DistributedMarketDataClient.hpp"
@@ -36,13 +37,14 @@ namespace {
   using IncomingMarketDataClient = std::shared_ptr<MarketDataClient>;
   using MarketDataRelayServletContainer = ServiceProtocolServletContainer<
     MetaAuthenticationServletAdapter<MetaMarketDataRelayServlet<
-      IncomingMarketDataClient, ApplicationAdministrationClient*>,
+      IncomingMarketDataClient,
+      CachedAdministrationClient<ApplicationAdministrationClient*>*>,
       ApplicationServiceLocatorClient*, NativePointerPolicy>,
     TcpServerSocket, BinarySender<SharedBuffer>,
     SizeDeclarativeEncoder<ZLibEncoder>, std::shared_ptr<LiveTimer>>;
   using BaseMarketDataRelayServlet = MarketDataRelayServlet<
     MarketDataRelayServletContainer, IncomingMarketDataClient,
-    ApplicationAdministrationClient*>;
+    CachedAdministrationClient<ApplicationAdministrationClient*>*>;
 
   Scope parse_scope(const JsonObject& node, const CountryDatabase& countries) {
     auto scope = Scope();
@@ -77,6 +79,9 @@ int main(int argc, const char** argv) {
     load_definitions(definitions_client);
     auto administration_client =
       ApplicationAdministrationClient(Ref(service_locator_client));
+    auto cached_administration_client =
+      CachedAdministrationClient<ApplicationAdministrationClient*>(
+        &administration_client);
     auto countries = definitions_client.load_country_database();
     auto market_data_client_builder = [&] {
       auto entries = service_locator_client.locate(
@@ -111,7 +116,7 @@ int main(int argc, const char** argv) {
       extract<int>(config, "max_connections", 10 * min_connections));
     auto base_registry_servlet = BaseMarketDataRelayServlet(client_timeout,
       market_data_client_builder, min_connections, max_connections,
-      &administration_client);
+      &cached_administration_client);
     auto server = MarketDataRelayServletContainer(
       init(&service_locator_client, &base_registry_servlet),
       init(service_config.m_interface),
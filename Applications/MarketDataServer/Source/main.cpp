@@ -21,6 +21,7 @@
 #include <boost/throw_exception.hpp>
 #include <Viper/MySql/Connection.hpp>
 #include "Nexus/AdministrationService/ApplicationDefinitions.hpp"
+#include "Nexus/AdministrationService/CachedAdministrationClient.hpp"
 #include "Nexus/DefinitionsService/ApplicationDefinitions.hpp"
 #include "Nexus/MarketDataService/AsyncHistoricalDataStore.hpp"
 #include "Nexus/MarketDataService/MarketDataFeedServlet.hpp"
@@ -42,13 +43,13 @@ namespace {
     MetaAuthenticationServletAdapter<MetaMarketDataRegistryServlet<
       MarketDataRegistry*, SessionCachedHistoricalDataStore<
         AsyncHistoricalDataStore<DataStore*>*>,
-      ApplicationAdministrationClient*>,
+      CachedAdministrationClient<ApplicationAdministrationClient*>*>,
       ApplicationServiceLocatorClient*, NativePointerPolicy>, TcpServerSocket,
     BinarySender<SharedBuffer>, NullEncoder, std::shared_ptr<LiveTimer>>;
   using BaseRegistryServlet = MarketDataRegistryServlet<
     RegistryServletContainer, MarketDataRegistry*,
     SessionCachedHistoricalDataStore<AsyncHistoricalDataStore<DataStore*>*>,
-    ApplicationAdministrationClient*>;
+    CachedAdministrationClient<ApplicationAdministrationClient*>*>;
   using FeedServletContainer = ServiceProtocolServletContainer<
     MetaAuthenticationServletAdapter<
       MetaMarketDataFeedServlet<BaseRegistryServlet*>,
@@ -90,6 +91,9 @@ int main(int argc, const char** argv) {
     load_definitions(definitions_client);
     auto administration_client =
       ApplicationAdministrationClient(Ref(service_locator_client));
+    auto cached_administration_client =
+      CachedAdministrationClient<ApplicationAdministrationClient*>(
+        &administration_client);
     auto countries = definitions_client.load_country_database();
     auto registry_service_config = try_or_nest([&] {
       return ServiceConfiguration::parse(
@@ -120,16 +124,24 @@ int main(int argc, const char** argv) {
     });
     auto async_data_store = AsyncHistoricalDataStore(&historical_data_store);
     auto cache_block_size = extract<int>(config, "cache_block_size", 1000);
-    auto market_data_registry = MarketDataRegistry();
-    auto base_registry_servlet = BaseRegistryServlet(&administration_client,
-      &market_data_registry, init(&async_data_store, cache_block_size));
+    auto shard_count = extract<int>(config, "shard_count", 1);
+    auto feed_worker_count = extract<int>(config, "feed_worker_count", 0);
+    auto market_data_registry = MarketDataRegistry(shard_count);
+    auto conflation_window = extract<time_duration>(
+      config, "conflation_window", milliseconds(100));
+    auto base_registry_servlet = BaseRegistryServlet(
+      &cached_administration_client, &market_data_registry,
+      init(&async_data_store, cache_block_size), conflation_window,
+      std::make_unique<Timer>(
+        std::in_place_type<LiveTimer>, conflation_window));
     auto registry_server = RegistryServletContainer(
       init(&service_locator_client, &base_registry_servlet),
       init(registry_service_config.m_interface),
       std::bind(factory<std::shared_ptr<LiveTimer>>(), seconds(10)));
     add(service_locator_client, registry_service_config);
     auto feed_server = FeedServletContainer(
-      init(&service_locator_client, &base_registry_servlet),
+      init(&service_locator_client,
+        init(&base_registry_servlet, feed_worker_count)),
       init(feed_service_config.m_interface),
       std::bind(factory<std::shared_ptr<LiveTimer>>(), seconds(10)));
     add(service_locator_client, feed_service_config);
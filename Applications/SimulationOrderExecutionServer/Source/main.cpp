@@ -18,13 +18,16 @@
 #include <boost/lexical_cast.hpp>
 #include <Viper/MySql/Connection.hpp>
 #include "Nexus/AdministrationService/ApplicationDefinitions.hpp"
+#include "Nexus/AdministrationService/CachedAdministrationClient.hpp"
 #include "Nexus/Compliance/ApplicationDefinitions.hpp"
 #include "Nexus/Compliance/ComplianceCheckOrderExecutionDriver.hpp"
 #include "Nexus/Compliance/ComplianceRuleBuilder.hpp"
 #include "Nexus/DefinitionsService/ApplicationDefinitions.hpp"
 #include "Nexus/MarketDataService/ApplicationDefinitions.hpp"
+#include "Nexus/MarketDataService/BboQuoteCache.hpp"
 #include "Nexus/OrderExecutionService/BoardLotCheck.hpp"
 #include "Nexus/OrderExecutionService/BuyingPowerCheck.hpp"
+#include "Nexus/OrderExecutionService/GroupCommitOrderExecutionDataStore.hpp"
 #include "Nexus/OrderExecutionService/OrderExecutionServlet.hpp"
 #include "Nexus/OrderExecutionService/OrderSubmissionCheckDriver.hpp"
 #include "Nexus/OrderExecutionService/ReplicatedOrderExecutionDataStore.hpp"
@@ -53,8 +56,9 @@ namespace {
   using OrderExecutionServletContainer = ServiceProtocolServletContainer<
     MetaAuthenticationServletAdapter<MetaOrderExecutionServlet<
       LiveNtpTimeClient*, ApplicationServiceLocatorClient*,
-      ApplicationUidClient*, ApplicationAdministrationClient*,
-      ApplicationOrderExecutionDriver*, ReplicatedOrderExecutionDataStore*>,
+      ApplicationUidClient*,
+      CachedAdministrationClient<ApplicationAdministrationClient*>*,
+      ApplicationOrderExecutionDriver*, OrderExecutionDataStore*>,
     ApplicationServiceLocatorClient*>, TcpServerSocket,
     BinarySender<SharedBuffer>, NullEncoder, std::shared_ptr<LiveTimer>>;
 }
@@ -74,6 +78,9 @@ int main(int argc, const char** argv) {
     auto time_client = make_live_ntp_time_client(service_locator_client);
     auto administration_client =
       ApplicationAdministrationClient(Ref(service_locator_client));
+    auto cached_administration_client =
+      CachedAdministrationClient<ApplicationAdministrationClient*>(
+        &administration_client);
     auto market_data_client =
       ApplicationMarketDataClient(Ref(service_locator_client));
     auto definitions_client =
@@ -83,6 +90,8 @@ int main(int argc, const char** argv) {
       ApplicationComplianceClient(Ref(service_locator_client));
     auto simulation_driver = SimulationOrderExecutionDriver(
       MarketDataClient(&market_data_client), TimeClient(time_client.get()));
+    auto bbo_quotes =
+      std::make_shared<BboQuoteCache>(MarketDataClient(&market_data_client));
     auto checks = std::vector<std::unique_ptr<OrderSubmissionCheck>>();
     try_or_nest([&] {
       checks.emplace_back(make_board_lot_check(&market_data_client));
@@ -90,7 +99,7 @@ int main(int argc, const char** argv) {
         std::make_unique<BuyingPowerCheck<ApplicationAdministrationClient*,
           ApplicationMarketDataClient*>>(
             ExchangeRateTable(definitions_client.load_exchange_rates()),
-            &administration_client, &market_data_client));
+            &administration_client, &market_data_client, bbo_quotes));
       checks.emplace_back(
         std::make_unique<RiskStateCheck<ApplicationAdministrationClient*>>(
           &administration_client));
@@ -100,7 +109,7 @@ int main(int argc, const char** argv) {
     auto rule_set = ComplianceRuleSet(
       &compliance_client, &service_locator_client, [&] (const auto& entry) {
         return make_compliance_rule(entry.get_schema(), market_data_client,
-          definitions_client, *time_client);
+          definitions_client, *time_client, bbo_quotes);
       });
     auto compliance_check_driver =
       ApplicationComplianceCheckOrderExecutionDriver(
@@ -122,10 +131,23 @@ int main(int argc, const char** argv) {
     }
     auto data_store = make_replicated_sql_order_execution_data_store(
       connection_builders, account_source);
+    auto commit_batch_size = extract<int>(config, "commit_batch_size", 0);
+    auto commit_interval =
+      extract<time_duration>(config, "commit_interval", milliseconds(1));
+    auto order_execution_data_store = [&] {
+      if(commit_batch_size <= 0) {
+        return OrderExecutionDataStore(data_store.get());
+      }
+      return OrderExecutionDataStore(std::in_place_type<
+        GroupCommitOrderExecutionDataStore<ReplicatedOrderExecutionDataStore*>>,
+        data_store.get(), commit_batch_size, std::make_unique<Timer>(
+          std::in_place_type<LiveTimer>, commit_interval));
+    }();
+    auto worker_count = extract<int>(config, "worker_count", 1);
     auto order_execution_server = OrderExecutionServletContainer(
       init(&service_locator_client, init(time_client.get(),
-        &service_locator_client, &uid_client, &administration_client,
-        &compliance_check_driver, data_store.get())),
+        &service_locator_client, &uid_client, &cached_administration_client,
+        &compliance_check_driver, &order_execution_data_store, worker_count)),
       init(service_config.m_interface),
       std::bind(factory<std::shared_ptr<LiveTimer>>(), seconds(10)));
     add(service_locator_client, service_config);
@@ -420,54 +420,8 @@ HttpResponse AdministrationWebServlet::on_store_account_roles(
   }
   auto params = session->shuttle_parameters<Parameters>(request);
   auto& clients = session->get_clients();
-  auto groups = clients.get_administration_client().load_managed_trading_groups(
-    session->get_account());
-  auto member_group = TradingGroup();
-  for(auto& group : groups) {
-    auto trading_group =
-      clients.get_administration_client().load_trading_group(group);
-    if(std::find(trading_group.get_managers().begin(),
-        trading_group.get_managers().end(), params.m_account) !=
-          trading_group.get_managers().end() ||
-        std::find(trading_group.get_traders().begin(),
-          trading_group.get_traders().end(), params.m_account) !=
-            trading_group.get_traders().end()) {
-      member_group = trading_group;
-      break;
-    }
-  }
-  auto previous_roles =
-    clients.get_administration_client().load_account_roles(params.m_account);
-  if(member_group.get_entry().m_type != DirectoryEntry::Type::DIRECTORY) {
-    session->shuttle_response(previous_roles, out(response));
-    return response;
-  }
-  if(params.m_roles.test(AccountRole::MANAGER) !=
-      previous_roles.test(AccountRole::MANAGER)) {
-    if(params.m_roles.test(AccountRole::MANAGER)) {
-      clients.get_service_locator_client().store(
-        params.m_account, member_group.get_entry(), Permission::READ);
-      clients.get_service_locator_client().associate(
-        params.m_account, member_group.get_managers_directory());
-    } else {
-      clients.get_service_locator_client().store(
-        params.m_account, member_group.get_entry(), Permissions(0));
-      clients.get_service_locator_client().detach(
-        params.m_account, member_group.get_managers_directory());
-    }
-  }
-  if(params.m_roles.test(AccountRole::TRADER) !=
-      previous_roles.test(AccountRole::TRADER)) {
-    if(params.m_roles.test(AccountRole::TRADER)) {
-      clients.get_service_locator_client().associate(
-        params.m_account, member_group.get_traders_directory());
-    } else {
-      clients.get_service_locator_client().detach(
-        params.m_account, member_group.get_traders_directory());
-    }
-  }
-  auto new_roles =
-    clients.get_administration_client().load_account_roles(params.m_account);
+  auto new_roles = clients.get_administration_client().store(
+    params.m_account, params.m_roles);
   session->shuttle_response(new_roles, out(response));
   return response;
 }
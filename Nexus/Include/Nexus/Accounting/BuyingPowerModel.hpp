@@ -2,13 +2,22 @@
 #define NEXUS_BUYING_POWER_MODEL_HPP
 #include <algorithm>
 #include <unordered_map>
-#include <vector>
+#include "Nexus/Accounting/PriceLadder.hpp"
+#include "Nexus/Definitions/TickerId.hpp"
 #include "Nexus/OrderExecutionService/ExecutionReport.hpp"
 #include "Nexus/OrderExecutionService/OrderFields.hpp"
 
 namespace Nexus {
 
-  /** Tracks the amount of buying power used up by a series of Orders. */
+  /**
+   * Tracks the amount of buying power used up by a series of Orders. Open
+   * Orders are aggregated by price so that submissions and fills are
+   * accounted for in logarithmic time, and terminal Orders no longer
+   * contribute to the cost of later updates. Positions are keyed by interned
+   * TickerId so that ExecutionReports are applied without hashing the
+   * Order's Ticker, and callers that intern the Ticker once when an Order is
+   * entered can pass its TickerId to avoid interning it on every call.
+   */
   class BuyingPowerModel {
     public:
 
@@ -38,6 +47,19 @@ namespace Nexus {
        */
       Money submit(OrderId id, const OrderFields& fields, Money expected_price);
 
+      /**
+       * Tracks a submission and returns the updated buying power.
+       * @param id The id used to track this submission.
+       * @param ticker The TickerId of the submission's Ticker.
+       * @param fields The OrderFields storing the details of the
+       *        submission.
+       * @param expected_price The expected price of the Order, this may differ
+       *        from the price that the Order is submitted for.
+       * @return The updated buying power for the submission's Currency.
+       */
+      Money submit(OrderId id, TickerId ticker, const OrderFields& fields,
+        Money expected_price);
+
       /**
        * Updates this model with the contents of an ExecutionReport.
        * @param report The ExecutionReport to update this model with.
@@ -54,39 +76,57 @@ namespace Nexus {
       void update(const Ticker& ticker, CurrencyId currency, Quantity quantity,
         Money expenditure);
 
+      /**
+       * Updates a position.
+       * @param ticker The TickerId of the Ticker the position is held in.
+       * @param currency The Currency the position is held in.
+       * @param quantity The change in the position's quantity.
+       * @param expenditure The change in the position's expenditure.
+       */
+      void update(TickerId ticker, CurrencyId currency, Quantity quantity,
+        Money expenditure);
+
     private:
       struct OrderEntry {
-        OrderId m_id;
-        OrderFields m_fields;
+        TickerId m_ticker;
+        CurrencyId m_currency;
+        Side m_side;
         Money m_expected_price;
         Quantity m_remaining_quantity;
 
-        OrderEntry(OrderId id, const OrderFields& fields, Money expected_price);
+        OrderEntry(
+          TickerId ticker, const OrderFields& fields, Money expected_price);
       };
       struct BuyingPowerEntry {
-        std::vector<OrderEntry> m_asks;
-        std::vector<OrderEntry> m_bids;
+        PriceLadder m_asks;
+        PriceLadder m_bids;
         Money m_expenditure;
         Quantity m_quantity;
+
+        BuyingPowerEntry() noexcept;
       };
-      std::unordered_map<OrderId, OrderFields> m_order_fields;
-      std::unordered_map<Ticker, BuyingPowerEntry> m_buying_power_entries;
+      std::unordered_map<OrderId, OrderEntry> m_orders;
+      TickerIdMap<BuyingPowerEntry> m_buying_power_entries;
       std::unordered_map<CurrencyId, Money> m_buying_power;
 
-      static Money compute_buying_power(
-        const std::vector<OrderEntry>& entries, Quantity offset);
       static Money compute_buying_power(const BuyingPowerEntry& entry);
   };
 
   inline BuyingPowerModel::OrderEntry::OrderEntry(
-    OrderId id, const OrderFields& fields, Money expected_price)
-    : m_id(id),
-      m_fields(fields),
+    TickerId ticker, const OrderFields& fields, Money expected_price)
+    : m_ticker(ticker),
+      m_currency(fields.m_currency),
+      m_side(fields.m_side),
       m_expected_price(expected_price),
       m_remaining_quantity(fields.m_quantity) {}
 
+  inline BuyingPowerModel::BuyingPowerEntry::BuyingPowerEntry() noexcept
+    : m_asks(Side::ASK),
+      m_bids(Side::BID),
+      m_quantity(0) {}
+
   inline bool BuyingPowerModel::has_order(OrderId id) const {
-    return m_order_fields.contains(id);
+    return m_orders.contains(id);
   }
 
   inline Money BuyingPowerModel::get_buying_power(CurrencyId currency) const {
@@ -99,26 +139,21 @@ namespace Nexus {
 
   inline Money BuyingPowerModel::submit(
       OrderId id, const OrderFields& fields, Money expected_price) {
-    auto& entry = m_buying_power_entries[fields.m_ticker];
+    return submit(id, to_ticker_id(fields.m_ticker), fields, expected_price);
+  }
+
+  inline Money BuyingPowerModel::submit(OrderId id, TickerId ticker,
+      const OrderFields& fields, Money expected_price) {
     auto& buying_power = m_buying_power[fields.m_currency];
-    buying_power -= compute_buying_power(entry);
-    auto& order_entries = pick(fields.m_side, entry.m_asks, entry.m_bids);
-    auto order_entry = OrderEntry(id, fields, expected_price);
-    auto insert_iterator = std::lower_bound(order_entries.begin(),
-      order_entries.end(), order_entry, [] (const auto& lhs, const auto& rhs) {
-        return (lhs.m_fields.m_side == Side::ASK &&
-          lhs.m_expected_price < rhs.m_expected_price) ||
-          (lhs.m_fields.m_side == Side::BID &&
-            lhs.m_expected_price > rhs.m_expected_price);
-      });
-    if(insert_iterator != order_entries.end() &&
-        insert_iterator->m_remaining_quantity == 0) {
-      *insert_iterator = order_entry;
-    } else {
-      order_entries.insert(insert_iterator, order_entry);
+    auto order = m_orders.try_emplace(id, ticker, fields, expected_price);
+    if(!order.second) {
+      return buying_power;
     }
+    auto& entry = m_buying_power_entries[order.first->second.m_ticker];
+    buying_power -= compute_buying_power(entry);
+    pick(fields.m_side, entry.m_asks, entry.m_bids).add(
+      expected_price, fields.m_quantity);
     buying_power += compute_buying_power(entry);
-    m_order_fields.insert(std::pair(id, fields));
     return buying_power;
   }
 
@@ -130,45 +165,46 @@ namespace Nexus {
         report.m_status == OrderStatus::CANCEL_REJECT) {
       return;
     }
-    auto& order_fields = m_order_fields.at(report.m_id);
-    auto& buying_power_entry =
-      m_buying_power_entries.at(order_fields.m_ticker);
-    auto& buying_power = m_buying_power[order_fields.m_currency];
+    auto& order = m_orders.at(report.m_id);
+    auto& buying_power_entry = m_buying_power_entries.at(order.m_ticker);
+    auto& buying_power = m_buying_power[order.m_currency];
     buying_power -= compute_buying_power(buying_power_entry);
-    auto& order_entries = pick(order_fields.m_side,
-      buying_power_entry.m_asks, buying_power_entry.m_bids);
-    for(auto& order_entry : order_entries) {
-      if(report.m_id == order_entry.m_id) {
-        if(is_terminal(report.m_status)) {
-          order_entry.m_remaining_quantity = 0;
-        } else {
-          order_entry.m_remaining_quantity -= report.m_last_quantity;
-        }
-        break;
+    auto removed_quantity = [&] {
+      if(is_terminal(report.m_status)) {
+        return order.m_remaining_quantity;
       }
+      return std::min(report.m_last_quantity, order.m_remaining_quantity);
+    }();
+    if(removed_quantity != 0) {
+      pick(order.m_side, buying_power_entry.m_asks,
+        buying_power_entry.m_bids).add(
+          order.m_expected_price, -removed_quantity);
+      order.m_remaining_quantity -= removed_quantity;
     }
     auto last_quantity = report.m_last_quantity;
-    if((order_fields.m_side == Side::BID &&
-        buying_power_entry.m_quantity < 0) ||
-        (order_fields.m_side == Side::ASK &&
-          buying_power_entry.m_quantity > 0)) {
+    if((order.m_side == Side::BID && buying_power_entry.m_quantity < 0) ||
+        (order.m_side == Side::ASK && buying_power_entry.m_quantity > 0)) {
       auto delta = std::min(abs(buying_power_entry.m_quantity), last_quantity);
       buying_power_entry.m_expenditure -=
-        get_direction(get_opposite(order_fields.m_side)) * delta *
+        get_direction(get_opposite(order.m_side)) * delta *
           (buying_power_entry.m_expenditure / buying_power_entry.m_quantity);
-      buying_power_entry.m_quantity +=
-        get_direction(order_fields.m_side) * delta;
+      buying_power_entry.m_quantity += get_direction(order.m_side) * delta;
       last_quantity -= delta;
     }
     buying_power_entry.m_quantity +=
-      get_direction(order_fields.m_side) * last_quantity;
+      get_direction(order.m_side) * last_quantity;
     buying_power_entry.m_expenditure +=
-      get_direction(order_fields.m_side) * last_quantity * report.m_last_price;
+      get_direction(order.m_side) * last_quantity * report.m_last_price;
     buying_power += compute_buying_power(buying_power_entry);
   }
 
   inline void BuyingPowerModel::update(const Ticker& ticker,
       CurrencyId currency, Quantity quantity, Money expenditure) {
+    update(to_ticker_id(ticker), currency, quantity, expenditure);
+  }
+
+  inline void BuyingPowerModel::update(TickerId ticker, CurrencyId currency,
+      Quantity quantity, Money expenditure) {
     auto& entry = m_buying_power_entries[ticker];
     auto& buying_power = m_buying_power[currency];
     buying_power -= compute_buying_power(entry);
@@ -177,36 +213,16 @@ namespace Nexus {
     buying_power += compute_buying_power(entry);
   }
 
-  inline Money BuyingPowerModel::compute_buying_power(
-      const std::vector<OrderEntry>& entries, Quantity offset) {
-    auto buying_power = Money();
-    for(auto& order_entry : entries) {
-      if(offset == 0) {
-        buying_power +=
-          order_entry.m_remaining_quantity * order_entry.m_expected_price;
-      } else if(order_entry.m_remaining_quantity < offset) {
-        offset -= order_entry.m_remaining_quantity;
-      } else {
-        buying_power += (order_entry.m_remaining_quantity - offset) *
-          order_entry.m_expected_price;
-        offset = 0;
-      }
-    }
-    return buying_power;
-  }
-
   inline Money BuyingPowerModel::compute_buying_power(
       const BuyingPowerEntry& entry) {
     auto ask_buying_power = Money();
     auto bid_buying_power = Money();
     if(entry.m_quantity >= 0) {
-      ask_buying_power = compute_buying_power(entry.m_asks, entry.m_quantity);
-      bid_buying_power =
-        compute_buying_power(entry.m_bids, 0) + entry.m_expenditure;
+      ask_buying_power = entry.m_asks.get_notional(entry.m_quantity);
+      bid_buying_power = entry.m_bids.get_notional() + entry.m_expenditure;
     } else {
-      ask_buying_power =
-        compute_buying_power(entry.m_asks, 0) - entry.m_expenditure;
-      bid_buying_power = compute_buying_power(entry.m_bids, -entry.m_quantity);
+      ask_buying_power = entry.m_asks.get_notional() - entry.m_expenditure;
+      bid_buying_power = entry.m_bids.get_notional(-entry.m_quantity);
     }
     return std::max(ask_buying_power, bid_buying_power);
   }
@@ -6,12 +6,12 @@
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queues/RoutineTaskQueue.hpp>
 #include <Beam/Queues/ScopedQueueReader.hpp>
-#include <Beam/Queues/StateQueue.hpp>
 #include <Beam/Queues/ValueSnapshotPublisher.hpp>
 #include <Beam/SignalHandling/NullSlot.hpp>
 #include <Beam/Utilities/TypeTraits.hpp>
 #include "Nexus/Accounting/Portfolio.hpp"
 #include "Nexus/Definitions/BboQuote.hpp"
+#include "Nexus/MarketDataService/BboQuoteCache.hpp"
 #include "Nexus/MarketDataService/MarketDataClient.hpp"
 #include "Nexus/OrderExecutionService/ExecutionReportPublisher.hpp"
 #include "Nexus/OrderExecutionService/Order.hpp"
@@ -45,6 +45,19 @@ namespace Nexus {
       PortfolioController(PF&& portfolio, MC&& market_data_client,
         Beam::ScopedQueueReader<std::shared_ptr<Order>> orders);
 
+      /**
+       * Constructs a PortfolioController that values the Portfolio using a
+       * shared BboQuoteCache.
+       * @param portfolio Initializes the Portfolio.
+       * @param market_data_client Initializes the MarketDataClient.
+       * @param bbo_quotes The BboQuoteCache used to value the Portfolio.
+       * @param orders The Orders to include in the Portfolio.
+       */
+      template<Beam::Initializes<P> PF, Beam::Initializes<C> MC>
+      PortfolioController(PF&& portfolio, MC&& market_data_client,
+        std::shared_ptr<BboQuoteCache> bbo_quotes,
+        Beam::ScopedQueueReader<std::shared_ptr<Order>> orders);
+
       /** Returns the object publishing updates to the Portfolio. */
       const Beam::SnapshotPublisher<PortfolioUpdateEntry, Portfolio*>&
         get_publisher() const;
@@ -52,6 +65,7 @@ namespace Nexus {
     private:
       Beam::local_ptr_t<P> m_portfolio;
       Beam::local_ptr_t<C> m_market_data_client;
+      std::shared_ptr<BboQuoteCache> m_bbo_quote_cache;
       ExecutionReportPublisher m_execution_report_publisher;
       Beam::ValueSnapshotPublisher<PortfolioUpdateEntry, Portfolio*>
         m_publisher;
@@ -73,21 +87,42 @@ namespace Nexus {
     P&&, C&&, Beam::ScopedQueueReader<std::shared_ptr<Order>>) ->
       PortfolioController<std::decay_t<P>, std::remove_reference_t<C>>;
 
+  template<typename P, typename C> requires
+    IsMarketDataClient<Beam::dereference_t<C>>
+  PortfolioController(P&&, C&&, std::shared_ptr<BboQuoteCache>,
+    Beam::ScopedQueueReader<std::shared_ptr<Order>>) ->
+      PortfolioController<std::decay_t<P>, std::remove_reference_t<C>>;
+
+  template<typename P, typename C> requires
+    IsMarketDataClient<Beam::dereference_t<C>>
+  template<Beam::Initializes<P> PF, Beam::Initializes<C> MC>
+  PortfolioController<P, C>::PortfolioController(
+    PF&& portfolio, MC&& market_data_client,
+    Beam::ScopedQueueReader<std::shared_ptr<Order>> orders)
+    : PortfolioController(std::forward<PF>(portfolio),
+        std::forward<MC>(market_data_client), nullptr, std::move(orders)) {}
+
   template<typename P, typename C> requires
     IsMarketDataClient<Beam::dereference_t<C>>
   template<Beam::Initializes<P> PF, Beam::Initializes<C> MC>
   PortfolioController<P, C>::PortfolioController(
       PF&& portfolio, MC&& market_data_client,
+      std::shared_ptr<BboQuoteCache> bbo_quotes,
       Beam::ScopedQueueReader<std::shared_ptr<Order>> orders)
     : m_portfolio(std::forward<PF>(portfolio)),
       m_market_data_client(
         std::forward<decltype(market_data_client)>(market_data_client)),
+      m_bbo_quote_cache(std::move(bbo_quotes)),
       m_execution_report_publisher(std::move(orders)),
       m_publisher([] (auto snapshot, auto& queue) {
         for_each(*snapshot, [&] (const auto& update) {
           queue.push(update);
         });
       }, Beam::NullSlot(), &*m_portfolio) {
+    if(!m_bbo_quote_cache) {
+      m_bbo_quote_cache = std::make_shared<BboQuoteCache>(
+        Nexus::MarketDataClient(&*m_market_data_client));
+    }
     m_publisher.with([&] {
       for(auto& inventory :
           m_portfolio->get_bookkeeper().get_inventory_range()) {
@@ -119,15 +154,13 @@ namespace Nexus {
   void PortfolioController<P, C>::subscribe(const Ticker& ticker) {
     if(auto ticker_iterator = m_tickers.find(ticker);
         ticker_iterator == m_tickers.end()) {
-      auto snapshot = std::make_shared<Beam::StateQueue<BboQuote>>();
-      m_market_data_client->query(Beam::make_latest_query(ticker), snapshot);
+      auto bbo_quote = m_bbo_quote_cache->get(ticker);
       try {
-        on_bbo(ticker, snapshot->pop());
+        on_bbo(ticker, bbo_quote.load());
       } catch(const std::exception&) {
       }
-      m_market_data_client->query(Beam::make_real_time_query(ticker),
-        m_tasks.get_slot<BboQuote>(
-          std::bind_front(&PortfolioController::on_bbo, this, ticker)));
+      m_bbo_quote_cache->monitor(ticker, m_tasks.get_slot<BboQuote>(
+        std::bind_front(&PortfolioController::on_bbo, this, ticker)));
       m_tickers.insert(ticker);
     }
   }
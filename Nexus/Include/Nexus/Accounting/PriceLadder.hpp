@@ -0,0 +1,222 @@
+#ifndef NEXUS_PRICE_LADDER_HPP
+#define NEXUS_PRICE_LADDER_HPP
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include "Nexus/Definitions/Money.hpp"
+#include "Nexus/Definitions/Quantity.hpp"
+#include "Nexus/Definitions/Side.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores the quantity of open orders at each price on one side of a book,
+   * maintaining prefix sums of quantity and notional so that the notional
+   * beyond any quantity can be computed in logarithmic time.
+   */
+  class PriceLadder {
+    public:
+
+      /**
+       * Constructs an empty PriceLadder.
+       * @param side The Side of the orders, asks are ordered from lowest to
+       *        highest price and bids from highest to lowest price.
+       */
+      explicit PriceLadder(Side side) noexcept;
+
+      PriceLadder(PriceLadder&&) = default;
+
+      /** Returns the Side of the orders. */
+      Side get_side() const;
+
+      /** Returns the total quantity across all prices. */
+      Quantity get_quantity() const;
+
+      /** Returns the total notional across all prices. */
+      Money get_notional() const;
+
+      /**
+       * Returns the notional that remains after skipping a quantity of the
+       * ladder, starting from the first price.
+       * @param offset The quantity to skip.
+       * @return The notional of the quantity beyond the <i>offset</i>.
+       */
+      Money get_notional(Quantity offset) const;
+
+      /**
+       * Adjusts the quantity at a price, removing the price once its quantity
+       * is no longer positive.
+       * @param price The price to adjust.
+       * @param quantity The change in quantity.
+       */
+      void add(Money price, Quantity quantity);
+
+      PriceLadder& operator =(PriceLadder&&) = default;
+
+    private:
+      struct Node {
+        Money m_price;
+        Quantity m_quantity;
+        std::uint64_t m_priority;
+        Quantity m_total_quantity;
+        Money m_total_notional;
+        std::unique_ptr<Node> m_left;
+        std::unique_ptr<Node> m_right;
+
+        Node(Money price, Quantity quantity);
+      };
+      Side m_side;
+      std::unique_ptr<Node> m_root;
+
+      bool is_before(Money lhs, Money rhs) const;
+      void add(std::unique_ptr<Node>& node, Money price, Quantity quantity);
+      static void remove(std::unique_ptr<Node>& node);
+      static void rotate_left(std::unique_ptr<Node>& node);
+      static void rotate_right(std::unique_ptr<Node>& node);
+      static void update(Node& node);
+  };
+
+  inline PriceLadder::Node::Node(Money price, Quantity quantity)
+      : m_price(price),
+        m_quantity(quantity),
+        m_total_quantity(quantity),
+        m_total_notional(quantity * price) {
+    auto seed = static_cast<std::uint64_t>(std::hash<Money>()(price));
+    seed += 0x9E3779B97F4A7C15;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EB;
+    m_priority = seed ^ (seed >> 31);
+  }
+
+  inline PriceLadder::PriceLadder(Side side) noexcept
+    : m_side(side) {}
+
+  inline Side PriceLadder::get_side() const {
+    return m_side;
+  }
+
+  inline Quantity PriceLadder::get_quantity() const {
+    if(!m_root) {
+      return 0;
+    }
+    return m_root->m_total_quantity;
+  }
+
+  inline Money PriceLadder::get_notional() const {
+    if(!m_root) {
+      return Money::ZERO;
+    }
+    return m_root->m_total_notional;
+  }
+
+  inline Money PriceLadder::get_notional(Quantity offset) const {
+    auto skipped_notional = Money::ZERO;
+    auto node = m_root.get();
+    while(node && offset > 0) {
+      auto left_quantity = Quantity(0);
+      if(node->m_left) {
+        left_quantity = node->m_left->m_total_quantity;
+        if(offset <= left_quantity) {
+          node = node->m_left.get();
+          continue;
+        }
+        skipped_notional += node->m_left->m_total_notional;
+        offset -= left_quantity;
+      }
+      auto quantity = std::min(offset, node->m_quantity);
+      skipped_notional += quantity * node->m_price;
+      offset -= quantity;
+      node = node->m_right.get();
+    }
+    return get_notional() - skipped_notional;
+  }
+
+  inline void PriceLadder::add(Money price, Quantity quantity) {
+    add(m_root, price, quantity);
+  }
+
+  inline bool PriceLadder::is_before(Money lhs, Money rhs) const {
+    if(m_side == Side::BID) {
+      return lhs > rhs;
+    }
+    return lhs < rhs;
+  }
+
+  inline void PriceLadder::add(
+      std::unique_ptr<Node>& node, Money price, Quantity quantity) {
+    if(!node) {
+      if(quantity > 0) {
+        node = std::make_unique<Node>(price, quantity);
+      }
+      return;
+    }
+    if(node->m_price == price) {
+      node->m_quantity += quantity;
+      if(node->m_quantity <= 0) {
+        remove(node);
+        return;
+      }
+    } else if(is_before(price, node->m_price)) {
+      add(node->m_left, price, quantity);
+      if(node->m_left && node->m_left->m_priority > node->m_priority) {
+        rotate_right(node);
+      }
+    } else {
+      add(node->m_right, price, quantity);
+      if(node->m_right && node->m_right->m_priority > node->m_priority) {
+        rotate_left(node);
+      }
+    }
+    update(*node);
+  }
+
+  inline void PriceLadder::remove(std::unique_ptr<Node>& node) {
+    if(!node->m_left) {
+      node = std::move(node->m_right);
+    } else if(!node->m_right) {
+      node = std::move(node->m_left);
+    } else if(node->m_left->m_priority > node->m_right->m_priority) {
+      rotate_right(node);
+      remove(node->m_right);
+      update(*node);
+    } else {
+      rotate_left(node);
+      remove(node->m_left);
+      update(*node);
+    }
+  }
+
+  inline void PriceLadder::rotate_left(std::unique_ptr<Node>& node) {
+    auto right = std::move(node->m_right);
+    node->m_right = std::move(right->m_left);
+    update(*node);
+    right->m_left = std::move(node);
+    node = std::move(right);
+    update(*node);
+  }
+
+  inline void PriceLadder::rotate_right(std::unique_ptr<Node>& node) {
+    auto left = std::move(node->m_left);
+    node->m_left = std::move(left->m_right);
+    update(*node);
+    left->m_right = std::move(node);
+    node = std::move(left);
+    update(*node);
+  }
+
+  inline void PriceLadder::update(Node& node) {
+    node.m_total_quantity = node.m_quantity;
+    node.m_total_notional = node.m_quantity * node.m_price;
+    if(node.m_left) {
+      node.m_total_quantity += node.m_left->m_total_quantity;
+      node.m_total_notional += node.m_left->m_total_notional;
+    }
+    if(node.m_right) {
+      node.m_total_quantity += node.m_right->m_total_quantity;
+      node.m_total_notional += node.m_right->m_total_notional;
+    }
+  }
+}
+
+#endif
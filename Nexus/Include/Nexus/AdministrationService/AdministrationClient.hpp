@@ -59,6 +59,8 @@ namespace Nexus {
       { client.load_account_roles(std::declval<const Beam::DirectoryEntry&>(),
           std::declval<const Beam::DirectoryEntry&>()) } ->
             std::same_as<AccountRoles>;
+      { client.store(std::declval<const Beam::DirectoryEntry&>(),
+          std::declval<AccountRoles>()) } -> std::same_as<AccountRoles>;
       { client.load_parent_trading_group(
           std::declval<const Beam::DirectoryEntry&>()) } ->
             std::same_as<Beam::DirectoryEntry>;
@@ -227,6 +229,16 @@ namespace Nexus {
       AccountRoles load_account_roles(
         const Beam::DirectoryEntry& parent, const Beam::DirectoryEntry& child);
 
+      /**
+       * Stores the trader and manager roles an account has within its trading
+       * group.
+       * @param account The account whose roles are to be stored.
+       * @param roles The roles to assign to the <i>account</i>.
+       * @return The roles associated with the <i>account</i> once stored.
+       */
+      AccountRoles store(
+        const Beam::DirectoryEntry& account, AccountRoles roles);
+
       /**
        * Loads the DirectoryEntry representing an account's trading group.
        * @param account The account whose trading group is to be loaded.
@@ -507,6 +519,8 @@ namespace Nexus {
         virtual AccountRoles load_account_roles(
           const Beam::DirectoryEntry& parent,
           const Beam::DirectoryEntry& child) = 0;
+        virtual AccountRoles store(
+          const Beam::DirectoryEntry& account, AccountRoles roles) = 0;
         virtual Beam::DirectoryEntry load_parent_trading_group(
           const Beam::DirectoryEntry& account) = 0;
         virtual AccountIdentity load_identity(
@@ -606,6 +620,8 @@ namespace Nexus {
           const Beam::DirectoryEntry& account) override;
         AccountRoles load_account_roles(const Beam::DirectoryEntry& parent,
           const Beam::DirectoryEntry& child) override;
+        AccountRoles store(
+          const Beam::DirectoryEntry& account, AccountRoles roles) override;
         Beam::DirectoryEntry load_parent_trading_group(
           const Beam::DirectoryEntry& account) override;
         AccountIdentity load_identity(
@@ -766,6 +782,11 @@ namespace Nexus {
     return m_client->load_account_roles(parent, child);
   }
 
+  inline AccountRoles AdministrationClient::store(
+      const Beam::DirectoryEntry& account, AccountRoles roles) {
+    return m_client->store(account, roles);
+  }
+
   inline Beam::DirectoryEntry AdministrationClient::load_parent_trading_group(
       const Beam::DirectoryEntry& account) {
     return m_client->load_parent_trading_group(account);
@@ -1000,6 +1021,12 @@ namespace Nexus {
     return m_client->load_account_roles(parent, child);
   }
 
+  template<typename C>
+  AccountRoles AdministrationClient::WrappedAdministrationClient<C>::store(
+      const Beam::DirectoryEntry& account, AccountRoles roles) {
+    return m_client->store(account, roles);
+  }
+
   template<typename C>
   Beam::DirectoryEntry AdministrationClient::WrappedAdministrationClient<C>::
       load_parent_trading_group(const Beam::DirectoryEntry& account) {
@@ -102,6 +102,17 @@ namespace Nexus {
       AccountRoles, (Beam::DirectoryEntry, parent),
       (Beam::DirectoryEntry, child)),
 
+    /**
+     * Stores the trader and manager roles an account has within its trading
+     * group.
+     * @param account The account whose roles are to be stored.
+     * @param roles The roles to assign to the <i>account</i>.
+     * @return The roles associated with the <i>account</i> once stored.
+     */
+    (StoreAccountRolesService,
+      "Nexus.AdministrationServices.StoreAccountRolesService", AccountRoles,
+      (Beam::DirectoryEntry, account), (AccountRoles, roles)),
+
     /**
      * Loads the DirectoryEntry representing an account's trading group.
      * @param account The account whose trading group is to be loaded.
@@ -402,7 +413,14 @@ namespace Nexus {
      */
     (MarkNotificationAsUnreadService,
       "Nexus.AdministrationServices.MarkNotificationAsUnreadService",
-      void, (Notification::Id, id)));
+      void, (Notification::Id, id)),
+
+    /**
+     * Monitors updates to the roles, entitlements and trading groups of all
+     * accounts.
+     */
+    (MonitorAccountUpdatesService,
+      "Nexus.AdministrationServices.MonitorAccountUpdatesService", void));
 
   BEAM_DEFINE_MESSAGES(administration_messages,
 
@@ -428,7 +446,15 @@ namespace Nexus {
      * @param notification The new notification.
      */
     (NotificationMessage, "Nexus.AdministrationService.NotificationMessage",
-      (Notification, notification)));
+      (Notification, notification)),
+
+    /**
+     * Indicates that an account's roles, entitlements or trading groups may
+     * have changed.
+     * @param account The account affected.
+     */
+    (AccountUpdateMessage, "Nexus.AdministrationService.AccountUpdateMessage",
+      (Beam::DirectoryEntry, account)));
 }
 
 #endif
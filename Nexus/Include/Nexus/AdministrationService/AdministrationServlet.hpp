@@ -3,6 +3,7 @@
 #include <atomic>
 #include <iostream>
 #include <limits>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <unordered_map>
@@ -11,6 +12,7 @@
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queries/StandardFunctionExpressions.hpp>
+#include <Beam/Queues/RoutineTaskQueue.hpp>
 #include <Beam/Routines/RoutineHandler.hpp>
 #include <Beam/ServiceLocator/ServiceLocatorClient.hpp>
 #include <Beam/Threading/Sync.hpp>
@@ -112,11 +114,14 @@ namespace Nexus {
       Beam::SynchronizedUnorderedMap<
         Beam::DirectoryEntry, std::vector<ServiceProtocolClient*>, Beam::Mutex>
           m_notification_subscribers;
+      Beam::Sync<std::vector<ServiceProtocolClient*>>
+        m_account_update_subscribers;
       std::atomic_int m_last_modification_request_id;
       std::atomic_int m_last_message_id;
       boost::uuids::time_generator_v7 m_uuid_generator;
       Beam::RoutineHandler m_grant_loop;
       Beam::OpenState m_open_state;
+      Beam::RoutineTaskQueue m_tasks;
 
       static AccountModificationRequest::Status resolve_modification_status(
         AccountRoles roles, boost::posix_time::ptime effective_date,
@@ -147,6 +152,8 @@ namespace Nexus {
         std::string description, std::string data,
         Notification::Category category);
       void send_notification(const Notification& notification);
+      void send_account_update(const Beam::DirectoryEntry& account);
+      void on_directory_update(const Beam::AccountUpdate& update);
       void ensure_modification_read_permission(
         const Beam::DirectoryEntry& account, AccountModificationRequest::Id id);
       AccountModificationRequest make_modification_request(
@@ -176,6 +183,8 @@ namespace Nexus {
       AccountRoles on_load_supervised_account_roles_request(
         ServiceProtocolClient& client, const Beam::DirectoryEntry& parent,
         const Beam::DirectoryEntry& child);
+      AccountRoles on_store_account_roles_request(ServiceProtocolClient& client,
+        const Beam::DirectoryEntry& account, AccountRoles roles);
       Beam::DirectoryEntry on_load_parent_trading_group_request(
         ServiceProtocolClient& client, const Beam::DirectoryEntry& account);
       AccountIdentity on_load_account_identity_request(
@@ -259,6 +268,7 @@ namespace Nexus {
         ServiceProtocolClient& client, const Notification::Id& id);
       void on_mark_notification_as_unread(
         ServiceProtocolClient& client, const Notification::Id& id);
+      void on_monitor_account_updates(ServiceProtocolClient& client);
   };
 
   template<typename S, typename D, typename R, typename T>
@@ -305,6 +315,9 @@ namespace Nexus {
       m_trading_groups_root = Beam::load_or_create_directory(
         *m_service_locator_client, "trading_groups",
         Beam::DirectoryEntry::STAR_DIRECTORY);
+      m_service_locator_client->monitor(
+        m_tasks.get_slot<Beam::AccountUpdate>(std::bind_front(
+          &AdministrationServlet::on_directory_update, this)));
       grant_scheduled_modifications();
       m_grant_loop = Beam::spawn(std::bind_front(
         &AdministrationServlet::grant_scheduled_modifications_loop, this));
@@ -340,6 +353,8 @@ namespace Nexus {
       &AdministrationServlet::on_load_account_roles_request, this));
     LoadSupervisedAccountRolesService::add_slot(out(slots), std::bind_front(
       &AdministrationServlet::on_load_supervised_account_roles_request, this));
+    StoreAccountRolesService::add_slot(out(slots), std::bind_front(
+      &AdministrationServlet::on_store_account_roles_request, this));
     LoadParentTradingGroupService::add_slot(out(slots), std::bind_front(
       &AdministrationServlet::on_load_parent_trading_group_request, this));
     LoadAccountIdentityService::add_slot(out(slots), std::bind_front(
@@ -415,6 +430,8 @@ namespace Nexus {
       &AdministrationServlet::on_mark_notification_as_read, this));
     MarkNotificationAsUnreadService::add_slot(out(slots), std::bind_front(
       &AdministrationServlet::on_mark_notification_as_unread, this));
+    MonitorAccountUpdatesService::add_slot(out(slots), std::bind_front(
+      &AdministrationServlet::on_monitor_account_updates, this));
   }
 
   template<typename C, typename S, typename D, typename R, typename T> requires
@@ -441,6 +458,9 @@ namespace Nexus {
     m_notification_subscribers.for_each([&] (auto& entry) {
       std::erase(entry.second, &client);
     });
+    Beam::with(m_account_update_subscribers, [&] (auto& subscribers) {
+      std::erase(subscribers, &client);
+    });
   }
 
   template<typename C, typename S, typename D, typename R, typename T> requires
@@ -452,6 +472,8 @@ namespace Nexus {
     if(m_open_state.set_closing()) {
       return;
     }
+    m_tasks.close();
+    m_tasks.wait();
     m_timer->cancel();
     m_grant_loop.wait();
     m_data_store->close();
@@ -701,11 +723,13 @@ namespace Nexus {
     auto existing_entitlements = load_entitlements(account);
     auto entitlement_set =
       std::unordered_set(entitlements.begin(), entitlements.end());
+    auto is_modified = false;
     for(auto& entitlement : m_entitlements.get_entries()) {
       auto& entry = entitlement.m_group_entry;
       if(entitlement_set.contains(entry)) {
         if(!std::ranges::contains(existing_entitlements, entry)) {
           m_service_locator_client->associate(account, entry);
+          is_modified = true;
           auto ss = std::stringstream();
           ss <<
             boost::posix_time::to_simple_string(m_time_client->get_time()) <<
@@ -716,6 +740,7 @@ namespace Nexus {
       } else {
         if(std::ranges::contains(existing_entitlements, entry)) {
           m_service_locator_client->detach(account, entry);
+          is_modified = true;
           auto ss = std::stringstream();
           ss <<
             boost::posix_time::to_simple_string(m_time_client->get_time()) <<
@@ -725,6 +750,9 @@ namespace Nexus {
         }
       }
     }
+    if(is_modified) {
+      send_account_update(account);
+    }
     send_notification(make_entitlement_modification_notification(
       boost::uuids::to_string(m_uuid_generator()), account, request_id,
       AccountModificationRequest::Status::GRANTED, m_time_client->get_time()));
@@ -810,6 +838,29 @@ namespace Nexus {
     });
   }
 
+  template<typename C, typename S, typename D, typename R, typename T> requires
+    Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+      IsAdministrationDataStore<Beam::dereference_t<D>> &&
+        Beam::IsTimeClient<Beam::dereference_t<R>> &&
+          Beam::IsTimer<Beam::dereference_t<T>>
+  void AdministrationServlet<C, S, D, R, T>::send_account_update(
+      const Beam::DirectoryEntry& account) {
+    Beam::with(m_account_update_subscribers, [&] (auto& subscribers) {
+      Beam::broadcast_record_message<AccountUpdateMessage>(
+        subscribers, account);
+    });
+  }
+
+  template<typename C, typename S, typename D, typename R, typename T> requires
+    Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+      IsAdministrationDataStore<Beam::dereference_t<D>> &&
+        Beam::IsTimeClient<Beam::dereference_t<R>> &&
+          Beam::IsTimer<Beam::dereference_t<T>>
+  void AdministrationServlet<C, S, D, R, T>::on_directory_update(
+      const Beam::AccountUpdate& update) {
+    send_account_update(update.m_account);
+  }
+
   template<typename C, typename S, typename D, typename R, typename T> requires
     Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
       IsAdministrationDataStore<Beam::dereference_t<D>> &&
@@ -1190,6 +1241,57 @@ namespace Nexus {
     return load_account_roles(parent, child);
   }
 
+  template<typename C, typename S, typename D, typename R, typename T> requires
+    Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+      IsAdministrationDataStore<Beam::dereference_t<D>> &&
+        Beam::IsTimeClient<Beam::dereference_t<R>> &&
+          Beam::IsTimer<Beam::dereference_t<T>>
+  AccountRoles AdministrationServlet<C, S, D, R, T>::
+      on_store_account_roles_request(ServiceProtocolClient& client,
+        const Beam::DirectoryEntry& account, AccountRoles roles) {
+    auto& session = client.get_session();
+    auto member_group = std::optional<TradingGroup>();
+    for(auto& group : load_managed_trading_groups(session.get_account())) {
+      auto trading_group = load_trading_group(group);
+      if(std::ranges::contains(trading_group.get_managers(), account) ||
+          std::ranges::contains(trading_group.get_traders(), account)) {
+        member_group = std::move(trading_group);
+        break;
+      }
+    }
+    if(!member_group) {
+      boost::throw_with_location(
+        Beam::ServiceRequestException("Insufficient permissions."));
+    }
+    auto previous_roles = load_account_roles(account);
+    if(roles.test(AccountRole::MANAGER) !=
+        previous_roles.test(AccountRole::MANAGER)) {
+      if(roles.test(AccountRole::MANAGER)) {
+        m_service_locator_client->store(
+          account, member_group->get_entry(), Beam::Permission::READ);
+        m_service_locator_client->associate(
+          account, member_group->get_managers_directory());
+      } else {
+        m_service_locator_client->store(
+          account, member_group->get_entry(), Beam::Permissions(0));
+        m_service_locator_client->detach(
+          account, member_group->get_managers_directory());
+      }
+    }
+    if(roles.test(AccountRole::TRADER) !=
+        previous_roles.test(AccountRole::TRADER)) {
+      if(roles.test(AccountRole::TRADER)) {
+        m_service_locator_client->associate(
+          account, member_group->get_traders_directory());
+      } else {
+        m_service_locator_client->detach(
+          account, member_group->get_traders_directory());
+      }
+    }
+    send_account_update(account);
+    return load_account_roles(account);
+  }
+
   template<typename C, typename S, typename D, typename R, typename T> requires
     Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
       IsAdministrationDataStore<Beam::dereference_t<D>> &&
@@ -1260,6 +1362,7 @@ namespace Nexus {
     m_data_store->with_transaction([&] {
       m_data_store->store(account_entry, identity);
     });
+    send_account_update(account_entry);
   }
 
   template<typename C, typename S, typename D, typename R, typename T> requires
@@ -2238,6 +2341,26 @@ namespace Nexus {
       m_data_store->mark_notification_as_unread(id);
     });
   }
+
+  template<typename C, typename S, typename D, typename R, typename T> requires
+    Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+      IsAdministrationDataStore<Beam::dereference_t<D>> &&
+        Beam::IsTimeClient<Beam::dereference_t<R>> &&
+          Beam::IsTimer<Beam::dereference_t<T>>
+  void AdministrationServlet<C, S, D, R, T>::on_monitor_account_updates(
+      ServiceProtocolClient& client) {
+    auto& session = client.get_session();
+    if(!check_administrator(session.get_account()) &&
+        !check_service(session.get_account())) {
+      boost::throw_with_location(
+        Beam::ServiceRequestException("Insufficient permissions."));
+    }
+    Beam::with(m_account_update_subscribers, [&] (auto& subscribers) {
+      if(!std::ranges::contains(subscribers, &client)) {
+        subscribers.push_back(&client);
+      }
+    });
+  }
 }
 
 #endif
@@ -0,0 +1,529 @@
+#ifndef NEXUS_CACHED_ADMINISTRATION_CLIENT_HPP
+#define NEXUS_CACHED_ADMINISTRATION_CLIENT_HPP
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <Beam/IO/OpenState.hpp>
+#include <Beam/Pointers/Dereference.hpp>
+#include <Beam/Pointers/LocalPtr.hpp>
+#include <Beam/Queues/RoutineTaskQueue.hpp>
+#include <Beam/Threading/Mutex.hpp>
+#include <Beam/Utilities/TypeTraits.hpp>
+#include "Nexus/AdministrationService/AdministrationClient.hpp"
+
+namespace Nexus {
+
+  /**
+   * Caches the roles, trading groups and entitlements loaded through an
+   * AdministrationClient, so that repeated lookups, such as those made when
+   * authenticating sessions, are served locally. Cached entries are
+   * invalidated by the account updates the administration server pushes when
+   * roles, identities or entitlements are stored through it and when accounts
+   * are added to or removed from the service locator. Directory edits made
+   * directly through the service locator are not pushed and remain unobserved
+   * until the next update. Should the stream of updates be broken, caching is
+   * disabled and every lookup is forwarded.
+   * @param <C> The type of AdministrationClient to cache.
+   */
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  class CachedAdministrationClient {
+    public:
+
+      /** The type of AdministrationClient to cache. */
+      using Client = Beam::dereference_t<C>;
+
+      /**
+       * Constructs a CachedAdministrationClient.
+       * @param client The AdministrationClient to cache.
+       */
+      template<Beam::Initializes<C> CF>
+      explicit CachedAdministrationClient(CF&& client);
+
+      ~CachedAdministrationClient();
+
+      std::vector<Beam::DirectoryEntry>
+        load_accounts_by_roles(AccountRoles roles);
+      std::vector<AccountQueryResult> query_accounts(const std::string& query);
+      Beam::DirectoryEntry load_administrators_root_entry();
+      Beam::DirectoryEntry load_services_root_entry();
+      Beam::DirectoryEntry load_trading_groups_root_entry();
+      bool check_administrator(const Beam::DirectoryEntry& account);
+      AccountRoles load_account_roles(const Beam::DirectoryEntry& account);
+      AccountRoles load_account_roles(
+        const Beam::DirectoryEntry& parent, const Beam::DirectoryEntry& child);
+      AccountRoles store(
+        const Beam::DirectoryEntry& account, AccountRoles roles);
+      Beam::DirectoryEntry load_parent_trading_group(
+        const Beam::DirectoryEntry& account);
+      AccountIdentity load_identity(const Beam::DirectoryEntry& account);
+      void store(
+        const Beam::DirectoryEntry& account, const AccountIdentity& identity);
+      TradingGroup load_trading_group(const Beam::DirectoryEntry& directory);
+      std::vector<Beam::DirectoryEntry>
+        load_managed_trading_groups(const Beam::DirectoryEntry& account);
+      std::vector<Beam::DirectoryEntry> load_administrators();
+      std::vector<Beam::DirectoryEntry> load_services();
+      EntitlementDatabase load_entitlements();
+      std::vector<Beam::DirectoryEntry> load_entitlements(
+        const Beam::DirectoryEntry& account);
+      const Beam::Publisher<RiskParameters>& get_risk_parameters_publisher(
+        const Beam::DirectoryEntry& account);
+      const Beam::Publisher<RiskState>& get_risk_state_publisher(
+        const Beam::DirectoryEntry& account);
+      void store(const Beam::DirectoryEntry& account, const RiskState& state);
+      AccountModificationRequest load_account_modification_request(
+        AccountModificationRequest::Id id);
+      std::vector<AccountModificationRequestSummary>
+        load_account_modification_request_summaries(
+          const AccountModificationRequestQuery& query);
+      AccountModificationRequestCounts
+        load_account_modification_request_counts(
+          const AccountModificationRequestQuery& query);
+      EntitlementModification load_entitlement_modification(
+        AccountModificationRequest::Id id);
+      AccountModificationRequest submit(const Beam::DirectoryEntry& account,
+        const EntitlementModification& modification,
+        boost::posix_time::ptime effective_date, const Message& comment);
+      RiskModification load_risk_modification(
+        AccountModificationRequest::Id id);
+      AccountModificationRequest submit(const Beam::DirectoryEntry& account,
+        const RiskModification& modification,
+        boost::posix_time::ptime effective_date, const Message& comment);
+      AccountModificationRequest::Update
+        load_account_modification_request_status(
+          AccountModificationRequest::Id id);
+      std::vector<AccountModificationRequest::Update>
+        load_account_modification_request_updates(
+          AccountModificationRequest::Id id);
+      AccountModificationRequest::Update approve_account_modification_request(
+        AccountModificationRequest::Id id,
+        boost::posix_time::ptime effective_date, const Message& comment);
+      AccountModificationRequest::Update reject_account_modification_request(
+        AccountModificationRequest::Id id, const Message& comment);
+      Message load_message(
+        AccountModificationRequest::Id request_id, Message::Id id);
+      std::vector<Message::Id> load_message_ids(
+        AccountModificationRequest::Id id);
+      Message send_account_modification_request_message(
+        AccountModificationRequest::Id id, const Message& message);
+      Notification send_notification(const Beam::DirectoryEntry& account,
+        const std::string& description, const std::string& data,
+        Notification::Category category);
+      Notification::Id monitor_notifications(
+        const Beam::DirectoryEntry& account,
+        Beam::ScopedQueueWriter<Notification> queue);
+      std::vector<Notification> load_notifications(
+        const Beam::DirectoryEntry& account, const Notification::Id& id,
+        Beam::SnapshotLimit limit, Notification::ReadState read_state);
+      void mark_notification_as_read(const Notification::Id& id);
+      void mark_notification_as_unread(const Notification::Id& id);
+      void close();
+
+    private:
+      template<typename T>
+      using Cache = std::unordered_map<Beam::DirectoryEntry, T>;
+      Beam::local_ptr_t<C> m_client;
+      Beam::Mutex m_mutex;
+      bool m_is_caching;
+      std::uint64_t m_version;
+      Cache<bool> m_administrators;
+      Cache<AccountRoles> m_account_roles;
+      Cache<std::vector<Beam::DirectoryEntry>> m_managed_trading_groups;
+      Cache<TradingGroup> m_trading_groups;
+      Cache<std::vector<Beam::DirectoryEntry>> m_entitlements;
+      std::optional<EntitlementDatabase> m_entitlement_database;
+      Beam::OpenState m_open_state;
+      Beam::RoutineTaskQueue m_tasks;
+
+      CachedAdministrationClient(const CachedAdministrationClient&) = delete;
+      CachedAdministrationClient& operator =(
+        const CachedAdministrationClient&) = delete;
+      template<typename T, typename F>
+      T load(Cache<T>& cache, const Beam::DirectoryEntry& key, F&& f);
+      void clear();
+      void on_account_update(const Beam::DirectoryEntry& account);
+      void on_account_updates_break(const std::exception_ptr& e);
+  };
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  template<Beam::Initializes<C> CF>
+  CachedAdministrationClient<C>::CachedAdministrationClient(CF&& client)
+      : m_client(std::forward<CF>(client)),
+        m_is_caching(true),
+        m_version(0) {
+    try {
+      m_client->monitor_account_updates(m_tasks.get_slot<Beam::DirectoryEntry>(
+        std::bind_front(&CachedAdministrationClient::on_account_update, this),
+        std::bind_front(
+          &CachedAdministrationClient::on_account_updates_break, this)));
+    } catch(const std::exception&) {
+      close();
+      throw;
+    }
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  CachedAdministrationClient<C>::~CachedAdministrationClient() {
+    close();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Beam::DirectoryEntry>
+      CachedAdministrationClient<C>::load_accounts_by_roles(
+        AccountRoles roles) {
+    return m_client->load_accounts_by_roles(roles);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<AccountQueryResult> CachedAdministrationClient<C>::query_accounts(
+      const std::string& query) {
+    return m_client->query_accounts(query);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Beam::DirectoryEntry
+      CachedAdministrationClient<C>::load_administrators_root_entry() {
+    return m_client->load_administrators_root_entry();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Beam::DirectoryEntry
+      CachedAdministrationClient<C>::load_services_root_entry() {
+    return m_client->load_services_root_entry();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Beam::DirectoryEntry
+      CachedAdministrationClient<C>::load_trading_groups_root_entry() {
+    return m_client->load_trading_groups_root_entry();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  bool CachedAdministrationClient<C>::check_administrator(
+      const Beam::DirectoryEntry& account) {
+    return load(m_administrators, account, [&] {
+      return m_client->check_administrator(account);
+    });
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountRoles CachedAdministrationClient<C>::load_account_roles(
+      const Beam::DirectoryEntry& account) {
+    return load(m_account_roles, account, [&] {
+      return m_client->load_account_roles(account);
+    });
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountRoles CachedAdministrationClient<C>::load_account_roles(
+      const Beam::DirectoryEntry& parent, const Beam::DirectoryEntry& child) {
+    return m_client->load_account_roles(parent, child);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountRoles CachedAdministrationClient<C>::store(
+      const Beam::DirectoryEntry& account, AccountRoles roles) {
+    auto result = m_client->store(account, roles);
+    on_account_update(account);
+    return result;
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Beam::DirectoryEntry CachedAdministrationClient<C>::load_parent_trading_group(
+      const Beam::DirectoryEntry& account) {
+    return m_client->load_parent_trading_group(account);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountIdentity CachedAdministrationClient<C>::load_identity(
+      const Beam::DirectoryEntry& account) {
+    return m_client->load_identity(account);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::store(
+      const Beam::DirectoryEntry& account, const AccountIdentity& identity) {
+    m_client->store(account, identity);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  TradingGroup CachedAdministrationClient<C>::load_trading_group(
+      const Beam::DirectoryEntry& directory) {
+    return load(m_trading_groups, directory, [&] {
+      return m_client->load_trading_group(directory);
+    });
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Beam::DirectoryEntry>
+      CachedAdministrationClient<C>::load_managed_trading_groups(
+        const Beam::DirectoryEntry& account) {
+    return load(m_managed_trading_groups, account, [&] {
+      return m_client->load_managed_trading_groups(account);
+    });
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Beam::DirectoryEntry>
+      CachedAdministrationClient<C>::load_administrators() {
+    return m_client->load_administrators();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Beam::DirectoryEntry>
+      CachedAdministrationClient<C>::load_services() {
+    return m_client->load_services();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  EntitlementDatabase CachedAdministrationClient<C>::load_entitlements() {
+    auto version = std::uint64_t(0);
+    {
+      auto lock = std::lock_guard(m_mutex);
+      if(m_entitlement_database) {
+        return *m_entitlement_database;
+      }
+      version = m_version;
+    }
+    auto entitlements = m_client->load_entitlements();
+    auto lock = std::lock_guard(m_mutex);
+    if(m_is_caching && m_version == version) {
+      m_entitlement_database = entitlements;
+    }
+    return entitlements;
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Beam::DirectoryEntry>
+      CachedAdministrationClient<C>::load_entitlements(
+        const Beam::DirectoryEntry& account) {
+    return load(m_entitlements, account, [&] {
+      return m_client->load_entitlements(account);
+    });
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  const Beam::Publisher<RiskParameters>&
+      CachedAdministrationClient<C>::get_risk_parameters_publisher(
+        const Beam::DirectoryEntry& account) {
+    return m_client->get_risk_parameters_publisher(account);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  const Beam::Publisher<RiskState>&
+      CachedAdministrationClient<C>::get_risk_state_publisher(
+        const Beam::DirectoryEntry& account) {
+    return m_client->get_risk_state_publisher(account);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::store(
+      const Beam::DirectoryEntry& account, const RiskState& state) {
+    m_client->store(account, state);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequest
+      CachedAdministrationClient<C>::load_account_modification_request(
+        AccountModificationRequest::Id id) {
+    return m_client->load_account_modification_request(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<AccountModificationRequestSummary>
+      CachedAdministrationClient<C>::
+        load_account_modification_request_summaries(
+          const AccountModificationRequestQuery& query) {
+    return m_client->load_account_modification_request_summaries(query);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequestCounts CachedAdministrationClient<C>::
+      load_account_modification_request_counts(
+        const AccountModificationRequestQuery& query) {
+    return m_client->load_account_modification_request_counts(query);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  EntitlementModification
+      CachedAdministrationClient<C>::load_entitlement_modification(
+        AccountModificationRequest::Id id) {
+    return m_client->load_entitlement_modification(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequest CachedAdministrationClient<C>::submit(
+      const Beam::DirectoryEntry& account,
+      const EntitlementModification& modification,
+      boost::posix_time::ptime effective_date, const Message& comment) {
+    return m_client->submit(account, modification, effective_date, comment);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  RiskModification CachedAdministrationClient<C>::load_risk_modification(
+      AccountModificationRequest::Id id) {
+    return m_client->load_risk_modification(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequest CachedAdministrationClient<C>::submit(
+      const Beam::DirectoryEntry& account,
+      const RiskModification& modification,
+      boost::posix_time::ptime effective_date, const Message& comment) {
+    return m_client->submit(account, modification, effective_date, comment);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequest::Update
+      CachedAdministrationClient<C>::load_account_modification_request_status(
+        AccountModificationRequest::Id id) {
+    return m_client->load_account_modification_request_status(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<AccountModificationRequest::Update>
+      CachedAdministrationClient<C>::load_account_modification_request_updates(
+        AccountModificationRequest::Id id) {
+    return m_client->load_account_modification_request_updates(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequest::Update
+      CachedAdministrationClient<C>::approve_account_modification_request(
+        AccountModificationRequest::Id id,
+        boost::posix_time::ptime effective_date, const Message& comment) {
+    return m_client->approve_account_modification_request(
+      id, effective_date, comment);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  AccountModificationRequest::Update
+      CachedAdministrationClient<C>::reject_account_modification_request(
+        AccountModificationRequest::Id id, const Message& comment) {
+    return m_client->reject_account_modification_request(id, comment);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Message CachedAdministrationClient<C>::load_message(
+      AccountModificationRequest::Id request_id, Message::Id id) {
+    return m_client->load_message(request_id, id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Message::Id> CachedAdministrationClient<C>::load_message_ids(
+      AccountModificationRequest::Id id) {
+    return m_client->load_message_ids(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Message CachedAdministrationClient<C>::
+      send_account_modification_request_message(
+        AccountModificationRequest::Id id, const Message& message) {
+    return m_client->send_account_modification_request_message(id, message);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Notification CachedAdministrationClient<C>::send_notification(
+      const Beam::DirectoryEntry& account, const std::string& description,
+      const std::string& data, Notification::Category category) {
+    return m_client->send_notification(account, description, data, category);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  Notification::Id CachedAdministrationClient<C>::monitor_notifications(
+      const Beam::DirectoryEntry& account,
+      Beam::ScopedQueueWriter<Notification> queue) {
+    return m_client->monitor_notifications(account, std::move(queue));
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  std::vector<Notification> CachedAdministrationClient<C>::load_notifications(
+      const Beam::DirectoryEntry& account, const Notification::Id& id,
+      Beam::SnapshotLimit limit, Notification::ReadState read_state) {
+    return m_client->load_notifications(account, id, limit, read_state);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::mark_notification_as_read(
+      const Notification::Id& id) {
+    m_client->mark_notification_as_read(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::mark_notification_as_unread(
+      const Notification::Id& id) {
+    m_client->mark_notification_as_unread(id);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::close() {
+    if(m_open_state.set_closing()) {
+      return;
+    }
+    m_tasks.close();
+    m_tasks.wait();
+    m_client->close();
+    m_open_state.close();
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  template<typename T, typename F>
+  T CachedAdministrationClient<C>::load(
+      Cache<T>& cache, const Beam::DirectoryEntry& key, F&& f) {
+    auto version = std::uint64_t(0);
+    {
+      auto lock = std::lock_guard(m_mutex);
+      auto i = cache.find(key);
+      if(i != cache.end()) {
+        return i->second;
+      }
+      version = m_version;
+    }
+    auto value = std::forward<F>(f)();
+    auto lock = std::lock_guard(m_mutex);
+    if(m_is_caching && m_version == version) {
+      cache.emplace(key, value);
+    }
+    return value;
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::clear() {
+    ++m_version;
+    m_administrators.clear();
+    m_account_roles.clear();
+    m_managed_trading_groups.clear();
+    m_trading_groups.clear();
+    m_entitlements.clear();
+    m_entitlement_database = std::nullopt;
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::on_account_update(
+      const Beam::DirectoryEntry& account) {
+    auto lock = std::lock_guard(m_mutex);
+    if(account == Beam::DirectoryEntry()) {
+      clear();
+      return;
+    }
+    ++m_version;
+    m_administrators.erase(account);
+    m_account_roles.erase(account);
+    m_managed_trading_groups.erase(account);
+    m_trading_groups.clear();
+    m_entitlements.erase(account);
+  }
+
+  template<typename C> requires IsAdministrationClient<Beam::dereference_t<C>>
+  void CachedAdministrationClient<C>::on_account_updates_break(
+      const std::exception_ptr& e) {
+    auto lock = std::lock_guard(m_mutex);
+    m_is_caching = false;
+    clear();
+  }
+}
+
+#endif
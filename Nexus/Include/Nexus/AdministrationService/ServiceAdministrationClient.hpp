@@ -48,6 +48,8 @@ namespace Nexus {
       AccountRoles load_account_roles(const Beam::DirectoryEntry& account);
       AccountRoles load_account_roles(
         const Beam::DirectoryEntry& parent, const Beam::DirectoryEntry& child);
+      AccountRoles store(
+        const Beam::DirectoryEntry& account, AccountRoles roles);
       Beam::DirectoryEntry load_parent_trading_group(
         const Beam::DirectoryEntry& account);
       AccountIdentity load_identity(const Beam::DirectoryEntry& account);
@@ -112,6 +114,16 @@ namespace Nexus {
         Beam::SnapshotLimit limit, Notification::ReadState read_state);
       void mark_notification_as_read(const Notification::Id& id);
       void mark_notification_as_unread(const Notification::Id& id);
+
+      /**
+       * Monitors updates to the roles, entitlements and trading groups of all
+       * accounts. Following a reconnection, a default constructed
+       * DirectoryEntry is pushed to indicate that updates may have been
+       * missed and any account may have changed.
+       * @param queue The queue to push the updated accounts to.
+       */
+      void monitor_account_updates(
+        Beam::ScopedQueueWriter<Beam::DirectoryEntry> queue);
       void close();
 
     private:
@@ -131,6 +143,8 @@ namespace Nexus {
         std::shared_ptr<RiskStatePublisher>> m_risk_state_publishers;
       Beam::SynchronizedUnorderedMap<Beam::DirectoryEntry, NotificationEntry,
         Beam::Mutex> m_notification_entries;
+      std::vector<Beam::ScopedQueueWriter<Beam::DirectoryEntry>>
+        m_account_update_queues;
       Beam::RoutineTaskQueue m_tasks;
 
       ServiceAdministrationClient(const ServiceAdministrationClient&) = delete;
@@ -147,6 +161,9 @@ namespace Nexus {
       void recover_notifications(ServiceProtocolClient& client);
       void on_notification_message(
         ServiceProtocolClient& client, Notification notification);
+      void recover_account_updates(ServiceProtocolClient& client);
+      void on_account_update_message(
+        ServiceProtocolClient& client, const Beam::DirectoryEntry& account);
   };
 
   template<typename B>
@@ -169,6 +186,9 @@ BEAM_SUPPRESS_THIS_INITIALIZER()
     Beam::add_message_slot<NotificationMessage>(
       Beam::out(m_client_handler.get_slots()), std::bind_front(
         &ServiceAdministrationClient::on_notification_message, this));
+    Beam::add_message_slot<AccountUpdateMessage>(
+      Beam::out(m_client_handler.get_slots()), std::bind_front(
+        &ServiceAdministrationClient::on_account_update_message, this));
 BEAM_UNSUPPRESS_THIS_INITIALIZER()
   } catch(const std::exception&) {
     std::throw_with_nested(Beam::ConnectException(
@@ -262,6 +282,17 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
       boost::lexical_cast<std::string>(child));
   }
 
+  template<typename B>
+  AccountRoles ServiceAdministrationClient<B>::store(
+      const Beam::DirectoryEntry& account, AccountRoles roles) {
+    return Beam::service_or_throw_with_nested([&] {
+      auto client = m_client_handler.get_client();
+      return client->template send_request<StoreAccountRolesService>(
+        account, roles);
+    }, "Failed to store account roles: " +
+      boost::lexical_cast<std::string>(account));
+  }
+
   template<typename B>
   Beam::DirectoryEntry
       ServiceAdministrationClient<B>::load_parent_trading_group(
@@ -645,6 +676,28 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
     }, "Failed to mark notification as unread: " + id);
   }
 
+  template<typename B>
+  void ServiceAdministrationClient<B>::monitor_account_updates(
+      Beam::ScopedQueueWriter<Beam::DirectoryEntry> queue) {
+    auto completion = Beam::Async<void>();
+    m_tasks.push([&] {
+      if(m_account_update_queues.empty()) {
+        try {
+          auto client = m_client_handler.get_client();
+          client->template send_request<MonitorAccountUpdatesService>();
+        } catch(const std::exception&) {
+          completion.get_eval().set_exception(
+            Beam::make_nested_service_exception(
+              "Failed to monitor account updates."));
+          return;
+        }
+      }
+      m_account_update_queues.push_back(std::move(queue));
+      completion.get_eval().set();
+    });
+    completion.get();
+  }
+
   template<typename B>
   void ServiceAdministrationClient<B>::close() {
     if(m_open_state.set_closing()) {
@@ -653,6 +706,7 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
     m_tasks.close();
     m_tasks.wait();
     m_client_handler.close();
+    m_account_update_queues.clear();
     m_notification_entries.clear();
     m_risk_state_publishers.clear();
     m_risk_parameter_publishers.clear();
@@ -666,6 +720,7 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
       recover_risk_parameters(*client);
       recover_risk_state(*client);
       recover_notifications(*client);
+      recover_account_updates(*client);
     });
   }
 
@@ -814,6 +869,47 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
       }
     });
   }
+
+  template<typename B>
+  void ServiceAdministrationClient<B>::recover_account_updates(
+      ServiceProtocolClient& client) {
+    if(m_account_update_queues.empty()) {
+      return;
+    }
+    try {
+      client.template send_request<MonitorAccountUpdatesService>();
+    } catch(const std::exception&) {
+      for(auto& queue : m_account_update_queues) {
+        queue.close(Beam::make_nested_service_exception(
+          "Failed to recover account updates."));
+      }
+      m_account_update_queues.clear();
+      return;
+    }
+    std::erase_if(m_account_update_queues, [&] (auto& queue) {
+      try {
+        queue.push(Beam::DirectoryEntry());
+        return false;
+      } catch(const Beam::PipeBrokenException&) {
+        return true;
+      }
+    });
+  }
+
+  template<typename B>
+  void ServiceAdministrationClient<B>::on_account_update_message(
+      ServiceProtocolClient& client, const Beam::DirectoryEntry& account) {
+    m_tasks.push([=, this] {
+      std::erase_if(m_account_update_queues, [&] (auto& queue) {
+        try {
+          queue.push(account);
+          return false;
+        } catch(const Beam::PipeBrokenException&) {
+          return true;
+        }
+      });
+    });
+  }
 }
 
 #endif
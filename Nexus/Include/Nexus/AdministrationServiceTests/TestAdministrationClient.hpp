@@ -62,6 +62,13 @@ namespace Nexus::Tests {
         Beam::Tests::ServiceResult<AccountRoles> m_result;
       };
 
+      /** Records a call to store_account_roles(). */
+      struct StoreAccountRolesOperation {
+        Beam::DirectoryEntry m_account;
+        AccountRoles m_roles;
+        Beam::Tests::ServiceResult<AccountRoles> m_result;
+      };
+
       /** Records a call to load_parent_trading_group(). */
       struct LoadParentTradingGroupOperation {
         Beam::DirectoryEntry m_account;
@@ -277,8 +284,8 @@ namespace Nexus::Tests {
         QueryAccountsOperation, LoadAdministratorsRootEntryOperation,
         LoadServicesRootEntryOperation, LoadTradingGroupsRootEntryOperation,
         CheckAdministratorOperation, LoadAccountRolesOperation,
-        LoadParentChildAccountRolesOperation, LoadParentTradingGroupOperation,
-        LoadIdentityOperation, StoreIdentityOperation,
+        LoadParentChildAccountRolesOperation, StoreAccountRolesOperation,
+        LoadParentTradingGroupOperation, LoadIdentityOperation, StoreIdentityOperation,
         LoadTradingGroupOperation, LoadManagedTradingGroupsOperation,
         LoadAdministratorsOperation, LoadServicesOperation,
         LoadEntitlementsOperation, LoadAccountEntitlementsOperation,
@@ -323,6 +330,8 @@ namespace Nexus::Tests {
       AccountRoles load_account_roles(const Beam::DirectoryEntry& account);
       AccountRoles load_account_roles(const Beam::DirectoryEntry& parent,
         const Beam::DirectoryEntry& child);
+      AccountRoles store(
+        const Beam::DirectoryEntry& account, AccountRoles roles);
       Beam::DirectoryEntry load_parent_trading_group(
         const Beam::DirectoryEntry& account);
       AccountIdentity load_identity(const Beam::DirectoryEntry& account);
@@ -452,6 +461,12 @@ namespace Nexus::Tests {
       LoadParentChildAccountRolesOperation, AccountRoles>(parent, child);
   }
 
+  inline AccountRoles TestAdministrationClient::store(
+      const Beam::DirectoryEntry& account, AccountRoles roles) {
+    return m_queue.append_result<StoreAccountRolesOperation, AccountRoles>(
+      account, roles);
+  }
+
   inline Beam::DirectoryEntry
       TestAdministrationClient::load_parent_trading_group(
         const Beam::DirectoryEntry& account) {
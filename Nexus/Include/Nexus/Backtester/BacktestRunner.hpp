@@ -0,0 +1,240 @@
+#ifndef NEXUS_BACKTEST_RUNNER_HPP
+#define NEXUS_BACKTEST_RUNNER_HPP
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include "Nexus/Accounting/Portfolio.hpp"
+#include "Nexus/Accounting/TrueAverageBookkeeper.hpp"
+#include "Nexus/Backtester/BacktesterClients.hpp"
+#include "Nexus/Backtester/BacktesterEnvironment.hpp"
+#include "Nexus/Backtester/MarketDataSlice.hpp"
+#include "Nexus/MarketDataService/DataStoreMarketDataClient.hpp"
+
+namespace Nexus {
+
+  /** Specifies a single backtest to run. */
+  struct BacktestScenario {
+
+    /** The name identifying the scenario. */
+    std::string m_name;
+
+    /** The backtest's starting time. */
+    boost::posix_time::ptime m_start;
+
+    /** The backtest's ending time. */
+    boost::posix_time::ptime m_end;
+
+    /**
+     * Starts the strategy under test. It is called once the scenario's
+     * BacktesterEnvironment is constructed and the backtest then runs to its
+     * end time. Any objects the strategy needs beyond the call must be kept
+     * alive by the strategy itself.
+     */
+    std::function<void (BacktesterEnvironment&)> m_strategy;
+  };
+
+  /** Stores the result of running a BacktestScenario. */
+  struct BacktestResult {
+
+    /** The name of the scenario. */
+    std::string m_name;
+
+    /** The scenario's portfolio, marked as of the end of the backtest. */
+    Portfolio<TrueAverageBookkeeper> m_portfolio;
+
+    /** The error that stopped the scenario, or empty if it completed. */
+    std::string m_error;
+
+    /** The wall clock time taken to run the scenario. */
+    boost::posix_time::time_duration m_run_time;
+  };
+
+  /** Stores a single row of a summary of BacktestResults. */
+  struct BacktestSummary {
+
+    /** The name of the scenario. */
+    std::string m_name;
+
+    /** The currency the row is totaled in. */
+    CurrencyId m_currency;
+
+    /** The realized profit and loss net of fees. */
+    Money m_realized_profit_and_loss;
+
+    /** The unrealized profit and loss. */
+    Money m_unrealized_profit_and_loss;
+
+    /** The total fees paid. */
+    Money m_fees;
+
+    /** The total quantity traded. */
+    Quantity m_volume;
+
+    /** The number of transactions. */
+    int m_transaction_count;
+
+    /** The error that stopped the scenario, or empty if it completed. */
+    std::string m_error;
+
+    /** The wall clock time taken to run the scenario. */
+    boost::posix_time::time_duration m_run_time;
+  };
+
+  /**
+   * Runs independent BacktestScenarios concurrently, each in its own
+   * BacktesterEnvironment. Every scenario loads its historical market data
+   * from the same read-only MarketDataSlice, so that the data is stored once
+   * no matter how many scenarios replay it. Each BacktesterEventHandler
+   * flushes the process's pending Routines after every event, which also
+   * flushes the Routines of concurrent scenarios; this can delay a scenario
+   * but doesn't change its result, since each scenario's state is confined
+   * to its own BacktesterEnvironment.
+   */
+  class BacktestRunner {
+    public:
+
+      /**
+       * Constructs a BacktestRunner using one thread per hardware thread.
+       * @param market_data The historical market data to replay.
+       */
+      explicit BacktestRunner(MarketDataSlice market_data);
+
+      /**
+       * Constructs a BacktestRunner.
+       * @param market_data The historical market data to replay.
+       * @param concurrency The maximum number of scenarios to run at once.
+       */
+      BacktestRunner(MarketDataSlice market_data, std::size_t concurrency);
+
+      /** Returns the maximum number of scenarios run at once. */
+      std::size_t get_concurrency() const;
+
+      /**
+       * Runs a list of scenarios, blocking until they all complete.
+       * @param scenarios The scenarios to run.
+       * @return The result of each scenario, in the order it was specified.
+       */
+      std::vector<BacktestResult> run(
+        const std::vector<BacktestScenario>& scenarios);
+
+    private:
+      MarketDataSlice m_market_data;
+      std::size_t m_concurrency;
+
+      BacktestRunner(const BacktestRunner&) = delete;
+      BacktestRunner& operator =(const BacktestRunner&) = delete;
+      BacktestResult run(const BacktestScenario& scenario);
+  };
+
+  /**
+   * Tabulates a list of BacktestResults, producing one row per scenario and
+   * currency traded, or a single row with no currency for scenarios that
+   * made no trades.
+   * @param results The results to summarize.
+   * @return The summary table.
+   */
+  inline std::vector<BacktestSummary> summarize(
+      const std::vector<BacktestResult>& results) {
+    auto summary = std::vector<BacktestSummary>();
+    for(auto& result : results) {
+      auto row = BacktestSummary();
+      row.m_name = result.m_name;
+      row.m_currency = CurrencyId::NONE;
+      row.m_transaction_count = 0;
+      row.m_error = result.m_error;
+      row.m_run_time = result.m_run_time;
+      auto& bookkeeper = result.m_portfolio.get_bookkeeper();
+      auto& unrealized = result.m_portfolio.get_unrealized_profit_and_losses();
+      auto is_empty = true;
+      for(auto& total : bookkeeper.get_totals_range()) {
+        is_empty = false;
+        auto currency_row = row;
+        currency_row.m_currency = total.m_position.m_currency;
+        currency_row.m_realized_profit_and_loss =
+          get_realized_profit_and_loss(total);
+        auto unrealized_iterator = unrealized.find(currency_row.m_currency);
+        if(unrealized_iterator != unrealized.end()) {
+          currency_row.m_unrealized_profit_and_loss =
+            unrealized_iterator->second;
+        }
+        currency_row.m_fees = total.m_fees;
+        currency_row.m_volume = total.m_volume;
+        currency_row.m_transaction_count = total.m_transaction_count;
+        summary.push_back(std::move(currency_row));
+      }
+      if(is_empty) {
+        summary.push_back(std::move(row));
+      }
+    }
+    return summary;
+  }
+
+  inline BacktestRunner::BacktestRunner(MarketDataSlice market_data)
+    : BacktestRunner(
+        std::move(market_data), std::thread::hardware_concurrency()) {}
+
+  inline BacktestRunner::BacktestRunner(
+    MarketDataSlice market_data, std::size_t concurrency)
+    : m_market_data(std::move(market_data)),
+      m_concurrency(std::max<std::size_t>(concurrency, 1)) {}
+
+  inline std::size_t BacktestRunner::get_concurrency() const {
+    return m_concurrency;
+  }
+
+  inline std::vector<BacktestResult> BacktestRunner::run(
+      const std::vector<BacktestScenario>& scenarios) {
+    auto results = std::vector<BacktestResult>(scenarios.size());
+    auto next = std::atomic_size_t(0);
+    auto worker = [&] {
+      while(true) {
+        auto index = next++;
+        if(index >= scenarios.size()) {
+          return;
+        }
+        results[index] = run(scenarios[index]);
+      }
+    };
+    auto workers = std::vector<std::thread>();
+    auto count = std::min(m_concurrency, scenarios.size());
+    for(auto i = std::size_t(1); i < count; ++i) {
+      workers.emplace_back(worker);
+    }
+    worker();
+    for(auto& thread : workers) {
+      thread.join();
+    }
+    return results;
+  }
+
+  inline BacktestResult BacktestRunner::run(const BacktestScenario& scenario) {
+    auto result = BacktestResult();
+    result.m_name = scenario.m_name;
+    auto start = std::chrono::steady_clock::now();
+    try {
+      auto environment = BacktesterEnvironment(scenario.m_start,
+        scenario.m_end, MarketDataClient(std::in_place_type<
+          DataStoreMarketDataClient<MarketDataSlice>>, m_market_data));
+      if(scenario.m_strategy) {
+        scenario.m_strategy(environment);
+      }
+      environment.wait();
+      auto clients = BacktesterClients(Beam::Ref(environment));
+      result.m_portfolio = make_portfolio(clients);
+    } catch(const std::exception& e) {
+      result.m_error = e.what();
+    }
+    result.m_run_time = boost::posix_time::microseconds(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    return result;
+  }
+}
+
+#endif
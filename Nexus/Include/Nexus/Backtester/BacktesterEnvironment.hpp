@@ -38,6 +38,16 @@ namespace Nexus {
       BacktesterEnvironment(boost::posix_time::ptime start,
         boost::posix_time::ptime end, Clients clients);
 
+      /**
+       * Constructs a BacktesterEnvironment.
+       * @param start The backtester's starting time.
+       * @param end The backtester's ending time.
+       * @param market_data_client The MarketDataClient used to load historical
+       *        market data.
+       */
+      BacktesterEnvironment(boost::posix_time::ptime start,
+        boost::posix_time::ptime end, MarketDataClient market_data_client);
+
       ~BacktesterEnvironment();
 
       /** Returns the BacktesterEventHandler. */
@@ -104,7 +114,8 @@ namespace Nexus {
       void close();
 
     private:
-      Clients m_clients;
+      boost::optional<Clients> m_clients;
+      MarketDataClient m_historical_market_data_client;
       BacktesterEventHandler m_event_handler;
       Beam::TimeClient m_time_client;
       Beam::Tests::ServiceLocatorTestEnvironment m_service_locator_environment;
@@ -135,7 +146,14 @@ namespace Nexus {
   inline BacktesterEnvironment::BacktesterEnvironment(
       boost::posix_time::ptime start, boost::posix_time::ptime end,
       Clients clients)
-      : m_clients(std::move(clients)),
+      : BacktesterEnvironment(start, end, clients.get_market_data_client()) {
+    m_clients.emplace(std::move(clients));
+  }
+
+  inline BacktesterEnvironment::BacktesterEnvironment(
+      boost::posix_time::ptime start, boost::posix_time::ptime end,
+      MarketDataClient market_data_client)
+      : m_historical_market_data_client(std::move(market_data_client)),
         m_event_handler(start, end),
         m_time_client(
           std::in_place_type<BacktesterTimeClient>, Beam::Ref(m_event_handler)),
@@ -149,16 +167,17 @@ namespace Nexus {
           m_service_locator_client, m_administration_client,
           HistoricalDataStore(std::in_place_type<CutoffHistoricalDataStore<
             ClientHistoricalDataStore<MarketDataClient>>>,
-            m_clients.get_market_data_client(),
+            m_historical_market_data_client,
             m_event_handler.get_start_time())),
         m_market_data_service(
           Beam::Ref(m_event_handler), Beam::Ref(m_market_data_environment),
-          m_clients.get_market_data_client()),
+          m_historical_market_data_client),
         m_market_data_client(std::in_place_type<BacktesterMarketDataClient>,
           Beam::Ref(m_market_data_service),
           m_market_data_environment.make_registry_client(
             Beam::Ref(m_service_locator_client))),
-        m_charting_environment(m_service_locator_client, m_market_data_client),
+        m_charting_environment(
+          m_service_locator_client, m_market_data_client, m_time_client),
         m_compliance_environment(
           m_service_locator_client, m_administration_client, m_time_client) {
     try {
@@ -309,7 +328,7 @@ namespace Nexus {
     if(time.is_special()) {
       return snapshot;
     }
-    auto& client = m_clients.get_market_data_client();
+    auto& client = m_historical_market_data_client;
     auto bbo_query = TickerQuery();
     bbo_query.set_index(ticker);
     bbo_query.set_range(Beam::Sequence::FIRST, time);
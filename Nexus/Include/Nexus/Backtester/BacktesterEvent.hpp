@@ -34,10 +34,19 @@ namespace Nexus {
       /** Marks this event as complete/executed. */
       void complete();
 
+      /**
+       * Schedules this event to be executed again rather than completed once
+       * its current execution returns, so that a single event can be recycled
+       * for a series of occurrences.
+       * @param timestamp The time of the next execution.
+       */
+      void reschedule(boost::posix_time::ptime timestamp);
+
     private:
       friend class BacktesterEventHandler;
       mutable Beam::Mutex m_mutex;
       bool m_is_complete;
+      bool m_is_rescheduled;
       Beam::ConditionVariable m_is_complete_condition;
       boost::posix_time::ptime m_timestamp;
 
@@ -63,6 +72,7 @@ namespace Nexus {
   inline BacktesterEvent::BacktesterEvent(
     boost::posix_time::ptime timestamp) noexcept
     : m_is_complete(false),
+      m_is_rescheduled(false),
       m_timestamp(timestamp) {}
 
   inline void BacktesterEvent::complete() {
@@ -75,6 +85,11 @@ namespace Nexus {
     }
     m_is_complete_condition.notify_all();
   }
+
+  inline void BacktesterEvent::reschedule(boost::posix_time::ptime timestamp) {
+    m_timestamp = timestamp;
+    m_is_rescheduled = true;
+  }
 }
 
 #endif
@@ -1,7 +1,7 @@
 #ifndef NEXUS_BACKTESTER_EVENT_HANDLER_HPP
 #define NEXUS_BACKTESTER_EVENT_HANDLER_HPP
 #include <algorithm>
-#include <deque>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -18,7 +18,14 @@
 
 namespace Nexus {
 
-  /** Implements an event loop to handle BacktesterEvents. */
+  /**
+   * Implements an event loop to handle BacktesterEvents. Pending events are
+   * kept in a binary heap of runs, where each run is a list of events sorted
+   * by timestamp. Adding a pre-sorted list of events costs a single heap
+   * insertion regardless of its length, and the storage of exhausted runs is
+   * recycled. Events with equal timestamps are handled in the order they were
+   * added.
+   */
   class BacktesterEventHandler {
     public:
 
@@ -48,7 +55,8 @@ namespace Nexus {
       void add(const std::shared_ptr<BacktesterEvent>& event);
 
       /**
-       * Adds a list of events to be handled.
+       * Adds a list of events to be handled. The list is handled most
+       * efficiently when it is already sorted by timestamp.
        * @param events The list of events to handle.
        */
       void add(const std::vector<std::shared_ptr<BacktesterEvent>>& events);
@@ -87,11 +95,19 @@ namespace Nexus {
       void close();
 
     private:
+      struct EventRun {
+        std::vector<std::shared_ptr<BacktesterEvent>> m_events;
+        std::size_t m_next;
+        std::uint64_t m_sequence;
+      };
       mutable Beam::Mutex m_mutex;
       boost::posix_time::ptime m_start_time;
       boost::posix_time::ptime m_end_time;
       Beam::Tests::TimeServiceTestEnvironment m_time_environment;
-      std::deque<std::shared_ptr<BacktesterEvent>> m_events;
+      std::vector<EventRun> m_runs;
+      std::vector<std::size_t> m_free_runs;
+      std::vector<std::size_t> m_schedule;
+      std::uint64_t m_next_sequence;
       std::size_t m_active_count;
       bool m_has_processed_active_event;
       bool m_is_suspended;
@@ -109,6 +125,10 @@ namespace Nexus {
       BacktesterEventHandler(const BacktesterEventHandler&) = delete;
       BacktesterEventHandler& operator =(
         const BacktesterEventHandler&) = delete;
+      bool is_after(std::size_t left, std::size_t right) const;
+      std::size_t make_run();
+      void schedule(std::size_t run);
+      std::shared_ptr<BacktesterEvent> pop();
       void event_loop();
   };
 
@@ -116,6 +136,7 @@ namespace Nexus {
       boost::posix_time::ptime start, boost::posix_time::ptime end)
       : m_start_time(start),
         m_end_time(end),
+        m_next_sequence(0),
         m_active_count(0),
         m_has_processed_active_event(false),
         m_is_suspended(false),
@@ -154,11 +175,9 @@ namespace Nexus {
     auto is_active = !event->is_passive();
     {
       auto lock = std::lock_guard(m_mutex);
-      auto insert_iterator = std::upper_bound(m_events.begin(), m_events.end(),
-        event, [] (const auto& lhs, const auto& rhs) {
-          return lhs->get_timestamp() < rhs->get_timestamp();
-        });
-      m_events.insert(insert_iterator, event);
+      auto run = make_run();
+      m_runs[run].m_events.push_back(event);
+      schedule(run);
       if(is_active) {
         ++m_active_count;
       }
@@ -176,17 +195,22 @@ namespace Nexus {
     auto is_active = false;
     {
       auto lock = std::lock_guard(m_mutex);
-      for(auto& event : events) {
-        is_active |= !event->is_passive();
-        auto insert_iterator = std::upper_bound(m_events.begin(),
-          m_events.end(), event, [] (const auto& lhs, const auto& rhs) {
-            return lhs->get_timestamp() < rhs->get_timestamp();
-          });
+      auto run = make_run();
+      auto& run_events = m_runs[run].m_events;
+      run_events.assign(events.begin(), events.end());
+      auto is_earlier = [] (const auto& lhs, const auto& rhs) {
+        return lhs->get_timestamp() < rhs->get_timestamp();
+      };
+      if(!std::is_sorted(run_events.begin(), run_events.end(), is_earlier)) {
+        std::stable_sort(run_events.begin(), run_events.end(), is_earlier);
+      }
+      for(auto& event : run_events) {
         if(!event->is_passive()) {
+          is_active = true;
           ++m_active_count;
         }
-        m_events.insert(insert_iterator, event);
       }
+      schedule(run);
     }
     if(is_active) {
       m_event_available_condition.notify_one();
@@ -226,7 +250,7 @@ namespace Nexus {
   inline std::shared_ptr<const BacktesterEvent>
       BacktesterEventHandler::advance() {
     auto lock = std::unique_lock(m_mutex);
-    if(!m_is_suspended || m_events.empty()) {
+    if(!m_is_suspended || m_schedule.empty()) {
       return nullptr;
     }
     ++m_step_count;
@@ -269,6 +293,57 @@ namespace Nexus {
     Beam::flush_pending_routines();
   }
 
+  inline bool BacktesterEventHandler::is_after(
+      std::size_t left, std::size_t right) const {
+    auto& left_run = m_runs[left];
+    auto& right_run = m_runs[right];
+    auto left_timestamp = left_run.m_events[left_run.m_next]->get_timestamp();
+    auto right_timestamp =
+      right_run.m_events[right_run.m_next]->get_timestamp();
+    if(left_timestamp != right_timestamp) {
+      return left_timestamp > right_timestamp;
+    }
+    return left_run.m_sequence + left_run.m_next >
+      right_run.m_sequence + right_run.m_next;
+  }
+
+  inline std::size_t BacktesterEventHandler::make_run() {
+    if(m_free_runs.empty()) {
+      m_runs.emplace_back();
+      return m_runs.size() - 1;
+    }
+    auto run = m_free_runs.back();
+    m_free_runs.pop_back();
+    return run;
+  }
+
+  inline void BacktesterEventHandler::schedule(std::size_t run) {
+    auto& event_run = m_runs[run];
+    event_run.m_next = 0;
+    event_run.m_sequence = m_next_sequence;
+    m_next_sequence += event_run.m_events.size();
+    m_schedule.push_back(run);
+    std::push_heap(m_schedule.begin(), m_schedule.end(),
+      std::bind_front(&BacktesterEventHandler::is_after, this));
+  }
+
+  inline std::shared_ptr<BacktesterEvent> BacktesterEventHandler::pop() {
+    auto compare = std::bind_front(&BacktesterEventHandler::is_after, this);
+    std::pop_heap(m_schedule.begin(), m_schedule.end(), compare);
+    auto run = m_schedule.back();
+    auto& event_run = m_runs[run];
+    auto event = std::move(event_run.m_events[event_run.m_next]);
+    ++event_run.m_next;
+    if(event_run.m_next == event_run.m_events.size()) {
+      event_run.m_events.clear();
+      m_schedule.pop_back();
+      m_free_runs.push_back(run);
+    } else {
+      std::push_heap(m_schedule.begin(), m_schedule.end(), compare);
+    }
+    return event;
+  }
+
   inline void BacktesterEventHandler::event_loop() {
     while(true) {
       auto event = std::shared_ptr<BacktesterEvent>();
@@ -304,8 +379,7 @@ namespace Nexus {
         if(is_step) {
           --m_step_count;
         }
-        event = std::move(m_events.front());
-        m_events.pop_front();
+        event = pop();
         if(!event->is_passive()) {
           --m_active_count;
         }
@@ -317,7 +391,12 @@ namespace Nexus {
         m_time_environment.set(event->get_timestamp());
       }
       event->execute();
-      event->complete();
+      if(event->m_is_rescheduled) {
+        event->m_is_rescheduled = false;
+        add(event);
+      } else {
+        event->complete();
+      }
       if(!event->is_passive()) {
         auto lock = std::lock_guard(m_mutex);
         if(!m_has_processed_active_event) {
@@ -5,6 +5,7 @@
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 #include <Beam/Pointers/Ref.hpp>
 #include <Beam/Queues/Queue.hpp>
 #include <Beam/Threading/Mutex.hpp>
@@ -22,6 +23,10 @@ namespace Nexus {
 namespace Details {
   using BacktesterMarketDataServiceHandle =
     std::shared_ptr<Beam::Sync<BacktesterMarketDataService*, Beam::Mutex>>;
+
+  template<typename I, typename T>
+  void publish(
+    BacktesterMarketDataService& service, const I& index, const T& value);
 }
 
   /** Provides historical market data to the backtester. */
@@ -101,6 +106,9 @@ namespace Details {
       template<typename, typename> friend class MarketDataEvent;
       template<typename> friend class MarketDataLoadEvent;
       template<typename> friend class MarketDataQueryEvent;
+      template<typename I, typename T>
+      friend void Details::publish(
+        BacktesterMarketDataService&, const I&, const T&);
       BacktesterEventHandler* m_event_handler;
       Tests::MarketDataServiceTestEnvironment* m_market_data_environment;
       MarketDataClient m_market_data_client;
@@ -149,7 +157,11 @@ namespace Details {
   };
 
   /**
-   * Loads a batch of historical market data for a specific type and index.
+   * Loads a batch of historical market data for a specific type and index and
+   * publishes it one value at a time. Rather than allocating an event per
+   * value, the event reschedules itself at the timestamp of each value it
+   * loaded, and once they are all published, reschedules itself to load the
+   * next batch.
    * @param <T> The type of market data being loaded.
    */
   template<typename T>
@@ -180,6 +192,11 @@ namespace Details {
       typename QueryType::Index m_index;
       Beam::Range::Point m_start;
       Details::BacktesterMarketDataServiceHandle m_service;
+      std::vector<Beam::SequencedValue<MarketDataType>> m_values;
+      std::vector<boost::posix_time::ptime> m_timestamps;
+      std::size_t m_next;
+
+      void load(BacktesterMarketDataService& service);
   };
 
   /**
@@ -317,50 +334,65 @@ namespace Details {
     : BacktesterEvent(timestamp),
       m_index(std::move(index)),
       m_start(start),
-      m_service(service->m_self) {}
+      m_service(service->m_self),
+      m_next(0) {}
 
   template<typename T>
   void MarketDataLoadEvent<T>::execute() {
     Beam::with(*m_service, [&] (const auto& service) {
       if(!service) {
+        m_values.clear();
         return;
       }
-      const auto QUERY_SIZE = 1000;
-      auto end = [&] () -> Beam::Range::Point {
-        if(service->m_event_handler->get_end_time() ==
-            boost::posix_time::pos_infin) {
-          return Beam::Sequence::PRESENT;
+      if(m_next == m_values.size()) {
+        load(*service);
+        if(!m_values.empty()) {
+          reschedule(m_timestamps.front());
         }
-        return service->m_event_handler->get_end_time();
-      }();
-      auto query = QueryType();
-      query.set_index(m_index);
-      query.set_range(m_start, end);
-      query.set_snapshot_limit(Beam::SnapshotLimit::Type::HEAD, QUERY_SIZE);
-      auto queue =
-        std::make_shared<Beam::Queue<Beam::SequencedValue<MarketDataType>>>();
-      service->m_market_data_client.query(query, queue);
-      auto data = std::vector<Beam::SequencedValue<MarketDataType>>();
-      Beam::flush(queue, std::back_inserter(data));
-      if(data.empty()) {
         return;
       }
-      auto events = std::vector<std::shared_ptr<BacktesterEvent>>();
-      auto timestamp = service->m_event_handler->get_time();
-      for(auto& value : data) {
-        timestamp = std::max(timestamp, Beam::get_timestamp(value.get_value()));
-        events.push_back(std::make_shared<MarketDataEvent<
-          typename QueryType::Index, MarketDataType>>(query.get_index(),
-            std::move(value), timestamp, Beam::Ref(*service)));
+      Details::publish(*service, m_index, *m_values[m_next]);
+      ++m_next;
+      if(m_next != m_values.size()) {
+        reschedule(m_timestamps[m_next]);
+      } else {
+        reschedule(get_timestamp());
       }
-      auto reload_event = std::make_shared<MarketDataLoadEvent>(
-        m_index, Beam::increment(data.back().get_sequence()),
-        events.back()->get_timestamp(), Beam::Ref(*service));
-      events.push_back(reload_event);
-      service->m_event_handler->add(events);
     });
   }
 
+  template<typename T>
+  void MarketDataLoadEvent<T>::load(BacktesterMarketDataService& service) {
+    const auto QUERY_SIZE = 1000;
+    auto end = [&] () -> Beam::Range::Point {
+      if(service.m_event_handler->get_end_time() ==
+          boost::posix_time::pos_infin) {
+        return Beam::Sequence::PRESENT;
+      }
+      return service.m_event_handler->get_end_time();
+    }();
+    auto query = QueryType();
+    query.set_index(m_index);
+    query.set_range(m_start, end);
+    query.set_snapshot_limit(Beam::SnapshotLimit::Type::HEAD, QUERY_SIZE);
+    auto queue =
+      std::make_shared<Beam::Queue<Beam::SequencedValue<MarketDataType>>>();
+    service.m_market_data_client.query(query, queue);
+    m_values.clear();
+    m_timestamps.clear();
+    m_next = 0;
+    Beam::flush(queue, std::back_inserter(m_values));
+    if(m_values.empty()) {
+      return;
+    }
+    auto timestamp = service.m_event_handler->get_time();
+    for(auto& value : m_values) {
+      timestamp = std::max(timestamp, Beam::get_timestamp(value.get_value()));
+      m_timestamps.push_back(timestamp);
+    }
+    m_start = Beam::increment(m_values.back().get_sequence());
+  }
+
   template<typename I, typename T>
   MarketDataEvent<I, T>::MarketDataEvent(Index index, MarketDataType value,
     boost::posix_time::ptime timestamp,
@@ -376,26 +408,33 @@ namespace Details {
       if(!service) {
         return;
       }
-      if constexpr(std::is_same_v<Index, Ticker> &&
-          std::is_same_v<MarketDataType, BboQuote>) {
-        if(service->m_bbo_slot) {
-          service->m_bbo_slot(m_index, m_value);
-        }
-      } else if constexpr(std::is_same_v<Index, Ticker> &&
-          std::is_same_v<MarketDataType, TimeAndSale>) {
-        if(service->m_time_and_sale_slot) {
-          service->m_time_and_sale_slot(m_index, m_value);
-        }
-      } else if constexpr(std::is_same_v<Index, Ticker> &&
-          std::is_same_v<MarketDataType, BookQuote>) {
-        if(service->m_book_quote_slot) {
-          service->m_book_quote_slot(m_index, m_value);
-        }
-      }
-      service->m_market_data_environment->get_feed_client().publish(
-        Beam::IndexedValue(m_value, m_index));
+      Details::publish(*service, m_index, m_value);
     });
   }
+
+namespace Details {
+  template<typename I, typename T>
+  void publish(
+      BacktesterMarketDataService& service, const I& index, const T& value) {
+    if constexpr(std::is_same_v<I, Ticker> && std::is_same_v<T, BboQuote>) {
+      if(service.m_bbo_slot) {
+        service.m_bbo_slot(index, value);
+      }
+    } else if constexpr(std::is_same_v<I, Ticker> &&
+        std::is_same_v<T, TimeAndSale>) {
+      if(service.m_time_and_sale_slot) {
+        service.m_time_and_sale_slot(index, value);
+      }
+    } else if constexpr(std::is_same_v<I, Ticker> &&
+        std::is_same_v<T, BookQuote>) {
+      if(service.m_book_quote_slot) {
+        service.m_book_quote_slot(index, value);
+      }
+    }
+    service.m_market_data_environment->get_feed_client().publish(
+      Beam::IndexedValue(value, index));
+  }
+}
 }
 
 #endif
@@ -0,0 +1,163 @@
+#ifndef NEXUS_BACKTESTER_MARKET_DATA_SLICE_HPP
+#define NEXUS_BACKTESTER_MARKET_DATA_SLICE_HPP
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <boost/throw_exception.hpp>
+#include "Nexus/MarketDataService/ColumnarHistoricalDataStore.hpp"
+#include "Nexus/MarketDataService/HistoricalDataStore.hpp"
+#include "Nexus/MarketDataService/HistoricalDataStoreException.hpp"
+
+namespace Nexus {
+
+  /**
+   * Provides read-only access to historical market data shared among many
+   * backtests. Copies of a MarketDataSlice refer to the same underlying data
+   * store, storing to a slice is rejected, and closing a slice leaves the
+   * underlying data store open for the remaining backtests.
+   */
+  class MarketDataSlice {
+    public:
+
+      /**
+       * Constructs a MarketDataSlice over a directory written by a
+       * ColumnarHistoricalDataStore, whose files are read through memory
+       * mappings.
+       * @param root The directory containing the market data.
+       */
+      explicit MarketDataSlice(std::filesystem::path root);
+
+      /**
+       * Constructs a MarketDataSlice over an existing data store.
+       * @param data_store The data store to read from.
+       */
+      explicit MarketDataSlice(HistoricalDataStore data_store);
+
+      std::vector<TickerInfo> load_ticker_info(const TickerInfoQuery& query);
+      void store(const TickerInfo& info);
+      std::vector<SequencedOrderImbalance> load_order_imbalances(
+        const VenueQuery& query);
+      void store(const SequencedVenueOrderImbalance& imbalance);
+      void store(const std::vector<SequencedVenueOrderImbalance>& imbalances);
+      std::vector<SequencedBboQuote> load_bbo_quotes(const TickerQuery& query);
+      void store(const SequencedTickerBboQuote& quote);
+      void store(const std::vector<SequencedTickerBboQuote>& quotes);
+      std::vector<SequencedBookQuote> load_book_quotes(
+        const TickerQuery& query);
+      void store(const SequencedTickerBookQuote& quote);
+      void store(const std::vector<SequencedTickerBookQuote>& quotes);
+      std::vector<SequencedTimeAndSale> load_time_and_sales(
+        const TickerQuery& query);
+      void store(const SequencedTickerTimeAndSale& time_and_sale);
+      void store(const std::vector<SequencedTickerTimeAndSale>& time_and_sales);
+      std::vector<SequencedTickerStatus> load_ticker_statuses(
+        const TickerQuery& query);
+      void store(const SequencedIndexedTickerStatus& status);
+      void store(const std::vector<SequencedIndexedTickerStatus>& statuses);
+      void close();
+
+    private:
+      std::shared_ptr<HistoricalDataStore> m_data_store;
+
+      [[noreturn]] static void reject_store();
+  };
+
+  inline MarketDataSlice::MarketDataSlice(std::filesystem::path root)
+    : MarketDataSlice(HistoricalDataStore(
+        std::in_place_type<ColumnarHistoricalDataStore>, std::move(root))) {}
+
+  inline MarketDataSlice::MarketDataSlice(HistoricalDataStore data_store)
+    : m_data_store(std::make_shared<HistoricalDataStore>(
+        std::move(data_store))) {}
+
+  inline std::vector<TickerInfo> MarketDataSlice::load_ticker_info(
+      const TickerInfoQuery& query) {
+    return m_data_store->load_ticker_info(query);
+  }
+
+  inline void MarketDataSlice::store(const TickerInfo& info) {
+    reject_store();
+  }
+
+  inline std::vector<SequencedOrderImbalance>
+      MarketDataSlice::load_order_imbalances(const VenueQuery& query) {
+    return m_data_store->load_order_imbalances(query);
+  }
+
+  inline void MarketDataSlice::store(
+      const SequencedVenueOrderImbalance& imbalance) {
+    reject_store();
+  }
+
+  inline void MarketDataSlice::store(
+      const std::vector<SequencedVenueOrderImbalance>& imbalances) {
+    reject_store();
+  }
+
+  inline std::vector<SequencedBboQuote> MarketDataSlice::load_bbo_quotes(
+      const TickerQuery& query) {
+    return m_data_store->load_bbo_quotes(query);
+  }
+
+  inline void MarketDataSlice::store(const SequencedTickerBboQuote& quote) {
+    reject_store();
+  }
+
+  inline void MarketDataSlice::store(
+      const std::vector<SequencedTickerBboQuote>& quotes) {
+    reject_store();
+  }
+
+  inline std::vector<SequencedBookQuote> MarketDataSlice::load_book_quotes(
+      const TickerQuery& query) {
+    return m_data_store->load_book_quotes(query);
+  }
+
+  inline void MarketDataSlice::store(const SequencedTickerBookQuote& quote) {
+    reject_store();
+  }
+
+  inline void MarketDataSlice::store(
+      const std::vector<SequencedTickerBookQuote>& quotes) {
+    reject_store();
+  }
+
+  inline std::vector<SequencedTimeAndSale>
+      MarketDataSlice::load_time_and_sales(const TickerQuery& query) {
+    return m_data_store->load_time_and_sales(query);
+  }
+
+  inline void MarketDataSlice::store(
+      const SequencedTickerTimeAndSale& time_and_sale) {
+    reject_store();
+  }
+
+  inline void MarketDataSlice::store(
+      const std::vector<SequencedTickerTimeAndSale>& time_and_sales) {
+    reject_store();
+  }
+
+  inline std::vector<SequencedTickerStatus>
+      MarketDataSlice::load_ticker_statuses(const TickerQuery& query) {
+    return m_data_store->load_ticker_statuses(query);
+  }
+
+  inline void MarketDataSlice::store(
+      const SequencedIndexedTickerStatus& status) {
+    reject_store();
+  }
+
+  inline void MarketDataSlice::store(
+      const std::vector<SequencedIndexedTickerStatus>& statuses) {
+    reject_store();
+  }
+
+  inline void MarketDataSlice::close() {}
+
+  inline void MarketDataSlice::reject_store() {
+    boost::throw_with_location(
+      HistoricalDataStoreException("Market data slice is read-only."));
+  }
+}
+
+#endif
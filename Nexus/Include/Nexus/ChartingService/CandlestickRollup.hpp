@@ -0,0 +1,299 @@
+#ifndef NEXUS_CANDLESTICK_ROLLUP_HPP
+#define NEXUS_CANDLESTICK_ROLLUP_HPP
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <type_traits>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "Nexus/ChartingService/ChartingServices.hpp"
+#include "Nexus/Definitions/TimeAndSale.hpp"
+
+namespace Nexus {
+
+  /**
+   * Pre-aggregates the TimeAndSales of a single Ticker into price
+   * candlesticks at a fixed set of granularities, so that price series can be
+   * produced without re-scanning every TimeAndSale in a range.
+   */
+  class CandlestickRollup {
+    public:
+
+      /** The number of granularities maintained. */
+      static constexpr auto GRANULARITY_COUNT = std::size_t(5);
+
+      /**
+       * Returns the granularities maintained, from finest to coarsest. Each
+       * granularity divides every coarser granularity.
+       */
+      static const std::array<boost::posix_time::time_duration,
+        GRANULARITY_COUNT>& get_granularities();
+
+      /**
+       * Returns the start of the coarsest candlestick containing a timestamp,
+       * all other granularities are aligned to it.
+       */
+      static boost::posix_time::ptime get_alignment(
+        boost::posix_time::ptime timestamp);
+
+      /** Constructs an empty CandlestickRollup. */
+      CandlestickRollup() noexcept;
+
+      /**
+       * Returns the time from which all TimeAndSales are aggregated, or
+       * <code>pos_infin</code> if nothing has been aggregated.
+       */
+      boost::posix_time::ptime get_start() const;
+
+      /**
+       * Extends the aggregation backwards in time.
+       * @param start The new start, must be aligned using get_alignment.
+       * @param time_and_sales The TimeAndSales from the <i>start</i> up to the
+       *        current start, in order.
+       */
+      void extend(boost::posix_time::ptime start,
+        const std::vector<SequencedTimeAndSale>& time_and_sales);
+
+      /**
+       * Aggregates a real-time TimeAndSale. TimeAndSales that have already
+       * been aggregated or that precede the start are ignored.
+       * @param time_and_sale The TimeAndSale to aggregate.
+       */
+      void update(const SequencedTimeAndSale& time_and_sale);
+
+      /**
+       * Loads a price series. The series is built from the coarsest
+       * granularity that divides the <i>interval</i> and is aligned with the
+       * <i>start_time</i>. Finer granularities cover the end of the range when
+       * a coarser candlestick extends past it, and only a sub-second remainder
+       * is loaded from TimeAndSales.
+       * @param start_time The series start time (inclusive), must not precede
+       *        the start of this rollup.
+       * @param end_time The series end time (inclusive).
+       * @param interval The time interval per Candlestick.
+       * @param loader Loads the TimeAndSales within an inclusive time range.
+       * @return The price series.
+       */
+      template<typename F>
+      PriceQueryResult load(boost::posix_time::ptime start_time,
+        boost::posix_time::ptime end_time,
+        boost::posix_time::time_duration interval, F&& loader) const;
+
+    private:
+      struct Bar {
+        PriceCandlestick m_candlestick;
+        Beam::Sequence m_first_sequence;
+        Beam::Sequence m_last_sequence;
+        boost::posix_time::ptime m_last_timestamp;
+
+        Bar(boost::posix_time::ptime start, boost::posix_time::ptime end);
+        void update(const SequencedTimeAndSale& time_and_sale);
+        void merge(const Bar& bar);
+      };
+      using Bars = std::map<boost::posix_time::ptime, Bar>;
+      boost::posix_time::ptime m_start;
+      Beam::Sequence m_last_sequence;
+      std::array<Bars, GRANULARITY_COUNT> m_bars;
+
+      static std::int64_t get_ticks(boost::posix_time::ptime timestamp);
+      static boost::posix_time::ptime floor(boost::posix_time::ptime timestamp,
+        boost::posix_time::time_duration granularity);
+      void aggregate(const SequencedTimeAndSale& time_and_sale);
+  };
+
+  inline const std::array<boost::posix_time::time_duration,
+      CandlestickRollup::GRANULARITY_COUNT>&
+        CandlestickRollup::get_granularities() {
+    static const auto GRANULARITIES =
+      std::array<boost::posix_time::time_duration, GRANULARITY_COUNT>{
+        boost::posix_time::seconds(1), boost::posix_time::minutes(1),
+        boost::posix_time::minutes(5), boost::posix_time::hours(1),
+        boost::posix_time::hours(24)};
+    return GRANULARITIES;
+  }
+
+  inline boost::posix_time::ptime CandlestickRollup::get_alignment(
+      boost::posix_time::ptime timestamp) {
+    return floor(timestamp, get_granularities().back());
+  }
+
+  inline CandlestickRollup::Bar::Bar(
+    boost::posix_time::ptime start, boost::posix_time::ptime end)
+    : m_candlestick(start, end) {}
+
+  inline void CandlestickRollup::Bar::update(
+      const SequencedTimeAndSale& time_and_sale) {
+    if(m_first_sequence == Beam::Sequence()) {
+      m_first_sequence = time_and_sale.get_sequence();
+    }
+    m_last_sequence = time_and_sale.get_sequence();
+    if(m_last_timestamp.is_not_a_date_time() ||
+        time_and_sale->m_timestamp > m_last_timestamp) {
+      m_last_timestamp = time_and_sale->m_timestamp;
+    }
+    m_candlestick.update(time_and_sale->m_price, time_and_sale->m_size);
+  }
+
+  inline void CandlestickRollup::Bar::merge(const Bar& bar) {
+    if(m_first_sequence == Beam::Sequence()) {
+      m_candlestick = PriceCandlestick(m_candlestick.get_start(),
+        m_candlestick.get_end(), bar.m_candlestick.get_open(),
+        bar.m_candlestick.get_close(), bar.m_candlestick.get_high(),
+        bar.m_candlestick.get_low(), bar.m_candlestick.get_volume());
+      m_first_sequence = bar.m_first_sequence;
+    } else {
+      m_candlestick = PriceCandlestick(m_candlestick.get_start(),
+        m_candlestick.get_end(), m_candlestick.get_open(),
+        bar.m_candlestick.get_close(),
+        std::max(m_candlestick.get_high(), bar.m_candlestick.get_high()),
+        std::min(m_candlestick.get_low(), bar.m_candlestick.get_low()),
+        m_candlestick.get_volume() + bar.m_candlestick.get_volume());
+    }
+    m_last_sequence = bar.m_last_sequence;
+  }
+
+  inline CandlestickRollup::CandlestickRollup() noexcept
+    : m_start(boost::posix_time::pos_infin) {}
+
+  inline boost::posix_time::ptime CandlestickRollup::get_start() const {
+    return m_start;
+  }
+
+  inline void CandlestickRollup::extend(boost::posix_time::ptime start,
+      const std::vector<SequencedTimeAndSale>& time_and_sales) {
+    if(start >= m_start) {
+      return;
+    }
+    for(auto& time_and_sale : time_and_sales) {
+      if(time_and_sale->m_timestamp >= start &&
+          time_and_sale->m_timestamp < m_start) {
+        aggregate(time_and_sale);
+        m_last_sequence =
+          std::max(m_last_sequence, time_and_sale.get_sequence());
+      }
+    }
+    m_start = start;
+  }
+
+  inline void CandlestickRollup::update(
+      const SequencedTimeAndSale& time_and_sale) {
+    if(time_and_sale.get_sequence() <= m_last_sequence ||
+        m_start.is_special() || time_and_sale->m_timestamp < m_start) {
+      return;
+    }
+    aggregate(time_and_sale);
+    m_last_sequence = time_and_sale.get_sequence();
+  }
+
+  template<typename F>
+  PriceQueryResult CandlestickRollup::load(boost::posix_time::ptime start_time,
+      boost::posix_time::ptime end_time,
+      boost::posix_time::time_duration interval, F&& loader) const {
+    if(interval.ticks() <= 0) {
+      return PriceQueryResult();
+    }
+    auto buckets = std::map<std::int64_t, Bar>();
+    auto add = [&] (boost::posix_time::ptime timestamp, const auto& value) {
+      auto index = (timestamp - start_time).ticks() / interval.ticks();
+      auto bucket = buckets.find(index);
+      if(bucket == buckets.end()) {
+        auto bucket_start = start_time + interval * static_cast<int>(index);
+        bucket = buckets.emplace(
+          index, Bar(bucket_start, bucket_start + interval)).first;
+      }
+      if constexpr(std::is_same_v<std::decay_t<decltype(value)>, Bar>) {
+        bucket->second.merge(value);
+      } else {
+        bucket->second.update(value);
+      }
+    };
+    auto load_time_and_sales = [&] (boost::posix_time::ptime start,
+        boost::posix_time::ptime end) {
+      for(auto& time_and_sale : loader(start,
+          end - boost::posix_time::time_duration::unit())) {
+        if(time_and_sale->m_timestamp >= start &&
+            time_and_sale->m_timestamp < end) {
+          add(time_and_sale->m_timestamp, time_and_sale);
+        }
+      }
+    };
+    auto& granularities = get_granularities();
+    auto level = static_cast<int>(GRANULARITY_COUNT) - 1;
+    while(level >= 0 && (interval.ticks() % granularities[level].ticks() != 0 ||
+        get_ticks(start_time) % granularities[level].ticks() != 0)) {
+      --level;
+    }
+    auto end = end_time + boost::posix_time::time_duration::unit();
+    if(level < 0) {
+      load_time_and_sales(start_time, end);
+    } else {
+      auto start = start_time;
+      for(; level >= 0; --level) {
+        auto& granularity = granularities[level];
+        auto& bars = m_bars[level];
+        auto i = bars.lower_bound(start);
+        for(; i != bars.end() && i->first + granularity <= end; ++i) {
+          add(i->first, i->second);
+        }
+        start += granularity * static_cast<int>(
+          (end - start).ticks() / granularity.ticks());
+        if(i == bars.end() || i->first >= end) {
+          start = end;
+        } else if(i->second.m_last_timestamp < end) {
+          add(i->first, i->second);
+          start = end;
+        }
+        if(start == end) {
+          break;
+        }
+      }
+      if(start < end) {
+        load_time_and_sales(start, end);
+      }
+    }
+    auto result = PriceQueryResult();
+    for(auto& bucket : buckets) {
+      if(result.series.empty()) {
+        result.start = bucket.second.m_first_sequence;
+      }
+      result.end = bucket.second.m_last_sequence;
+      result.series.push_back(bucket.second.m_candlestick);
+    }
+    return result;
+  }
+
+  inline std::int64_t CandlestickRollup::get_ticks(
+      boost::posix_time::ptime timestamp) {
+    static const auto EPOCH =
+      boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
+    return (timestamp - EPOCH).ticks();
+  }
+
+  inline boost::posix_time::ptime CandlestickRollup::floor(
+      boost::posix_time::ptime timestamp,
+      boost::posix_time::time_duration granularity) {
+    auto ticks = get_ticks(timestamp);
+    auto remainder = ticks % granularity.ticks();
+    if(remainder < 0) {
+      remainder += granularity.ticks();
+    }
+    return timestamp - boost::posix_time::time_duration(0, 0, 0, remainder);
+  }
+
+  inline void CandlestickRollup::aggregate(
+      const SequencedTimeAndSale& time_and_sale) {
+    auto& granularities = get_granularities();
+    for(auto i = std::size_t(0); i != GRANULARITY_COUNT; ++i) {
+      auto start = floor(time_and_sale->m_timestamp, granularities[i]);
+      auto bar = m_bars[i].find(start);
+      if(bar == m_bars[i].end()) {
+        bar = m_bars[i].emplace(
+          start, Bar(start, start + granularities[i])).first;
+      }
+      bar->second.update(time_and_sale);
+    }
+  }
+}
+
+#endif
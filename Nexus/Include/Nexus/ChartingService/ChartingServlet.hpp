@@ -1,17 +1,27 @@
 #ifndef NEXUS_CHARTING_SERVLET_HPP
 #define NEXUS_CHARTING_SERVLET_HPP
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <Beam/Collections/SynchronizedSet.hpp>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queries/ConversionEvaluatorNode.hpp>
 #include <Beam/Queries/IndexedExpressionSubscriptions.hpp>
 #include <Beam/Queries/ExpressionSubscriptions.hpp>
+#include <Beam/Queues/QueueWriter.hpp>
 #include <Beam/Queues/RoutineTaskQueue.hpp>
 #include <Beam/Threading/Mutex.hpp>
+#include <Beam/TimeService/TimeClient.hpp>
 #include <Beam/Utilities/Casts.hpp>
 #include <Beam/Utilities/Instantiate.hpp>
 #include <Beam/Utilities/TypeTraits.hpp>
 #include <boost/throw_exception.hpp>
+#include "Nexus/ChartingService/CandlestickRollup.hpp"
 #include "Nexus/ChartingService/ChartingServices.hpp"
 #include "Nexus/MarketDataService/CachedHistoricalDataStore.hpp"
 #include "Nexus/MarketDataService/ClientHistoricalDataStore.hpp"
@@ -39,24 +49,55 @@ namespace Details {
    * Provides historical and charting related data.
    * @param <C> The container instantiating this servlet.
    * @param <M> The type of MarketDataClient used to access real-time data.
+   * @param <T> The type of TimeClient used to tell recent price series from
+   *        historical ones.
    */
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
   class ChartingServlet {
     public:
 
       /** The type of MarketDataClient used. */
       using MarketDataClient = Beam::dereference_t<M>;
 
+      /** The type of TimeClient used. */
+      using TimeClient = Beam::dereference_t<T>;
+
       using Container = C;
       using ServiceProtocolClient = typename Container::ServiceProtocolClient;
 
+      /** The default number of Tickers to keep a CandlestickRollup for. */
+      static constexpr auto DEFAULT_ROLLUP_CAPACITY = std::size_t(1000);
+
+      /** The default horizon of price series served from rollups. */
+      static inline const auto DEFAULT_ROLLUP_HORIZON =
+        boost::posix_time::hours(24);
+
+      /**
+       * Constructs a ChartingServlet using the default rollup capacity and
+       * horizon.
+       * @param market_data_client Initializes the MarketDataClient.
+       * @param time_client Initializes the TimeClient.
+       */
+      template<Beam::Initializes<M> MF, Beam::Initializes<T> TF>
+      ChartingServlet(MF&& market_data_client, TF&& time_client);
+
       /**
        * Constructs a ChartingServlet.
        * @param market_data_client Initializes the MarketDataClient.
+       * @param time_client Initializes the TimeClient.
+       * @param rollup_capacity The number of Tickers to keep a
+       *        CandlestickRollup for, the least recently used rollup is
+       *        evicted beyond this.
+       * @param rollup_horizon Price series starting within this duration of
+       *        the current time are served from a CandlestickRollup, older
+       *        series are built directly from their TimeAndSales.
        */
-      template<Beam::Initializes<M> MF>
-      explicit ChartingServlet(MF&& market_data_client);
+      template<Beam::Initializes<M> MF, Beam::Initializes<T> TF>
+      ChartingServlet(MF&& market_data_client, TF&& time_client,
+        std::size_t rollup_capacity,
+        boost::posix_time::time_duration rollup_horizon);
 
       void register_services(
         Beam::Out<Beam::ServiceSlots<ServiceProtocolClient>> slots);
@@ -73,10 +114,24 @@ namespace Details {
         Beam::SynchronizedUnorderedSet<Ticker, Beam::Mutex>
           m_real_time_subscriptions;
       };
+      struct RollupEntry {
+        Beam::Mutex m_mutex;
+        CandlestickRollup m_rollup;
+        bool m_is_loaded = false;
+        std::vector<SequencedTimeAndSale> m_pending;
+        std::shared_ptr<Beam::QueueWriter<SequencedTimeAndSale>> m_queue;
+        std::list<Ticker>::iterator m_usage;
+      };
       Beam::local_ptr_t<M> m_market_data_client;
+      Beam::local_ptr_t<T> m_time_client;
       CachedHistoricalDataStore<ClientHistoricalDataStore<MarketDataClient*>>
         m_data_store;
       QueryEntry<SequencedTimeAndSale> m_time_and_sale_queries;
+      std::size_t m_rollup_capacity;
+      boost::posix_time::time_duration m_rollup_horizon;
+      Beam::Mutex m_rollups_mutex;
+      std::unordered_map<Ticker, std::shared_ptr<RollupEntry>> m_rollups;
+      std::list<Ticker> m_rollup_usage;
       Beam::OpenState m_open_state;
       Beam::RoutineTaskQueue m_tasks;
 
@@ -88,6 +143,16 @@ namespace Details {
         ServiceProtocolClient& client, const Ticker& ticker,
         boost::posix_time::ptime start_time, boost::posix_time::ptime end_time,
         boost::posix_time::time_duration interval);
+      PriceQueryResult load_price_series(const Ticker& ticker,
+        boost::posix_time::ptime start_time, boost::posix_time::ptime end_time,
+        boost::posix_time::time_duration interval);
+      std::shared_ptr<RollupEntry> load_rollup(const Ticker& ticker);
+      void backfill(const Ticker& ticker, RollupEntry& rollup,
+        boost::posix_time::ptime start);
+      std::vector<SequencedTimeAndSale> load_time_and_sales(
+        const Ticker& ticker, const Beam::Range& range);
+      void on_rollup_update(const std::shared_ptr<RollupEntry>& rollup,
+        const SequencedTimeAndSale& time_and_sale);
       template<typename MarketDataType>
       void handle_query(Beam::RequestToken<
           ServiceProtocolClient, QueryTickerService>& request,
@@ -98,27 +163,44 @@ namespace Details {
         QueryEntry<MarketDataType>& query_entry);
   };
 
-  template<typename M>
+  template<typename M, typename T>
   struct MetaChartingServlet {
     using Session = Beam::NullSession;
     static constexpr auto SUPPORTS_PARALLELISM = true;
 
     template<typename C>
     struct apply {
-      using type = ChartingServlet<C, M>;
+      using type = ChartingServlet<C, M, T>;
     };
   };
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  template<Beam::Initializes<M> MF>
-  ChartingServlet<C, M>::ChartingServlet(MF&& market_data_client)
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  template<Beam::Initializes<M> MF, Beam::Initializes<T> TF>
+  ChartingServlet<C, M, T>::ChartingServlet(
+    MF&& market_data_client, TF&& time_client)
+    : ChartingServlet(std::forward<MF>(market_data_client),
+        std::forward<TF>(time_client), DEFAULT_ROLLUP_CAPACITY,
+        DEFAULT_ROLLUP_HORIZON) {}
+
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  template<Beam::Initializes<M> MF, Beam::Initializes<T> TF>
+  ChartingServlet<C, M, T>::ChartingServlet(MF&& market_data_client,
+    TF&& time_client, std::size_t rollup_capacity,
+    boost::posix_time::time_duration rollup_horizon)
     : m_market_data_client(std::forward<MF>(market_data_client)),
-      m_data_store(Beam::init(&*m_market_data_client), 10000) {}
+      m_time_client(std::forward<TF>(time_client)),
+      m_data_store(Beam::init(&*m_market_data_client), 10000),
+      m_rollup_capacity(std::max<std::size_t>(rollup_capacity, 1)),
+      m_rollup_horizon(rollup_horizon) {}
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  void ChartingServlet<C, M>::register_services(
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::register_services(
       Beam::Out<Beam::ServiceSlots<ServiceProtocolClient>> slots) {
     Nexus::register_query_types(Beam::out(slots->get_registry()));
     register_charting_services(out(slots));
@@ -131,15 +213,17 @@ namespace Details {
       &ChartingServlet::on_load_ticker_price_series_request, this));
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  void ChartingServlet<C, M>::handle_close(ServiceProtocolClient& client) {
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::handle_close(ServiceProtocolClient& client) {
     m_time_and_sale_queries.m_queries.remove_all(client);
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  void ChartingServlet<C, M>::close() {
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::close() {
     if(m_open_state.set_closing()) {
       return;
     }
@@ -149,9 +233,10 @@ namespace Details {
     m_open_state.close();
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  void ChartingServlet<C, M>::on_query_ticker_request(
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::on_query_ticker_request(
       Beam::RequestToken<ServiceProtocolClient, QueryTickerService>&
         request, const TickerChartingQuery& query, int client_query_id) {
     auto& session = request.get_session();
@@ -162,34 +247,71 @@ namespace Details {
     }
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  void ChartingServlet<C, M>::on_end_ticker_query(
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::on_end_ticker_query(
       ServiceProtocolClient& client, int id) {
     auto& session = client.get_session();
     m_time_and_sale_queries.m_queries.end(client, id);
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
-  PriceQueryResult ChartingServlet<C, M>::on_load_ticker_price_series_request(
-      ServiceProtocolClient& client, const Ticker& ticker,
-      boost::posix_time::ptime start_time, boost::posix_time::ptime end_time,
-      boost::posix_time::time_duration interval) {
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  PriceQueryResult
+      ChartingServlet<C, M, T>::on_load_ticker_price_series_request(
+        ServiceProtocolClient& client, const Ticker& ticker,
+        boost::posix_time::ptime start_time,
+        boost::posix_time::ptime end_time,
+        boost::posix_time::time_duration interval) {
     if(end_time < start_time + interval ||
         start_time == boost::posix_time::neg_infin  ||
         end_time == boost::posix_time::pos_infin) {
       boost::throw_with_location(
         Beam::ServiceRequestException("Invalid time range."));
     }
-    auto queue = std::make_shared<Beam::Queue<SequencedTimeAndSale>>();
-    auto time_and_sale_query = TickerQuery();
-    time_and_sale_query.set_index(ticker);
-    time_and_sale_query.set_range(start_time, end_time);
-    time_and_sale_query.set_snapshot_limit(Beam::SnapshotLimit::UNLIMITED);
-    m_market_data_client->query(time_and_sale_query, queue);
-    auto time_and_sales = std::vector<SequencedTimeAndSale>();
-    Beam::flush(queue, std::back_inserter(time_and_sales));
+    if(start_time < m_time_client->get_time() - m_rollup_horizon) {
+      return load_price_series(ticker, start_time, end_time, interval);
+    }
+    auto rollup = load_rollup(ticker);
+    backfill(ticker, *rollup, CandlestickRollup::get_alignment(start_time));
+    auto remainder = std::vector<SequencedTimeAndSale>();
+    auto remainder_range =
+      std::optional<std::pair<boost::posix_time::ptime,
+        boost::posix_time::ptime>>();
+    while(true) {
+      auto missing_range = remainder_range;
+      auto result = [&] {
+        auto lock = std::lock_guard(rollup->m_mutex);
+        return rollup->m_rollup.load(start_time, end_time, interval,
+          [&] (auto start, auto end) ->
+              const std::vector<SequencedTimeAndSale>& {
+            if(!remainder_range || start < remainder_range->first ||
+                end > remainder_range->second) {
+              missing_range.emplace(start, end);
+            }
+            return remainder;
+          });
+      }();
+      if(missing_range == remainder_range) {
+        return result;
+      }
+      remainder = load_time_and_sales(
+        ticker, Beam::Range(missing_range->first, missing_range->second));
+      remainder_range = missing_range;
+    }
+  }
+
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  PriceQueryResult ChartingServlet<C, M, T>::load_price_series(
+      const Ticker& ticker, boost::posix_time::ptime start_time,
+      boost::posix_time::ptime end_time,
+      boost::posix_time::time_duration interval) {
+    auto time_and_sales =
+      load_time_and_sales(ticker, Beam::Range(start_time, end_time));
     auto result = PriceQueryResult();
     if(!time_and_sales.empty()) {
       result.start = time_and_sales.front().get_sequence();
@@ -204,7 +326,8 @@ namespace Details {
       auto has_point = false;
       while(time_and_sales_iterator != time_and_sales.end() &&
           (*time_and_sales_iterator)->m_timestamp < current_end) {
-        candlestick.update((*time_and_sales_iterator)->m_price);
+        candlestick.update((*time_and_sales_iterator)->m_price,
+          (*time_and_sales_iterator)->m_size);
         has_point = true;
         ++time_and_sales_iterator;
       }
@@ -217,10 +340,125 @@ namespace Details {
     return result;
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  std::shared_ptr<typename ChartingServlet<C, M, T>::RollupEntry>
+      ChartingServlet<C, M, T>::load_rollup(const Ticker& ticker) {
+    auto evicted_rollup = std::shared_ptr<RollupEntry>();
+    auto is_new = false;
+    auto rollup = [&] {
+      auto lock = std::lock_guard(m_rollups_mutex);
+      auto& rollup = m_rollups[ticker];
+      if(rollup) {
+        m_rollup_usage.splice(
+          m_rollup_usage.begin(), m_rollup_usage, rollup->m_usage);
+        return rollup;
+      }
+      is_new = true;
+      rollup = std::make_shared<RollupEntry>();
+      rollup->m_usage = m_rollup_usage.insert(m_rollup_usage.begin(), ticker);
+      rollup->m_queue =
+        std::shared_ptr<Beam::QueueWriter<SequencedTimeAndSale>>(
+          m_tasks.get_slot<SequencedTimeAndSale>(std::bind_front(
+            &ChartingServlet::on_rollup_update, this, rollup)));
+      if(m_rollups.size() > m_rollup_capacity) {
+        auto i = m_rollups.find(m_rollup_usage.back());
+        evicted_rollup = std::move(i->second);
+        m_rollups.erase(i);
+        m_rollup_usage.pop_back();
+      }
+      return rollup;
+    }();
+    if(evicted_rollup) {
+      evicted_rollup->m_queue->close();
+    }
+    if(is_new) {
+      auto query = TickerQuery();
+      query.set_index(ticker);
+      query.set_range(Beam::Range::REAL_TIME);
+      m_market_data_client->query(query, rollup->m_queue);
+    }
+    return rollup;
+  }
+
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::backfill(const Ticker& ticker,
+      RollupEntry& rollup, boost::posix_time::ptime start) {
+    while(true) {
+      auto rollup_start = boost::posix_time::ptime();
+      auto is_loaded = false;
+      {
+        auto lock = std::lock_guard(rollup.m_mutex);
+        rollup_start = rollup.m_rollup.get_start();
+        is_loaded = rollup.m_is_loaded;
+      }
+      if(start >= rollup_start) {
+        return;
+      }
+      auto range = [&] {
+        if(is_loaded) {
+          return Beam::Range(start,
+            rollup_start - boost::posix_time::time_duration::unit());
+        }
+        return Beam::Range(start, Beam::Sequence::PRESENT);
+      }();
+      auto time_and_sales = load_time_and_sales(ticker, range);
+      auto lock = std::lock_guard(rollup.m_mutex);
+      if(rollup.m_rollup.get_start() != rollup_start ||
+          rollup.m_is_loaded != is_loaded) {
+        continue;
+      }
+      rollup.m_rollup.extend(start, time_and_sales);
+      if(!is_loaded) {
+        rollup.m_is_loaded = true;
+        for(auto& time_and_sale : rollup.m_pending) {
+          rollup.m_rollup.update(time_and_sale);
+        }
+        rollup.m_pending = {};
+      }
+      return;
+    }
+  }
+
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  std::vector<SequencedTimeAndSale>
+      ChartingServlet<C, M, T>::load_time_and_sales(
+        const Ticker& ticker, const Beam::Range& range) {
+    auto queue = std::make_shared<Beam::Queue<SequencedTimeAndSale>>();
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(range);
+    query.set_snapshot_limit(Beam::SnapshotLimit::UNLIMITED);
+    m_market_data_client->query(query, queue);
+    auto time_and_sales = std::vector<SequencedTimeAndSale>();
+    Beam::flush(queue, std::back_inserter(time_and_sales));
+    return time_and_sales;
+  }
+
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
+  void ChartingServlet<C, M, T>::on_rollup_update(
+      const std::shared_ptr<RollupEntry>& rollup,
+      const SequencedTimeAndSale& time_and_sale) {
+    auto lock = std::lock_guard(rollup->m_mutex);
+    if(rollup->m_is_loaded) {
+      rollup->m_rollup.update(time_and_sale);
+    } else {
+      rollup->m_pending.push_back(time_and_sale);
+    }
+  }
+
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
   template<typename MarketDataType>
-  void ChartingServlet<C, M>::handle_query(
+  void ChartingServlet<C, M, T>::handle_query(
       Beam::RequestToken<ServiceProtocolClient, QueryTickerService>& request,
       const TickerChartingQuery& query, int client_query_id,
       QueryEntry<MarketDataType>& query_entry) {
@@ -261,10 +499,11 @@ namespace Details {
       });
   }
 
-  template<typename C, typename M> requires
-    IsMarketDataClient<Beam::dereference_t<M>>
+  template<typename C, typename M, typename T> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      Beam::IsTimeClient<Beam::dereference_t<T>>
   template<typename Index, typename MarketDataType>
-  void ChartingServlet<C, M>::on_query_update(const Index& index,
+  void ChartingServlet<C, M, T>::on_query_update(const Index& index,
       const MarketDataType& value, QueryEntry<MarketDataType>& queries) {
     auto indexed_value = Beam::SequencedValue(
       Beam::IndexedValue(*value, index), value.get_sequence());
@@ -10,6 +10,7 @@
 #include <Beam/Services/AuthenticatedServiceProtocolClientBuilder.hpp>
 #include <Beam/Services/ServiceProtocolClient.hpp>
 #include <Beam/Services/ServiceProtocolServletContainer.hpp>
+#include <Beam/TimeService/TimeClient.hpp>
 #include <Beam/TimeService/TriggerTimer.hpp>
 #include <boost/functional/factory.hpp>
 #include "Nexus/ChartingService/ChartingServlet.hpp"
@@ -29,10 +30,11 @@ namespace Nexus::Tests {
        * Constructs a ChartingServiceTestEnvironment.
        * @param service_locator_client The ServiceLocatorClient to use.
        * @param market_data_client The MarketDataClient to use.
+       * @param time_client The TimeClient to use.
        */
       ChartingServiceTestEnvironment(
         Beam::ServiceLocatorClient service_locator_client,
-        MarketDataClient market_data_client);
+        MarketDataClient market_data_client, Beam::TimeClient time_client);
 
       ~ChartingServiceTestEnvironment();
 
@@ -50,7 +52,8 @@ namespace Nexus::Tests {
       using ServiceProtocolServletContainer =
         Beam::ServiceProtocolServletContainer<
           Beam::MetaAuthenticationServletAdapter<
-            MetaChartingServlet<MarketDataClient>, Beam::ServiceLocatorClient>,
+            MetaChartingServlet<MarketDataClient, Beam::TimeClient>,
+            Beam::ServiceLocatorClient>,
           Beam::LocalServerConnection*, Beam::BinarySender<Beam::SharedBuffer>,
           Beam::NullEncoder, std::shared_ptr<Beam::TriggerTimer>>;
       using ServiceProtocolClientBuilder =
@@ -70,9 +73,10 @@ namespace Nexus::Tests {
 
   inline ChartingServiceTestEnvironment::ChartingServiceTestEnvironment(
     Beam::ServiceLocatorClient service_locator_client,
-    MarketDataClient market_data_client)
+    MarketDataClient market_data_client, Beam::TimeClient time_client)
     : m_container(Beam::init(std::move(service_locator_client),
-        Beam::init(std::move(market_data_client))), &m_server_connection,
+        Beam::init(std::move(market_data_client), std::move(time_client))),
+        &m_server_connection,
         boost::factory<std::shared_ptr<Beam::TriggerTimer>>()) {}
 
   inline ChartingServiceTestEnvironment::~ChartingServiceTestEnvironment() {
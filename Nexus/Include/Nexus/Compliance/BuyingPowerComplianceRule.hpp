@@ -1,11 +1,9 @@
 #ifndef NEXUS_BUYING_POWER_COMPLIANCE_RULE_HPP
 #define NEXUS_BUYING_POWER_COMPLIANCE_RULE_HPP
-#include <Beam/Collections/SynchronizedMap.hpp>
+#include <unordered_map>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queues/MultiQueueWriter.hpp>
-#include <Beam/Queues/StateQueue.hpp>
-#include <Beam/Routines/RoutineHandler.hpp>
 #include <Beam/Threading/Sync.hpp>
 #include <Beam/Utilities/Algorithm.hpp>
 #include <Beam/Utilities/TypeTraits.hpp>
@@ -13,9 +11,11 @@
 #include "Nexus/Accounting/BuyingPowerModel.hpp"
 #include "Nexus/Definitions/BboQuote.hpp"
 #include "Nexus/Definitions/ExchangeRateTable.hpp"
+#include "Nexus/Definitions/TickerId.hpp"
 #include "Nexus/Compliance/ComplianceCheckException.hpp"
 #include "Nexus/Compliance/ComplianceRule.hpp"
 #include "Nexus/Compliance/ComplianceRuleSchema.hpp"
+#include "Nexus/MarketDataService/BboQuoteCache.hpp"
 #include "Nexus/MarketDataService/MarketDataClient.hpp"
 
 namespace Nexus {
@@ -49,6 +49,20 @@ namespace Nexus {
       BuyingPowerComplianceRule(Money buying_power, CurrencyId currency,
         const ExchangeRateTable& exchange_rates, CF&& market_data_client);
 
+      /**
+       * Constructs a BuyingPowerComplianceRule that prices Orders from a
+       * shared BboQuoteCache.
+       * @param buying_power The total buying power available.
+       * @param currency The buying power's currency.
+       * @param exchange_rates Used to convert currencies.
+       * @param market_data_client Initializes the MarketDataClient.
+       * @param bbo_quotes The BboQuoteCache used to price Orders.
+       */
+      template<Beam::Initializes<C> CF>
+      BuyingPowerComplianceRule(Money buying_power, CurrencyId currency,
+        const ExchangeRateTable& exchange_rates, CF&& market_data_client,
+        std::shared_ptr<BboQuoteCache> bbo_quotes);
+
       void submit(const std::shared_ptr<Order>& order) override;
       void restore(const Beam::DirectoryEntry& account,
         const InventorySnapshot& snapshot,
@@ -63,12 +77,12 @@ namespace Nexus {
       Beam::Sync<BuyingPowerModel> m_buying_power_model;
       Beam::MultiQueueWriter<ExecutionReport> m_execution_report_queue;
       std::unordered_map<OrderId, CurrencyId> m_currencies;
-      Beam::SynchronizedUnorderedMap<Ticker,
-        std::shared_ptr<Beam::StateQueue<BboQuote>>> m_bbo_quotes;
-      std::vector<Beam::RoutineHandler> m_query_routines;
+      std::shared_ptr<BboQuoteCache> m_bbo_quotes;
+      Beam::Sync<std::unordered_map<TickerId, BboQuoteCache::Handle>>
+        m_bbo_quote_handles;
 
-      BboQuote load_bbo_quote(const Ticker& ticker);
-      Money get_expected_price(const OrderFields& fields);
+      BboQuote load_bbo_quote(TickerId id, const Ticker& ticker);
+      Money get_expected_price(TickerId id, const OrderFields& fields);
   };
 
   template<typename C>
@@ -76,6 +90,11 @@ namespace Nexus {
     Money, CurrencyId, const ExchangeRateTable&, C&&) ->
       BuyingPowerComplianceRule<std::remove_cvref_t<C>>;
 
+  template<typename C>
+  BuyingPowerComplianceRule(Money, CurrencyId, const ExchangeRateTable&, C&&,
+    std::shared_ptr<BboQuoteCache>) ->
+      BuyingPowerComplianceRule<std::remove_cvref_t<C>>;
+
   /** The standard name used to identify the BuyingPowerComplianceRule. */
   inline auto BUYING_POWER_COMPLIANCE_RULE_NAME = std::string("buying_power");
 
@@ -96,11 +115,13 @@ namespace Nexus {
    * @param exchange_rates Used to convert currencies.
    * @param market_data_client Initializes the MarketDataClient used to
    *        price Orders.
+   * @param bbo_quotes The BboQuoteCache used to price Orders.
    */
   inline auto make_buying_power_compliance_rule(
       const std::vector<ComplianceParameter>& parameters,
       const ExchangeRateTable& exchange_rates,
-      IsMarketDataClient auto& market_data_client) {
+      IsMarketDataClient auto& market_data_client,
+      std::shared_ptr<BboQuoteCache> bbo_quotes) {
     auto buying_power = Money::ZERO;
     auto currency = Currencies::USD;
     for(auto& parameter : parameters) {
@@ -112,8 +133,24 @@ namespace Nexus {
     }
     using Rule = BuyingPowerComplianceRule<
       std::remove_reference_t<decltype(market_data_client)>*>;
-    return std::make_unique<Rule>(
-      buying_power, currency, exchange_rates, &market_data_client);
+    return std::make_unique<Rule>(buying_power, currency, exchange_rates,
+      &market_data_client, std::move(bbo_quotes));
+  }
+
+  /**
+   * Makes a new BuyingPowerComplianceRule from a list of ComplianceParameters.
+   * @param parameters The parameters to construct the rule from.
+   * @param exchange_rates Used to convert currencies.
+   * @param market_data_client Initializes the MarketDataClient used to
+   *        price Orders.
+   */
+  inline auto make_buying_power_compliance_rule(
+      const std::vector<ComplianceParameter>& parameters,
+      const ExchangeRateTable& exchange_rates,
+      IsMarketDataClient auto& market_data_client) {
+    return make_buying_power_compliance_rule(parameters, exchange_rates,
+      market_data_client, std::make_shared<BboQuoteCache>(
+        MarketDataClient(&market_data_client)));
   }
 
   template<typename C> requires IsMarketDataClient<Beam::dereference_t<C>>
@@ -123,13 +160,28 @@ namespace Nexus {
     CF&& market_data_client)
     : m_buying_power(buying_power),
       m_currency(currency),
-      m_market_data_client(std::forward<CF>(market_data_client)) {}
+      m_exchange_rates(exchange_rates),
+      m_market_data_client(std::forward<CF>(market_data_client)),
+      m_bbo_quotes(std::make_shared<BboQuoteCache>(
+        Nexus::MarketDataClient(&*m_market_data_client))) {}
+
+  template<typename C> requires IsMarketDataClient<Beam::dereference_t<C>>
+  template<Beam::Initializes<C> CF>
+  BuyingPowerComplianceRule<C>::BuyingPowerComplianceRule(Money buying_power,
+    CurrencyId currency, const ExchangeRateTable& exchange_rates,
+    CF&& market_data_client, std::shared_ptr<BboQuoteCache> bbo_quotes)
+    : m_buying_power(buying_power),
+      m_currency(currency),
+      m_exchange_rates(exchange_rates),
+      m_market_data_client(std::forward<CF>(market_data_client)),
+      m_bbo_quotes(std::move(bbo_quotes)) {}
 
   template<typename C> requires IsMarketDataClient<Beam::dereference_t<C>>
   void BuyingPowerComplianceRule<C>::submit(
       const std::shared_ptr<Order>& order) {
     auto& fields = order->get_info().m_fields;
-    auto price = get_expected_price(fields);
+    auto ticker = get_ticker_id(order->get_info());
+    auto price = get_expected_price(ticker, fields);
     Beam::with(m_buying_power_model, [&] (auto& buying_power_model) {
       while(auto report = m_execution_report_queue.try_pop()) {
         if(report->m_last_quantity != 0) {
@@ -157,7 +209,7 @@ namespace Nexus {
       }
       m_currencies.insert(std::pair(order->get_info().m_id, fields.m_currency));
       auto updated_buying_power = buying_power_model.submit(
-        order->get_info().m_id, converted_fields, converted_price);
+        order->get_info().m_id, ticker, converted_fields, converted_price);
       if(updated_buying_power > m_buying_power) {
         auto report = ExecutionReport();
         report.m_id = order->get_info().m_id;
@@ -197,9 +249,10 @@ namespace Nexus {
   template<typename C> requires IsMarketDataClient<Beam::dereference_t<C>>
   void BuyingPowerComplianceRule<C>::add(const std::shared_ptr<Order>& order) {
     auto& fields = order->get_info().m_fields;
+    auto ticker = get_ticker_id(order->get_info());
     auto price = [&] {
       try {
-        return get_expected_price(order->get_info().m_fields);
+        return get_expected_price(ticker, fields);
       } catch(const std::exception&) {
         if(order->get_info().m_fields.m_type == OrderType::LIMIT) {
           return order->get_info().m_fields.m_price;
@@ -221,24 +274,26 @@ namespace Nexus {
         return;
       }
       buying_power_model.submit(
-        order->get_info().m_id, converted_fields, converted_price);
+        order->get_info().m_id, ticker, converted_fields, converted_price);
       order->get_publisher().monitor(m_execution_report_queue.get_writer());
     });
   }
 
   template<typename C> requires IsMarketDataClient<Beam::dereference_t<C>>
   BboQuote BuyingPowerComplianceRule<C>::load_bbo_quote(
-      const Ticker& ticker) {
-    auto publisher = m_bbo_quotes.get_or_insert(ticker, [&] {
-      auto publisher = std::make_shared<Beam::StateQueue<BboQuote>>();
-      m_query_routines.push_back(query_real_time_with_snapshot(
-        *m_market_data_client, ticker, publisher));
-      return publisher;
+      TickerId id, const Ticker& ticker) {
+    auto bbo_quote = Beam::with(m_bbo_quote_handles, [&] (auto& handles) {
+      if(auto i = handles.find(id); i != handles.end()) {
+        return i->second;
+      }
+      return handles.emplace(id, m_bbo_quotes->get(ticker)).first->second;
     });
     try {
-      return publisher->peek();
+      return bbo_quote.load();
     } catch(const Beam::PipeBrokenException&) {
-      m_bbo_quotes.erase(ticker);
+      Beam::with(m_bbo_quote_handles, [&] (auto& handles) {
+        handles.erase(id);
+      });
       boost::throw_with_location(
         ComplianceCheckException("No BBO quote available."));
     }
@@ -246,8 +301,8 @@ namespace Nexus {
 
   template<typename C> requires IsMarketDataClient<Beam::dereference_t<C>>
   Money BuyingPowerComplianceRule<C>::get_expected_price(
-      const OrderFields& fields) {
-    auto bbo = load_bbo_quote(fields.m_ticker);
+      TickerId id, const OrderFields& fields) {
+    auto bbo = load_bbo_quote(id, fields.m_ticker);
     if(fields.m_type == OrderType::LIMIT) {
       if(fields.m_price <= Money::ZERO) {
         boost::throw_with_location(ComplianceCheckException("Invalid price."));
@@ -23,17 +23,19 @@ namespace Nexus {
    * @param market_data_client The MarketDataClient needed by various rules.
    * @param definitions_client The DefinitionsClient needed by various rules.
    * @param time_client The TimeClient needed by various rules.
+   * @param bbo_quotes The BboQuoteCache shared by rules that price Orders.
    * @return The ComplianceRule represented by the <i>schema</i>.
    */
   std::unique_ptr<ComplianceRule> make_compliance_rule(
       const ComplianceRuleSchema& schema,
       IsMarketDataClient auto& market_data_client,
       IsDefinitionsClient auto& definitions_client,
-      Beam::IsTimeClient auto& time_client) {
+      Beam::IsTimeClient auto& time_client,
+      const std::shared_ptr<BboQuoteCache>& bbo_quotes) {
     if(schema.get_name() == BUYING_POWER_COMPLIANCE_RULE_NAME) {
       return make_buying_power_compliance_rule(schema.get_parameters(),
         ExchangeRateTable(definitions_client.load_exchange_rates()),
-        market_data_client);
+        market_data_client, bbo_quotes);
     } else if(schema.get_name() == OPPOSING_CANCEL_RULE_NAME) {
       return make_opposing_cancel_compliance_rule(
         schema.get_parameters(), time_client);
@@ -47,26 +49,26 @@ namespace Nexus {
         schema.get_parameters());
     } else if(schema.get_name() == PER_ACCOUNT_RULE_NAME) {
       return make_per_account_compliance_rule(
-        unwrap(schema), [&] (const auto& schema) {
+        unwrap(schema), [&, bbo_quotes] (const auto& schema) {
           return make_compliance_rule(schema, market_data_client,
-            definitions_client, time_client);
+            definitions_client, time_client, bbo_quotes);
         });
     } else if(schema.get_name() == PER_TICKER_RULE_NAME) {
       return make_per_ticker_compliance_rule(
-        unwrap(schema), [&] (const auto& schema) {
+        unwrap(schema), [&, bbo_quotes] (const auto& schema) {
           return make_compliance_rule(schema, market_data_client,
-            definitions_client, time_client);
+            definitions_client, time_client, bbo_quotes);
         });
     } else if(schema.get_name() == PER_SIDE_RULE_NAME) {
       return make_per_side_compliance_rule(
-        unwrap(schema), [&] (const auto& schema) {
+        unwrap(schema), [&, bbo_quotes] (const auto& schema) {
           return make_compliance_rule(schema, market_data_client,
-            definitions_client, time_client);
+            definitions_client, time_client, bbo_quotes);
         });
     } else if(schema.get_name() == SCOPE_FILTER_RULE_NAME) {
       auto sub_schema = unwrap(schema);
-      auto sub_rule = make_compliance_rule(
-        sub_schema, market_data_client, definitions_client, time_client);
+      auto sub_rule = make_compliance_rule(sub_schema, market_data_client,
+        definitions_client, time_client, bbo_quotes);
       return make_scope_filter_compliance_rule(
         schema.get_parameters(), std::move(sub_rule));
     } else if(schema.get_name() == REJECT_CANCELS_RULE_NAME) {
@@ -75,13 +77,31 @@ namespace Nexus {
       return std::make_unique<RejectSubmissionsComplianceRule>();
     } else if(schema.get_name() == TIME_FILTER_RULE_NAME) {
       auto sub_schema = unwrap(schema);
-      auto sub_rule = make_compliance_rule(
-        sub_schema, market_data_client, definitions_client, time_client);
+      auto sub_rule = make_compliance_rule(sub_schema, market_data_client,
+        definitions_client, time_client, bbo_quotes);
       return make_time_filter_compliance_rule(
         schema.get_parameters(), time_client, std::move(sub_rule));
     }
     return nullptr;
   }
+
+  /**
+   * Returns a ComplianceRule from a ComplianceRuleSchema.
+   * @param schema The ComplianceRuleSchema to build the ComplianceRule from.
+   * @param market_data_client The MarketDataClient needed by various rules.
+   * @param definitions_client The DefinitionsClient needed by various rules.
+   * @param time_client The TimeClient needed by various rules.
+   * @return The ComplianceRule represented by the <i>schema</i>.
+   */
+  std::unique_ptr<ComplianceRule> make_compliance_rule(
+      const ComplianceRuleSchema& schema,
+      IsMarketDataClient auto& market_data_client,
+      IsDefinitionsClient auto& definitions_client,
+      Beam::IsTimeClient auto& time_client) {
+    return make_compliance_rule(schema, market_data_client, definitions_client,
+      time_client, std::make_shared<BboQuoteCache>(
+        MarketDataClient(&market_data_client)));
+  }
 }
 
 #endif
@@ -0,0 +1,428 @@
+#ifndef NEXUS_TICKER_ID_HPP
+#define NEXUS_TICKER_ID_HPP
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/throw_exception.hpp>
+#include "Nexus/Definitions/Ticker.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores a dense integer identifying a Ticker that was interned into a
+   * TickerTable. TickerIds are only meaningful within the process that
+   * interned them and are never serialized.
+   */
+  class TickerId {
+    public:
+
+      /** Represents an invalid or no Ticker. */
+      static const TickerId NONE;
+
+      /** Constructs an invalid id. */
+      constexpr TickerId() noexcept;
+
+      /**
+       * Constructs a TickerId from its index.
+       * @param value The index of the interned Ticker.
+       */
+      constexpr explicit TickerId(std::uint32_t value) noexcept;
+
+      /** Returns the integral representation of this id. */
+      constexpr explicit operator std::uint32_t() const noexcept;
+
+      /** Tests if this TickerId is not equal to NONE. */
+      constexpr explicit operator bool() const;
+
+      auto operator <=>(const TickerId&) const = default;
+
+    private:
+      std::uint32_t m_value;
+  };
+
+  inline const TickerId TickerId::NONE(~0);
+
+  /**
+   * Interns Tickers, assigning each distinct Ticker a TickerId in the order
+   * it is first seen. Interned Tickers are never removed, so that a TickerId
+   * remains valid for the lifetime of the table.
+   */
+  class TickerTable {
+    public:
+
+      /** Constructs an empty TickerTable. */
+      TickerTable() = default;
+
+      /** Returns the number of Tickers interned. */
+      std::size_t get_size() const;
+
+      /**
+       * Returns the TickerId of an interned Ticker.
+       * @param ticker The Ticker to lookup.
+       * @return The <i>ticker</i>'s id, or NONE if it has not been interned.
+       */
+      TickerId find(const Ticker& ticker) const;
+
+      /**
+       * Returns an interned Ticker.
+       * @param id The TickerId to lookup.
+       * @return The Ticker with the specified <i>id</i>, or an empty Ticker if
+       *         no such Ticker has been interned.
+       */
+      const Ticker& from(TickerId id) const;
+
+      /**
+       * Interns a Ticker.
+       * @param ticker The Ticker to intern.
+       * @return The <i>ticker</i>'s id, assigning a new one if it has not
+       *         previously been interned.
+       */
+      TickerId intern(const Ticker& ticker);
+
+    private:
+      mutable std::shared_mutex m_mutex;
+      std::unordered_map<Ticker, TickerId> m_ids;
+      std::deque<Ticker> m_tickers;
+
+      TickerTable(const TickerTable&) = delete;
+      TickerTable& operator =(const TickerTable&) = delete;
+  };
+
+  /**
+   * Maps TickerIds to values through an open addressed index of the ids it
+   * contains, so that lookups cost a multiply and a probe rather than hashing
+   * and comparing the Ticker. The index grows with the number of entries
+   * rather than with the largest id interned in the process. Entries are
+   * stored in insertion order and are never moved, references remain valid
+   * until the map is cleared.
+   * @param <T> The type of value to store.
+   */
+  template<typename T>
+  class TickerIdMap {
+    public:
+
+      /** The type of value to store. */
+      using Value = T;
+
+      /** The type of each entry stored. */
+      using Entry = std::pair<const TickerId, T>;
+
+      /** Constructs an empty TickerIdMap. */
+      TickerIdMap() = default;
+
+      /** Returns the number of entries. */
+      std::size_t size() const;
+
+      /** Returns <code>true</code> iff there are no entries. */
+      bool empty() const;
+
+      /**
+       * Returns <code>true</code> iff a TickerId has a value.
+       * @param id The TickerId to test.
+       */
+      bool contains(TickerId id) const;
+
+      /**
+       * Returns the value associated with a TickerId.
+       * @param id The TickerId to lookup.
+       * @return A pointer to the value, or <code>nullptr</code> if there is no
+       *         value associated with the <i>id</i>.
+       */
+      T* find(TickerId id);
+
+      /**
+       * Returns the value associated with a TickerId.
+       * @param id The TickerId to lookup.
+       * @return A pointer to the value, or <code>nullptr</code> if there is no
+       *         value associated with the <i>id</i>.
+       */
+      const T* find(TickerId id) const;
+
+      /**
+       * Returns the value associated with a TickerId, throwing
+       * std::out_of_range if there is none.
+       * @param id The TickerId to lookup.
+       */
+      T& at(TickerId id);
+
+      /**
+       * Returns the value associated with a TickerId, throwing
+       * std::out_of_range if there is none.
+       * @param id The TickerId to lookup.
+       */
+      const T& at(TickerId id) const;
+
+      /**
+       * Associates a value with a TickerId if it has none.
+       * @param id The TickerId to associate the value with.
+       * @param args The arguments used to construct the value.
+       * @return A pointer to the value associated with the <i>id</i> and
+       *         <code>true</code> iff it was constructed.
+       */
+      template<typename... Args>
+      std::pair<T*, bool> try_emplace(TickerId id, Args&&... args);
+
+      /**
+       * Returns the value associated with a TickerId, default constructing it
+       * if there is none.
+       * @param id The TickerId to lookup.
+       */
+      T& operator [](TickerId id);
+
+      /** Removes all entries. */
+      void clear();
+
+      auto begin();
+      auto begin() const;
+      auto end();
+      auto end() const;
+
+    private:
+      struct Slot {
+        std::uint32_t m_id;
+        std::uint32_t m_index;
+      };
+      static constexpr auto NO_ENTRY = ~std::uint32_t(0);
+      static constexpr auto MINIMUM_SLOTS = std::size_t(16);
+      std::vector<Slot> m_slots;
+      std::deque<Entry> m_entries;
+
+      std::size_t find_slot(std::uint32_t id) const;
+      std::uint32_t get_index(TickerId id) const;
+      void reserve_slot();
+  };
+
+  /** Returns the process-wide TickerTable. */
+  inline TickerTable& get_ticker_table() {
+    static auto table = TickerTable();
+    return table;
+  }
+
+  /**
+   * Interns a Ticker into the process-wide TickerTable.
+   * @param ticker The Ticker to intern.
+   * @return The <i>ticker</i>'s id.
+   */
+  inline TickerId to_ticker_id(const Ticker& ticker) {
+    return get_ticker_table().intern(ticker);
+  }
+
+  /**
+   * Returns a Ticker interned into the process-wide TickerTable.
+   * @param id The TickerId to lookup.
+   * @return The Ticker with the specified <i>id</i>.
+   */
+  inline const Ticker& to_ticker(TickerId id) {
+    return get_ticker_table().from(id);
+  }
+
+  inline std::ostream& operator <<(std::ostream& out, TickerId value) {
+    return out << static_cast<std::uint32_t>(value);
+  }
+
+  inline std::size_t hash_value(TickerId id) {
+    return static_cast<std::uint32_t>(id);
+  }
+
+  constexpr TickerId::TickerId() noexcept
+    : TickerId(~0) {}
+
+  constexpr TickerId::TickerId(std::uint32_t value) noexcept
+    : m_value(value) {}
+
+  constexpr TickerId::operator std::uint32_t() const noexcept {
+    return m_value;
+  }
+
+  constexpr TickerId::operator bool() const {
+    return m_value != TickerId().m_value;
+  }
+
+  inline std::size_t TickerTable::get_size() const {
+    auto lock = std::shared_lock(m_mutex);
+    return m_tickers.size();
+  }
+
+  inline TickerId TickerTable::find(const Ticker& ticker) const {
+    auto lock = std::shared_lock(m_mutex);
+    auto i = m_ids.find(ticker);
+    if(i == m_ids.end()) {
+      return TickerId::NONE;
+    }
+    return i->second;
+  }
+
+  inline const Ticker& TickerTable::from(TickerId id) const {
+    static const auto NONE = Ticker();
+    auto lock = std::shared_lock(m_mutex);
+    auto index = static_cast<std::uint32_t>(id);
+    if(index >= m_tickers.size()) {
+      return NONE;
+    }
+    return m_tickers[index];
+  }
+
+  inline TickerId TickerTable::intern(const Ticker& ticker) {
+    if(auto id = find(ticker)) {
+      return id;
+    }
+    auto lock = std::unique_lock(m_mutex);
+    auto id = TickerId(static_cast<std::uint32_t>(m_tickers.size()));
+    auto entry = m_ids.try_emplace(ticker, id);
+    if(entry.second) {
+      m_tickers.push_back(ticker);
+    }
+    return entry.first->second;
+  }
+
+  template<typename T>
+  std::size_t TickerIdMap<T>::size() const {
+    return m_entries.size();
+  }
+
+  template<typename T>
+  bool TickerIdMap<T>::empty() const {
+    return m_entries.empty();
+  }
+
+  template<typename T>
+  bool TickerIdMap<T>::contains(TickerId id) const {
+    return get_index(id) != NO_ENTRY;
+  }
+
+  template<typename T>
+  T* TickerIdMap<T>::find(TickerId id) {
+    auto index = get_index(id);
+    if(index == NO_ENTRY) {
+      return nullptr;
+    }
+    return &m_entries[index].second;
+  }
+
+  template<typename T>
+  const T* TickerIdMap<T>::find(TickerId id) const {
+    auto index = get_index(id);
+    if(index == NO_ENTRY) {
+      return nullptr;
+    }
+    return &m_entries[index].second;
+  }
+
+  template<typename T>
+  T& TickerIdMap<T>::at(TickerId id) {
+    if(auto value = find(id)) {
+      return *value;
+    }
+    boost::throw_with_location(std::out_of_range("TickerId not found."));
+  }
+
+  template<typename T>
+  const T& TickerIdMap<T>::at(TickerId id) const {
+    if(auto value = find(id)) {
+      return *value;
+    }
+    boost::throw_with_location(std::out_of_range("TickerId not found."));
+  }
+
+  template<typename T>
+  template<typename... Args>
+  std::pair<T*, bool> TickerIdMap<T>::try_emplace(
+      TickerId id, Args&&... args) {
+    if(auto value = find(id)) {
+      return {value, false};
+    }
+    if(!id) {
+      boost::throw_with_location(std::out_of_range("Invalid TickerId."));
+    }
+    reserve_slot();
+    auto& entry = m_entries.emplace_back(std::piecewise_construct,
+      std::forward_as_tuple(id),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+    auto& slot = m_slots[find_slot(static_cast<std::uint32_t>(id))];
+    slot.m_id = static_cast<std::uint32_t>(id);
+    slot.m_index = static_cast<std::uint32_t>(m_entries.size() - 1);
+    return {&entry.second, true};
+  }
+
+  template<typename T>
+  T& TickerIdMap<T>::operator [](TickerId id) {
+    return *try_emplace(id).first;
+  }
+
+  template<typename T>
+  void TickerIdMap<T>::clear() {
+    m_slots.clear();
+    m_entries.clear();
+  }
+
+  template<typename T>
+  auto TickerIdMap<T>::begin() {
+    return m_entries.begin();
+  }
+
+  template<typename T>
+  auto TickerIdMap<T>::begin() const {
+    return m_entries.begin();
+  }
+
+  template<typename T>
+  auto TickerIdMap<T>::end() {
+    return m_entries.end();
+  }
+
+  template<typename T>
+  auto TickerIdMap<T>::end() const {
+    return m_entries.end();
+  }
+
+  template<typename T>
+  std::size_t TickerIdMap<T>::find_slot(std::uint32_t id) const {
+    auto mask = m_slots.size() - 1;
+    auto slot = static_cast<std::size_t>(id * 2654435769U) & mask;
+    while(m_slots[slot].m_id != id && m_slots[slot].m_id != NO_ENTRY) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  template<typename T>
+  std::uint32_t TickerIdMap<T>::get_index(TickerId id) const {
+    if(m_slots.empty() || !id) {
+      return NO_ENTRY;
+    }
+    return m_slots[find_slot(static_cast<std::uint32_t>(id))].m_index;
+  }
+
+  template<typename T>
+  void TickerIdMap<T>::reserve_slot() {
+    if(2 * (m_entries.size() + 1) <= m_slots.size()) {
+      return;
+    }
+    auto size = std::max(MINIMUM_SLOTS, 2 * m_slots.size());
+    m_slots.assign(size, Slot(NO_ENTRY, NO_ENTRY));
+    for(auto i = std::size_t(0); i != m_entries.size(); ++i) {
+      auto id = static_cast<std::uint32_t>(m_entries[i].first);
+      auto& slot = m_slots[find_slot(id)];
+      slot.m_id = id;
+      slot.m_index = static_cast<std::uint32_t>(i);
+    }
+  }
+}
+
+namespace std {
+  template <>
+  struct hash<Nexus::TickerId> {
+    size_t operator()(Nexus::TickerId value) const noexcept {
+      return Nexus::hash_value(value);
+    }
+  };
+}
+
+#endif
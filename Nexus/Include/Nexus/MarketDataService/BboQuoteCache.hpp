@@ -0,0 +1,416 @@
+#ifndef NEXUS_BBO_QUOTE_CACHE_HPP
+#define NEXUS_BBO_QUOTE_CACHE_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Beam/IO/OpenState.hpp>
+#include <Beam/Queues/Queue.hpp>
+#include <Beam/Queues/QueueWriter.hpp>
+#include <Beam/Queues/RoutineTaskQueue.hpp>
+#include <Beam/Queues/ScopedQueueWriter.hpp>
+#include <Beam/Queues/StateQueue.hpp>
+#include <Beam/Routines/RoutineHandler.hpp>
+#include <Beam/Threading/Mutex.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/throw_exception.hpp>
+#include "Nexus/Definitions/BboQuote.hpp"
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/MarketDataService/MarketDataClient.hpp"
+
+namespace Nexus {
+
+  /**
+   * Shares a single real-time BboQuote subscription per Ticker among any
+   * number of readers and subscribers. The most recent BboQuote of each Ticker
+   * is stored behind a sequence lock so that it can be read without blocking
+   * the thread that publishes updates. A Ticker's subscription is held open
+   * for as long as any Handle to it or any monitor of it remains.
+   */
+  class BboQuoteCache {
+    public:
+
+      /**
+       * Refers to a Ticker's most recent BboQuote, reading it only touches the
+       * Ticker's sequence lock. A Handle must not outlive its BboQuoteCache.
+       */
+      class Handle;
+
+      /**
+       * Constructs a BboQuoteCache.
+       * @param client The MarketDataClient used to subscribe to BboQuotes.
+       */
+      explicit BboQuoteCache(MarketDataClient client);
+
+      ~BboQuoteCache();
+
+      /**
+       * Returns a Handle to a Ticker's BboQuote, subscribing to it if needed.
+       * The Ticker's subscription is released once all of its Handles are
+       * destroyed and all of its monitors are broken.
+       * @param ticker The Ticker to load.
+       * @return A Handle used to read the <i>ticker</i>'s BboQuote.
+       */
+      Handle get(const Ticker& ticker);
+
+      /**
+       * Monitors the BboQuotes of a Ticker, the current BboQuote is pushed
+       * immediately if available. The Ticker's subscription is released once
+       * all of its Handles are destroyed and all of its monitors are broken.
+       * @param ticker The Ticker to monitor.
+       * @param queue The queue to push BboQuote updates to.
+       */
+      void monitor(
+        const Ticker& ticker, Beam::ScopedQueueWriter<BboQuote> queue);
+
+      void close();
+
+    private:
+      class QuoteSlot {
+        public:
+          QuoteSlot() = default;
+
+          BboQuote load() const;
+          void store(const BboQuote& bbo);
+
+        private:
+          static_assert(std::is_trivially_copyable_v<BboQuote>);
+          static constexpr auto WORD_COUNT =
+            (sizeof(BboQuote) + sizeof(std::uint64_t) - 1) /
+              sizeof(std::uint64_t);
+          std::atomic<std::uint64_t> m_sequence;
+          std::array<std::atomic<std::uint64_t>, WORD_COUNT> m_words;
+      };
+      struct Entry {
+        QuoteSlot m_bbo;
+        std::atomic_bool m_is_available;
+        Beam::StateQueue<BboQuote> m_snapshot;
+        Beam::Mutex m_mutex;
+        std::shared_ptr<Beam::QueueWriter<BboQuote>> m_queue;
+        std::vector<Beam::ScopedQueueWriter<BboQuote>> m_subscribers;
+        int m_handle_count;
+        std::atomic_bool m_is_closed;
+
+        Entry();
+
+        bool is_referenced() const;
+      };
+      struct Lease {
+        BboQuoteCache* m_cache;
+        Ticker m_ticker;
+        std::shared_ptr<Entry> m_entry;
+
+        Lease(BboQuoteCache* cache, Ticker ticker,
+          std::shared_ptr<Entry> entry);
+        ~Lease();
+      };
+      MarketDataClient m_client;
+      mutable Beam::Mutex m_mutex;
+      std::unordered_map<Ticker, std::shared_ptr<Entry>> m_entries;
+      std::uint64_t m_next_query_id;
+      std::unordered_map<std::uint64_t, Beam::RoutineHandler> m_query_routines;
+      std::vector<std::uint64_t> m_completed_queries;
+      Beam::RoutineTaskQueue m_tasks;
+      Beam::OpenState m_open_state;
+
+      BboQuoteCache(const BboQuoteCache&) = delete;
+      BboQuoteCache& operator =(const BboQuoteCache&) = delete;
+      std::shared_ptr<Entry> load_entry(const Ticker& ticker);
+      void query(const Ticker& ticker,
+        std::shared_ptr<Beam::QueueWriter<BboQuote>> queue,
+        const std::shared_ptr<Entry>& entry);
+      void release(const Ticker& ticker, const std::shared_ptr<Entry>& entry);
+      void on_bbo(const Ticker& ticker, const std::shared_ptr<Entry>& entry,
+        const BboQuote& bbo);
+      void on_break(const Ticker& ticker, const std::shared_ptr<Entry>& entry,
+        const std::exception_ptr& exception);
+  };
+
+  class BboQuoteCache::Handle {
+    public:
+
+      /**
+       * Returns the most recent BboQuote, waiting for the Ticker's snapshot if
+       * none has been received yet.
+       * @return The most recent BboQuote published for the Ticker.
+       * @throws PipeBrokenException if no BboQuote is available.
+       */
+      BboQuote load() const;
+
+    private:
+      friend class BboQuoteCache;
+      std::shared_ptr<Lease> m_lease;
+
+      explicit Handle(std::shared_ptr<Lease> lease);
+  };
+
+  inline BboQuote BboQuoteCache::QuoteSlot::load() const {
+    auto words = std::array<std::uint64_t, WORD_COUNT>();
+    while(true) {
+      auto sequence = m_sequence.load(std::memory_order_acquire);
+      if(sequence % 2 == 1) {
+        continue;
+      }
+      for(auto i = std::size_t(0); i != WORD_COUNT; ++i) {
+        words[i] = m_words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(m_sequence.load(std::memory_order_relaxed) == sequence) {
+        break;
+      }
+    }
+    auto bbo = BboQuote();
+    std::memcpy(&bbo, words.data(), sizeof(BboQuote));
+    return bbo;
+  }
+
+  inline void BboQuoteCache::QuoteSlot::store(const BboQuote& bbo) {
+    auto words = std::array<std::uint64_t, WORD_COUNT>();
+    std::memcpy(words.data(), &bbo, sizeof(BboQuote));
+    auto sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(auto i = std::size_t(0); i != WORD_COUNT; ++i) {
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  inline BboQuoteCache::Entry::Entry()
+    : m_is_available(false),
+      m_handle_count(0),
+      m_is_closed(false) {}
+
+  inline bool BboQuoteCache::Entry::is_referenced() const {
+    return m_handle_count != 0 || !m_subscribers.empty();
+  }
+
+  inline BboQuoteCache::Lease::Lease(
+    BboQuoteCache* cache, Ticker ticker, std::shared_ptr<Entry> entry)
+    : m_cache(cache),
+      m_ticker(std::move(ticker)),
+      m_entry(std::move(entry)) {}
+
+  inline BboQuoteCache::Lease::~Lease() {
+    auto is_released = [&] {
+      auto lock = std::lock_guard(m_entry->m_mutex);
+      if(m_entry->m_is_closed) {
+        return false;
+      }
+      --m_entry->m_handle_count;
+      if(m_entry->is_referenced()) {
+        return false;
+      }
+      m_entry->m_is_closed = true;
+      return true;
+    }();
+    if(is_released) {
+      m_cache->release(m_ticker, m_entry);
+    }
+  }
+
+  inline BboQuote BboQuoteCache::Handle::load() const {
+    auto& entry = *m_lease->m_entry;
+    if(!entry.m_is_available.load(std::memory_order_acquire)) {
+      entry.m_snapshot.peek();
+    }
+    if(entry.m_is_closed) {
+      boost::throw_with_location(Beam::PipeBrokenException());
+    }
+    return entry.m_bbo.load();
+  }
+
+  inline BboQuoteCache::Handle::Handle(std::shared_ptr<Lease> lease)
+    : m_lease(std::move(lease)) {}
+
+  inline BboQuoteCache::BboQuoteCache(MarketDataClient client)
+    : m_client(std::move(client)),
+      m_next_query_id(0) {}
+
+  inline BboQuoteCache::~BboQuoteCache() {
+    close();
+  }
+
+  inline BboQuoteCache::Handle BboQuoteCache::get(const Ticker& ticker) {
+    while(true) {
+      auto entry = load_entry(ticker);
+      auto lock = std::lock_guard(entry->m_mutex);
+      if(entry->m_is_closed) {
+        continue;
+      }
+      ++entry->m_handle_count;
+      return Handle(std::make_shared<Lease>(this, ticker, entry));
+    }
+  }
+
+  inline void BboQuoteCache::monitor(
+      const Ticker& ticker, Beam::ScopedQueueWriter<BboQuote> queue) {
+    while(true) {
+      auto entry = load_entry(ticker);
+      auto lock = std::lock_guard(entry->m_mutex);
+      if(entry->m_is_closed) {
+        continue;
+      }
+      if(entry->m_is_available.load(std::memory_order_acquire)) {
+        try {
+          queue.push(entry->m_bbo.load());
+        } catch(const std::exception&) {
+          return;
+        }
+      }
+      entry->m_subscribers.push_back(std::move(queue));
+      return;
+    }
+  }
+
+  inline void BboQuoteCache::close() {
+    if(m_open_state.set_closing()) {
+      return;
+    }
+    auto entries = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      return std::exchange(m_entries, {});
+    }();
+    for(auto& entry : entries) {
+      release(entry.first, entry.second);
+    }
+    m_tasks.close();
+    m_tasks.wait();
+    auto query_routines = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      return std::exchange(m_query_routines, {});
+    }();
+    query_routines.clear();
+    m_open_state.close();
+  }
+
+  inline std::shared_ptr<BboQuoteCache::Entry> BboQuoteCache::load_entry(
+      const Ticker& ticker) {
+    auto lock = std::lock_guard(m_mutex);
+    if(!m_open_state.is_open()) {
+      boost::throw_with_location(Beam::PipeBrokenException());
+    }
+    auto& entry = m_entries[ticker];
+    if(entry && !entry->m_is_closed) {
+      return entry;
+    }
+    entry = std::make_shared<Entry>();
+    auto queue = std::shared_ptr<Beam::QueueWriter<BboQuote>>(
+      m_tasks.get_slot<BboQuote>(
+        std::bind_front(&BboQuoteCache::on_bbo, this, ticker, entry),
+        std::bind_front(&BboQuoteCache::on_break, this, ticker, entry)));
+    entry->m_queue = queue;
+    for(auto id : m_completed_queries) {
+      m_query_routines.erase(id);
+    }
+    m_completed_queries.clear();
+    auto id = m_next_query_id;
+    ++m_next_query_id;
+    m_query_routines.emplace(id, Beam::spawn([=, this] {
+      query(ticker, queue, entry);
+      auto lock = std::lock_guard(m_mutex);
+      m_completed_queries.push_back(id);
+    }));
+    return entry;
+  }
+
+  inline void BboQuoteCache::query(const Ticker& ticker,
+      std::shared_ptr<Beam::QueueWriter<BboQuote>> queue,
+      const std::shared_ptr<Entry>& entry) {
+    auto snapshot_queue = std::make_shared<Beam::Queue<SequencedBboQuote>>();
+    m_client.query(Beam::make_latest_query(ticker), snapshot_queue);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    auto snapshot = boost::optional<SequencedBboQuote>();
+    try {
+      snapshot = snapshot_queue->pop();
+    } catch(const Beam::PipeBrokenException&) {}
+    if(snapshot) {
+      query.set_range(
+        Beam::increment(snapshot->get_sequence()), Beam::Sequence::LAST);
+      try {
+        queue->push(std::move(**snapshot));
+      } catch(const std::exception&) {
+        return;
+      }
+    } else {
+      query.set_range(Beam::Sequence::FIRST, Beam::Sequence::LAST);
+    }
+    query.set_snapshot_limit(Beam::SnapshotLimit::UNLIMITED);
+    query.set_interruption_policy(Beam::InterruptionPolicy::IGNORE_CONTINUE);
+    m_client.query(query, std::move(queue));
+    if(!snapshot) {
+      entry->m_snapshot.close();
+    }
+  }
+
+  inline void BboQuoteCache::release(
+      const Ticker& ticker, const std::shared_ptr<Entry>& entry) {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      auto i = m_entries.find(ticker);
+      if(i != m_entries.end() && i->second == entry) {
+        m_entries.erase(i);
+      }
+    }
+    auto queue = [&] {
+      auto lock = std::lock_guard(entry->m_mutex);
+      entry->m_is_closed = true;
+      for(auto& subscriber : entry->m_subscribers) {
+        subscriber.close();
+      }
+      entry->m_subscribers.clear();
+      return std::exchange(entry->m_queue, nullptr);
+    }();
+    entry->m_snapshot.close();
+    if(queue) {
+      queue->close();
+    }
+  }
+
+  inline void BboQuoteCache::on_bbo(const Ticker& ticker,
+      const std::shared_ptr<Entry>& entry, const BboQuote& bbo) {
+    auto is_released = [&] {
+      auto lock = std::lock_guard(entry->m_mutex);
+      if(entry->m_is_closed) {
+        return false;
+      }
+      entry->m_bbo.store(bbo);
+      if(!entry->m_is_available.exchange(true, std::memory_order_acq_rel)) {
+        try {
+          entry->m_snapshot.push(bbo);
+        } catch(const std::exception&) {}
+      }
+      std::erase_if(entry->m_subscribers, [&] (auto& subscriber) {
+        try {
+          subscriber.push(bbo);
+          return false;
+        } catch(const std::exception&) {
+          return true;
+        }
+      });
+      if(!entry->is_referenced()) {
+        entry->m_is_closed = true;
+        return true;
+      }
+      return false;
+    }();
+    if(is_released) {
+      release(ticker, entry);
+    }
+  }
+
+  inline void BboQuoteCache::on_break(const Ticker& ticker,
+      const std::shared_ptr<Entry>& entry, const std::exception_ptr&) {
+    release(ticker, entry);
+  }
+}
+
+#endif
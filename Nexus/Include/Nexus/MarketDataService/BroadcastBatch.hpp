@@ -0,0 +1,302 @@
+#ifndef NEXUS_MARKET_DATA_BROADCAST_BATCH_HPP
+#define NEXUS_MARKET_DATA_BROADCAST_BATCH_HPP
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Beam/Services/RecordMessage.hpp>
+#include "Nexus/MarketDataService/BroadcastChannel.hpp"
+#include "Nexus/MarketDataService/MarketDataRegistryServices.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores a list of market data updates encoded once so that it can be sent
+   * to any number of clients. Clients that opted in to batched messages
+   * receive the list as a single message, with BookQuotes and TimeAndSales
+   * encoded as a MarketDataFrame built on first use. Other clients receive one
+   * message per update.
+   * @param <T> The type of sequenced, indexed market data sent.
+   */
+  template<typename T>
+  class EncodedMarketDataBatch {
+    public:
+
+      /** The type of market data sent. */
+      using Value = typename T::Value::Value;
+
+      /**
+       * Constructs an EncodedMarketDataBatch.
+       * @param values The updates to send, in sequence order.
+       */
+      explicit EncodedMarketDataBatch(std::vector<T> values);
+
+      /**
+       * Sends the updates to a client, using a single message if the client's
+       * BroadcastChannel accepts batched messages.
+       * @param client The client to send the updates to.
+       */
+      template<typename C>
+      void send(C& client);
+
+    private:
+      std::vector<T> m_values;
+      MarketDataFrame<Value> m_frame;
+  };
+
+  /**
+   * Sends a list of market data updates to a client, using a single frame
+   * for the whole list if the client accepts batched messages.
+   * @param client The client to send the updates to.
+   * @param values The updates to send.
+   */
+  template<typename C, typename T>
+  void send_market_data_batch(C& client, const std::vector<T>& values) {
+    if(!values.empty()) {
+      EncodedMarketDataBatch<T>(values).send(client);
+    }
+  }
+
+  /**
+   * Coalesces the market data updates produced by one publish cycle so that
+   * each client receives at most one frame per type of market data. Frames
+   * are tied to the BroadcastChannel of the client's session when they are
+   * queued and are only sent while that channel is open. Each update is
+   * stored once, and clients receiving the same list of updates share a
+   * single encoding of it. Clients that have not opted in to batched messages
+   * are sent the frame's updates one message each.
+   * @param <C> The type of ServiceProtocolClient receiving the updates.
+   */
+  template<typename C>
+  class BroadcastBatch {
+    public:
+
+      /** The type of ServiceProtocolClient receiving the updates. */
+      using ServiceProtocolClient = C;
+
+      /** Constructs an empty BroadcastBatch. */
+      BroadcastBatch() = default;
+
+      /** Returns <code>true</code> iff no updates are pending. */
+      bool is_empty() const;
+
+      /**
+       * Adds a BboQuote to a client's pending frame.
+       * @param client The client to send the BboQuote to.
+       * @param quote The BboQuote to send.
+       */
+      void push(
+        ServiceProtocolClient& client, const SequencedTickerBboQuote& quote);
+
+      /**
+       * Adds a BookQuote to a client's pending frame.
+       * @param client The client to send the BookQuote to.
+       * @param quote The BookQuote to send.
+       */
+      void push(
+        ServiceProtocolClient& client, const SequencedTickerBookQuote& quote);
+
+      /**
+       * Adds a TimeAndSale to a client's pending frame.
+       * @param client The client to send the TimeAndSale to.
+       * @param time_and_sale The TimeAndSale to send.
+       */
+      void push(ServiceProtocolClient& client,
+        const SequencedTickerTimeAndSale& time_and_sale);
+
+      /**
+       * Sends all pending frames and clears the batch. Frames whose channel
+       * has closed are discarded. BboQuotes and BookQuotes for a session that
+       * is conflating updates are added to its ConflationBuffer instead.
+       */
+      void send();
+
+    private:
+      using Indices = std::vector<std::uint32_t>;
+      template<typename T>
+      using Encodings = std::map<Indices, EncodedMarketDataBatch<T>>;
+      struct Frame {
+        std::shared_ptr<BroadcastChannel> m_channel;
+        Indices m_bbo_quotes;
+        Indices m_book_quotes;
+        Indices m_time_and_sales;
+      };
+      using Frames = std::vector<std::pair<ServiceProtocolClient*, Frame>>;
+      std::unordered_map<ServiceProtocolClient*, Frame> m_frames;
+      std::vector<SequencedTickerBboQuote> m_bbo_quotes;
+      std::vector<SequencedTickerBookQuote> m_book_quotes;
+      std::vector<SequencedTickerTimeAndSale> m_time_and_sales;
+
+      BroadcastBatch(const BroadcastBatch&) = delete;
+      BroadcastBatch& operator =(const BroadcastBatch&) = delete;
+      Frame& get_frame(ServiceProtocolClient& client);
+      template<typename T>
+      static std::uint32_t add(std::vector<T>& values, const T& value);
+      template<typename T>
+      static bool conflate(ServiceProtocolClient& client,
+        const Indices& indices, const std::vector<T>& values);
+      template<typename T>
+      static std::vector<EncodedMarketDataBatch<T>*> encode(
+        const Frames& frames, Indices Frame::* indices,
+        const std::vector<T>& values, Encodings<T>& encodings);
+  };
+
+  template<typename T>
+  EncodedMarketDataBatch<T>::EncodedMarketDataBatch(std::vector<T> values)
+    : m_values(std::move(values)) {}
+
+  template<typename T>
+  template<typename C>
+  void EncodedMarketDataBatch<T>::send(C& client) {
+    if(m_values.size() == 1 ||
+        !client.get_session().m_channel->is_batching()) {
+      for(auto& value : m_values) {
+        Beam::send_record_message<market_data_message_type_t<Value>>(
+          client, value);
+      }
+    } else if constexpr(std::is_same_v<Value, BboQuote>) {
+      Beam::send_record_message<market_data_batch_message_type_t<Value>>(
+        client, m_values);
+    } else {
+      if(m_frame.is_empty()) {
+        m_frame = MarketDataFrame<Value>(m_values);
+      }
+      Beam::send_record_message<market_data_batch_message_type_t<Value>>(
+        client, m_frame);
+    }
+  }
+
+  template<typename C>
+  bool BroadcastBatch<C>::is_empty() const {
+    return m_frames.empty();
+  }
+
+  template<typename C>
+  void BroadcastBatch<C>::push(
+      ServiceProtocolClient& client, const SequencedTickerBboQuote& quote) {
+    get_frame(client).m_bbo_quotes.push_back(add(m_bbo_quotes, quote));
+  }
+
+  template<typename C>
+  void BroadcastBatch<C>::push(
+      ServiceProtocolClient& client, const SequencedTickerBookQuote& quote) {
+    get_frame(client).m_book_quotes.push_back(add(m_book_quotes, quote));
+  }
+
+  template<typename C>
+  void BroadcastBatch<C>::push(ServiceProtocolClient& client,
+      const SequencedTickerTimeAndSale& time_and_sale) {
+    get_frame(client).m_time_and_sales.push_back(
+      add(m_time_and_sales, time_and_sale));
+  }
+
+  template<typename C>
+  void BroadcastBatch<C>::send() {
+    auto frames = Frames(std::make_move_iterator(m_frames.begin()),
+      std::make_move_iterator(m_frames.end()));
+    m_frames.clear();
+    auto bbo_quote_encodings = Encodings<SequencedTickerBboQuote>();
+    auto bbo_quotes = encode(
+      frames, &Frame::m_bbo_quotes, m_bbo_quotes, bbo_quote_encodings);
+    auto book_quote_encodings = Encodings<SequencedTickerBookQuote>();
+    auto book_quotes = encode(
+      frames, &Frame::m_book_quotes, m_book_quotes, book_quote_encodings);
+    auto time_and_sale_encodings = Encodings<SequencedTickerTimeAndSale>();
+    auto time_and_sales = encode(frames, &Frame::m_time_and_sales,
+      m_time_and_sales, time_and_sale_encodings);
+    m_time_and_sales.clear();
+    for(auto i = std::size_t(0); i != frames.size(); ++i) {
+      auto& client = *frames[i].first;
+      auto& frame = frames[i].second;
+      frame.m_channel->with([&] {
+        if(bbo_quotes[i] &&
+            !conflate(client, frame.m_bbo_quotes, m_bbo_quotes)) {
+          bbo_quotes[i]->send(client);
+        }
+        if(book_quotes[i] &&
+            !conflate(client, frame.m_book_quotes, m_book_quotes)) {
+          book_quotes[i]->send(client);
+        }
+        if(time_and_sales[i]) {
+          time_and_sales[i]->send(client);
+        }
+      });
+    }
+    m_bbo_quotes.clear();
+    m_book_quotes.clear();
+  }
+
+  template<typename C>
+  typename BroadcastBatch<C>::Frame& BroadcastBatch<C>::get_frame(
+      ServiceProtocolClient& client) {
+    auto& frame = m_frames[&client];
+    auto& channel = client.get_session().m_channel;
+    if(frame.m_channel != channel) {
+      frame = Frame();
+      frame.m_channel = channel;
+    }
+    return frame;
+  }
+
+  template<typename C>
+  template<typename T>
+  std::uint32_t BroadcastBatch<C>::add(
+      std::vector<T>& values, const T& value) {
+    if(values.empty() || values.back().get_sequence() != value.get_sequence() ||
+        values.back()->get_index() != value->get_index()) {
+      values.push_back(value);
+    }
+    return static_cast<std::uint32_t>(values.size() - 1);
+  }
+
+  template<typename C>
+  template<typename T>
+  bool BroadcastBatch<C>::conflate(ServiceProtocolClient& client,
+      const Indices& indices, const std::vector<T>& values) {
+    if constexpr(requires { client.get_session().m_conflation; }) {
+      auto& conflation = client.get_session().m_conflation;
+      if(!conflation.is_enabled()) {
+        return false;
+      }
+      for(auto index : indices) {
+        conflation.push(values[index]);
+      }
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  template<typename C>
+  template<typename T>
+  std::vector<EncodedMarketDataBatch<T>*> BroadcastBatch<C>::encode(
+      const Frames& frames, Indices Frame::* indices,
+      const std::vector<T>& values, Encodings<T>& encodings) {
+    auto batches = std::vector<EncodedMarketDataBatch<T>*>();
+    batches.reserve(frames.size());
+    for(auto& frame : frames) {
+      auto& frame_indices = frame.second.*indices;
+      if(frame_indices.empty()) {
+        batches.push_back(nullptr);
+        continue;
+      }
+      auto i = encodings.find(frame_indices);
+      if(i == encodings.end()) {
+        auto frame_values = std::vector<T>();
+        frame_values.reserve(frame_indices.size());
+        for(auto index : frame_indices) {
+          frame_values.push_back(values[index]);
+        }
+        i = encodings.emplace(frame_indices,
+          EncodedMarketDataBatch<T>(std::move(frame_values))).first;
+      }
+      batches.push_back(&i->second);
+    }
+    return batches;
+  }
+}
+
+#endif
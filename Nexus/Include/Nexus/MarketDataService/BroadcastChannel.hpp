@@ -0,0 +1,86 @@
+#ifndef NEXUS_MARKET_DATA_BROADCAST_CHANNEL_HPP
+#define NEXUS_MARKET_DATA_BROADCAST_CHANNEL_HPP
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <Beam/Threading/Mutex.hpp>
+
+namespace Nexus {
+
+  /**
+   * Identifies a single connection of a client receiving batched broadcasts.
+   * A new channel is made for every session, so a frame queued for a closed
+   * client is never delivered to a later client reusing its address. Clients
+   * receive one message per update until they opt in to batched messages.
+   */
+  class BroadcastChannel {
+    public:
+
+      /** Constructs an open BroadcastChannel. */
+      BroadcastChannel() noexcept;
+
+      /**
+       * Returns <code>true</code> iff the client accepts batched messages.
+       */
+      bool is_batching() const;
+
+      /**
+       * Sets whether the client accepts batched messages.
+       * @param is_batching <code>true</code> iff the client accepts batched
+       *        messages.
+       */
+      void set_batching(bool is_batching);
+
+      /**
+       * Closes this channel, waiting for any frame being sent over it to
+       * complete.
+       */
+      void close();
+
+      /**
+       * Calls a function with exclusive access to this channel if it is open.
+       * @param f The function to call.
+       * @return <code>true</code> iff the channel was open and <i>f</i> was
+       *         called.
+       */
+      template<typename F>
+      bool with(F&& f);
+
+    private:
+      Beam::Mutex m_mutex;
+      bool m_is_open;
+      std::atomic_bool m_is_batching;
+
+      BroadcastChannel(const BroadcastChannel&) = delete;
+      BroadcastChannel& operator =(const BroadcastChannel&) = delete;
+  };
+
+  inline BroadcastChannel::BroadcastChannel() noexcept
+    : m_is_open(true),
+      m_is_batching(false) {}
+
+  inline bool BroadcastChannel::is_batching() const {
+    return m_is_batching.load(std::memory_order_acquire);
+  }
+
+  inline void BroadcastChannel::set_batching(bool is_batching) {
+    m_is_batching.store(is_batching, std::memory_order_release);
+  }
+
+  inline void BroadcastChannel::close() {
+    auto lock = std::lock_guard(m_mutex);
+    m_is_open = false;
+  }
+
+  template<typename F>
+  bool BroadcastChannel::with(F&& f) {
+    auto lock = std::lock_guard(m_mutex);
+    if(!m_is_open) {
+      return false;
+    }
+    std::forward<F>(f)();
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,761 @@
+#ifndef NEXUS_COLUMNAR_BLOCK_HPP
+#define NEXUS_COLUMNAR_BLOCK_HPP
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Beam/Pointers/Ref.hpp>
+#include <Beam/Queries/Sequence.hpp>
+#include <Beam/Queries/SequencedValue.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/throw_exception.hpp>
+#include "Nexus/Definitions/BboQuote.hpp"
+#include "Nexus/Definitions/BookQuote.hpp"
+#include "Nexus/Definitions/OrderImbalance.hpp"
+#include "Nexus/Definitions/TickerInfo.hpp"
+#include "Nexus/Definitions/TickerStatus.hpp"
+#include "Nexus/Definitions/TimeAndSale.hpp"
+#include "Nexus/MarketDataService/HistoricalDataStoreException.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores the header that precedes every block of a columnar file. The
+   * header summarizes the block's contents so that readers can skip it without
+   * decoding its columns.
+   */
+  struct ColumnarBlockHeader {
+
+    /** The value identifying the start of a block. */
+    static constexpr auto MAGIC = std::uint32_t(0x4B424358);
+
+    /** Identifies the start of a block, must be equal to MAGIC. */
+    std::uint32_t m_magic;
+
+    /** The number of values stored in the block. */
+    std::uint32_t m_count;
+
+    /** The size of the block's columns in bytes. */
+    std::uint64_t m_size;
+
+    /** The smallest Sequence stored in the block. */
+    std::uint64_t m_first_sequence;
+
+    /** The largest Sequence stored in the block. */
+    std::uint64_t m_last_sequence;
+
+    /** The earliest timestamp stored in the block, in microseconds. */
+    std::int64_t m_start_timestamp;
+
+    /** The latest timestamp stored in the block, in microseconds. */
+    std::int64_t m_end_timestamp;
+  };
+
+  /** Appends columns of values to a buffer. */
+  class ColumnWriter {
+    public:
+
+      /**
+       * Constructs a ColumnWriter.
+       * @param buffer The buffer to append columns to.
+       */
+      explicit ColumnWriter(Beam::Ref<std::string> buffer) noexcept;
+
+      /** Writes a single byte. */
+      void write(std::uint8_t value);
+
+      /** Writes an unsigned integer using a variable length encoding. */
+      void write_varint(std::uint64_t value);
+
+      /** Writes a length prefixed string. */
+      void write_string(std::string_view value);
+
+      /** Writes a column of bytes. */
+      void write_bytes(const std::vector<std::uint8_t>& column);
+
+      /**
+       * Writes a column of integers as zig-zag encoded differences between
+       * consecutive values.
+       */
+      void write_deltas(const std::vector<std::int64_t>& column);
+
+      /**
+       * Writes a column of Quantities. Columns whose values are all integral
+       * multiples of the Quantity's resolution are delta encoded, otherwise
+       * the raw representations are written.
+       */
+      void write_quantities(const std::vector<Quantity>& column);
+
+      /**
+       * Writes a column of strings as a dictionary of its distinct values
+       * followed by each value's index into the dictionary.
+       */
+      void write_dictionary(const std::vector<std::string_view>& column);
+
+    private:
+      std::string* m_buffer;
+  };
+
+  /** Reads columns of values from a buffer. */
+  class ColumnReader {
+    public:
+
+      /**
+       * Constructs a ColumnReader.
+       * @param data The buffer to read from.
+       * @param size The size of the <i>data</i>.
+       */
+      ColumnReader(const char* data, std::size_t size) noexcept;
+
+      /** Reads a single byte. */
+      std::uint8_t read();
+
+      /** Reads an unsigned integer using a variable length encoding. */
+      std::uint64_t read_varint();
+
+      /** Reads a length prefixed string. */
+      std::string read_string();
+
+      /** Reads a column of bytes. */
+      std::vector<std::uint8_t> read_bytes(std::size_t count);
+
+      /** Reads a column of delta encoded integers. */
+      std::vector<std::int64_t> read_deltas(std::size_t count);
+
+      /** Reads a column of Quantities. */
+      std::vector<Quantity> read_quantities(std::size_t count);
+
+      /** Reads a dictionary encoded column of strings. */
+      std::vector<std::string> read_dictionary(std::size_t count);
+
+      /** Returns the number of bytes read so far. */
+      std::size_t get_position() const;
+
+    private:
+      const char* m_data;
+      std::size_t m_size;
+      std::size_t m_position;
+
+      void require(std::size_t size) const;
+  };
+
+  /**
+   * Specifies how the fields of a market data value other than its timestamp
+   * are split into columns.
+   * @param <T> The type of market data value.
+   */
+  template<typename T>
+  struct ColumnarCodec;
+
+  template<>
+  struct ColumnarCodec<BboQuote> {
+    static void encode(std::span<const Beam::SequencedValue<BboQuote>> values,
+      ColumnWriter& writer);
+    static void decode(ColumnReader& reader, std::span<BboQuote> values);
+  };
+
+  template<>
+  struct ColumnarCodec<BookQuote> {
+    static void encode(std::span<const Beam::SequencedValue<BookQuote>> values,
+      ColumnWriter& writer);
+    static void decode(ColumnReader& reader, std::span<BookQuote> values);
+  };
+
+  template<>
+  struct ColumnarCodec<TimeAndSale> {
+    static void encode(
+      std::span<const Beam::SequencedValue<TimeAndSale>> values,
+      ColumnWriter& writer);
+    static void decode(ColumnReader& reader, std::span<TimeAndSale> values);
+  };
+
+  template<>
+  struct ColumnarCodec<TickerStatus> {
+    static void encode(
+      std::span<const Beam::SequencedValue<TickerStatus>> values,
+      ColumnWriter& writer);
+    static void decode(ColumnReader& reader, std::span<TickerStatus> values);
+  };
+
+  template<>
+  struct ColumnarCodec<OrderImbalance> {
+    static void encode(
+      std::span<const Beam::SequencedValue<OrderImbalance>> values,
+      ColumnWriter& writer);
+    static void decode(ColumnReader& reader, std::span<OrderImbalance> values);
+  };
+
+  /**
+   * Converts a timestamp into the number of microseconds since the epoch,
+   * special values are mapped to reserved integers.
+   */
+  inline std::int64_t to_columnar_timestamp(boost::posix_time::ptime value) {
+    if(value.is_not_a_date_time()) {
+      return std::numeric_limits<std::int64_t>::min();
+    } else if(value.is_neg_infinity()) {
+      return std::numeric_limits<std::int64_t>::min() + 1;
+    } else if(value.is_pos_infinity()) {
+      return std::numeric_limits<std::int64_t>::max();
+    }
+    static const auto EPOCH =
+      boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
+    return (value - EPOCH).total_microseconds();
+  }
+
+  /** Converts the result of to_columnar_timestamp back into a timestamp. */
+  inline boost::posix_time::ptime from_columnar_timestamp(std::int64_t value) {
+    if(value == std::numeric_limits<std::int64_t>::min()) {
+      return boost::posix_time::not_a_date_time;
+    } else if(value == std::numeric_limits<std::int64_t>::min() + 1) {
+      return boost::posix_time::neg_infin;
+    } else if(value == std::numeric_limits<std::int64_t>::max()) {
+      return boost::posix_time::pos_infin;
+    }
+    static const auto EPOCH =
+      boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1));
+    return EPOCH + boost::posix_time::microseconds(value);
+  }
+
+  /**
+   * Encodes a block of values and appends it, along with its header, to a
+   * buffer.
+   * @param values The values to encode.
+   * @param buffer The buffer to append the block to.
+   */
+  template<typename T>
+  void encode_columnar_block(std::span<const Beam::SequencedValue<T>> values,
+      std::string& buffer) {
+    auto header = ColumnarBlockHeader();
+    header.m_magic = ColumnarBlockHeader::MAGIC;
+    header.m_count = static_cast<std::uint32_t>(values.size());
+    header.m_first_sequence = std::numeric_limits<std::uint64_t>::max();
+    header.m_last_sequence = 0;
+    header.m_start_timestamp = std::numeric_limits<std::int64_t>::max();
+    header.m_end_timestamp = std::numeric_limits<std::int64_t>::min();
+    auto sequences = std::vector<std::int64_t>();
+    sequences.reserve(values.size());
+    auto timestamps = std::vector<std::int64_t>();
+    timestamps.reserve(values.size());
+    for(auto& value : values) {
+      auto sequence = value.get_sequence().get_ordinal();
+      auto timestamp = to_columnar_timestamp(value->m_timestamp);
+      header.m_first_sequence = std::min(header.m_first_sequence, sequence);
+      header.m_last_sequence = std::max(header.m_last_sequence, sequence);
+      header.m_start_timestamp = std::min(header.m_start_timestamp, timestamp);
+      header.m_end_timestamp = std::max(header.m_end_timestamp, timestamp);
+      sequences.push_back(static_cast<std::int64_t>(sequence));
+      timestamps.push_back(timestamp);
+    }
+    auto offset = buffer.size();
+    buffer.resize(offset + sizeof(ColumnarBlockHeader));
+    auto writer = ColumnWriter(Beam::Ref(buffer));
+    writer.write_deltas(sequences);
+    writer.write_deltas(timestamps);
+    ColumnarCodec<T>::encode(values, writer);
+    header.m_size = buffer.size() - offset - sizeof(ColumnarBlockHeader);
+    std::memcpy(buffer.data() + offset, &header, sizeof(ColumnarBlockHeader));
+  }
+
+  /**
+   * Decodes a block of values.
+   * @param header The block's header.
+   * @param data The block's columns, immediately following its header.
+   * @param values The vector to append the decoded values to.
+   */
+  template<typename T>
+  void decode_columnar_block(const ColumnarBlockHeader& header,
+      const char* data, std::vector<Beam::SequencedValue<T>>& values) {
+    auto reader = ColumnReader(data, header.m_size);
+    auto sequences = reader.read_deltas(header.m_count);
+    auto timestamps = reader.read_deltas(header.m_count);
+    auto decoded = std::vector<T>(header.m_count);
+    for(auto i = std::size_t(0); i != decoded.size(); ++i) {
+      decoded[i].m_timestamp = from_columnar_timestamp(timestamps[i]);
+    }
+    ColumnarCodec<T>::decode(reader, decoded);
+    values.reserve(values.size() + decoded.size());
+    for(auto i = std::size_t(0); i != decoded.size(); ++i) {
+      values.emplace_back(std::move(decoded[i]),
+        Beam::Sequence(static_cast<std::uint64_t>(sequences[i])));
+    }
+  }
+
+  /**
+   * Encodes a list of TickerInfo.
+   * @param info The TickerInfo to encode.
+   * @param buffer The buffer to append the encoding to.
+   */
+  inline void encode_columnar_ticker_info(
+      const std::vector<TickerInfo>& info, std::string& buffer) {
+    auto writer = ColumnWriter(Beam::Ref(buffer));
+    writer.write_varint(info.size());
+    auto symbols = std::vector<std::string_view>();
+    auto venues = std::vector<std::string_view>();
+    auto names = std::vector<std::string_view>();
+    auto sectors = std::vector<std::string_view>();
+    auto board_lots = std::vector<Quantity>();
+    for(auto& entry : info) {
+      symbols.push_back(entry.m_ticker.get_symbol());
+      venues.push_back(entry.m_ticker.get_venue().get_code().get_data());
+      names.push_back(entry.m_name);
+      sectors.push_back(entry.m_sector);
+      board_lots.push_back(entry.m_board_lot);
+    }
+    writer.write_dictionary(symbols);
+    writer.write_dictionary(venues);
+    writer.write_dictionary(names);
+    writer.write_dictionary(sectors);
+    writer.write_quantities(board_lots);
+  }
+
+  /**
+   * Decodes a list of TickerInfo.
+   * @param data The encoded TickerInfo, consisting of one or more consecutive
+   *        lists encoded by encode_columnar_ticker_info.
+   * @param size The size of the <i>data</i>.
+   * @return The decoded TickerInfo, in the order they were encoded.
+   */
+  inline std::vector<TickerInfo> decode_columnar_ticker_info(
+      const char* data, std::size_t size) {
+    auto reader = ColumnReader(data, size);
+    auto info = std::vector<TickerInfo>();
+    while(reader.get_position() != size) {
+      auto count = static_cast<std::size_t>(reader.read_varint());
+      auto symbols = reader.read_dictionary(count);
+      auto venues = reader.read_dictionary(count);
+      auto names = reader.read_dictionary(count);
+      auto sectors = reader.read_dictionary(count);
+      auto board_lots = reader.read_quantities(count);
+      for(auto i = std::size_t(0); i != count; ++i) {
+        auto& entry = info.emplace_back();
+        entry.m_ticker =
+          Ticker(std::move(symbols[i]), Venue(std::move(venues[i])));
+        entry.m_name = std::move(names[i]);
+        entry.m_sector = std::move(sectors[i]);
+        entry.m_board_lot = board_lots[i];
+      }
+    }
+    return info;
+  }
+
+  inline ColumnWriter::ColumnWriter(Beam::Ref<std::string> buffer) noexcept
+    : m_buffer(buffer.get()) {}
+
+  inline void ColumnWriter::write(std::uint8_t value) {
+    m_buffer->push_back(static_cast<char>(value));
+  }
+
+  inline void ColumnWriter::write_varint(std::uint64_t value) {
+    while(value >= 0x80) {
+      write(static_cast<std::uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    write(static_cast<std::uint8_t>(value));
+  }
+
+  inline void ColumnWriter::write_string(std::string_view value) {
+    write_varint(value.size());
+    m_buffer->append(value);
+  }
+
+  inline void ColumnWriter::write_bytes(
+      const std::vector<std::uint8_t>& column) {
+    m_buffer->append(
+      reinterpret_cast<const char*>(column.data()), column.size());
+  }
+
+  inline void ColumnWriter::write_deltas(
+      const std::vector<std::int64_t>& column) {
+    auto previous = std::uint64_t(0);
+    for(auto value : column) {
+      auto delta = static_cast<std::int64_t>(
+        static_cast<std::uint64_t>(value) - previous);
+      write_varint((static_cast<std::uint64_t>(delta) << 1) ^
+        static_cast<std::uint64_t>(delta >> 63));
+      previous = static_cast<std::uint64_t>(value);
+    }
+  }
+
+  inline void ColumnWriter::write_quantities(
+      const std::vector<Quantity>& column) {
+    static constexpr auto MAXIMUM = boost::float64_t(std::int64_t(1) << 62);
+    auto is_integral = std::ranges::all_of(column, [] (auto value) {
+      auto representation = value.get_representation();
+      return std::nearbyint(representation) == representation &&
+        std::abs(representation) < MAXIMUM;
+    });
+    if(is_integral) {
+      write(0);
+      auto integers = std::vector<std::int64_t>();
+      integers.reserve(column.size());
+      for(auto value : column) {
+        integers.push_back(
+          static_cast<std::int64_t>(value.get_representation()));
+      }
+      write_deltas(integers);
+    } else {
+      write(1);
+      for(auto value : column) {
+        auto representation = value.get_representation();
+        auto bytes = std::array<char, sizeof(representation)>();
+        std::memcpy(bytes.data(), &representation, sizeof(representation));
+        m_buffer->append(bytes.data(), bytes.size());
+      }
+    }
+  }
+
+  inline void ColumnWriter::write_dictionary(
+      const std::vector<std::string_view>& column) {
+    auto dictionary = std::unordered_map<std::string_view, std::uint64_t>();
+    auto entries = std::vector<std::string_view>();
+    auto indices = std::vector<std::uint64_t>();
+    indices.reserve(column.size());
+    for(auto value : column) {
+      auto entry = dictionary.try_emplace(value, entries.size());
+      if(entry.second) {
+        entries.push_back(value);
+      }
+      indices.push_back(entry.first->second);
+    }
+    write_varint(entries.size());
+    for(auto entry : entries) {
+      write_string(entry);
+    }
+    if(entries.size() > 1) {
+      for(auto index : indices) {
+        write_varint(index);
+      }
+    }
+  }
+
+  inline ColumnReader::ColumnReader(const char* data, std::size_t size) noexcept
+    : m_data(data),
+      m_size(size),
+      m_position(0) {}
+
+  inline std::uint8_t ColumnReader::read() {
+    require(1);
+    return static_cast<std::uint8_t>(m_data[m_position++]);
+  }
+
+  inline std::uint64_t ColumnReader::read_varint() {
+    auto value = std::uint64_t(0);
+    for(auto shift = 0; shift < 64; shift += 7) {
+      auto byte = read();
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    boost::throw_with_location(
+      HistoricalDataStoreException("Invalid columnar integer."));
+  }
+
+  inline std::string ColumnReader::read_string() {
+    auto size = static_cast<std::size_t>(read_varint());
+    require(size);
+    auto value = std::string(m_data + m_position, size);
+    m_position += size;
+    return value;
+  }
+
+  inline std::vector<std::uint8_t> ColumnReader::read_bytes(std::size_t count) {
+    require(count);
+    auto column = std::vector<std::uint8_t>(count);
+    std::memcpy(column.data(), m_data + m_position, count);
+    m_position += count;
+    return column;
+  }
+
+  inline std::vector<std::int64_t> ColumnReader::read_deltas(
+      std::size_t count) {
+    auto column = std::vector<std::int64_t>();
+    column.reserve(count);
+    auto previous = std::uint64_t(0);
+    for(auto i = std::size_t(0); i != count; ++i) {
+      auto encoding = read_varint();
+      auto delta = (encoding >> 1) ^ (~(encoding & 1) + 1);
+      previous += delta;
+      column.push_back(static_cast<std::int64_t>(previous));
+    }
+    return column;
+  }
+
+  inline std::vector<Quantity> ColumnReader::read_quantities(
+      std::size_t count) {
+    auto column = std::vector<Quantity>();
+    column.reserve(count);
+    auto encoding = read();
+    if(encoding == 0) {
+      for(auto value : read_deltas(count)) {
+        column.push_back(
+          Quantity::from_representation(static_cast<boost::float64_t>(value)));
+      }
+    } else if(encoding == 1) {
+      auto representation = boost::float64_t();
+      require(count * sizeof(representation));
+      for(auto i = std::size_t(0); i != count; ++i) {
+        std::memcpy(
+          &representation, m_data + m_position, sizeof(representation));
+        m_position += sizeof(representation);
+        column.push_back(Quantity::from_representation(representation));
+      }
+    } else {
+      boost::throw_with_location(
+        HistoricalDataStoreException("Invalid quantity column."));
+    }
+    return column;
+  }
+
+  inline std::vector<std::string> ColumnReader::read_dictionary(
+      std::size_t count) {
+    auto entries = std::vector<std::string>();
+    auto size = static_cast<std::size_t>(read_varint());
+    for(auto i = std::size_t(0); i != size; ++i) {
+      entries.push_back(read_string());
+    }
+    auto column = std::vector<std::string>();
+    column.reserve(count);
+    if(entries.size() <= 1) {
+      if(entries.empty() && count != 0) {
+        boost::throw_with_location(
+          HistoricalDataStoreException("Invalid dictionary column."));
+      }
+      column.resize(count, entries.empty() ? std::string() : entries.front());
+      return column;
+    }
+    for(auto i = std::size_t(0); i != count; ++i) {
+      auto index = read_varint();
+      if(index >= entries.size()) {
+        boost::throw_with_location(
+          HistoricalDataStoreException("Invalid dictionary index."));
+      }
+      column.push_back(entries[index]);
+    }
+    return column;
+  }
+
+  inline std::size_t ColumnReader::get_position() const {
+    return m_position;
+  }
+
+  inline void ColumnReader::require(std::size_t size) const {
+    if(size > m_size - m_position) {
+      boost::throw_with_location(
+        HistoricalDataStoreException("Truncated columnar block."));
+    }
+  }
+
+  inline void ColumnarCodec<BboQuote>::encode(
+      std::span<const Beam::SequencedValue<BboQuote>> values,
+      ColumnWriter& writer) {
+    auto sides = std::vector<std::uint8_t>();
+    auto bid_prices = std::vector<Quantity>();
+    auto bid_sizes = std::vector<Quantity>();
+    auto ask_prices = std::vector<Quantity>();
+    auto ask_sizes = std::vector<Quantity>();
+    for(auto& value : values) {
+      sides.push_back(static_cast<std::uint8_t>(
+        static_cast<int>(value->m_bid.m_side) |
+          static_cast<int>(value->m_ask.m_side) << 4));
+      bid_prices.push_back(Quantity(value->m_bid.m_price));
+      bid_sizes.push_back(value->m_bid.m_size);
+      ask_prices.push_back(Quantity(value->m_ask.m_price));
+      ask_sizes.push_back(value->m_ask.m_size);
+    }
+    writer.write_bytes(sides);
+    writer.write_quantities(bid_prices);
+    writer.write_quantities(bid_sizes);
+    writer.write_quantities(ask_prices);
+    writer.write_quantities(ask_sizes);
+  }
+
+  inline void ColumnarCodec<BboQuote>::decode(
+      ColumnReader& reader, std::span<BboQuote> values) {
+    auto sides = reader.read_bytes(values.size());
+    auto bid_prices = reader.read_quantities(values.size());
+    auto bid_sizes = reader.read_quantities(values.size());
+    auto ask_prices = reader.read_quantities(values.size());
+    auto ask_sizes = reader.read_quantities(values.size());
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      auto& value = values[i];
+      value.m_bid.m_side = static_cast<Side::Type>(sides[i] & 0x0F);
+      value.m_bid.m_price = Money(bid_prices[i]);
+      value.m_bid.m_size = bid_sizes[i];
+      value.m_ask.m_side = static_cast<Side::Type>(sides[i] >> 4);
+      value.m_ask.m_price = Money(ask_prices[i]);
+      value.m_ask.m_size = ask_sizes[i];
+    }
+  }
+
+  inline void ColumnarCodec<BookQuote>::encode(
+      std::span<const Beam::SequencedValue<BookQuote>> values,
+      ColumnWriter& writer) {
+    auto mpids = std::vector<std::string_view>();
+    auto flags = std::vector<std::uint8_t>();
+    auto venues = std::vector<std::string_view>();
+    auto prices = std::vector<Quantity>();
+    auto sizes = std::vector<Quantity>();
+    for(auto& value : values) {
+      mpids.push_back(value->m_mpid);
+      flags.push_back(static_cast<std::uint8_t>(
+        static_cast<int>(value->m_quote.m_side) |
+          (value->m_is_primary_mpid ? 0x10 : 0)));
+      venues.push_back(value->m_venue.get_code().get_data());
+      prices.push_back(Quantity(value->m_quote.m_price));
+      sizes.push_back(value->m_quote.m_size);
+    }
+    writer.write_dictionary(mpids);
+    writer.write_bytes(flags);
+    writer.write_dictionary(venues);
+    writer.write_quantities(prices);
+    writer.write_quantities(sizes);
+  }
+
+  inline void ColumnarCodec<BookQuote>::decode(
+      ColumnReader& reader, std::span<BookQuote> values) {
+    auto mpids = reader.read_dictionary(values.size());
+    auto flags = reader.read_bytes(values.size());
+    auto venues = reader.read_dictionary(values.size());
+    auto prices = reader.read_quantities(values.size());
+    auto sizes = reader.read_quantities(values.size());
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      auto& value = values[i];
+      value.m_mpid = std::move(mpids[i]);
+      value.m_is_primary_mpid = (flags[i] & 0x10) != 0;
+      value.m_venue = Venue(std::move(venues[i]));
+      value.m_quote.m_side = static_cast<Side::Type>(flags[i] & 0x0F);
+      value.m_quote.m_price = Money(prices[i]);
+      value.m_quote.m_size = sizes[i];
+    }
+  }
+
+  inline void ColumnarCodec<TimeAndSale>::encode(
+      std::span<const Beam::SequencedValue<TimeAndSale>> values,
+      ColumnWriter& writer) {
+    auto prices = std::vector<Quantity>();
+    auto sizes = std::vector<Quantity>();
+    auto condition_types = std::vector<std::uint8_t>();
+    auto condition_codes = std::vector<std::string_view>();
+    auto market_centers = std::vector<std::string_view>();
+    auto buyer_mpids = std::vector<std::string_view>();
+    auto seller_mpids = std::vector<std::string_view>();
+    for(auto& value : values) {
+      prices.push_back(Quantity(value->m_price));
+      sizes.push_back(value->m_size);
+      condition_types.push_back(
+        static_cast<std::uint8_t>(static_cast<int>(value->m_condition.m_type)));
+      condition_codes.push_back(value->m_condition.m_code);
+      market_centers.push_back(value->m_market_center);
+      buyer_mpids.push_back(value->m_buyer_mpid);
+      seller_mpids.push_back(value->m_seller_mpid);
+    }
+    writer.write_quantities(prices);
+    writer.write_quantities(sizes);
+    writer.write_bytes(condition_types);
+    writer.write_dictionary(condition_codes);
+    writer.write_dictionary(market_centers);
+    writer.write_dictionary(buyer_mpids);
+    writer.write_dictionary(seller_mpids);
+  }
+
+  inline void ColumnarCodec<TimeAndSale>::decode(
+      ColumnReader& reader, std::span<TimeAndSale> values) {
+    auto prices = reader.read_quantities(values.size());
+    auto sizes = reader.read_quantities(values.size());
+    auto condition_types = reader.read_bytes(values.size());
+    auto condition_codes = reader.read_dictionary(values.size());
+    auto market_centers = reader.read_dictionary(values.size());
+    auto buyer_mpids = reader.read_dictionary(values.size());
+    auto seller_mpids = reader.read_dictionary(values.size());
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      auto& value = values[i];
+      value.m_price = Money(prices[i]);
+      value.m_size = sizes[i];
+      value.m_condition.m_type =
+        static_cast<TimeAndSale::Condition::Type::Type>(condition_types[i]);
+      value.m_condition.m_code = std::move(condition_codes[i]);
+      value.m_market_center = std::move(market_centers[i]);
+      value.m_buyer_mpid = std::move(buyer_mpids[i]);
+      value.m_seller_mpid = std::move(seller_mpids[i]);
+    }
+  }
+
+  inline void ColumnarCodec<TickerStatus>::encode(
+      std::span<const Beam::SequencedValue<TickerStatus>> values,
+      ColumnWriter& writer) {
+    auto venues = std::vector<std::string_view>();
+    auto states = std::vector<std::string_view>();
+    auto flags = std::vector<std::uint8_t>();
+    for(auto& value : values) {
+      venues.push_back(value->m_venue.get_code().get_data());
+      states.push_back(value->m_state);
+      flags.push_back(static_cast<std::uint8_t>(value->m_flags));
+    }
+    writer.write_dictionary(venues);
+    writer.write_dictionary(states);
+    writer.write_bytes(flags);
+  }
+
+  inline void ColumnarCodec<TickerStatus>::decode(
+      ColumnReader& reader, std::span<TickerStatus> values) {
+    auto venues = reader.read_dictionary(values.size());
+    auto states = reader.read_dictionary(values.size());
+    auto flags = reader.read_bytes(values.size());
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      auto& value = values[i];
+      value.m_venue = Venue(std::move(venues[i]));
+      value.m_state = std::move(states[i]);
+      value.m_flags = static_cast<TickerStatus::Flag>(flags[i]);
+    }
+  }
+
+  inline void ColumnarCodec<OrderImbalance>::encode(
+      std::span<const Beam::SequencedValue<OrderImbalance>> values,
+      ColumnWriter& writer) {
+    auto symbols = std::vector<std::string_view>();
+    auto venues = std::vector<std::string_view>();
+    auto sides = std::vector<std::uint8_t>();
+    auto sizes = std::vector<Quantity>();
+    auto reference_prices = std::vector<Quantity>();
+    for(auto& value : values) {
+      symbols.push_back(value->m_ticker.get_symbol());
+      venues.push_back(value->m_ticker.get_venue().get_code().get_data());
+      sides.push_back(
+        static_cast<std::uint8_t>(static_cast<int>(value->m_side)));
+      sizes.push_back(value->m_size);
+      reference_prices.push_back(Quantity(value->m_reference_price));
+    }
+    writer.write_dictionary(symbols);
+    writer.write_dictionary(venues);
+    writer.write_bytes(sides);
+    writer.write_quantities(sizes);
+    writer.write_quantities(reference_prices);
+  }
+
+  inline void ColumnarCodec<OrderImbalance>::decode(
+      ColumnReader& reader, std::span<OrderImbalance> values) {
+    auto symbols = reader.read_dictionary(values.size());
+    auto venues = reader.read_dictionary(values.size());
+    auto sides = reader.read_bytes(values.size());
+    auto sizes = reader.read_quantities(values.size());
+    auto reference_prices = reader.read_quantities(values.size());
+    for(auto i = std::size_t(0); i != values.size(); ++i) {
+      auto& value = values[i];
+      value.m_ticker =
+        Ticker(std::move(symbols[i]), Venue(std::move(venues[i])));
+      value.m_side = static_cast<Side::Type>(sides[i]);
+      value.m_size = sizes[i];
+      value.m_reference_price = Money(reference_prices[i]);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,727 @@
+#ifndef NEXUS_COLUMNAR_HISTORICAL_DATA_STORE_HPP
+#define NEXUS_COLUMNAR_HISTORICAL_DATA_STORE_HPP
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Beam/IO/OpenState.hpp>
+#include <Beam/Queries/Range.hpp>
+#include <Beam/Threading/Mutex.hpp>
+#include <boost/date_time/gregorian/gregorian.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/throw_exception.hpp>
+#include "Nexus/MarketDataService/ColumnarBlock.hpp"
+#include "Nexus/MarketDataService/HistoricalDataStore.hpp"
+#include "Nexus/MarketDataService/HistoricalDataStoreException.hpp"
+#include "Nexus/MarketDataService/LocalHistoricalDataStore.hpp"
+#include "Nexus/Queries/CompiledFilter.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores historical market data in per-index, per-day columnar files.
+   * Values are buffered in memory and appended to their file as a block once
+   * enough of them accumulate or the data store is flushed. Each block starts
+   * with a header summarizing its range of sequences and timestamps, so that
+   * queries only decode the blocks that overlap their range. Blocks are
+   * appended in sequence order, so a HEAD query decodes blocks from the
+   * start of each file and a TAIL query from its end, stopping once the
+   * snapshot limit is met. Files are read through memory mappings.
+   * Full blocks are handed off to be encoded and written outside of the lock
+   * guarding the buffers, so storing values doesn't wait on file I/O.
+   * TickerInfo is appended to a single file as it's stored, and the file is
+   * compacted when the data store is opened.
+   */
+  class ColumnarHistoricalDataStore {
+    public:
+
+      /** The default number of values stored in a single block. */
+      static constexpr auto DEFAULT_BLOCK_SIZE = std::size_t(4096);
+
+      /**
+       * Constructs a ColumnarHistoricalDataStore using the default block size.
+       * @param root The directory to store the files in.
+       */
+      explicit ColumnarHistoricalDataStore(std::filesystem::path root);
+
+      /**
+       * Constructs a ColumnarHistoricalDataStore.
+       * @param root The directory to store the files in.
+       * @param block_size The number of values to buffer per index and day
+       *        before writing them as a block.
+       */
+      ColumnarHistoricalDataStore(
+        std::filesystem::path root, std::size_t block_size);
+
+      ~ColumnarHistoricalDataStore();
+
+      /** Writes all buffered values to their files. */
+      void flush();
+
+      std::vector<TickerInfo> load_ticker_info(const TickerInfoQuery& query);
+      void store(const TickerInfo& info);
+      std::vector<SequencedOrderImbalance> load_order_imbalances(
+        const VenueQuery& query);
+      void store(const SequencedVenueOrderImbalance& imbalance);
+      void store(const std::vector<SequencedVenueOrderImbalance>& imbalances);
+      std::vector<SequencedBboQuote> load_bbo_quotes(const TickerQuery& query);
+      void store(const SequencedTickerBboQuote& quote);
+      void store(const std::vector<SequencedTickerBboQuote>& quotes);
+      std::vector<SequencedBookQuote> load_book_quotes(
+        const TickerQuery& query);
+      void store(const SequencedTickerBookQuote& quote);
+      void store(const std::vector<SequencedTickerBookQuote>& quotes);
+      std::vector<SequencedTimeAndSale> load_time_and_sales(
+        const TickerQuery& query);
+      void store(const SequencedTickerTimeAndSale& time_and_sale);
+      void store(const std::vector<SequencedTickerTimeAndSale>& time_and_sales);
+      std::vector<SequencedTickerStatus> load_ticker_statuses(
+        const TickerQuery& query);
+      void store(const SequencedIndexedTickerStatus& status);
+      void store(const std::vector<SequencedIndexedTickerStatus>& statuses);
+      void close();
+
+    private:
+      template<typename T, typename I>
+      struct Series {
+        using Value = T;
+        using Index = I;
+        using Buffers =
+          std::map<std::string, std::vector<Beam::SequencedValue<T>>>;
+        std::string m_name;
+        std::unordered_map<Index, Buffers> m_buffers;
+        std::unordered_map<Index, Buffers> m_pending;
+
+        explicit Series(std::string name);
+      };
+      std::filesystem::path m_root;
+      std::size_t m_block_size;
+      Beam::Mutex m_mutex;
+      Beam::Mutex m_write_mutex;
+      LocalHistoricalDataStore m_ticker_info;
+      Series<OrderImbalance, Venue> m_order_imbalances;
+      Series<BboQuote, Ticker> m_bbo_quotes;
+      Series<BookQuote, Ticker> m_book_quotes;
+      Series<TimeAndSale, Ticker> m_time_and_sales;
+      Series<TickerStatus, Ticker> m_ticker_statuses;
+      Beam::OpenState m_open_state;
+
+      ColumnarHistoricalDataStore(const ColumnarHistoricalDataStore&) = delete;
+      ColumnarHistoricalDataStore& operator =(
+        const ColumnarHistoricalDataStore&) = delete;
+      static std::string get_day(boost::posix_time::ptime timestamp);
+      static std::string escape(std::string_view name);
+      static bool is_in_range(const Beam::Range& range,
+        Beam::Sequence sequence, boost::posix_time::ptime timestamp);
+      static bool is_overlapping(
+        const Beam::Range& range, const ColumnarBlockHeader& header);
+      std::filesystem::path get_directory(
+        const std::string& name, const Ticker& ticker) const;
+      std::filesystem::path get_directory(
+        const std::string& name, const Venue& venue) const;
+      std::vector<TickerInfo> load_all_ticker_info();
+      template<typename S, typename V>
+      bool push(S& series, const V& value);
+      template<typename S, typename R>
+      void buffer(S& series, const R& values);
+      template<typename S>
+      void seal(S& series);
+      template<typename S>
+      void write(S& series);
+      template<typename T>
+      void append(const std::filesystem::path& path,
+        std::span<const Beam::SequencedValue<T>> values);
+      template<typename T, typename F>
+      static void read(const std::filesystem::path& path, std::uintmax_t size,
+        const Beam::Range& range, const F& is_match, bool is_head,
+        std::size_t limit, std::vector<Beam::SequencedValue<T>>& values);
+      template<typename S, typename Q>
+      std::vector<Beam::SequencedValue<typename S::Value>> load(
+        S& series, const Q& query);
+  };
+
+  template<typename T, typename I>
+  ColumnarHistoricalDataStore::Series<T, I>::Series(std::string name)
+    : m_name(std::move(name)) {}
+
+  inline ColumnarHistoricalDataStore::ColumnarHistoricalDataStore(
+    std::filesystem::path root)
+    : ColumnarHistoricalDataStore(std::move(root), DEFAULT_BLOCK_SIZE) {}
+
+  inline ColumnarHistoricalDataStore::ColumnarHistoricalDataStore(
+      std::filesystem::path root, std::size_t block_size)
+      : m_root(std::move(root)),
+        m_block_size(std::max<std::size_t>(block_size, 1)),
+        m_order_imbalances("order_imbalances"),
+        m_bbo_quotes("bbo_quotes"),
+        m_book_quotes("book_quotes"),
+        m_time_and_sales("time_and_sales"),
+        m_ticker_statuses("ticker_statuses") {
+    auto path = m_root / "ticker_info.col";
+    auto file = std::ifstream(path, std::ios::binary);
+    if(!file) {
+      return;
+    }
+    auto contents = std::string(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+    file.close();
+    auto entries =
+      decode_columnar_ticker_info(contents.data(), contents.size());
+    for(auto& info : entries) {
+      m_ticker_info.store(info);
+    }
+    auto ticker_info = load_all_ticker_info();
+    if(ticker_info.size() == entries.size()) {
+      return;
+    }
+    contents.clear();
+    encode_columnar_ticker_info(ticker_info, contents);
+    auto staging_path = m_root / "ticker_info.col.tmp";
+    try {
+      {
+        auto staging_file = std::ofstream(
+          staging_path, std::ios::binary | std::ios::trunc);
+        staging_file.write(contents.data(), contents.size());
+        if(!staging_file) {
+          boost::throw_with_location(HistoricalDataStoreException(
+            "Unable to write " + staging_path.string() + "."));
+        }
+      }
+      std::filesystem::rename(staging_path, path);
+    } catch(const std::filesystem::filesystem_error& e) {
+      boost::throw_with_location(HistoricalDataStoreException(e.what()));
+    }
+  }
+
+  inline ColumnarHistoricalDataStore::~ColumnarHistoricalDataStore() {
+    close();
+  }
+
+  inline void ColumnarHistoricalDataStore::flush() {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      seal(m_order_imbalances);
+      seal(m_bbo_quotes);
+      seal(m_book_quotes);
+      seal(m_time_and_sales);
+      seal(m_ticker_statuses);
+    }
+    auto lock = std::lock_guard(m_write_mutex);
+    write(m_order_imbalances);
+    write(m_bbo_quotes);
+    write(m_book_quotes);
+    write(m_time_and_sales);
+    write(m_ticker_statuses);
+  }
+
+  inline std::vector<TickerInfo> ColumnarHistoricalDataStore::load_ticker_info(
+      const TickerInfoQuery& query) {
+    return m_ticker_info.load_ticker_info(query);
+  }
+
+  inline void ColumnarHistoricalDataStore::store(const TickerInfo& info) {
+    auto lock = std::lock_guard(m_write_mutex);
+    m_ticker_info.store(info);
+    auto contents = std::string();
+    encode_columnar_ticker_info(std::vector{info}, contents);
+    auto path = m_root / "ticker_info.col";
+    try {
+      std::filesystem::create_directories(m_root);
+    } catch(const std::filesystem::filesystem_error& e) {
+      boost::throw_with_location(HistoricalDataStoreException(e.what()));
+    }
+    auto file = std::ofstream(path, std::ios::binary | std::ios::app);
+    file.write(contents.data(), contents.size());
+    if(!file) {
+      boost::throw_with_location(HistoricalDataStoreException(
+        "Unable to write " + path.string() + "."));
+    }
+  }
+
+  inline std::vector<SequencedOrderImbalance>
+      ColumnarHistoricalDataStore::load_order_imbalances(
+        const VenueQuery& query) {
+    return load(m_order_imbalances, query);
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const SequencedVenueOrderImbalance& imbalance) {
+    buffer(m_order_imbalances, std::span(&imbalance, 1));
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const std::vector<SequencedVenueOrderImbalance>& imbalances) {
+    buffer(m_order_imbalances, imbalances);
+  }
+
+  inline std::vector<SequencedBboQuote>
+      ColumnarHistoricalDataStore::load_bbo_quotes(const TickerQuery& query) {
+    return load(m_bbo_quotes, query);
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const SequencedTickerBboQuote& quote) {
+    buffer(m_bbo_quotes, std::span(&quote, 1));
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const std::vector<SequencedTickerBboQuote>& quotes) {
+    buffer(m_bbo_quotes, quotes);
+  }
+
+  inline std::vector<SequencedBookQuote>
+      ColumnarHistoricalDataStore::load_book_quotes(const TickerQuery& query) {
+    return load(m_book_quotes, query);
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const SequencedTickerBookQuote& quote) {
+    buffer(m_book_quotes, std::span(&quote, 1));
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const std::vector<SequencedTickerBookQuote>& quotes) {
+    buffer(m_book_quotes, quotes);
+  }
+
+  inline std::vector<SequencedTimeAndSale>
+      ColumnarHistoricalDataStore::load_time_and_sales(
+        const TickerQuery& query) {
+    return load(m_time_and_sales, query);
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const SequencedTickerTimeAndSale& time_and_sale) {
+    buffer(m_time_and_sales, std::span(&time_and_sale, 1));
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const std::vector<SequencedTickerTimeAndSale>& time_and_sales) {
+    buffer(m_time_and_sales, time_and_sales);
+  }
+
+  inline std::vector<SequencedTickerStatus>
+      ColumnarHistoricalDataStore::load_ticker_statuses(
+        const TickerQuery& query) {
+    return load(m_ticker_statuses, query);
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const SequencedIndexedTickerStatus& status) {
+    buffer(m_ticker_statuses, std::span(&status, 1));
+  }
+
+  inline void ColumnarHistoricalDataStore::store(
+      const std::vector<SequencedIndexedTickerStatus>& statuses) {
+    buffer(m_ticker_statuses, statuses);
+  }
+
+  inline void ColumnarHistoricalDataStore::close() {
+    if(m_open_state.set_closing()) {
+      return;
+    }
+    flush();
+    m_open_state.close();
+  }
+
+  inline std::string ColumnarHistoricalDataStore::get_day(
+      boost::posix_time::ptime timestamp) {
+    if(timestamp.is_special()) {
+      return "undated";
+    }
+    return boost::gregorian::to_iso_string(timestamp.date());
+  }
+
+  inline std::string ColumnarHistoricalDataStore::escape(
+      std::string_view name) {
+    static constexpr auto DIGITS = "0123456789ABCDEF";
+    auto escaped = std::string();
+    for(auto c : name) {
+      if(std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') {
+        escaped += c;
+      } else {
+        escaped += '%';
+        escaped += DIGITS[static_cast<unsigned char>(c) >> 4];
+        escaped += DIGITS[static_cast<unsigned char>(c) & 0x0F];
+      }
+    }
+    if(escaped.empty()) {
+      return "%";
+    }
+    return escaped;
+  }
+
+  inline bool ColumnarHistoricalDataStore::is_in_range(
+      const Beam::Range& range, Beam::Sequence sequence,
+      boost::posix_time::ptime timestamp) {
+    if(auto start = boost::get<boost::posix_time::ptime>(&range.get_start())) {
+      if(timestamp < *start) {
+        return false;
+      }
+    } else if(sequence < boost::get<Beam::Sequence>(range.get_start())) {
+      return false;
+    }
+    if(auto end = boost::get<boost::posix_time::ptime>(&range.get_end())) {
+      if(timestamp > *end) {
+        return false;
+      }
+    } else if(sequence > boost::get<Beam::Sequence>(range.get_end())) {
+      return false;
+    }
+    return true;
+  }
+
+  inline bool ColumnarHistoricalDataStore::is_overlapping(
+      const Beam::Range& range, const ColumnarBlockHeader& header) {
+    if(auto start = boost::get<boost::posix_time::ptime>(&range.get_start())) {
+      if(header.m_end_timestamp < to_columnar_timestamp(*start)) {
+        return false;
+      }
+    } else if(Beam::Sequence(header.m_last_sequence) <
+        boost::get<Beam::Sequence>(range.get_start())) {
+      return false;
+    }
+    if(auto end = boost::get<boost::posix_time::ptime>(&range.get_end())) {
+      if(header.m_start_timestamp > to_columnar_timestamp(*end)) {
+        return false;
+      }
+    } else if(Beam::Sequence(header.m_first_sequence) >
+        boost::get<Beam::Sequence>(range.get_end())) {
+      return false;
+    }
+    return true;
+  }
+
+  inline std::filesystem::path ColumnarHistoricalDataStore::get_directory(
+      const std::string& name, const Ticker& ticker) const {
+    return get_directory(name, ticker.get_venue()) /
+      escape(ticker.get_symbol());
+  }
+
+  inline std::filesystem::path ColumnarHistoricalDataStore::get_directory(
+      const std::string& name, const Venue& venue) const {
+    return m_root / name / escape(venue.get_code().get_data());
+  }
+
+  inline std::vector<TickerInfo>
+      ColumnarHistoricalDataStore::load_all_ticker_info() {
+    auto query = TickerInfoQuery();
+    query.set_index(Scope::GLOBAL);
+    query.set_snapshot_limit(Beam::SnapshotLimit::UNLIMITED);
+    return m_ticker_info.load_ticker_info(query);
+  }
+
+  template<typename S, typename V>
+  bool ColumnarHistoricalDataStore::push(S& series, const V& value) {
+    auto day = get_day((*value)->m_timestamp);
+    auto& values = series.m_buffers[value->get_index()][day];
+    values.push_back(Beam::SequencedValue(**value, value.get_sequence()));
+    if(values.size() < m_block_size) {
+      return false;
+    }
+    auto& pending = series.m_pending[value->get_index()][day];
+    pending.insert(pending.end(), std::make_move_iterator(values.begin()),
+      std::make_move_iterator(values.end()));
+    values.clear();
+    return true;
+  }
+
+  template<typename S, typename R>
+  void ColumnarHistoricalDataStore::buffer(S& series, const R& values) {
+    auto is_sealed = false;
+    {
+      auto lock = std::lock_guard(m_mutex);
+      for(auto& value : values) {
+        is_sealed |= push(series, value);
+      }
+    }
+    if(is_sealed) {
+      auto lock = std::lock_guard(m_write_mutex);
+      write(series);
+    }
+  }
+
+  template<typename S>
+  void ColumnarHistoricalDataStore::seal(S& series) {
+    for(auto& buffers : series.m_buffers) {
+      for(auto& buffer : buffers.second) {
+        if(!buffer.second.empty()) {
+          auto& pending = series.m_pending[buffers.first][buffer.first];
+          pending.insert(pending.end(),
+            std::make_move_iterator(buffer.second.begin()),
+            std::make_move_iterator(buffer.second.end()));
+        }
+      }
+    }
+    series.m_buffers.clear();
+  }
+
+  template<typename S>
+  void ColumnarHistoricalDataStore::write(S& series) {
+    auto pending = std::unordered_map<typename S::Index,
+      typename S::Buffers>();
+    {
+      auto lock = std::lock_guard(m_mutex);
+      pending.swap(series.m_pending);
+    }
+    try {
+      while(!pending.empty()) {
+        auto& buffers = *pending.begin();
+        auto directory = get_directory(series.m_name, buffers.first);
+        while(!buffers.second.empty()) {
+          auto& buffer = *buffers.second.begin();
+          append<typename S::Value>(
+            directory / (buffer.first + ".col"), buffer.second);
+          buffers.second.erase(buffers.second.begin());
+        }
+        pending.erase(pending.begin());
+      }
+    } catch(...) {
+      auto lock = std::lock_guard(m_mutex);
+      for(auto& buffers : pending) {
+        for(auto& buffer : buffers.second) {
+          auto& values = series.m_pending[buffers.first][buffer.first];
+          values.insert(values.begin(),
+            std::make_move_iterator(buffer.second.begin()),
+            std::make_move_iterator(buffer.second.end()));
+        }
+      }
+      throw;
+    }
+  }
+
+  template<typename T>
+  void ColumnarHistoricalDataStore::append(const std::filesystem::path& path,
+      std::span<const Beam::SequencedValue<T>> values) {
+    auto contents = std::string();
+    for(auto i = std::size_t(0); i < values.size(); i += m_block_size) {
+      encode_columnar_block<T>(values.subspan(
+        i, std::min(m_block_size, values.size() - i)), contents);
+    }
+    try {
+      std::filesystem::create_directories(path.parent_path());
+    } catch(const std::filesystem::filesystem_error& e) {
+      boost::throw_with_location(HistoricalDataStoreException(e.what()));
+    }
+    auto file = std::ofstream(path, std::ios::binary | std::ios::app);
+    file.write(contents.data(), contents.size());
+    if(!file) {
+      boost::throw_with_location(HistoricalDataStoreException(
+        "Unable to write " + path.string() + "."));
+    }
+  }
+
+  template<typename T, typename F>
+  void ColumnarHistoricalDataStore::read(const std::filesystem::path& path,
+      std::uintmax_t size, const Beam::Range& range, const F& is_match,
+      bool is_head, std::size_t limit,
+      std::vector<Beam::SequencedValue<T>>& values) {
+    if(size == 0 || values.size() >= limit) {
+      return;
+    }
+    try {
+      auto mapping = boost::interprocess::file_mapping(
+        path.string().c_str(), boost::interprocess::read_only);
+      auto region = boost::interprocess::mapped_region(
+        mapping, boost::interprocess::read_only, 0, size);
+      auto data = static_cast<const char*>(region.get_address());
+      auto decode = [&] (const ColumnarBlockHeader& header,
+          std::uintmax_t offset, std::vector<Beam::SequencedValue<T>>& block) {
+        auto first = block.size();
+        decode_columnar_block(header, data + offset, block);
+        block.erase(std::remove_if(block.begin() + first, block.end(),
+          [&] (const auto& value) {
+            return !is_match(value);
+          }), block.end());
+      };
+      auto tail_blocks =
+        std::vector<std::pair<ColumnarBlockHeader, std::uintmax_t>>();
+      auto offset = std::uintmax_t(0);
+      while(offset != size) {
+        auto header = ColumnarBlockHeader();
+        if(size - offset < sizeof(header)) {
+          boost::throw_with_location(HistoricalDataStoreException(
+            "Truncated block in " + path.string() + "."));
+        }
+        std::memcpy(&header, data + offset, sizeof(header));
+        offset += sizeof(header);
+        if(header.m_magic != ColumnarBlockHeader::MAGIC ||
+            header.m_size > size - offset) {
+          boost::throw_with_location(HistoricalDataStoreException(
+            "Invalid block in " + path.string() + "."));
+        }
+        if(is_overlapping(range, header)) {
+          if(is_head) {
+            decode(header, offset, values);
+            if(values.size() >= limit) {
+              return;
+            }
+          } else {
+            tail_blocks.emplace_back(header, offset);
+          }
+        }
+        offset += header.m_size;
+      }
+      auto partitions = std::vector<std::vector<Beam::SequencedValue<T>>>();
+      auto count = values.size();
+      for(auto i = tail_blocks.rbegin();
+          i != tail_blocks.rend() && count < limit; ++i) {
+        auto& block = partitions.emplace_back();
+        decode(i->first, i->second, block);
+        count += block.size();
+      }
+      if(partitions.empty()) {
+        return;
+      }
+      auto matches = std::vector<Beam::SequencedValue<T>>();
+      matches.reserve(count);
+      for(auto i = partitions.rbegin(); i != partitions.rend(); ++i) {
+        matches.insert(matches.end(), std::make_move_iterator(i->begin()),
+          std::make_move_iterator(i->end()));
+      }
+      matches.insert(matches.end(), std::make_move_iterator(values.begin()),
+        std::make_move_iterator(values.end()));
+      values = std::move(matches);
+    } catch(const boost::interprocess::interprocess_exception& e) {
+      boost::throw_with_location(HistoricalDataStoreException(e.what()));
+    }
+  }
+
+  template<typename S, typename Q>
+  std::vector<Beam::SequencedValue<typename S::Value>>
+      ColumnarHistoricalDataStore::load(S& series, const Q& query) {
+    using Value = Beam::SequencedValue<typename S::Value>;
+    auto& range = query.get_range();
+    auto size = static_cast<std::size_t>(
+      std::max(0, query.get_snapshot_limit().get_size()));
+    if(size == 0) {
+      return {};
+    }
+    auto is_head = query.get_snapshot_limit().get_type() ==
+      Beam::SnapshotLimit::Type::HEAD;
+    auto filter = QueryFilter<typename S::Value>(query.get_filter());
+    auto directory = get_directory(series.m_name, query.get_index());
+    auto days = std::set<std::string>();
+    auto is_listed = [&] (const std::string& day) {
+      if(day == "undated") {
+        return true;
+      }
+      if(auto start = boost::get<boost::posix_time::ptime>(
+          &range.get_start()); start && !start->is_special() &&
+            day < get_day(*start)) {
+        return false;
+      }
+      if(auto end = boost::get<boost::posix_time::ptime>(&range.get_end());
+          end && !end->is_special() && day > get_day(*end)) {
+        return false;
+      }
+      return true;
+    };
+    {
+      auto write_lock = std::lock_guard(m_write_mutex);
+      auto error = std::error_code();
+      for(auto& entry :
+          std::filesystem::directory_iterator(directory, error)) {
+        if(entry.path().extension() == ".col") {
+          days.insert(entry.path().stem().string());
+        }
+      }
+      auto lock = std::lock_guard(m_mutex);
+      for(auto buffers : {&series.m_pending, &series.m_buffers}) {
+        auto i = buffers->find(query.get_index());
+        if(i != buffers->end()) {
+          for(auto& buffer : i->second) {
+            days.insert(buffer.first);
+          }
+        }
+      }
+    }
+    std::erase_if(days, [&] (const auto& day) {
+      return !is_listed(day);
+    });
+    auto ordered_days = std::vector<std::string>(days.begin(), days.end());
+    if(!is_head) {
+      std::reverse(ordered_days.begin(), ordered_days.end());
+    }
+    auto is_match = [&] (const Value& value) {
+      return is_in_range(range, value.get_sequence(), value->m_timestamp) &&
+        filter(*value);
+    };
+    auto partitions = std::vector<std::vector<Value>>();
+    auto count = std::size_t(0);
+    for(auto& day : ordered_days) {
+      auto path = directory / (day + ".col");
+      auto buffered = std::vector<Value>();
+      auto file_size = [&] {
+        auto write_lock = std::lock_guard(m_write_mutex);
+        auto error = std::error_code();
+        auto file_size = std::filesystem::file_size(path, error);
+        if(error) {
+          file_size = 0;
+        }
+        auto lock = std::lock_guard(m_mutex);
+        for(auto buffers : {&series.m_pending, &series.m_buffers}) {
+          auto i = buffers->find(query.get_index());
+          if(i != buffers->end()) {
+            auto buffer = i->second.find(day);
+            if(buffer != i->second.end()) {
+              buffered.insert(buffered.end(), buffer->second.begin(),
+                buffer->second.end());
+            }
+          }
+        }
+        return file_size;
+      }();
+      std::erase_if(buffered, [&] (const auto& value) {
+        return !is_match(value);
+      });
+      auto limit = size - count;
+      auto values = std::vector<Value>();
+      if(is_head) {
+        read(path, file_size, range, is_match, true, limit, values);
+        if(values.size() < limit) {
+          values.insert(values.end(), std::make_move_iterator(
+            buffered.begin()), std::make_move_iterator(buffered.end()));
+        }
+      } else {
+        values = std::move(buffered);
+        read(path, file_size, range, is_match, false, limit, values);
+      }
+      count += values.size();
+      partitions.push_back(std::move(values));
+      if(count >= size) {
+        break;
+      }
+    }
+    if(!is_head) {
+      std::reverse(partitions.begin(), partitions.end());
+    }
+    auto matches = std::vector<Value>();
+    matches.reserve(count);
+    for(auto& partition : partitions) {
+      matches.insert(matches.end(), std::make_move_iterator(partition.begin()),
+        std::make_move_iterator(partition.end()));
+    }
+    if(matches.size() > size) {
+      if(is_head) {
+        matches.erase(matches.begin() + size, matches.end());
+      } else {
+        matches.erase(matches.begin(), matches.end() - size);
+      }
+    }
+    return matches;
+  }
+}
+
+#endif
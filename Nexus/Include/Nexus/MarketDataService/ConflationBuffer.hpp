@@ -0,0 +1,180 @@
+#ifndef NEXUS_MARKET_DATA_CONFLATION_BUFFER_HPP
+#define NEXUS_MARKET_DATA_CONFLATION_BUFFER_HPP
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <Beam/Threading/Mutex.hpp>
+#include <boost/functional/hash.hpp>
+#include "Nexus/MarketDataService/ConflationStatistics.hpp"
+#include "Nexus/MarketDataService/TickerQuery.hpp"
+
+namespace Nexus {
+
+  /**
+   * Collapses a session's BboQuote and BookQuote updates to their latest value
+   * until they are flushed.
+   */
+  class ConflationBuffer {
+    public:
+
+      /** Stores the updates pending delivery. */
+      struct Updates {
+
+        /** The latest BboQuote of every Ticker updated, in sequence order. */
+        std::vector<SequencedTickerBboQuote> m_bbo_quotes;
+
+        /** The latest BookQuote of every listing updated, in sequence order. */
+        std::vector<SequencedTickerBookQuote> m_book_quotes;
+      };
+
+      /** Constructs a disabled ConflationBuffer. */
+      ConflationBuffer() noexcept;
+
+      /** Returns <code>true</code> iff updates are being conflated. */
+      bool is_enabled() const;
+
+      /** Returns the window and the number of updates dropped so far. */
+      ConflationStatistics get_statistics() const;
+
+      /**
+       * Sets the conflation window.
+       * @param window The window over which updates are conflated, or zero to
+       *        deliver every update.
+       */
+      void set_window(boost::posix_time::time_duration window);
+
+      /**
+       * Buffers a BboQuote if updates are being conflated, superseding any
+       * pending BboQuote for its Ticker.
+       * @param quote The BboQuote to buffer.
+       * @return <code>true</code> iff the BboQuote was buffered, otherwise it
+       *         must be delivered directly.
+       */
+      bool push(const SequencedTickerBboQuote& quote);
+
+      /**
+       * Buffers a BookQuote if updates are being conflated, superseding any
+       * pending BookQuote for the same listing.
+       * @param quote The BookQuote to buffer.
+       * @return <code>true</code> iff the BookQuote was buffered, otherwise it
+       *         must be delivered directly.
+       */
+      bool push(const SequencedTickerBookQuote& quote);
+
+      /** Removes and returns all pending updates. */
+      Updates flush();
+
+    private:
+      struct BookQuoteKey {
+        Ticker m_ticker;
+        Side m_side;
+        Money m_price;
+        std::string m_mpid;
+
+        bool operator ==(const BookQuoteKey&) const = default;
+      };
+      struct BookQuoteKeyHash {
+        std::size_t operator ()(const BookQuoteKey& key) const;
+      };
+      mutable Beam::Mutex m_mutex;
+      std::atomic_bool m_is_enabled;
+      ConflationStatistics m_statistics;
+      std::unordered_map<Ticker, SequencedTickerBboQuote> m_bbo_quotes;
+      std::unordered_map<BookQuoteKey, SequencedTickerBookQuote,
+        BookQuoteKeyHash> m_book_quotes;
+
+      ConflationBuffer(const ConflationBuffer&) = delete;
+      ConflationBuffer& operator =(const ConflationBuffer&) = delete;
+  };
+
+  inline std::size_t ConflationBuffer::BookQuoteKeyHash::operator ()(
+      const BookQuoteKey& key) const {
+    auto seed = std::size_t(0);
+    boost::hash_combine(seed, key.m_ticker);
+    boost::hash_combine(seed, key.m_side);
+    boost::hash_combine(seed, key.m_price);
+    boost::hash_combine(seed, key.m_mpid);
+    return seed;
+  }
+
+  inline ConflationBuffer::ConflationBuffer() noexcept
+    : m_is_enabled(false) {}
+
+  inline bool ConflationBuffer::is_enabled() const {
+    return m_is_enabled.load(std::memory_order_acquire);
+  }
+
+  inline ConflationStatistics ConflationBuffer::get_statistics() const {
+    auto lock = std::lock_guard(m_mutex);
+    return m_statistics;
+  }
+
+  inline void ConflationBuffer::set_window(
+      boost::posix_time::time_duration window) {
+    auto lock = std::lock_guard(m_mutex);
+    if(window < boost::posix_time::time_duration()) {
+      window = boost::posix_time::time_duration();
+    }
+    m_statistics.m_window = window;
+    m_is_enabled.store(window != boost::posix_time::time_duration(),
+      std::memory_order_release);
+  }
+
+  inline bool ConflationBuffer::push(const SequencedTickerBboQuote& quote) {
+    auto lock = std::lock_guard(m_mutex);
+    if(!is_enabled()) {
+      return false;
+    }
+    auto [i, is_inserted] = m_bbo_quotes.try_emplace(quote->get_index(), quote);
+    if(!is_inserted) {
+      i->second = quote;
+      ++m_statistics.m_dropped_bbo_quote_count;
+    }
+    return true;
+  }
+
+  inline bool ConflationBuffer::push(const SequencedTickerBookQuote& quote) {
+    auto key = BookQuoteKey(quote->get_index(), (*quote)->m_quote.m_side,
+      (*quote)->m_quote.m_price, (*quote)->m_mpid);
+    auto lock = std::lock_guard(m_mutex);
+    if(!is_enabled()) {
+      return false;
+    }
+    auto [i, is_inserted] = m_book_quotes.try_emplace(std::move(key), quote);
+    if(!is_inserted) {
+      i->second = quote;
+      ++m_statistics.m_dropped_book_quote_count;
+    }
+    return true;
+  }
+
+  inline ConflationBuffer::Updates ConflationBuffer::flush() {
+    auto bbo_quotes = std::unordered_map<Ticker, SequencedTickerBboQuote>();
+    auto book_quotes = std::unordered_map<
+      BookQuoteKey, SequencedTickerBookQuote, BookQuoteKeyHash>();
+    {
+      auto lock = std::lock_guard(m_mutex);
+      bbo_quotes.swap(m_bbo_quotes);
+      book_quotes.swap(m_book_quotes);
+    }
+    auto updates = Updates();
+    updates.m_bbo_quotes.reserve(bbo_quotes.size());
+    for(auto& quote : bbo_quotes) {
+      updates.m_bbo_quotes.push_back(std::move(quote.second));
+    }
+    updates.m_book_quotes.reserve(book_quotes.size());
+    for(auto& quote : book_quotes) {
+      updates.m_book_quotes.push_back(std::move(quote.second));
+    }
+    auto sequence_comparator = [] (const auto& lhs, const auto& rhs) {
+      return lhs.get_sequence() < rhs.get_sequence();
+    };
+    std::ranges::sort(updates.m_bbo_quotes, sequence_comparator);
+    std::ranges::sort(updates.m_book_quotes, sequence_comparator);
+    return updates;
+  }
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef NEXUS_MARKET_DATA_CONFLATION_STATISTICS_HPP
+#define NEXUS_MARKET_DATA_CONFLATION_STATISTICS_HPP
+#include <cstdint>
+#include <ostream>
+#include <Beam/Serialization/DataShuttle.hpp>
+#include <Beam/Serialization/ShuttleDateTime.hpp>
+#include <boost/date_time/posix_time/posix_time_duration.hpp>
+
+namespace Nexus {
+
+  /** Stores the state of a session's market data conflation. */
+  struct ConflationStatistics {
+
+    /**
+     * The window over which BboQuote and BookQuote updates are conflated, or
+     * zero if every update is delivered.
+     */
+    boost::posix_time::time_duration m_window;
+
+    /** The number of BboQuote updates superseded before being delivered. */
+    std::uint64_t m_dropped_bbo_quote_count = 0;
+
+    /** The number of BookQuote updates superseded before being delivered. */
+    std::uint64_t m_dropped_book_quote_count = 0;
+
+    bool operator ==(const ConflationStatistics&) const = default;
+  };
+
+  inline std::ostream& operator <<(
+      std::ostream& out, const ConflationStatistics& statistics) {
+    return out << '(' << statistics.m_window << ' ' <<
+      statistics.m_dropped_bbo_quote_count << ' ' <<
+      statistics.m_dropped_book_quote_count << ')';
+  }
+}
+
+namespace Beam {
+  template<>
+  struct Shuttle<Nexus::ConflationStatistics> {
+    template<IsShuttle S>
+    void operator ()(S& shuttle, Nexus::ConflationStatistics& value,
+        unsigned int version) const {
+      shuttle.shuttle("window", value.m_window);
+      shuttle.shuttle(
+        "dropped_bbo_quote_count", value.m_dropped_bbo_quote_count);
+      shuttle.shuttle(
+        "dropped_book_quote_count", value.m_dropped_book_quote_count);
+    }
+  };
+}
+
+#endif
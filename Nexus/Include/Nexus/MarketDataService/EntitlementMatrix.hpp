@@ -0,0 +1,175 @@
+#ifndef NEXUS_MARKET_DATA_ENTITLEMENT_MATRIX_HPP
+#define NEXUS_MARKET_DATA_ENTITLEMENT_MATRIX_HPP
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include "Nexus/MarketDataService/EntitlementDatabase.hpp"
+#include "Nexus/MarketDataService/EntitlementSet.hpp"
+
+namespace Nexus {
+
+  /**
+   * Assigns each venue named by an EntitlementDatabase a dense index, so that
+   * an EntitlementKey maps to a single cell of an EntitlementMatrix. Index 0
+   * is reserved for venues the database does not name.
+   */
+  class EntitlementIndex {
+    public:
+
+      /** Constructs an EntitlementIndex naming no venues. */
+      EntitlementIndex();
+
+      /**
+       * Constructs an EntitlementIndex over the venues named by a database.
+       * @param database The EntitlementDatabase whose venues are indexed.
+       */
+      explicit EntitlementIndex(const EntitlementDatabase& database);
+
+      /** Returns the number of venue indices, including the reserved one. */
+      int get_size() const;
+
+      /**
+       * Returns a venue's index.
+       * @param venue The venue to look up.
+       * @return The <i>venue</i>'s index, or 0 if the venue is not indexed.
+       */
+      int get_index(Venue venue) const;
+
+      /**
+       * Returns the venue at an index.
+       * @param index The index to look up.
+       * @return The venue at the <i>index</i>, or an empty venue for index 0.
+       */
+      Venue get_venue(int index) const;
+
+      /**
+       * Returns the cell of an EntitlementMatrix storing a key.
+       * @param key The EntitlementKey to look up.
+       * @return The cell storing the <i>key</i>.
+       */
+      int get_cell(const EntitlementKey& key) const;
+
+    private:
+      std::vector<Venue> m_venues;
+  };
+
+  /**
+   * Stores the entitlements of a session as a dense matrix of
+   * MarketDataTypeSets, indexed by venue and source through an
+   * EntitlementIndex. Sessions granted the same entitlements can share a
+   * single matrix.
+   */
+  class EntitlementMatrix {
+    public:
+
+      /** Constructs an EntitlementMatrix granting nothing. */
+      EntitlementMatrix() = default;
+
+      /**
+       * Constructs an EntitlementMatrix from an EntitlementSet.
+       * @param index The EntitlementIndex used to address cells.
+       * @param entitlements The entitlements to store.
+       */
+      EntitlementMatrix(
+        const EntitlementIndex& index, const EntitlementSet& entitlements);
+
+      /**
+       * Checks if a cell is entitled to a market data message.
+       * @param cell The cell to check, as returned by an EntitlementIndex.
+       * @param type The type of market data message to check.
+       * @return <code>true</code> iff the <i>cell</i> is entitled to the
+       *         <i>type</i>.
+       */
+      bool contains(int cell, MarketDataType type) const;
+
+      /** Returns the entitled MarketDataTypeSet of every cell. */
+      const std::vector<MarketDataTypeSet>& get_cells() const;
+
+      bool operator ==(const EntitlementMatrix&) const = default;
+
+    private:
+      std::vector<MarketDataTypeSet> m_cells;
+  };
+
+  inline EntitlementIndex::EntitlementIndex()
+    : m_venues(1) {}
+
+  inline EntitlementIndex::EntitlementIndex(
+      const EntitlementDatabase& database) {
+    for(auto& entry : database.get_entries()) {
+      for(auto& applicability : entry.m_applicability) {
+        m_venues.push_back(applicability.first.m_venue);
+        m_venues.push_back(applicability.first.m_source);
+      }
+    }
+    std::sort(m_venues.begin(), m_venues.end());
+    m_venues.erase(
+      std::unique(m_venues.begin(), m_venues.end()), m_venues.end());
+    m_venues.insert(m_venues.begin(), Venue());
+  }
+
+  inline int EntitlementIndex::get_size() const {
+    return static_cast<int>(m_venues.size());
+  }
+
+  inline int EntitlementIndex::get_index(Venue venue) const {
+    auto i = std::lower_bound(m_venues.begin() + 1, m_venues.end(), venue);
+    if(i == m_venues.end() || *i != venue) {
+      return 0;
+    }
+    return static_cast<int>(i - m_venues.begin());
+  }
+
+  inline Venue EntitlementIndex::get_venue(int index) const {
+    return m_venues[index];
+  }
+
+  inline int EntitlementIndex::get_cell(const EntitlementKey& key) const {
+    return get_size() * get_index(key.m_venue) + get_index(key.m_source);
+  }
+
+  inline EntitlementMatrix::EntitlementMatrix(
+      const EntitlementIndex& index, const EntitlementSet& entitlements)
+      : m_cells(index.get_size() * index.get_size()) {
+    for(auto venue = 0; venue != index.get_size(); ++venue) {
+      for(auto source = 1; source != index.get_size(); ++source) {
+        m_cells[index.get_size() * venue + source] = entitlements.find(
+          EntitlementKey(index.get_venue(venue), index.get_venue(source)));
+      }
+    }
+  }
+
+  inline bool EntitlementMatrix::contains(int cell, MarketDataType type) const {
+    if(cell >= static_cast<int>(m_cells.size())) {
+      return false;
+    }
+    return m_cells[cell].test(type);
+  }
+
+  inline const std::vector<MarketDataTypeSet>&
+      EntitlementMatrix::get_cells() const {
+    return m_cells;
+  }
+
+  inline std::size_t hash_value(const EntitlementMatrix& matrix) {
+    auto seed = std::size_t(0);
+    for(auto& cell : matrix.get_cells()) {
+      boost::hash_combine(seed, cell.get_bitset().to_ulong());
+    }
+    return seed;
+  }
+}
+
+namespace std {
+  template<>
+  struct hash<Nexus::EntitlementMatrix> {
+    std::size_t operator ()(
+        const Nexus::EntitlementMatrix& value) const noexcept {
+      return Nexus::hash_value(value);
+    }
+  };
+}
+
+#endif
@@ -86,6 +86,14 @@ namespace Nexus {
        */
       bool contains(const EntitlementKey& key, MarketDataType type) const;
 
+      /**
+       * Returns the types of market data this session is entitled to on a
+       * key.
+       * @param key The EntitlementKey to look up.
+       * @return The set of market data types entitled on the <i>key</i>.
+       */
+      MarketDataTypeSet find(const EntitlementKey& key) const;
+
       /**
        * Grants an entitlement to this session.
        * @param key The EntitlementKey to grant to this session.
@@ -129,14 +137,19 @@ namespace Nexus {
 
   inline bool EntitlementSet::contains(
       const EntitlementKey& key, MarketDataType type) const {
+    return find(key).test(type);
+  }
+
+  inline MarketDataTypeSet EntitlementSet::find(
+      const EntitlementKey& key) const {
     auto i = m_entitlements.find(key);
     if(i == m_entitlements.end()) {
       i = m_entitlements.find(EntitlementKey(Venue(), key.m_source));
       if(i == m_entitlements.end()) {
-        return false;
+        return MarketDataTypeSet();
       }
     }
-    return i->second.test(type);
+    return i->second;
   }
 
   inline void EntitlementSet::grant(
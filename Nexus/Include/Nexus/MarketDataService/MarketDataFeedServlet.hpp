@@ -1,10 +1,17 @@
 #ifndef NEXUS_MARKET_DATA_FEED_SERVLET_HPP
 #define NEXUS_MARKET_DATA_FEED_SERVLET_HPP
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include <Beam/IO/OpenState.hpp>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
+#include <Beam/Queues/RoutineTaskQueue.hpp>
+#include <Beam/Routines/Async.hpp>
 #include <Beam/Services/ServiceProtocolServlet.hpp>
+#include <Beam/Threading/Mutex.hpp>
 #include <Beam/Utilities/ReportException.hpp>
 #include <Beam/Utilities/VariantLambdaVisitor.hpp>
 #include "Nexus/MarketDataService/MarketDataFeedServices.hpp"
@@ -35,6 +42,19 @@ namespace Nexus {
       template<Beam::Initializes<R> RF>
       explicit MarketDataFeedServlet(RF&& registry);
 
+      /**
+       * Constructs a MarketDataFeedServlet that publishes on a set of
+       * dedicated workers. Messages are assigned to workers by hashing their
+       * index so that each index is always published in order, while messages
+       * for different indices are published in parallel.
+       * @param registry The registry storing all market data originating from
+       *        this servlet.
+       * @param worker_count The number of dedicated workers, or 0 to publish
+       *        directly from the receiving routine.
+       */
+      template<Beam::Initializes<R> RF>
+      MarketDataFeedServlet(RF&& registry, int worker_count);
+
       void register_services(
         Beam::Out<Beam::ServiceSlots<ServiceProtocolClient>> slots);
       void handle_accept(ServiceProtocolClient& client);
@@ -44,10 +64,17 @@ namespace Nexus {
     private:
       Beam::local_ptr_t<R> m_registry;
       std::atomic_int m_next_source_id;
+      Beam::Mutex m_workers_mutex;
+      std::vector<std::unique_ptr<Beam::RoutineTaskQueue>> m_workers;
       Beam::OpenState m_open_state;
 
       MarketDataFeedServlet(const MarketDataFeedServlet&) = delete;
       MarketDataFeedServlet& operator =(const MarketDataFeedServlet&) = delete;
+      template<typename T>
+      void publish(const T& data, int source_id);
+      void publish(
+        const std::vector<MarketDataFeedMessage>& messages, int source_id);
+      void flush_workers();
       void on_set_ticker_info_message(
         ServiceProtocolClient& client, const TickerInfo& info);
       void on_send_market_data_feed_messages(ServiceProtocolClient& client,
@@ -74,8 +101,18 @@ namespace Nexus {
   template<typename C, typename R>
   template<Beam::Initializes<R> RF>
   MarketDataFeedServlet<C, R>::MarketDataFeedServlet(RF&& registry)
-    : m_registry(std::forward<RF>(registry)),
-      m_next_source_id(0) {}
+    : MarketDataFeedServlet(std::forward<RF>(registry), 0) {}
+
+  template<typename C, typename R>
+  template<Beam::Initializes<R> RF>
+  MarketDataFeedServlet<C, R>::MarketDataFeedServlet(
+      RF&& registry, int worker_count)
+      : m_registry(std::forward<RF>(registry)),
+        m_next_source_id(0) {
+    for(auto i = 0; i < worker_count; ++i) {
+      m_workers.push_back(std::make_unique<Beam::RoutineTaskQueue>());
+    }
+  }
 
   template<typename C, typename R>
   void MarketDataFeedServlet<C, R>::register_services(Beam::Out<
@@ -99,11 +136,24 @@ namespace Nexus {
   void MarketDataFeedServlet<C, R>::handle_close(
       ServiceProtocolClient& client) {
     auto& session = client.get_session();
+    flush_workers();
     m_registry->clear(session.m_source_id);
   }
 
   template<typename C, typename R>
   void MarketDataFeedServlet<C, R>::close() {
+    if(m_open_state.set_closing()) {
+      return;
+    }
+    {
+      auto lock = std::lock_guard(m_workers_mutex);
+      for(auto& worker : m_workers) {
+        worker->close();
+      }
+    }
+    for(auto& worker : m_workers) {
+      worker->wait();
+    }
     m_open_state.close();
   }
 
@@ -118,16 +168,72 @@ namespace Nexus {
       ServiceProtocolClient& client,
       const std::vector<MarketDataFeedMessage>& messages) {
     auto source_id = client.get_session().m_source_id;
+    if(m_workers.empty()) {
+      publish(messages, source_id);
+      return;
+    }
+    auto batches =
+      std::vector<std::vector<MarketDataFeedMessage>>(m_workers.size());
     for(auto& message : messages) {
-      try {
+      auto worker = boost::apply_visitor([&] (const auto& data) {
+        using Index = std::decay_t<decltype(data.get_index())>;
+        return std::hash<Index>()(data.get_index()) % m_workers.size();
+      }, message);
+      batches[worker].push_back(message);
+    }
+    for(auto i = std::size_t(0); i != batches.size(); ++i) {
+      if(batches[i].empty()) {
+        continue;
+      }
+      m_workers[i]->push([=, this, batch = std::move(batches[i])] {
+        publish(batch, source_id);
+      });
+    }
+  }
+
+  template<typename C, typename R>
+  template<typename T>
+  void MarketDataFeedServlet<C, R>::publish(const T& data, int source_id) {
+    try {
+      m_registry->publish(data, source_id);
+    } catch(const std::exception&) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+  }
+
+  template<typename C, typename R>
+  void MarketDataFeedServlet<C, R>::publish(
+      const std::vector<MarketDataFeedMessage>& messages, int source_id) {
+    if constexpr(requires { m_registry->publish(messages, source_id); }) {
+      publish<std::vector<MarketDataFeedMessage>>(messages, source_id);
+    } else {
+      for(auto& message : messages) {
         boost::apply_visitor([&] (const auto& data) {
-          m_registry->publish(data, source_id);
+          publish(data, source_id);
         }, message);
-      } catch(const std::exception&) {
-        std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
       }
     }
   }
+
+  template<typename C, typename R>
+  void MarketDataFeedServlet<C, R>::flush_workers() {
+    {
+      auto lock = std::lock_guard(m_workers_mutex);
+      if(m_open_state.is_open()) {
+        for(auto& worker : m_workers) {
+          auto flush = Beam::Async<void>();
+          worker->push([&] {
+            flush.get_eval().set();
+          });
+          flush.get();
+        }
+        return;
+      }
+    }
+    for(auto& worker : m_workers) {
+      worker->wait();
+    }
+  }
 }
 
 #endif
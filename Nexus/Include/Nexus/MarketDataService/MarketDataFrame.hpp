@@ -0,0 +1,145 @@
+#ifndef NEXUS_MARKET_DATA_FRAME_HPP
+#define NEXUS_MARKET_DATA_FRAME_HPP
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Beam/Pointers/Ref.hpp>
+#include <Beam/Queries/IndexedValue.hpp>
+#include <Beam/Queries/SequencedValue.hpp>
+#include <Beam/Serialization/DataShuttle.hpp>
+#include <Beam/Serialization/SerializationException.hpp>
+#include <Beam/Utilities/Expect.hpp>
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/MarketDataService/ColumnarBlock.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores a batch of Ticker indexed market data sent to a client in a single
+   * frame. The batch is encoded using the columnar block format, so that
+   * the Tickers and the string fields of each value, such as MPIDs, market
+   * centers and condition codes, are sent once per frame as a dictionary
+   * followed by each value's index into it.
+   * @param <T> The type of market data stored.
+   */
+  template<typename T>
+  class MarketDataFrame {
+    public:
+
+      /** The type of market data stored. */
+      using Value = T;
+
+      /** The type of each value sent in the frame. */
+      using SequencedValue =
+        Beam::SequencedValue<Beam::IndexedValue<Value, Ticker>>;
+
+      /** Constructs an empty MarketDataFrame. */
+      MarketDataFrame() = default;
+
+      /**
+       * Constructs a MarketDataFrame.
+       * @param values The values to send, in sequence order.
+       */
+      explicit MarketDataFrame(const std::vector<SequencedValue>& values);
+
+      /** Returns <code>true</code> iff the frame stores no values. */
+      bool is_empty() const;
+
+      /** Returns the size of the encoded frame in bytes. */
+      std::size_t get_size() const;
+
+      /** Decodes the values stored in the frame. */
+      std::vector<SequencedValue> decode() const;
+
+      bool operator ==(const MarketDataFrame&) const = default;
+
+    private:
+      friend struct Beam::Shuttle<MarketDataFrame>;
+      std::string m_data;
+  };
+
+  template<typename T>
+  MarketDataFrame<T>::MarketDataFrame(
+      const std::vector<SequencedValue>& values) {
+    if(values.empty()) {
+      return;
+    }
+    auto block = std::vector<Beam::SequencedValue<Value>>();
+    block.reserve(values.size());
+    auto symbols = std::vector<std::string_view>();
+    symbols.reserve(values.size());
+    auto venues = std::vector<std::string_view>();
+    venues.reserve(values.size());
+    for(auto& value : values) {
+      block.emplace_back(value->get_value(), value.get_sequence());
+      auto& ticker = value->get_index();
+      symbols.push_back(ticker.get_symbol());
+      venues.push_back(ticker.get_venue().get_code().get_data());
+    }
+    encode_columnar_block<Value>(block, m_data);
+    auto writer = ColumnWriter(Beam::Ref(m_data));
+    writer.write_dictionary(symbols);
+    writer.write_dictionary(venues);
+  }
+
+  template<typename T>
+  bool MarketDataFrame<T>::is_empty() const {
+    return m_data.empty();
+  }
+
+  template<typename T>
+  std::size_t MarketDataFrame<T>::get_size() const {
+    return m_data.size();
+  }
+
+  template<typename T>
+  std::vector<typename MarketDataFrame<T>::SequencedValue>
+      MarketDataFrame<T>::decode() const {
+    if(m_data.empty()) {
+      return {};
+    }
+    return Beam::try_or_nest([&] {
+      auto header = ColumnarBlockHeader();
+      if(m_data.size() < sizeof(header)) {
+        boost::throw_with_location(
+          Beam::SerializationException("Truncated market data frame."));
+      }
+      std::memcpy(&header, m_data.data(), sizeof(header));
+      if(header.m_magic != ColumnarBlockHeader::MAGIC ||
+          header.m_size > m_data.size() - sizeof(header)) {
+        boost::throw_with_location(
+          Beam::SerializationException("Invalid market data frame header."));
+      }
+      auto block = std::vector<Beam::SequencedValue<Value>>();
+      decode_columnar_block<Value>(
+        header, m_data.data() + sizeof(header), block);
+      auto offset = sizeof(header) + header.m_size;
+      auto reader =
+        ColumnReader(m_data.data() + offset, m_data.size() - offset);
+      auto symbols = reader.read_dictionary(block.size());
+      auto venues = reader.read_dictionary(block.size());
+      auto values = std::vector<SequencedValue>();
+      values.reserve(block.size());
+      for(auto i = std::size_t(0); i != block.size(); ++i) {
+        values.emplace_back(Beam::IndexedValue(std::move(*block[i]),
+          Ticker(std::move(symbols[i]), Venue(std::move(venues[i])))),
+          block[i].get_sequence());
+      }
+      return values;
+    }, Beam::SerializationException("Invalid market data frame."));
+  }
+}
+
+namespace Beam {
+  template<typename T>
+  struct Shuttle<Nexus::MarketDataFrame<T>> {
+    template<IsShuttle S>
+    void operator ()(S& shuttle, Nexus::MarketDataFrame<T>& value,
+        unsigned int version) const {
+      shuttle.shuttle("data", value.m_data);
+    }
+  };
+}
+
+#endif
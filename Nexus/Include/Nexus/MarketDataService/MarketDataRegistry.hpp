@@ -1,8 +1,11 @@
 #ifndef NEXUS_MARKET_DATA_REGISTRY_HPP
 #define NEXUS_MARKET_DATA_REGISTRY_HPP
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <ranges>
+#include <stdexcept>
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
@@ -13,6 +16,7 @@
 #include <Beam/Utilities/Remote.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/optional/optional.hpp>
+#include <boost/throw_exception.hpp>
 #include <boost/variant/variant.hpp>
 #include <tsl/htrie_map.h>
 #include "Nexus/MarketDataService/HistoricalDataStore.hpp"
@@ -63,8 +67,28 @@ namespace Nexus {
   class MarketDataRegistry {
     public:
 
-      /** Constructs an empty MarketDataRegistry. */
-      MarketDataRegistry() = default;
+      /** Constructs an empty MarketDataRegistry with a single shard. */
+      MarketDataRegistry();
+
+      /**
+       * Constructs an empty MarketDataRegistry whose Tickers and primary
+       * listings are partitioned by hash into independently synchronized
+       * shards, so that publishing to Tickers belonging to different shards
+       * never contends.
+       * @param shard_count The number of shards to partition Tickers into.
+       */
+      explicit MarketDataRegistry(int shard_count);
+
+      /** Returns the number of shards Tickers are partitioned into. */
+      int get_shard_count() const;
+
+      /**
+       * Returns the index of the shard storing a Ticker's data.
+       * @param ticker The Ticker to lookup.
+       * @return The index of the shard storing the <i>ticker</i>'s primary
+       *         listing.
+       */
+      int get_shard(const Ticker& ticker) const;
 
       /**
        * Returns a list of TickerInfo's matching a prefix.
@@ -169,22 +193,55 @@ namespace Nexus {
       template<typename> friend struct std::hash;
       using SyncVenueEntry = Beam::Sync<VenueEntry, Beam::Mutex>;
       using SyncTickerEntry = Beam::Sync<TickerEntry, Beam::Mutex>;
+      using TickerEntries = Beam::SynchronizedUnorderedMap<Ticker,
+        std::shared_ptr<Beam::Remote<SyncTickerEntry, Beam::Mutex>>>;
+      using PrimaryListings =
+        Beam::SynchronizedUnorderedMap<PrimaryListingKey, Ticker>;
       Beam::Sync<tsl::htrie_map<char, TickerInfo>> m_ticker_database;
-      Beam::SynchronizedUnorderedMap<PrimaryListingKey, Ticker>
-        m_primary_listings;
+      std::vector<std::unique_ptr<PrimaryListings>> m_primary_listings;
       Beam::SynchronizedUnorderedMap<Venue, std::shared_ptr<
         Beam::Remote<SyncVenueEntry, Beam::Mutex>>> m_venue_entries;
-      Beam::SynchronizedUnorderedMap<Ticker, std::shared_ptr<Beam::Remote<
-        SyncTickerEntry, Beam::Mutex>>> m_ticker_entries;
+      std::vector<std::unique_ptr<TickerEntries>> m_ticker_entries;
+      std::vector<std::unique_ptr<TickerEntries>> m_listing_entries;
+      std::atomic<std::uint64_t> m_listing_version;
 
       MarketDataRegistry(const MarketDataRegistry&) = delete;
       MarketDataRegistry& operator =(const MarketDataRegistry&) = delete;
+      int get_primary_listing_shard(const Ticker& ticker) const;
+      PrimaryListings& get_primary_listings(const std::string& symbol) const;
       boost::optional<SyncVenueEntry&> load(
         Venue venue, IsHistoricalDataStore auto& data_store);
       boost::optional<SyncTickerEntry&> load(
         const Ticker& ticker, IsHistoricalDataStore auto & data_store);
   };
 
+  inline MarketDataRegistry::MarketDataRegistry()
+    : MarketDataRegistry(1) {}
+
+  inline MarketDataRegistry::MarketDataRegistry(int shard_count)
+      : m_listing_version(0) {
+    if(shard_count <= 0) {
+      boost::throw_with_location(
+        std::invalid_argument("Shard count must be positive."));
+    }
+    m_primary_listings.reserve(shard_count);
+    m_ticker_entries.reserve(shard_count);
+    m_listing_entries.reserve(shard_count);
+    for(auto i = 0; i != shard_count; ++i) {
+      m_primary_listings.push_back(std::make_unique<PrimaryListings>());
+      m_ticker_entries.push_back(std::make_unique<TickerEntries>());
+      m_listing_entries.push_back(std::make_unique<TickerEntries>());
+    }
+  }
+
+  inline int MarketDataRegistry::get_shard_count() const {
+    return static_cast<int>(m_ticker_entries.size());
+  }
+
+  inline int MarketDataRegistry::get_shard(const Ticker& ticker) const {
+    return get_primary_listing_shard(get_primary_listing(ticker));
+  }
+
   inline std::vector<TickerInfo> MarketDataRegistry::search_ticker_info(
       const std::string& prefix) const {
     auto matches = std::unordered_set<TickerInfo>();
@@ -225,8 +282,9 @@ namespace Nexus {
     if(ticker.get_symbol().empty() || !ticker.get_venue()) {
       return Ticker(ticker.get_symbol(), Venue());
     }
+    auto& primary_listings = get_primary_listings(ticker.get_symbol());
     auto venue_key = PrimaryListingKey(ticker.get_symbol(), ticker.get_venue());
-    if(auto verified_ticker = m_primary_listings.try_load(venue_key)) {
+    if(auto verified_ticker = primary_listings.try_load(venue_key)) {
       return *verified_ticker;
     }
     auto& venue_entry = VENUES.from(ticker.get_venue());
@@ -235,9 +293,8 @@ namespace Nexus {
     }
     auto country_key = 
       PrimaryListingKey(ticker.get_symbol(), venue_entry.m_country_code);
-    if(auto verified_ticker = m_primary_listings.try_load(country_key)) {
-      const_cast<MarketDataRegistry*>(this)->m_primary_listings.insert(
-        venue_key, *verified_ticker);
+    if(auto verified_ticker = primary_listings.try_load(country_key)) {
+      primary_listings.insert(venue_key, *verified_ticker);
       return *verified_ticker;
     }
     return ticker;
@@ -245,7 +302,9 @@ namespace Nexus {
 
   inline boost::optional<SessionTechnicals>
       MarketDataRegistry::find_session_technicals(const Ticker& ticker) const {
-    auto entry = m_ticker_entries.find(get_primary_listing(ticker));
+    auto primary_listing = get_primary_listing(ticker);
+    auto entry = m_ticker_entries[get_primary_listing_shard(
+      primary_listing)]->find(primary_listing);
     if(!entry || !(*entry)->is_available()) {
       return boost::none;
     }
@@ -256,7 +315,9 @@ namespace Nexus {
 
   inline boost::optional<TickerSnapshot>
       MarketDataRegistry::find_snapshot(const Ticker& ticker) const {
-    auto entry = m_ticker_entries.find(get_primary_listing(ticker));
+    auto primary_listing = get_primary_listing(ticker);
+    auto entry = m_ticker_entries[get_primary_listing_shard(
+      primary_listing)]->find(primary_listing);
     if(!entry || !(*entry)->is_available()) {
       return boost::none;
     }
@@ -276,12 +337,19 @@ namespace Nexus {
     if(!venue_entry.m_venue) {
       return;
     }
+    auto& primary_listings = get_primary_listings(info.m_ticker.get_symbol());
     auto venue_key =
       PrimaryListingKey(info.m_ticker.get_symbol(), info.m_ticker.get_venue());
-    m_primary_listings.update(venue_key, info.m_ticker);
+    primary_listings.update(venue_key, info.m_ticker);
     auto country_key =
       PrimaryListingKey(info.m_ticker.get_symbol(), venue_entry.m_country_code);
-    m_primary_listings.update(country_key, info.m_ticker);
+    primary_listings.update(country_key, info.m_ticker);
+    ++m_listing_version;
+    for(auto& shard : m_listing_entries) {
+      shard->with([] (auto& listing_entries) {
+        listing_entries.clear();
+      });
+    }
   }
 
   template<typename F>
@@ -378,11 +446,13 @@ namespace Nexus {
   inline void MarketDataRegistry::clear(int source_id) {
     auto entries = std::vector<
       std::shared_ptr<Beam::Remote<SyncTickerEntry, Beam::Mutex>>>();
-    m_ticker_entries.with([&] (auto& ticker_entries) {
-      for(auto& entry : ticker_entries | std::views::values) {
-        entries.push_back(entry);
-      }
-    });
+    for(auto& shard : m_ticker_entries) {
+      shard->with([&] (auto& ticker_entries) {
+        for(auto& entry : ticker_entries | std::views::values) {
+          entries.push_back(entry);
+        }
+      });
+    }
     for(auto& entry : entries) {
       if(entry->is_available()) {
         Beam::with(**entry, [&] (auto& entry) {
@@ -392,6 +462,25 @@ namespace Nexus {
     }
   }
 
+  inline int MarketDataRegistry::get_primary_listing_shard(
+      const Ticker& ticker) const {
+    if(m_ticker_entries.size() == 1) {
+      return 0;
+    }
+    return static_cast<int>(
+      std::hash<Ticker>()(ticker) % m_ticker_entries.size());
+  }
+
+  inline MarketDataRegistry::PrimaryListings&
+      MarketDataRegistry::get_primary_listings(
+        const std::string& symbol) const {
+    if(m_primary_listings.size() == 1) {
+      return *m_primary_listings.front();
+    }
+    return *m_primary_listings[
+      std::hash<std::string>()(symbol) % m_primary_listings.size()];
+  }
+
   boost::optional<MarketDataRegistry::SyncVenueEntry&> MarketDataRegistry::load(
       Venue venue, IsHistoricalDataStore auto& data_store) {
     if(!venue) {
@@ -409,11 +498,19 @@ namespace Nexus {
   boost::optional<MarketDataRegistry::SyncTickerEntry&>
       MarketDataRegistry::load(
         const Ticker& ticker, IsHistoricalDataStore auto& data_store) {
+    auto& listing_entries =
+      *m_listing_entries[get_primary_listing_shard(ticker)];
+    if(auto entry = listing_entries.find(ticker)) {
+      return ***entry;
+    }
+    auto version = m_listing_version.load();
     auto sanitized_ticker = get_primary_listing(ticker);
     if(!sanitized_ticker) {
       return boost::none;
     }
-    auto entry = m_ticker_entries.get_or_insert(sanitized_ticker, [&] {
+    auto& ticker_entries =
+      *m_ticker_entries[get_primary_listing_shard(sanitized_ticker)];
+    auto entry = ticker_entries.get_or_insert(sanitized_ticker, [&] {
       return std::make_shared<
         Beam::Remote<SyncTickerEntry, Beam::Mutex>>([&] (auto& entry) {
           auto initial_sequences =
@@ -425,6 +522,10 @@ namespace Nexus {
           entry.emplace(sanitized_ticker, close, initial_sequences);
         });
     });
+    listing_entries.insert(ticker, entry);
+    if(m_listing_version.load() != version) {
+      listing_entries.erase(ticker);
+    }
     return **entry;
   }
 }
@@ -6,6 +6,8 @@
 #include <Beam/Services/RecordMessage.hpp>
 #include <Beam/Services/Service.hpp>
 #include "Nexus/Definitions/TickerInfo.hpp"
+#include "Nexus/MarketDataService/ConflationStatistics.hpp"
+#include "Nexus/MarketDataService/MarketDataFrame.hpp"
 #include "Nexus/MarketDataService/TickerQuery.hpp"
 #include "Nexus/MarketDataService/TickerSnapshot.hpp"
 #include "Nexus/MarketDataService/VenueQuery.hpp"
@@ -17,6 +19,8 @@ namespace Nexus {
   using BookQuoteQueryResult = Beam::QueryResult<SequencedBookQuote>;
   using TimeAndSaleQueryResult = Beam::QueryResult<SequencedTimeAndSale>;
   using TickerStatusQueryResult = Beam::QueryResult<SequencedTickerStatus>;
+  using BookQuoteFrame = MarketDataFrame<BookQuote>;
+  using TimeAndSaleFrame = MarketDataFrame<TimeAndSale>;
 
   /** Standard name for the market data registry service. */
   inline const auto MARKET_DATA_REGISTRY_SERVICE_NAME =
@@ -104,7 +108,26 @@ namespace Nexus {
      */
     (LoadTickerInfoFromPrefixService,
       "Nexus.MarketDataService.LoadTickerInfoFromPrefixService",
-      std::vector<TickerInfo>, (std::string, prefix)));
+      std::vector<TickerInfo>, (std::string, prefix)),
+
+    /**
+     * Enables or disables conflation of the session's BboQuote and BookQuote
+     * updates.
+     * @param is_enabled Whether updates to the same listing are collapsed to
+     *        their latest value within the server's conflation window.
+     * @return The conflation window in effect for the session.
+     */
+    (SetConflationService, "Nexus.MarketDataService.SetConflationService",
+      boost::posix_time::time_duration, (bool, is_enabled)),
+
+    /**
+     * Loads the session's conflation window and the number of updates it has
+     * dropped.
+     * @return The session's ConflationStatistics.
+     */
+    (LoadConflationStatisticsService,
+      "Nexus.MarketDataService.LoadConflationStatisticsService",
+      ConflationStatistics));
 
   BEAM_DEFINE_MESSAGES(market_data_registry_messages,
 
@@ -143,6 +166,38 @@ namespace Nexus {
     (TickerStatusMessage, "Nexus.MarketDataService.TickerStatusMessage",
       (SequencedIndexedTickerStatus, status)),
 
+    /**
+     * Sends a batch of SequencedTickerBboQuotes in a single frame.
+     * @param bbo_quotes The SequencedTickerBboQuotes in sequence order.
+     */
+    (BboQuotesMessage, "Nexus.MarketDataService.BboQuotesMessage",
+      (std::vector<SequencedTickerBboQuote>, bbo_quotes)),
+
+    /**
+     * Sends a batch of SequencedTickerBookQuotes in a single frame whose
+     * MPIDs are dictionary encoded.
+     * @param book_quotes The SequencedTickerBookQuotes in sequence order.
+     */
+    (BookQuotesMessage, "Nexus.MarketDataService.BookQuotesMessage",
+      (BookQuoteFrame, book_quotes)),
+
+    /**
+     * Sends a batch of SequencedTickerTimeAndSales in a single frame whose
+     * market centers, MPIDs and condition codes are dictionary encoded.
+     * @param time_and_sales The SequencedTickerTimeAndSales in sequence order.
+     */
+    (TimeAndSalesMessage, "Nexus.MarketDataService.TimeAndSalesMessage",
+      (TimeAndSaleFrame, time_and_sales)),
+
+    /**
+     * Sets whether the session accepts BboQuotesMessage, BookQuotesMessage
+     * and TimeAndSalesMessage. Sessions that never send it receive one
+     * message per update.
+     * @param is_enabled Whether updates may be sent in batches.
+     */
+    (SetBatchingMessage, "Nexus.MarketDataService.SetBatchingMessage",
+      (bool, is_enabled)),
+
     /**
      * Terminates a previous OrderImbalance query.
      * @param venue The venue that was queried.
@@ -222,6 +277,33 @@ namespace Nexus {
   struct market_data_message_type<TickerStatus> {
     using type = TickerStatusMessage;
   };
+
+  /**
+   * Returns the type of Service Message used to publish a batch of updates to
+   * market data queries.
+   * @param <T> The type of market data to publish.
+   */
+  template<typename T>
+  struct market_data_batch_message_type {};
+
+  template<typename T>
+  using market_data_batch_message_type_t =
+    typename market_data_batch_message_type<T>::type;
+
+  template<>
+  struct market_data_batch_message_type<BboQuote> {
+    using type = BboQuotesMessage;
+  };
+
+  template<>
+  struct market_data_batch_message_type<BookQuote> {
+    using type = BookQuotesMessage;
+  };
+
+  template<>
+  struct market_data_batch_message_type<TimeAndSale> {
+    using type = TimeAndSalesMessage;
+  };
 }
 
 #endif
@@ -1,18 +1,32 @@
 #ifndef NEXUS_MARKET_DATA_REGISTRY_SERVLET_HPP
 #define NEXUS_MARKET_DATA_REGISTRY_SERVLET_HPP
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Beam/Collections/SynchronizedList.hpp>
+#include <Beam/Collections/SynchronizedSet.hpp>
 #include <Beam/IO/OpenState.hpp>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
-#include <Beam/Queries/IndexedSubscriptions.hpp>
+#include <Beam/Routines/RoutineHandler.hpp>
+#include <Beam/Threading/Sync.hpp>
 #include <Beam/Services/ServiceProtocolServlet.hpp>
+#include <Beam/Services/ServiceRequestException.hpp>
+#include <Beam/TimeService/Timer.hpp>
+#include <Beam/Utilities/ReportException.hpp>
 #include "Nexus/AdministrationService/AdministrationClient.hpp"
+#include "Nexus/MarketDataService/BroadcastBatch.hpp"
 #include "Nexus/MarketDataService/EntitlementDatabase.hpp"
 #include "Nexus/MarketDataService/HistoricalDataStore.hpp"
+#include "Nexus/MarketDataService/MarketDataFeedServices.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistry.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistryServices.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistrySession.hpp"
+#include "Nexus/MarketDataService/SharedFilterSubscriptions.hpp"
 #include "Nexus/MarketDataService/TickerQuery.hpp"
-#include "Nexus/Queries/EvaluatorTranslator.hpp"
 #include "Nexus/Queries/ShuttleQueryTypes.hpp"
 
 namespace Nexus {
@@ -55,12 +69,40 @@ namespace Nexus {
       MarketDataRegistryServlet(AF&& administration_client,
         RF&& market_data_registry, DF&& data_store);
 
+      /**
+       * Constructs a MarketDataRegistryServlet that lets sessions conflate
+       * their BboQuote and BookQuote updates.
+       * @param administration_client Used to check for entitlements.
+       * @param market_data_registry The registry storing all market data
+       *        originating from this servlet.
+       * @param data_store Initializes the historical market data store.
+       * @param conflation_window The window over which conflated updates are
+       *        collapsed to their latest value.
+       * @param conflation_timer The Timer expiring once every
+       *        <i>conflation_window</i> to flush conflated updates.
+       */
+      template<Beam::Initializes<A> AF, Beam::Initializes<R> RF,
+        Beam::Initializes<D> DF>
+      MarketDataRegistryServlet(AF&& administration_client,
+        RF&& market_data_registry, DF&& data_store,
+        boost::posix_time::time_duration conflation_window,
+        std::unique_ptr<Beam::Timer> conflation_timer);
+
       void add(const TickerInfo& info);
       void publish(const VenueOrderImbalance& imbalance, int source_id);
       void publish(const TickerBboQuote& quote, int source_id);
       void publish(const TickerBookQuote& delta, int source_id);
       void publish(const TickerTimeAndSale& time_and_sale, int source_id);
       void publish(const IndexedTickerStatus& status, int source_id);
+
+      /**
+       * Publishes a list of market data updates as one publish cycle, sending
+       * each client at most one frame per type of market data.
+       * @param messages The market data updates to publish.
+       * @param source_id The id of the source publishing the updates.
+       */
+      void publish(
+        const std::vector<MarketDataFeedMessage>& messages, int source_id);
       void clear(int source_id);
       void register_services(
         Beam::Out<Beam::ServiceSlots<ServiceProtocolClient>> slots);
@@ -71,11 +113,19 @@ namespace Nexus {
     private:
       template<typename T>
       using VenueSubscriptions =
-        Beam::IndexedSubscriptions<T, Venue, ServiceProtocolClient>;
+        SharedFilterSubscriptions<T, Venue, ServiceProtocolClient>;
       template<typename T>
       using TickerSubscriptions =
-        Beam::IndexedSubscriptions<T, Ticker, ServiceProtocolClient>;
+        SharedFilterSubscriptions<T, Ticker, ServiceProtocolClient>;
+      using Batch = BroadcastBatch<ServiceProtocolClient>;
+      struct EntitlementClasses {
+        std::unordered_multimap<
+          std::size_t, std::weak_ptr<const EntitlementMatrix>> m_classes;
+        std::size_t m_sweep_size = 16;
+      };
       EntitlementDatabase m_entitlement_database;
+      EntitlementIndex m_entitlement_index;
+      Beam::Sync<EntitlementClasses, Beam::Mutex> m_entitlement_classes;
       Beam::local_ptr_t<A> m_administration_client;
       Beam::local_ptr_t<R> m_registry;
       Beam::local_ptr_t<D> m_data_store;
@@ -84,11 +134,26 @@ namespace Nexus {
       TickerSubscriptions<BookQuote> m_book_quote_subscriptions;
       TickerSubscriptions<TimeAndSale> m_time_and_sale_subscriptions;
       TickerSubscriptions<TickerStatus> m_ticker_status_subscriptions;
+      boost::posix_time::time_duration m_conflation_window;
+      std::unique_ptr<Beam::Timer> m_conflation_timer;
+      Beam::SynchronizedVector<ServiceProtocolClient*, Beam::Mutex>
+        m_conflated_clients;
       Beam::OpenState m_open_state;
+      Beam::RoutineHandler m_conflation_loop;
 
       MarketDataRegistryServlet(const MarketDataRegistryServlet&) = delete;
       MarketDataRegistryServlet& operator =(
         const MarketDataRegistryServlet&) = delete;
+      void publish(const TickerBboQuote& quote, int source_id, Batch* batch);
+      void publish(const TickerBookQuote& delta, int source_id, Batch* batch);
+      void publish(const TickerTimeAndSale& time_and_sale, int source_id,
+        Batch* batch);
+      template<typename Message, typename Clients, typename Value>
+      void broadcast(const Clients& clients, const Value& value, Batch* batch);
+      std::shared_ptr<const EntitlementMatrix> make_entitlement_class(
+        EntitlementMatrix matrix);
+      void flush(ServiceProtocolClient& client);
+      void conflation_loop();
       template<typename Type, typename Service, typename Query,
         typename Subscriptions>
       void on_query(Beam::RequestToken<ServiceProtocolClient, Service>& request,
@@ -126,6 +191,10 @@ namespace Nexus {
         ServiceProtocolClient& client, const TickerInfoQuery& query);
       std::vector<TickerInfo> on_load_ticker_info_from_prefix(
         ServiceProtocolClient& client, const std::string& prefix);
+      boost::posix_time::time_duration on_set_conflation(
+        ServiceProtocolClient& client, bool is_enabled);
+      ConflationStatistics on_load_conflation_statistics(
+        ServiceProtocolClient& client);
   };
 
   template<typename R, typename D, typename A>
@@ -145,9 +214,24 @@ namespace Nexus {
     Beam::Initializes<D> DF>
   MarketDataRegistryServlet<C, R, D, A>::MarketDataRegistryServlet(
       AF&& administration_client, RF&& registry, DF&& data_store)
+      : MarketDataRegistryServlet(std::forward<AF>(administration_client),
+          std::forward<RF>(registry), std::forward<DF>(data_store),
+          boost::posix_time::time_duration(), nullptr) {}
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  template<Beam::Initializes<A> AF, Beam::Initializes<R> RF,
+    Beam::Initializes<D> DF>
+  MarketDataRegistryServlet<C, R, D, A>::MarketDataRegistryServlet(
+      AF&& administration_client, RF&& registry, DF&& data_store,
+      boost::posix_time::time_duration conflation_window,
+      std::unique_ptr<Beam::Timer> conflation_timer)
       : m_administration_client(std::forward<AF>(administration_client)),
         m_registry(std::forward<RF>(registry)),
-        m_data_store(std::forward<DF>(data_store)) {
+        m_data_store(std::forward<DF>(data_store)),
+        m_conflation_window(conflation_window),
+        m_conflation_timer(std::move(conflation_timer)) {
     try {
       auto query = TickerInfoQuery();
       query.set_index(Scope::GLOBAL);
@@ -157,6 +241,11 @@ namespace Nexus {
         m_registry->add(entry);
       }
       m_entitlement_database = m_administration_client->load_entitlements();
+      m_entitlement_index = EntitlementIndex(m_entitlement_database);
+      if(m_conflation_timer) {
+        m_conflation_loop = Beam::spawn(std::bind_front(
+          &MarketDataRegistryServlet::conflation_loop, this));
+      }
     } catch(const std::exception&) {
       close();
       throw;
@@ -192,14 +281,7 @@ namespace Nexus {
       IsAdministrationClient<Beam::dereference_t<A>>
   void MarketDataRegistryServlet<C, R, D, A>::publish(
       const TickerBboQuote& quote, int source_id) {
-    m_registry->publish(quote, source_id, *m_data_store,
-      [&] (const auto& quote) {
-        m_data_store->store(quote);
-        m_bbo_quote_subscriptions.publish(quote,
-          [&] (const auto& clients) {
-            Beam::broadcast_record_message<BboQuoteMessage>(clients, quote);
-          });
-      });
+    publish(quote, source_id, nullptr);
   }
 
   template<typename C, typename R, typename D, typename A> requires
@@ -207,22 +289,7 @@ namespace Nexus {
       IsAdministrationClient<Beam::dereference_t<A>>
   void MarketDataRegistryServlet<C, R, D, A>::publish(
       const TickerBookQuote& delta, int source_id) {
-    auto ticker = m_registry->get_primary_listing(delta.get_index());
-    auto key = EntitlementKey(ticker.get_venue(), delta.get_value().m_venue);
-    m_registry->publish(delta, source_id, *m_data_store,
-      [&] (const auto& quote) {
-        m_data_store->store(quote);
-        if(!ticker.get_venue()) {
-          return;
-        }
-        m_book_quote_subscriptions.publish(quote, [&] (const auto& client) {
-          return has_entitlement(
-            client.get_session(), key, MarketDataType::BOOK_QUOTE);
-        },
-        [&] (const auto& clients) {
-          Beam::broadcast_record_message<BookQuoteMessage>(clients, quote);
-        });
-      });
+    publish(delta, source_id, nullptr);
   }
 
   template<typename C, typename R, typename D, typename A> requires
@@ -230,15 +297,7 @@ namespace Nexus {
       IsAdministrationClient<Beam::dereference_t<A>>
   void MarketDataRegistryServlet<C, R, D, A>::publish(
       const TickerTimeAndSale& time_and_sale, int source_id) {
-    m_registry->publish(time_and_sale, source_id, *m_data_store,
-      [&] (const auto& time_and_sale) {
-        m_data_store->store(time_and_sale);
-        m_time_and_sale_subscriptions.publish(time_and_sale,
-          [&] (const auto& clients) {
-            Beam::broadcast_record_message<TimeAndSaleMessage>(
-              clients, time_and_sale);
-          });
-      });
+    publish(time_and_sale, source_id, nullptr);
   }
 
   template<typename C, typename R, typename D, typename A> requires
@@ -257,6 +316,28 @@ namespace Nexus {
       });
   }
 
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRegistryServlet<C, R, D, A>::publish(
+      const std::vector<MarketDataFeedMessage>& messages, int source_id) {
+    auto batch = Batch();
+    for(auto& message : messages) {
+      try {
+        boost::apply_visitor([&] (const auto& data) {
+          if constexpr(requires { publish(data, source_id, &batch); }) {
+            publish(data, source_id, &batch);
+          } else {
+            publish(data, source_id);
+          }
+        }, message);
+      } catch(const std::exception&) {
+        std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+      }
+    }
+    batch.send();
+  }
+
   template<typename C, typename R, typename D, typename A> requires
     IsHistoricalDataStore<Beam::dereference_t<D>> &&
       IsAdministrationClient<Beam::dereference_t<A>>
@@ -298,6 +379,10 @@ namespace Nexus {
     Beam::add_message_slot<EndTickerStatusQueryMessage>(
       out(slots), std::bind_front(
         &MarketDataRegistryServlet::on_end_ticker_status_query, this));
+    Beam::add_message_slot<SetBatchingMessage>(out(slots),
+      [] (auto& client, auto is_enabled) {
+        client.get_session().m_channel->set_batching(is_enabled);
+      });
     LoadTickerSnapshotService::add_slot(out(slots), std::bind_front(
       &MarketDataRegistryServlet::on_load_ticker_snapshot, this));
     LoadSessionTechnicalsService::add_slot(out(slots), std::bind_front(
@@ -306,6 +391,10 @@ namespace Nexus {
       &MarketDataRegistryServlet::on_query_ticker_info, this));
     LoadTickerInfoFromPrefixService::add_slot(out(slots), std::bind_front(
       &MarketDataRegistryServlet::on_load_ticker_info_from_prefix, this));
+    SetConflationService::add_slot(out(slots),
+      std::bind_front(&MarketDataRegistryServlet::on_set_conflation, this));
+    LoadConflationStatisticsService::add_slot(out(slots), std::bind_front(
+      &MarketDataRegistryServlet::on_load_conflation_statistics, this));
   }
 
   template<typename C, typename R, typename D, typename A> requires
@@ -328,6 +417,8 @@ namespace Nexus {
         }
       }
     }
+    session.m_entitlement_matrix = make_entitlement_class(
+      EntitlementMatrix(m_entitlement_index, session.m_entitlements));
   }
 
   template<typename C, typename R, typename D, typename A> requires
@@ -340,6 +431,8 @@ namespace Nexus {
     m_book_quote_subscriptions.remove_all(client);
     m_time_and_sale_subscriptions.remove_all(client);
     m_ticker_status_subscriptions.remove_all(client);
+    m_conflated_clients.erase(&client);
+    client.get_session().m_channel->close();
   }
 
   template<typename C, typename R, typename D, typename A> requires
@@ -349,10 +442,159 @@ namespace Nexus {
     if(m_open_state.set_closing()) {
       return;
     }
+    if(m_conflation_timer) {
+      m_conflation_timer->cancel();
+    }
+    m_conflation_loop.wait();
     m_data_store->close();
     m_open_state.close();
   }
 
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRegistryServlet<C, R, D, A>::publish(
+      const TickerBboQuote& quote, int source_id, Batch* batch) {
+    m_registry->publish(quote, source_id, *m_data_store,
+      [&] (const auto& quote) {
+        m_data_store->store(quote);
+        m_bbo_quote_subscriptions.publish(quote,
+          [&] (const auto& clients) {
+            broadcast<BboQuoteMessage>(clients, quote, batch);
+          });
+      });
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRegistryServlet<C, R, D, A>::publish(
+      const TickerBookQuote& delta, int source_id, Batch* batch) {
+    m_registry->publish(delta, source_id, *m_data_store,
+      [&] (const auto& quote) {
+        m_data_store->store(quote);
+        auto venue = quote->get_index().get_venue();
+        if(!venue) {
+          return;
+        }
+        auto cell = m_entitlement_index.get_cell(
+          EntitlementKey(venue, (*quote)->m_venue));
+        m_book_quote_subscriptions.publish(quote, [&] (const auto& client) {
+          return has_entitlement(
+            client.get_session(), cell, MarketDataType::BOOK_QUOTE);
+        },
+        [&] (const auto& clients) {
+          broadcast<BookQuoteMessage>(clients, quote, batch);
+        });
+      });
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRegistryServlet<C, R, D, A>::publish(
+      const TickerTimeAndSale& time_and_sale, int source_id, Batch* batch) {
+    m_registry->publish(time_and_sale, source_id, *m_data_store,
+      [&] (const auto& time_and_sale) {
+        m_data_store->store(time_and_sale);
+        m_time_and_sale_subscriptions.publish(time_and_sale,
+          [&] (const auto& clients) {
+            broadcast<TimeAndSaleMessage>(clients, time_and_sale, batch);
+          });
+      });
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  template<typename Message, typename Clients, typename Value>
+  void MarketDataRegistryServlet<C, R, D, A>::broadcast(
+      const Clients& clients, const Value& value, Batch* batch) {
+    if constexpr(std::is_same_v<Value, SequencedTickerTimeAndSale>) {
+      if(!batch) {
+        Beam::broadcast_record_message<Message>(clients, value);
+        return;
+      }
+    }
+    auto direct_batch = Batch();
+    if(!batch) {
+      batch = &direct_batch;
+    }
+    for(auto& client : clients) {
+      batch->push(*client, value);
+    }
+    if(batch == &direct_batch) {
+      direct_batch.send();
+    }
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  std::shared_ptr<const EntitlementMatrix>
+      MarketDataRegistryServlet<C, R, D, A>::make_entitlement_class(
+        EntitlementMatrix matrix) {
+    auto hash = hash_value(matrix);
+    return Beam::with(m_entitlement_classes, [&] (auto& classes) {
+      auto [first, last] = classes.m_classes.equal_range(hash);
+      for(auto i = first; i != last; ++i) {
+        if(auto existing_class = i->second.lock()) {
+          if(*existing_class == matrix) {
+            return existing_class;
+          }
+        }
+      }
+      if(classes.m_classes.size() >= classes.m_sweep_size) {
+        std::erase_if(classes.m_classes, [] (const auto& entitlement_class) {
+          return entitlement_class.second.expired();
+        });
+        classes.m_sweep_size =
+          std::max<std::size_t>(16, 2 * classes.m_classes.size());
+      }
+      auto entitlement_class =
+        std::make_shared<const EntitlementMatrix>(std::move(matrix));
+      classes.m_classes.emplace(hash, entitlement_class);
+      return entitlement_class;
+    });
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRegistryServlet<C, R, D, A>::flush(
+      ServiceProtocolClient& client) {
+    auto updates = client.get_session().m_conflation.flush();
+    send_market_data_batch(client, updates.m_bbo_quotes);
+    send_market_data_batch(client, updates.m_book_quotes);
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRegistryServlet<C, R, D, A>::conflation_loop() {
+    while(m_open_state.is_open()) {
+      m_conflation_timer->start();
+      m_conflation_timer->wait();
+      if(!m_open_state.is_open()) {
+        break;
+      }
+      auto clients = std::vector<std::pair<
+        ServiceProtocolClient*, std::shared_ptr<BroadcastChannel>>>();
+      m_conflated_clients.for_each([&] (auto& client) {
+        clients.emplace_back(client, client->get_session().m_channel);
+      });
+      for(auto& client : clients) {
+        try {
+          client.second->with([&] {
+            flush(*client.first);
+          });
+        } catch(const std::exception&) {
+          std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+        }
+      }
+    }
+  }
+
   template<typename C, typename R, typename D, typename A> requires
     IsHistoricalDataStore<Beam::dereference_t<D>> &&
       IsAdministrationClient<Beam::dereference_t<A>>
@@ -372,10 +614,9 @@ namespace Nexus {
       request.set(Result());
       return;
     }
-    auto filter = Beam::translate<EvaluatorTranslator>(query.get_filter());
     auto result = Result();
     result.m_id = subscriptions.init(
-      index, request.get_client(), query.get_range(), std::move(filter));
+      index, request.get_client(), query.get_range(), query.get_filter());
     result.m_snapshot = load<Type>(*m_data_store, query);
     subscriptions.commit(index, std::move(result), [&] (const auto& result) {
       request.set(result);
@@ -533,6 +774,45 @@ namespace Nexus {
         ServiceProtocolClient& client, const std::string& prefix) {
     return m_registry->search_ticker_info(prefix);
   }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  boost::posix_time::time_duration MarketDataRegistryServlet<C, R, D, A>::
+      on_set_conflation(ServiceProtocolClient& client, bool is_enabled) {
+    if(!m_conflation_timer) {
+      boost::throw_with_location(
+        Beam::ServiceRequestException("Conflation is not available."));
+    }
+    auto& session = client.get_session();
+    session.m_channel->with([&] {
+      if(is_enabled) {
+        session.m_conflation.set_window(m_conflation_window);
+      } else {
+        session.m_conflation.set_window(boost::posix_time::time_duration());
+        flush(client);
+      }
+    });
+    m_conflated_clients.with([&] (auto& clients) {
+      auto i = std::find(clients.begin(), clients.end(), &client);
+      if(is_enabled) {
+        if(i == clients.end()) {
+          clients.push_back(&client);
+        }
+      } else if(i != clients.end()) {
+        clients.erase(i);
+      }
+    });
+    return session.m_conflation.get_statistics().m_window;
+  }
+
+  template<typename C, typename R, typename D, typename A> requires
+    IsHistoricalDataStore<Beam::dereference_t<D>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  ConflationStatistics MarketDataRegistryServlet<C, R, D, A>::
+      on_load_conflation_statistics(ServiceProtocolClient& client) {
+    return client.get_session().m_conflation.get_statistics();
+  }
 }
 
 #endif
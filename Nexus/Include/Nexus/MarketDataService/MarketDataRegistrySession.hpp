@@ -1,7 +1,11 @@
 #ifndef NEXUS_MARKET_DATA_REGISTRY_SESSION_HPP
 #define NEXUS_MARKET_DATA_REGISTRY_SESSION_HPP
+#include <memory>
 #include <Beam/ServiceLocator/AuthenticatedSession.hpp>
 #include "Nexus/AdministrationService/AccountRoles.hpp"
+#include "Nexus/MarketDataService/BroadcastChannel.hpp"
+#include "Nexus/MarketDataService/ConflationBuffer.hpp"
+#include "Nexus/MarketDataService/EntitlementMatrix.hpp"
 #include "Nexus/MarketDataService/EntitlementSet.hpp"
 
 namespace Nexus {
@@ -15,6 +19,19 @@ namespace Nexus {
 
       /** The entitlements granted to the session. */
       EntitlementSet m_entitlements;
+
+      /**
+       * The session's entitlements compiled into a matrix, shared among all
+       * sessions granted the same entitlements.
+       */
+      std::shared_ptr<const EntitlementMatrix> m_entitlement_matrix;
+
+      /** The session's pending conflated updates. */
+      ConflationBuffer m_conflation;
+
+      /** The channel batched broadcasts are sent to this session over. */
+      std::shared_ptr<BroadcastChannel> m_channel =
+        std::make_shared<BroadcastChannel>();
   };
 
   /**
@@ -31,6 +48,22 @@ namespace Nexus {
         session.m_entitlements.contains(key, type);
   }
 
+  /**
+   * Tests if a session has been granted a market data entitlement through its
+   * EntitlementMatrix.
+   * @param session The session to test.
+   * @param cell The cell of the entitlement to check.
+   * @param type The type of market data to test.
+   * @return <code>true</code> iff the session has been granted the entitlement.
+   */
+  inline bool has_entitlement(const MarketDataRegistrySession& session,
+      int cell, MarketDataType type) {
+    return session.m_roles.test(AccountRole::SERVICE) ||
+      session.m_roles.test(AccountRole::ADMINISTRATOR) ||
+        (session.m_entitlement_matrix &&
+          session.m_entitlement_matrix->contains(cell, type));
+  }
+
   /**
    * Tests if a session has been granted a market data entitlement for a query.
    * @param session The session to test.
@@ -10,12 +10,14 @@
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queries/IndexedSubscriptions.hpp>
+#include <Beam/Queues/PipeBrokenException.hpp>
 #include <Beam/Queues/RoutineTaskQueue.hpp>
 #include <Beam/Routines/RoutineHandlerGroup.hpp>
 #include <Beam/Services/ServiceProtocolServlet.hpp>
 #include <Beam/Threading/CallOnce.hpp>
 #include <Beam/Utilities/ResourcePool.hpp>
 #include "Nexus/AdministrationService/AdministrationClient.hpp"
+#include "Nexus/MarketDataService/BroadcastBatch.hpp"
 #include "Nexus/MarketDataService/EntitlementDatabase.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistryServices.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistrySession.hpp"
@@ -81,6 +83,8 @@ namespace Nexus {
     private:
       struct RealTimeQueryEntry {
         std::unique_ptr<MarketDataClient> m_market_data_client;
+        BroadcastBatch<ServiceProtocolClient> m_batch;
+        bool m_is_flush_pending;
         Beam::RoutineTaskQueue m_tasks;
 
         RealTimeQueryEntry(
@@ -137,14 +141,18 @@ namespace Nexus {
         ServiceProtocolClient& client, const TickerInfoQuery& query);
       std::vector<TickerInfo> on_load_ticker_info_from_prefix(
         ServiceProtocolClient& client, const std::string& prefix);
+      template<typename Clients, typename Value>
+      void broadcast(RealTimeQueryEntry& entry, const Clients& clients,
+        const Value& value);
+      void flush(RealTimeQueryEntry& entry);
       template<typename Index, typename Value, typename Subscriptions>
       std::enable_if_t<!std::is_same_v<Value, SequencedBookQuote>>
-        on_real_time_update(const Index& index, const Value& value,
-          Subscriptions& subscriptions);
+        on_real_time_update(RealTimeQueryEntry& entry, const Index& index,
+          const Value& value, Subscriptions& subscriptions);
       template<typename Index, typename Value, typename Subscriptions>
       std::enable_if_t<std::is_same_v<Value, SequencedBookQuote>>
-        on_real_time_update(const Index& index, const Value& value,
-          Subscriptions& subscriptions);
+        on_real_time_update(RealTimeQueryEntry& entry, const Index& index,
+          const Value& value, Subscriptions& subscriptions);
   };
 
   template<typename M, typename A>
@@ -163,7 +171,8 @@ namespace Nexus {
       IsAdministrationClient<Beam::dereference_t<A>>
   MarketDataRelayServlet<C, M, A>::RealTimeQueryEntry::RealTimeQueryEntry(
     std::unique_ptr<MarketDataClient> market_data_client)
-    : m_market_data_client(std::move(market_data_client)) {}
+    : m_market_data_client(std::move(market_data_client)),
+      m_is_flush_pending(false) {}
 
   template<typename C, typename M, typename A> requires
     IsMarketDataClient<Beam::dereference_t<M>> &&
@@ -238,6 +247,10 @@ namespace Nexus {
       [=, this] (auto& client, const auto& index, auto id) {
         on_end_query(client, index, id, m_ticker_status_subscriptions);
       });
+    Beam::add_message_slot<SetBatchingMessage>(out(slots),
+      [] (auto& client, auto is_enabled) {
+        client.get_session().m_channel->set_batching(is_enabled);
+      });
     LoadTickerSnapshotService::add_slot(out(slots), std::bind_front(
       &MarketDataRelayServlet::on_load_ticker_snapshot, this));
     LoadSessionTechnicalsService::add_slot(out(slots), std::bind_front(
@@ -280,6 +293,7 @@ namespace Nexus {
     m_book_quote_subscriptions.remove_all(client);
     m_time_and_sale_subscriptions.remove_all(client);
     m_ticker_status_subscriptions.remove_all(client);
+    client.get_session().m_channel->close();
   }
 
   template<typename C, typename M, typename A> requires
@@ -385,8 +399,9 @@ namespace Nexus {
         real_time_query.set_range(initial_sequence, Beam::Sequence::LAST);
         query_entry.m_market_data_client->query(real_time_query,
           query_entry.m_tasks.template get_slot<MarketDataType>(
-            [=, this, &subscriptions] (const auto& value) {
-              on_real_time_update(query.get_index(), value, subscriptions);
+            [=, this, &subscriptions, &query_entry] (const auto& value) {
+              on_real_time_update(
+                query_entry, query.get_index(), value, subscriptions);
             }));
       });
       auto queue = std::make_shared<Beam::Queue<MarketDataType>>();
@@ -480,19 +495,53 @@ namespace Nexus {
     return market_data_client->load_ticker_info_from_prefix(prefix);
   }
 
+  template<typename C, typename M, typename A> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  template<typename Clients, typename Value>
+  void MarketDataRelayServlet<C, M, A>::broadcast(RealTimeQueryEntry& entry,
+      const Clients& clients, const Value& value) {
+    using Type = typename Value::Value::Value;
+    if constexpr(
+        requires { typename market_data_batch_message_type<Type>::type; }) {
+      for(auto& client : clients) {
+        entry.m_batch.push(*client, value);
+      }
+      if(entry.m_is_flush_pending || entry.m_batch.is_empty()) {
+        return;
+      }
+      entry.m_is_flush_pending = true;
+      try {
+        entry.m_tasks.push([=, this, &entry] {
+          flush(entry);
+        });
+      } catch(const Beam::PipeBrokenException&) {}
+    } else {
+      Beam::broadcast_record_message<market_data_message_type_t<Type>>(
+        clients, value);
+    }
+  }
+
+  template<typename C, typename M, typename A> requires
+    IsMarketDataClient<Beam::dereference_t<M>> &&
+      IsAdministrationClient<Beam::dereference_t<A>>
+  void MarketDataRelayServlet<C, M, A>::flush(RealTimeQueryEntry& entry) {
+    entry.m_is_flush_pending = false;
+    entry.m_batch.send();
+  }
+
   template<typename C, typename M, typename A> requires
     IsMarketDataClient<Beam::dereference_t<M>> &&
       IsAdministrationClient<Beam::dereference_t<A>>
   template<typename Index, typename Value, typename Subscriptions>
   std::enable_if_t<!std::is_same_v<Value, SequencedBookQuote>>
       MarketDataRelayServlet<C, M, A>::on_real_time_update(
-        const Index& index, const Value& value, Subscriptions& subscriptions) {
+        RealTimeQueryEntry& entry, const Index& index, const Value& value,
+        Subscriptions& subscriptions) {
     auto indexed_value = Beam::SequencedValue(
       Beam::IndexedValue(*value, index), value.get_sequence());
     subscriptions.publish(indexed_value, [&] (auto& clients) {
-      Beam::broadcast_record_message<
-        market_data_message_type_t<typename Value::Value>>(
-          clients, indexed_value);
+      broadcast(entry, clients, indexed_value);
     });
   }
 
@@ -502,7 +551,8 @@ namespace Nexus {
   template<typename Index, typename Value, typename Subscriptions>
   std::enable_if_t<std::is_same_v<Value, SequencedBookQuote>>
       MarketDataRelayServlet<C, M, A>::on_real_time_update(
-        const Index& index, const Value& value, Subscriptions& subscriptions) {
+        RealTimeQueryEntry& entry, const Index& index, const Value& value,
+        Subscriptions& subscriptions) {
     auto key = EntitlementKey(index.get_venue(), value->m_venue);
     auto indexed_value = Beam::SequencedValue(
       Beam::IndexedValue(*value, index), value.get_sequence());
@@ -511,9 +561,7 @@ namespace Nexus {
         client.get_session(), key, MarketDataType::BOOK_QUOTE);
     },
     [&] (auto& clients) {
-      Beam::broadcast_record_message<
-        market_data_message_type_t<typename Value::Value>>(
-          clients, indexed_value);
+      broadcast(entry, clients, indexed_value);
     });
   }
 }
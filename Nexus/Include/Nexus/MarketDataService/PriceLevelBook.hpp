@@ -0,0 +1,188 @@
+#ifndef NEXUS_MARKET_DATA_PRICE_LEVEL_BOOK_HPP
+#define NEXUS_MARKET_DATA_PRICE_LEVEL_BOOK_HPP
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <Beam/Queries/Sequencer.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/optional/optional.hpp>
+#include "Nexus/MarketDataService/TickerQuery.hpp"
+
+namespace Nexus {
+
+  /**
+   * Stores one side of a book as a flat array of price levels, each level
+   * keeping the quotes of every MPID listed at its price.
+   */
+  class PriceLevelBook {
+    public:
+
+      /** Stores the quote of a single MPID listed at a price level. */
+      struct Slot {
+
+        /** The aggregated quote of the MPID. */
+        SequencedBookQuote m_quote;
+
+        /** The id of the source that last updated the quote. */
+        int m_source_id;
+      };
+
+      /** Stores all quotes listed at a single price. */
+      struct Level {
+
+        /** The price of the level. */
+        Money m_price;
+
+        /** The sum of the sizes of all slots at this level. */
+        Quantity m_size;
+
+        /** The slots at this level, ordered by MPID. */
+        boost::container::small_vector<Slot, 4> m_slots;
+      };
+
+      /**
+       * Constructs an empty PriceLevelBook.
+       * @param side The Side of the book.
+       */
+      explicit PriceLevelBook(Side side) noexcept;
+
+      /** Returns the Side of the book. */
+      Side get_side() const;
+
+      /**
+       * Returns the price levels, ordered from lowest to highest precedence so
+       * that the top of the book is at the back.
+       */
+      const std::vector<Level>& get_levels() const;
+
+      /**
+       * Applies a BookQuote delta to the book.
+       * @param quote The BookQuote whose size is added to its MPID's listing.
+       * @param source_id The id of the source publishing the delta.
+       * @param sequencer The Sequencer used to sequence the updated listing.
+       * @return The updated listing for the MPID, with a size of zero if the
+       *         listing was removed, or <code>boost::none</code> if the delta
+       *         did not affect the book.
+       */
+      boost::optional<SequencedBookQuote> publish(
+        const BookQuote& quote, int source_id, Beam::Sequencer& sequencer);
+
+      /**
+       * Removes all listings that originated from a specified source.
+       * @param source_id The id of the source to clear.
+       */
+      void clear(int source_id);
+
+      /**
+       * Appends all listings in the book to a list, ordered from highest to
+       * lowest precedence.
+       * @param quotes The list to append the listings to.
+       */
+      void append(std::vector<SequencedBookQuote>& quotes) const;
+
+    private:
+      Side m_side;
+      std::vector<Level> m_levels;
+      std::size_t m_listing_count;
+
+      std::vector<Level>::iterator find_level(Money price);
+  };
+
+  inline PriceLevelBook::PriceLevelBook(Side side) noexcept
+    : m_side(side),
+      m_listing_count(0) {}
+
+  inline Side PriceLevelBook::get_side() const {
+    return m_side;
+  }
+
+  inline const std::vector<PriceLevelBook::Level>&
+      PriceLevelBook::get_levels() const {
+    return m_levels;
+  }
+
+  inline boost::optional<SequencedBookQuote> PriceLevelBook::publish(
+      const BookQuote& quote, int source_id, Beam::Sequencer& sequencer) {
+    auto level = find_level(quote.m_quote.m_price);
+    if(level == m_levels.end() || level->m_price != quote.m_quote.m_price) {
+      if(quote.m_quote.m_size <= 0) {
+        return boost::none;
+      }
+      level = m_levels.insert(level, Level(quote.m_quote.m_price, 0, {}));
+    }
+    auto slot = std::ranges::lower_bound(level->m_slots, quote.m_mpid,
+      std::less<>(), [] (const auto& slot) -> const std::string& {
+        return slot.m_quote->m_mpid;
+      });
+    if(slot == level->m_slots.end() ||
+        slot->m_quote->m_mpid != quote.m_mpid) {
+      if(quote.m_quote.m_size <= 0) {
+        return boost::none;
+      }
+      auto sequence = sequencer.increment_next_sequence(quote.m_timestamp);
+      slot = level->m_slots.insert(
+        slot, Slot(SequencedBookQuote(quote, sequence), source_id));
+      level->m_size += quote.m_quote.m_size;
+      ++m_listing_count;
+      return slot->m_quote;
+    }
+    auto& listing = slot->m_quote->m_quote;
+    auto size = std::max<Quantity>(0, listing.m_size + quote.m_quote.m_size);
+    level->m_size += size - listing.m_size;
+    listing.m_size = size;
+    slot->m_quote->m_timestamp = quote.m_timestamp;
+    slot->m_quote.get_sequence() =
+      sequencer.increment_next_sequence(quote.m_timestamp);
+    slot->m_source_id = source_id;
+    if(size != 0) {
+      return slot->m_quote;
+    }
+    auto result = std::move(slot->m_quote);
+    level->m_slots.erase(slot);
+    --m_listing_count;
+    if(level->m_slots.empty()) {
+      m_levels.erase(level);
+    }
+    return result;
+  }
+
+  inline void PriceLevelBook::clear(int source_id) {
+    for(auto& level : m_levels) {
+      auto i = std::remove_if(level.m_slots.begin(), level.m_slots.end(),
+        [&] (const auto& slot) {
+          return slot.m_source_id == source_id;
+        });
+      if(i != level.m_slots.end()) {
+        m_listing_count -= level.m_slots.end() - i;
+        level.m_slots.erase(i, level.m_slots.end());
+        level.m_size = 0;
+        for(auto& slot : level.m_slots) {
+          level.m_size += slot.m_quote->m_quote.m_size;
+        }
+      }
+    }
+    std::erase_if(m_levels, [] (const auto& level) {
+      return level.m_slots.empty();
+    });
+  }
+
+  inline void PriceLevelBook::append(
+      std::vector<SequencedBookQuote>& quotes) const {
+    quotes.reserve(quotes.size() + m_listing_count);
+    for(auto level = m_levels.rbegin(); level != m_levels.rend(); ++level) {
+      for(auto& slot : level->m_slots) {
+        quotes.push_back(slot.m_quote);
+      }
+    }
+  }
+
+  inline std::vector<PriceLevelBook::Level>::iterator
+      PriceLevelBook::find_level(Money price) {
+    return std::lower_bound(m_levels.begin(), m_levels.end(), price,
+      [&] (const auto& level, auto price) {
+        return offer_comparator(m_side, level.m_price, price) > 0;
+      });
+  }
+}
+
+#endif
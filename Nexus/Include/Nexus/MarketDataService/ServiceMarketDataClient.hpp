@@ -91,6 +91,8 @@ namespace Nexus {
       ServiceMarketDataClient(const ServiceMarketDataClient&) = delete;
       ServiceMarketDataClient& operator =(
         const ServiceMarketDataClient&) = delete;
+      template<typename Message, typename Publisher>
+      void add_batch_message_handler(Publisher& publisher);
       void on_reconnect(const std::shared_ptr<ServiceProtocolClient>& client);
   };
 
@@ -120,6 +122,11 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
       template add_message_handler<TimeAndSaleMessage>();
     m_ticker_status_publisher.
       template add_message_handler<TickerStatusMessage>();
+    add_batch_message_handler<BboQuotesMessage>(m_bbo_quote_publisher);
+    add_batch_message_handler<BookQuotesMessage>(m_book_quote_publisher);
+    add_batch_message_handler<TimeAndSalesMessage>(m_time_and_sale_publisher);
+    Beam::send_record_message<SetBatchingMessage>(
+      *m_client_handler.get_client(), true);
   } catch(const std::exception&) {
     std::throw_with_nested(Beam::ConnectException(
       "Failed to connect to the market data server."));
@@ -247,9 +254,28 @@ BEAM_UNSUPPRESS_THIS_INITIALIZER()
     m_open_state.close();
   }
 
+  template<typename B>
+  template<typename Message, typename Publisher>
+  void ServiceMarketDataClient<B>::add_batch_message_handler(
+      Publisher& publisher) {
+    Beam::add_message_slot<Message>(Beam::out(m_client_handler.get_slots()),
+      [&publisher] (auto& client, const auto& batch) {
+        if constexpr(requires { batch.decode(); }) {
+          for(auto& value : batch.decode()) {
+            publisher.publish(value);
+          }
+        } else {
+          for(auto& value : batch) {
+            publisher.publish(value);
+          }
+        }
+      });
+  }
+
   template<typename B>
   void ServiceMarketDataClient<B>::on_reconnect(
       const std::shared_ptr<ServiceProtocolClient>& client) {
+    Beam::send_record_message<SetBatchingMessage>(*client, true);
     m_order_imbalance_publisher.recover(*client);
     m_bbo_quote_publisher.recover(*client);
     m_book_quote_publisher.recover(*client);
@@ -0,0 +1,397 @@
+#ifndef NEXUS_SHARED_FILTER_SUBSCRIPTIONS_HPP
+#define NEXUS_SHARED_FILTER_SUBSCRIPTIONS_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <Beam/Queries/ConstantExpression.hpp>
+#include <Beam/Queries/EvaluatorTranslator.hpp>
+#include <Beam/Queries/IndexedSubscriptions.hpp>
+#include <Beam/Queries/IndexedValue.hpp>
+#include <Beam/Queries/QueryResult.hpp>
+#include <Beam/Queries/Range.hpp>
+#include <Beam/Queries/SequencedValue.hpp>
+#include <Beam/Threading/Mutex.hpp>
+#include <boost/lexical_cast.hpp>
+#include "Nexus/Queries/CompiledFilter.hpp"
+#include "Nexus/Queries/EvaluatorTranslator.hpp"
+
+namespace Nexus {
+
+  /**
+   * Keeps track of real-time subscriptions to indexed values, sharing the
+   * evaluation of their filters. Filters are canonicalized by their textual
+   * form, so structurally equal filters on the same index share a single
+   * QueryFilter. Each distinct filter is evaluated at most once per published
+   * value, and its result fans out to every client that subscribed with it.
+   * Publishing looks an index up without taking a global lock: the entry of
+   * an index is created on its first subscription and kept for the lifetime
+   * of the SharedFilterSubscriptions, so only new indices copy the table.
+   * @param <V> The type of value being published.
+   * @param <I> The type of index subscribed to.
+   * @param <C> The type of ServiceProtocolClient subscribing.
+   */
+  template<typename V, typename I, typename C>
+  class SharedFilterSubscriptions {
+    public:
+
+      /** The type of value being published. */
+      using Value = V;
+
+      /** The type of index subscribed to. */
+      using Index = I;
+
+      /** The type of ServiceProtocolClient subscribing. */
+      using ServiceProtocolClient = C;
+
+      /** The type of indexed value published. */
+      using IndexedValue =
+        Beam::SequencedValue<Beam::IndexedValue<Value, Index>>;
+
+      /** Constructs an empty SharedFilterSubscriptions. */
+      SharedFilterSubscriptions() = default;
+
+      /**
+       * Initializes a subscription.
+       * @param index The index to subscribe to.
+       * @param client The client subscribing.
+       * @param range The range of the subscription.
+       * @param filter The subscription's filter.
+       * @return The id of the subscription.
+       */
+      int init(const Index& index, ServiceProtocolClient& client,
+        const Beam::Range& range, const Beam::Expression& filter);
+
+      /**
+       * Commits a previously initialized subscription.
+       * @param index The index subscribed to.
+       * @param result The result of the subscription's query.
+       * @param f The function to call with the committed result.
+       */
+      template<typename F>
+      void commit(const Index& index,
+        Beam::QueryResult<Beam::SequencedValue<Value>> result, F&& f);
+
+      /**
+       * Ends a subscription.
+       * @param index The index subscribed to.
+       * @param client The client that subscribed.
+       * @param id The id of the subscription.
+       */
+      void end(const Index& index, ServiceProtocolClient& client, int id);
+
+      /**
+       * Removes all of a client's subscriptions.
+       * @param client The client whose subscriptions are to be removed.
+       */
+      void remove_all(ServiceProtocolClient& client);
+
+      /**
+       * Publishes a value to every client whose filter accepts it.
+       * @param value The value to publish.
+       * @param sender Called with the list of clients to send the value to.
+       */
+      template<typename F>
+      void publish(const IndexedValue& value, const F& sender);
+
+      /**
+       * Publishes a value to every client whose filter accepts it and that
+       * satisfies a predicate.
+       * @param value The value to publish.
+       * @param predicate Tests whether a client may receive the value.
+       * @param sender Called with the list of clients to send the value to.
+       */
+      template<typename P, typename F>
+      void publish(
+        const IndexedValue& value, const P& predicate, const F& sender);
+
+    private:
+      struct Filter {
+        std::string m_key;
+        std::optional<QueryFilter<Value>> m_predicate;
+        int m_count;
+      };
+      struct Subscription {
+        ServiceProtocolClient* m_client;
+        int m_id;
+        std::size_t m_filter;
+      };
+      struct Entry {
+        Beam::Mutex m_mutex;
+        std::vector<Filter> m_filters;
+        std::vector<Subscription> m_subscriptions;
+        std::vector<std::uint8_t> m_results;
+      };
+      using Entries = std::unordered_map<Index, std::shared_ptr<Entry>>;
+      class ClientBuffer {
+        public:
+          ClientBuffer();
+          ~ClientBuffer();
+          std::vector<ServiceProtocolClient*>& operator *();
+
+        private:
+          std::vector<ServiceProtocolClient*> m_clients;
+
+          static std::vector<std::vector<ServiceProtocolClient*>>& get_pool();
+      };
+      Beam::IndexedSubscriptions<Value, Index, ServiceProtocolClient>
+        m_subscriptions;
+      Beam::Mutex m_mutex;
+      std::atomic<std::shared_ptr<const Entries>> m_entries;
+
+      SharedFilterSubscriptions(const SharedFilterSubscriptions&) = delete;
+      SharedFilterSubscriptions& operator =(
+        const SharedFilterSubscriptions&) = delete;
+      Entry* find(const Index& index) const;
+      Entry& load(const Index& index);
+      void match(Entry& entry, const IndexedValue& value,
+        std::vector<ServiceProtocolClient*>& clients);
+      template<typename F>
+      void remove(Entry& entry, const F& is_removed);
+  };
+
+  template<typename V, typename I, typename C>
+  int SharedFilterSubscriptions<V, I, C>::init(const Index& index,
+      ServiceProtocolClient& client, const Beam::Range& range,
+      const Beam::Expression& filter) {
+    auto key = boost::lexical_cast<std::string>(filter);
+    auto id = m_subscriptions.init(index, client, range,
+      Beam::translate<EvaluatorTranslator>(Beam::ConstantExpression(true)));
+    auto& entry = load(index);
+    auto lock = std::lock_guard(entry.m_mutex);
+    auto& filters = entry.m_filters;
+    auto i = std::find_if(filters.begin(), filters.end(),
+      [&] (const auto& filter) {
+        return filter.m_count != 0 && filter.m_key == key;
+      });
+    if(i == filters.end()) {
+      i = std::find_if(filters.begin(), filters.end(),
+        [] (const auto& filter) {
+          return filter.m_count == 0;
+        });
+      if(i == filters.end()) {
+        i = filters.insert(filters.end(), Filter());
+        entry.m_results.push_back(0);
+      }
+      i->m_key = std::move(key);
+      i->m_predicate.emplace(filter);
+      i->m_count = 0;
+    }
+    ++i->m_count;
+    entry.m_subscriptions.push_back(Subscription(
+      &client, id, static_cast<std::size_t>(i - filters.begin())));
+    return id;
+  }
+
+  template<typename V, typename I, typename C>
+  template<typename F>
+  void SharedFilterSubscriptions<V, I, C>::commit(const Index& index,
+      Beam::QueryResult<Beam::SequencedValue<Value>> result, F&& f) {
+    auto entry = find(index);
+    m_subscriptions.commit(index, std::move(result),
+      [&] (const auto& result) {
+        auto filtered_result = std::remove_cvref_t<decltype(result)>();
+        auto is_filtered = false;
+        if(entry) {
+          auto lock = std::lock_guard(entry->m_mutex);
+          auto subscription = std::find_if(entry->m_subscriptions.begin(),
+            entry->m_subscriptions.end(), [&] (const auto& subscription) {
+              return subscription.m_id == result.m_id;
+            });
+          if(subscription != entry->m_subscriptions.end()) {
+            auto& predicate =
+              *entry->m_filters[subscription->m_filter].m_predicate;
+            auto is_rejected = [&] (const auto& value) {
+              return !predicate(*value);
+            };
+            if(std::any_of(result.m_snapshot.begin(),
+                result.m_snapshot.end(), is_rejected)) {
+              filtered_result = result;
+              std::erase_if(filtered_result.m_snapshot, is_rejected);
+              is_filtered = true;
+            }
+          }
+        }
+        if(is_filtered) {
+          f(filtered_result);
+        } else {
+          f(result);
+        }
+      });
+  }
+
+  template<typename V, typename I, typename C>
+  void SharedFilterSubscriptions<V, I, C>::end(
+      const Index& index, ServiceProtocolClient& client, int id) {
+    m_subscriptions.end(index, client, id);
+    auto entry = find(index);
+    if(!entry) {
+      return;
+    }
+    auto lock = std::lock_guard(entry->m_mutex);
+    remove(*entry, [&] (const auto& subscription) {
+      return subscription.m_client == &client && subscription.m_id == id;
+    });
+  }
+
+  template<typename V, typename I, typename C>
+  void SharedFilterSubscriptions<V, I, C>::remove_all(
+      ServiceProtocolClient& client) {
+    m_subscriptions.remove_all(client);
+    auto entries = m_entries.load();
+    if(!entries) {
+      return;
+    }
+    for(auto& entry : *entries | std::views::values) {
+      auto lock = std::lock_guard(entry->m_mutex);
+      remove(*entry, [&] (const auto& subscription) {
+        return subscription.m_client == &client;
+      });
+    }
+  }
+
+  template<typename V, typename I, typename C>
+  template<typename F>
+  void SharedFilterSubscriptions<V, I, C>::publish(
+      const IndexedValue& value, const F& sender) {
+    publish(value, [] (const auto& client) {
+      return true;
+    }, sender);
+  }
+
+  template<typename V, typename I, typename C>
+  template<typename P, typename F>
+  void SharedFilterSubscriptions<V, I, C>::publish(
+      const IndexedValue& value, const P& predicate, const F& sender) {
+    auto entry = find(value->get_index());
+    if(!entry) {
+      return;
+    }
+    auto clients = ClientBuffer();
+    match(*entry, value, *clients);
+    if((*clients).empty()) {
+      return;
+    }
+    m_subscriptions.publish(value, [&] (const auto& client) {
+      return std::binary_search((*clients).begin(), (*clients).end(),
+        &client) && predicate(client);
+    }, sender);
+  }
+
+  template<typename V, typename I, typename C>
+  SharedFilterSubscriptions<V, I, C>::ClientBuffer::ClientBuffer() {
+    auto& pool = get_pool();
+    if(!pool.empty()) {
+      m_clients = std::move(pool.back());
+      pool.pop_back();
+    }
+  }
+
+  template<typename V, typename I, typename C>
+  SharedFilterSubscriptions<V, I, C>::ClientBuffer::~ClientBuffer() {
+    m_clients.clear();
+    get_pool().push_back(std::move(m_clients));
+  }
+
+  template<typename V, typename I, typename C>
+  std::vector<typename SharedFilterSubscriptions<V, I, C>::
+      ServiceProtocolClient*>& SharedFilterSubscriptions<V, I, C>::
+        ClientBuffer::operator *() {
+    return m_clients;
+  }
+
+  template<typename V, typename I, typename C>
+  std::vector<std::vector<typename SharedFilterSubscriptions<V, I, C>::
+      ServiceProtocolClient*>>& SharedFilterSubscriptions<V, I, C>::
+        ClientBuffer::get_pool() {
+    thread_local auto pool =
+      std::vector<std::vector<ServiceProtocolClient*>>();
+    return pool;
+  }
+
+  template<typename V, typename I, typename C>
+  typename SharedFilterSubscriptions<V, I, C>::Entry*
+      SharedFilterSubscriptions<V, I, C>::find(const Index& index) const {
+    auto entries = m_entries.load(std::memory_order_acquire);
+    if(!entries) {
+      return nullptr;
+    }
+    auto i = entries->find(index);
+    if(i == entries->end()) {
+      return nullptr;
+    }
+    return i->second.get();
+  }
+
+  template<typename V, typename I, typename C>
+  typename SharedFilterSubscriptions<V, I, C>::Entry&
+      SharedFilterSubscriptions<V, I, C>::load(const Index& index) {
+    auto lock = std::lock_guard(m_mutex);
+    auto entries = m_entries.load(std::memory_order_acquire);
+    if(entries) {
+      auto i = entries->find(index);
+      if(i != entries->end()) {
+        return *i->second;
+      }
+    }
+    auto new_entries = entries ?
+      std::make_shared<Entries>(*entries) : std::make_shared<Entries>();
+    auto& entry = *new_entries->emplace(
+      index, std::make_shared<Entry>()).first->second;
+    m_entries.store(std::move(new_entries), std::memory_order_release);
+    return entry;
+  }
+
+  template<typename V, typename I, typename C>
+  void SharedFilterSubscriptions<V, I, C>::match(Entry& entry,
+      const IndexedValue& value,
+      std::vector<ServiceProtocolClient*>& clients) {
+    static constexpr auto UNKNOWN = std::uint8_t(0);
+    static constexpr auto REJECTED = std::uint8_t(1);
+    static constexpr auto ACCEPTED = std::uint8_t(2);
+    auto lock = std::lock_guard(entry.m_mutex);
+    std::fill(entry.m_results.begin(), entry.m_results.end(), UNKNOWN);
+    for(auto& subscription : entry.m_subscriptions) {
+      auto& result = entry.m_results[subscription.m_filter];
+      if(result == UNKNOWN) {
+        if((*entry.m_filters[subscription.m_filter].m_predicate)(**value)) {
+          result = ACCEPTED;
+        } else {
+          result = REJECTED;
+        }
+      }
+      if(result == ACCEPTED) {
+        clients.push_back(subscription.m_client);
+      }
+    }
+    std::sort(clients.begin(), clients.end());
+    clients.erase(std::unique(clients.begin(), clients.end()), clients.end());
+  }
+
+  template<typename V, typename I, typename C>
+  template<typename F>
+  void SharedFilterSubscriptions<V, I, C>::remove(
+      Entry& entry, const F& is_removed) {
+    std::erase_if(entry.m_subscriptions, [&] (const auto& subscription) {
+      if(!is_removed(subscription)) {
+        return false;
+      }
+      auto& filter = entry.m_filters[subscription.m_filter];
+      --filter.m_count;
+      if(filter.m_count == 0) {
+        filter.m_key.clear();
+        filter.m_predicate.reset();
+      }
+      return true;
+    });
+  }
+}
+
+#endif
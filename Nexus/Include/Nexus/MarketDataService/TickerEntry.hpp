@@ -4,6 +4,7 @@
 #include <boost/optional/optional.hpp>
 #include "Nexus/Definitions/StandardTimeZones.hpp"
 #include "Nexus/Definitions/Venue.hpp"
+#include "Nexus/MarketDataService/PriceLevelBook.hpp"
 #include "Nexus/MarketDataService/TickerQuery.hpp"
 #include "Nexus/MarketDataService/TickerSnapshot.hpp"
 #include "Nexus/MarketDataService/VenueQuery.hpp"
@@ -58,6 +59,12 @@ namespace Nexus {
       /** Returns the most recently published BboQuote. */
       const SequencedTickerBboQuote& get_bbo_quote() const;
 
+      /**
+       * Returns the book for one Side.
+       * @param side The Side of the book to return.
+       */
+      const PriceLevelBook& get_book(Side side) const;
+
       /**
        * Publishes a BboQuote.
        * @param bbo_quote The BboQuote to publish.
@@ -101,12 +108,6 @@ namespace Nexus {
       void clear(int source_id);
 
     private:
-      struct BookQuoteEntry {
-        SequencedTickerBookQuote m_quote;
-        int m_source_id;
-
-        BookQuoteEntry(const SequencedTickerBookQuote& quote, int source_id);
-      };
       Ticker m_ticker;
       Beam::Sequencer m_bbo_sequencer;
       Beam::Sequencer m_book_quote_sequencer;
@@ -118,8 +119,8 @@ namespace Nexus {
       boost::posix_time::ptime m_session_reset_time;
       SequencedTickerBboQuote m_bbo_quote;
       SequencedTickerTimeAndSale m_time_and_sale;
-      std::vector<BookQuoteEntry> m_asks;
-      std::vector<BookQuoteEntry> m_bids;
+      PriceLevelBook m_asks;
+      PriceLevelBook m_bids;
 
       TickerEntry(const TickerEntry&) = delete;
       TickerEntry& operator =(const TickerEntry&) = delete;
@@ -178,11 +179,6 @@ namespace Nexus {
     return initial_sequences;
   }
 
-  inline TickerEntry::BookQuoteEntry::BookQuoteEntry(
-    const SequencedTickerBookQuote& quote, int source_id)
-    : m_quote(quote),
-      m_source_id(source_id) {}
-
   inline TickerEntry::TickerEntry(
       Ticker ticker, Money close, const InitialSequences& initial_sequences)
       : m_ticker(std::move(ticker)),
@@ -191,7 +187,9 @@ namespace Nexus {
         m_time_and_sale_sequencer(
           initial_sequences.m_next_time_and_sale_sequence),
         m_ticker_status_sequencer(
-          initial_sequences.m_next_ticker_status_sequence) {
+          initial_sequences.m_next_ticker_status_sequence),
+        m_asks(Side::ASK),
+        m_bids(Side::BID) {
     m_market_center = VENUES.from(m_ticker.get_venue()).m_market_center;
     if(m_market_center.empty()) {
       m_market_center = m_ticker.get_venue().get_code().get_data();
@@ -220,16 +218,8 @@ namespace Nexus {
     auto snapshot = TickerSnapshot(m_ticker);
     snapshot.m_bbo_quote = m_bbo_quote;
     snapshot.m_time_and_sale = m_time_and_sale;
-    for(auto& ask : m_asks) {
-      if((*ask.m_quote)->m_quote.m_size > 0) {
-        snapshot.m_asks.push_back(ask.m_quote);
-      }
-    }
-    for(auto& bid : m_bids) {
-      if((*bid.m_quote)->m_quote.m_size > 0) {
-        snapshot.m_bids.push_back(bid.m_quote);
-      }
-    }
+    m_asks.append(snapshot.m_asks);
+    m_bids.append(snapshot.m_bids);
     return snapshot;
   }
 
@@ -237,6 +227,10 @@ namespace Nexus {
     return m_bbo_quote;
   }
 
+  inline const PriceLevelBook& TickerEntry::get_book(Side side) const {
+    return pick(side, m_asks, m_bids);
+  }
+
   inline boost::optional<SequencedTickerBboQuote> TickerEntry::publish(
       const BboQuote& bbo_quote, int source_id) {
     if(m_session_reset_time == boost::posix_time::not_a_date_time) {
@@ -272,44 +266,12 @@ namespace Nexus {
   inline boost::optional<SequencedTickerBookQuote> TickerEntry::publish(
       const BookQuote& quote, int source_id) {
     auto& book = pick(quote.m_quote.m_side, m_asks, m_bids);
-    auto i = std::lower_bound(book.begin(), book.end(), quote,
-      [] (const auto& lhs, const auto& rhs) {
-        return listing_comparator(**lhs.m_quote, rhs);
-      });
-    if(i == book.end()) {
-      if(quote.m_quote.m_size <= 0) {
-        return boost::none;
-      }
-      auto value = m_book_quote_sequencer.make_sequenced_value(quote, m_ticker);
-      book.emplace_back(std::move(value), source_id);
-      i = book.end() - 1;
-    } else {
-      auto& entry = *i;
-      if((*entry.m_quote)->m_quote.m_price != quote.m_quote.m_price ||
-          (*entry.m_quote)->m_mpid != quote.m_mpid) {
-        if(quote.m_quote.m_size <= 0) {
-          return boost::none;
-        }
-        if((*entry.m_quote)->m_quote.m_size == 0) {
-          auto value =
-            m_book_quote_sequencer.make_sequenced_value(quote, m_ticker);
-          auto quote_entry = BookQuoteEntry(std::move(value), source_id);
-          entry = quote_entry;
-        } else {
-          auto value =
-            m_book_quote_sequencer.make_sequenced_value(quote, m_ticker);
-          i = book.emplace(i, std::move(value), source_id);
-        }
-      } else {
-        (*entry.m_quote)->m_quote.m_size = std::max<Quantity>(
-          0, (*entry.m_quote)->m_quote.m_size + quote.m_quote.m_size);
-        (*entry.m_quote)->m_timestamp = quote.m_timestamp;
-        entry.m_quote.get_sequence() =
-          m_book_quote_sequencer.increment_next_sequence(quote.m_timestamp);
-        entry.m_source_id = source_id;
-      }
+    auto value = book.publish(quote, source_id, m_book_quote_sequencer);
+    if(!value) {
+      return boost::none;
     }
-    return i->m_quote;
+    return SequencedTickerBookQuote(
+      TickerBookQuote(std::move(**value), m_ticker), value->get_sequence());
   }
 
   inline boost::optional<SequencedTickerTimeAndSale>
@@ -330,12 +292,8 @@ namespace Nexus {
   }
 
   inline void TickerEntry::clear(int source_id) {
-    std::erase_if(m_asks, [&] (const auto& entry) {
-      return entry.m_source_id == source_id;
-    });
-    std::erase_if(m_bids, [&] (const auto& entry) {
-      return entry.m_source_id == source_id;
-    });
+    m_asks.clear(source_id);
+    m_bids.clear(source_id);
   }
 }
 
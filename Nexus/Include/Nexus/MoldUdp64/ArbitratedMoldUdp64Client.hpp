@@ -0,0 +1,342 @@
+#ifndef NEXUS_ARBITRATED_MOLD_UDP_64_CLIENT_HPP
+#define NEXUS_ARBITRATED_MOLD_UDP_64_CLIENT_HPP
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <Beam/IO/ConnectException.hpp>
+#include <Beam/IO/OpenState.hpp>
+#include <Beam/IO/SharedBuffer.hpp>
+#include <Beam/Pointers/Dereference.hpp>
+#include <Beam/Pointers/LocalPtr.hpp>
+#include <Beam/Pointers/Out.hpp>
+#include <Beam/Queues/PipeBrokenException.hpp>
+#include <Beam/Routines/RoutineHandler.hpp>
+#include <Beam/Threading/ConditionVariable.hpp>
+#include <Beam/Threading/Mutex.hpp>
+#include <Beam/Utilities/Expect.hpp>
+#include <Beam/Utilities/TypeTraits.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/throw_exception.hpp>
+#include "Nexus/MoldUdp64/MoldUdp64Retransmitter.hpp"
+#include "Nexus/MoldUdp64/MoldUdp64Sequencer.hpp"
+
+namespace Nexus {
+
+  /**
+   * Implements a MoldUdp64 client that arbitrates between two redundant
+   * lines, emitting each message exactly once from whichever line delivers it
+   * first. Gaps present on both lines are recovered as in the
+   * MoldUdp64Client. Without a retransmitter a gap is reported as soon as
+   * every open line has delivered the packets following it. Each line reads
+   * into buffers taken from the sequencer's pool and at most capacity
+   * packets are held between the lines and the reader.
+   * @param <C> The type of Channel connected to each line.
+   * @param <R> The type of retransmitter used to recover missing messages.
+   */
+  template<typename C, typename R = NullMoldUdp64Retransmitter> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  class ArbitratedMoldUdp64Client {
+    public:
+
+      /** The type of Channel connected to each line. */
+      using Channel = Beam::dereference_t<C>;
+
+      /** The type of retransmitter used to recover missing messages. */
+      using Retransmitter = Beam::dereference_t<R>;
+
+      /**
+       * Constructs an ArbitratedMoldUdp64Client.
+       * @param a The Channel connected to the A line.
+       * @param b The Channel connected to the B line.
+       */
+      template<Beam::Initializes<C> AF, Beam::Initializes<C> BF>
+      ArbitratedMoldUdp64Client(AF&& a, BF&& b);
+
+      /**
+       * Constructs an ArbitratedMoldUdp64Client.
+       * @param a The Channel connected to the A line.
+       * @param b The Channel connected to the B line.
+       * @param retransmitter The retransmitter used to recover missing
+       *        messages.
+       */
+      template<Beam::Initializes<C> AF, Beam::Initializes<C> BF,
+        Beam::Initializes<R> RF>
+      ArbitratedMoldUdp64Client(AF&& a, BF&& b, RF&& retransmitter);
+
+      /**
+       * Constructs an ArbitratedMoldUdp64Client.
+       * @param a The Channel connected to the A line.
+       * @param b The Channel connected to the B line.
+       * @param retransmitter The retransmitter used to recover missing
+       *        messages.
+       * @param capacity The number of out of sequence packets to buffer, and
+       *        of packets received ahead of the reader.
+       */
+      template<Beam::Initializes<C> AF, Beam::Initializes<C> BF,
+        Beam::Initializes<R> RF>
+      ArbitratedMoldUdp64Client(
+        AF&& a, BF&& b, RF&& retransmitter, std::size_t capacity);
+
+      ~ArbitratedMoldUdp64Client();
+
+      /** Reads the next message from the feed. */
+      MoldUdp64Message read();
+
+      /**
+       * Reads the next message from the feed.
+       * @param sequence_number The message's sequence number.
+       */
+      MoldUdp64Message read(Beam::Out<std::uint64_t> sequence_number);
+
+      /**
+       * Reads a batch of consecutive messages from the feed without copying
+       * them. The messages point into the packets received and remain valid
+       * until the next read.
+       * @param messages Stores the messages read.
+       * @param sequence_number The sequence number of the first message read.
+       * @return The number of messages read, at least one.
+       */
+      std::size_t read_batch(std::span<MoldUdp64Message> messages,
+        Beam::Out<std::uint64_t> sequence_number);
+
+      void close();
+
+    private:
+      struct Line {
+        bool m_is_open;
+        std::uint64_t m_end;
+      };
+      Beam::local_ptr_t<C> m_a;
+      Beam::local_ptr_t<C> m_b;
+      Beam::local_ptr_t<R> m_retransmitter;
+      std::size_t m_capacity;
+      Beam::Mutex m_mutex;
+      MoldUdp64Sequencer m_sequencer;
+      boost::optional<MoldUdp64Gap> m_requested_gap;
+      std::deque<Beam::SharedBuffer> m_packets;
+      std::array<Line, 2> m_lines;
+      int m_line_count;
+      bool m_is_closing;
+      std::exception_ptr m_exception;
+      Beam::ConditionVariable m_packet_available_condition;
+      Beam::ConditionVariable m_space_available_condition;
+      Beam::RoutineHandler m_a_loop;
+      Beam::RoutineHandler m_b_loop;
+      Beam::OpenState m_open_state;
+
+      ArbitratedMoldUdp64Client(const ArbitratedMoldUdp64Client&) = delete;
+      ArbitratedMoldUdp64Client& operator =(
+        const ArbitratedMoldUdp64Client&) = delete;
+      boost::optional<Beam::SharedBuffer> pop_packet(bool is_blocking);
+      bool is_pending(const MoldUdp64Gap& gap);
+      void line_loop(Channel& channel, Line& line);
+  };
+
+  template<typename C>
+  ArbitratedMoldUdp64Client(C&&, C&&) ->
+    ArbitratedMoldUdp64Client<std::remove_cvref_t<C>>;
+
+  template<typename C, typename R>
+  ArbitratedMoldUdp64Client(C&&, C&&, R&&) ->
+    ArbitratedMoldUdp64Client<std::remove_cvref_t<C>, std::remove_cvref_t<R>>;
+
+  template<typename C, typename R>
+  ArbitratedMoldUdp64Client(C&&, C&&, R&&, std::size_t) ->
+    ArbitratedMoldUdp64Client<std::remove_cvref_t<C>, std::remove_cvref_t<R>>;
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  template<Beam::Initializes<C> AF, Beam::Initializes<C> BF>
+  ArbitratedMoldUdp64Client<C, R>::ArbitratedMoldUdp64Client(AF&& a, BF&& b)
+    : ArbitratedMoldUdp64Client(
+        std::forward<AF>(a), std::forward<BF>(b), R()) {}
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  template<Beam::Initializes<C> AF, Beam::Initializes<C> BF,
+    Beam::Initializes<R> RF>
+  ArbitratedMoldUdp64Client<C, R>::ArbitratedMoldUdp64Client(
+    AF&& a, BF&& b, RF&& retransmitter)
+    : ArbitratedMoldUdp64Client(std::forward<AF>(a), std::forward<BF>(b),
+        std::forward<RF>(retransmitter),
+        MoldUdp64Sequencer::DEFAULT_CAPACITY) {}
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  template<Beam::Initializes<C> AF, Beam::Initializes<C> BF,
+    Beam::Initializes<R> RF>
+  ArbitratedMoldUdp64Client<C, R>::ArbitratedMoldUdp64Client(
+      AF&& a, BF&& b, RF&& retransmitter, std::size_t capacity)
+      try : m_a(std::forward<AF>(a)),
+            m_b(std::forward<BF>(b)),
+            m_retransmitter(std::forward<RF>(retransmitter)),
+            m_capacity(std::max<std::size_t>(capacity, 1)),
+            m_sequencer(capacity),
+            m_lines{Line(true, 0), Line(true, 0)},
+            m_line_count(2),
+            m_is_closing(false) {
+    try {
+      m_a_loop = Beam::spawn(
+        std::bind_front(&ArbitratedMoldUdp64Client::line_loop, this,
+          std::ref(*m_a), std::ref(m_lines[0])));
+      m_b_loop = Beam::spawn(
+        std::bind_front(&ArbitratedMoldUdp64Client::line_loop, this,
+          std::ref(*m_b), std::ref(m_lines[1])));
+    } catch(const std::exception&) {
+      close();
+      throw;
+    }
+  } catch(const std::exception&) {
+    std::throw_with_nested(
+      Beam::ConnectException("MoldUDP64 client failed to connect."));
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  ArbitratedMoldUdp64Client<C, R>::~ArbitratedMoldUdp64Client() {
+    close();
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  MoldUdp64Message ArbitratedMoldUdp64Client<C, R>::read() {
+    auto sequence_number = std::uint64_t();
+    return read(Beam::out(sequence_number));
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  MoldUdp64Message ArbitratedMoldUdp64Client<C, R>::read(
+      Beam::Out<std::uint64_t> sequence_number) {
+    auto message = MoldUdp64Message();
+    read_batch(std::span(&message, 1), Beam::out(*sequence_number));
+    return message;
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  std::size_t ArbitratedMoldUdp64Client<C, R>::read_batch(
+      std::span<MoldUdp64Message> messages,
+      Beam::Out<std::uint64_t> sequence_number) {
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_sequencer.release();
+    }
+    return Details::read_sequenced(m_sequencer, *m_retransmitter,
+      m_requested_gap, messages, Beam::out(*sequence_number),
+      std::bind_front(&ArbitratedMoldUdp64Client::pop_packet, this),
+      std::bind_front(&ArbitratedMoldUdp64Client::is_pending, this));
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  void ArbitratedMoldUdp64Client<C, R>::close() {
+    if(m_open_state.set_closing()) {
+      return;
+    }
+    {
+      auto lock = std::lock_guard(m_mutex);
+      m_is_closing = true;
+      m_space_available_condition.notify_all();
+    }
+    m_a->get_connection().close();
+    m_b->get_connection().close();
+    m_a_loop.wait();
+    m_b_loop.wait();
+    m_open_state.close();
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  boost::optional<Beam::SharedBuffer>
+      ArbitratedMoldUdp64Client<C, R>::pop_packet(bool is_blocking) {
+    auto lock = std::unique_lock(m_mutex);
+    while(m_packets.empty()) {
+      if(!is_blocking) {
+        return boost::none;
+      } else if(m_line_count == 0) {
+        Beam::try_or_nest([&] {
+          std::rethrow_exception(m_exception);
+        }, Beam::IOException("Failed to read MoldUDP64 packet."));
+      }
+      m_packet_available_condition.wait(lock);
+    }
+    auto packet = std::move(m_packets.front());
+    m_packets.pop_front();
+    m_space_available_condition.notify_one();
+    return packet;
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  bool ArbitratedMoldUdp64Client<C, R>::is_pending(const MoldUdp64Gap& gap) {
+    auto lock = std::lock_guard(m_mutex);
+    return !m_packets.empty() ||
+      std::ranges::any_of(m_lines, [&] (const auto& line) {
+        return line.m_is_open && line.m_end <= gap.m_sequence_number;
+      });
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  void ArbitratedMoldUdp64Client<C, R>::line_loop(
+      Channel& channel, Line& line) {
+    try {
+      while(true) {
+        auto packet = [&] {
+          auto lock = std::lock_guard(m_mutex);
+          return m_sequencer.acquire();
+        }();
+        channel.get_reader().read(Beam::out(packet));
+        auto end = boost::optional<std::uint64_t>();
+        if(packet.get_size() >= MoldUdp64Packet::PACKET_LENGTH) {
+          auto header = MoldUdp64Packet::parse(
+            std::string_view(packet.get_data(), packet.get_size()));
+          end = header.m_sequence_number;
+          if(header.m_count != MoldUdp64Packet::END_OF_SESSION) {
+            *end += header.m_count;
+          }
+        }
+        auto lock = std::unique_lock(m_mutex);
+        while(m_packets.size() >= m_capacity && !m_is_closing) {
+          m_space_available_condition.wait(lock);
+        }
+        if(m_is_closing) {
+          boost::throw_with_location(Beam::PipeBrokenException());
+        }
+        if(end) {
+          line.m_end = std::max(line.m_end, *end);
+        }
+        m_packets.push_back(std::move(packet));
+        m_packet_available_condition.notify_one();
+      }
+    } catch(const std::exception&) {
+      auto lock = std::lock_guard(m_mutex);
+      line.m_is_open = false;
+      if(--m_line_count == 0) {
+        m_exception = std::current_exception();
+      }
+      m_packet_available_condition.notify_one();
+    }
+  }
+}
+
+#endif
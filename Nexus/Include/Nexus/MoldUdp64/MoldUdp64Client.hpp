@@ -1,6 +1,7 @@
 #ifndef NEXUS_MOLD_UDP_64_CLIENT_HPP
 #define NEXUS_MOLD_UDP_64_CLIENT_HPP
 #include <cstdint>
+#include <span>
 #include <Beam/IO/ConnectException.hpp>
 #include <Beam/IO/OpenState.hpp>
 #include <Beam/IO/SharedBuffer.hpp>
@@ -9,22 +10,33 @@
 #include <Beam/Pointers/Out.hpp>
 #include <Beam/Utilities/Expect.hpp>
 #include <Beam/Utilities/TypeTraits.hpp>
-#include "Nexus/MoldUdp64/MoldUdp64Message.hpp"
-#include "Nexus/MoldUdp64/MoldUdp64Packet.hpp"
+#include <boost/optional/optional.hpp>
+#include "Nexus/MoldUdp64/MoldUdp64Retransmitter.hpp"
+#include "Nexus/MoldUdp64/MoldUdp64Sequencer.hpp"
 
 namespace Nexus {
 
   /**
-   * Implements a client using the MoldUdp64 protocol.
+   * Implements a client using the MoldUdp64 protocol. Packets received out of
+   * sequence are buffered, missing messages are requested from a
+   * retransmitter and a gap that can not be recovered before the buffer fills
+   * is reported by a MoldUdp64GapException. Without a retransmitter a gap can
+   * not be recovered, so it is reported as soon as it is detected.
    * @param <C> The type of Channel connected to the MoldUdp64 server.
+   * @param <R> The type of retransmitter used to recover missing messages.
    */
-  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
+  template<typename C, typename R = NullMoldUdp64Retransmitter> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
   class MoldUdp64Client {
     public:
 
       /** The type of Channel connected to the MoldUdp64 server. */
       using Channel = Beam::dereference_t<C>;
 
+      /** The type of retransmitter used to recover missing messages. */
+      using Retransmitter = Beam::dereference_t<R>;
+
       /**
        * Constructs a MoldUdp64Client.
        * @param channel The Channel to connect to the MoldUdp64 server
@@ -32,6 +44,25 @@ namespace Nexus {
       template<Beam::Initializes<C> CF>
       explicit MoldUdp64Client(CF&& channel);
 
+      /**
+       * Constructs a MoldUdp64Client.
+       * @param channel The Channel to connect to the MoldUdp64 server
+       * @param retransmitter The retransmitter used to recover missing
+       *        messages.
+       */
+      template<Beam::Initializes<C> CF, Beam::Initializes<R> RF>
+      MoldUdp64Client(CF&& channel, RF&& retransmitter);
+
+      /**
+       * Constructs a MoldUdp64Client.
+       * @param channel The Channel to connect to the MoldUdp64 server
+       * @param retransmitter The retransmitter used to recover missing
+       *        messages.
+       * @param capacity The number of out of sequence packets to buffer.
+       */
+      template<Beam::Initializes<C> CF, Beam::Initializes<R> RF>
+      MoldUdp64Client(CF&& channel, RF&& retransmitter, std::size_t capacity);
+
       ~MoldUdp64Client();
 
       /** Reads the next message from the feed. */
@@ -43,15 +74,24 @@ namespace Nexus {
        */
       MoldUdp64Message read(Beam::Out<std::uint64_t> sequence_number);
 
+      /**
+       * Reads a batch of consecutive messages from the feed without copying
+       * them. The messages point into the packets received and remain valid
+       * until the next read.
+       * @param messages Stores the messages read.
+       * @param sequence_number The sequence number of the first message read.
+       * @return The number of messages read, at least one.
+       */
+      std::size_t read_batch(std::span<MoldUdp64Message> messages,
+        Beam::Out<std::uint64_t> sequence_number);
+
       void close();
 
     private:
       Beam::local_ptr_t<C> m_channel;
-      Beam::SharedBuffer m_buffer;
-      MoldUdp64Packet m_packet;
-      const char* m_source;
-      std::size_t m_remaining_size;
-      std::uint64_t m_sequence_number;
+      Beam::local_ptr_t<R> m_retransmitter;
+      MoldUdp64Sequencer m_sequencer;
+      boost::optional<MoldUdp64Gap> m_requested_gap;
       Beam::OpenState m_open_state;
 
       MoldUdp64Client(const MoldUdp64Client&) = delete;
@@ -61,62 +101,96 @@ namespace Nexus {
   template<typename C>
   MoldUdp64Client(C&&) -> MoldUdp64Client<std::remove_cvref_t<C>>;
 
-  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
+  template<typename C, typename R>
+  MoldUdp64Client(C&&, R&&) ->
+    MoldUdp64Client<std::remove_cvref_t<C>, std::remove_cvref_t<R>>;
+
+  template<typename C, typename R>
+  MoldUdp64Client(C&&, R&&, std::size_t) ->
+    MoldUdp64Client<std::remove_cvref_t<C>, std::remove_cvref_t<R>>;
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
   template<Beam::Initializes<C> CF>
-  MoldUdp64Client<C>::MoldUdp64Client(CF&& channel)
+  MoldUdp64Client<C, R>::MoldUdp64Client(CF&& channel)
+    : MoldUdp64Client(std::forward<CF>(channel), R()) {}
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  template<Beam::Initializes<C> CF, Beam::Initializes<R> RF>
+  MoldUdp64Client<C, R>::MoldUdp64Client(CF&& channel, RF&& retransmitter)
+    : MoldUdp64Client(std::forward<CF>(channel),
+        std::forward<RF>(retransmitter),
+        MoldUdp64Sequencer::DEFAULT_CAPACITY) {}
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  template<Beam::Initializes<C> CF, Beam::Initializes<R> RF>
+  MoldUdp64Client<C, R>::MoldUdp64Client(
+    CF&& channel, RF&& retransmitter, std::size_t capacity)
     try : m_channel(std::forward<CF>(channel)),
-          m_sequence_number(-1) {
+          m_retransmitter(std::forward<RF>(retransmitter)),
+          m_sequencer(capacity) {
     } catch(const std::exception&) {
       std::throw_with_nested(
         Beam::ConnectException("MoldUDP64 client failed to connect."));
     }
 
-  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
-  MoldUdp64Client<C>::~MoldUdp64Client() {
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  MoldUdp64Client<C, R>::~MoldUdp64Client() {
     close();
   }
 
-  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
-  MoldUdp64Message MoldUdp64Client<C>::read() {
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  MoldUdp64Message MoldUdp64Client<C, R>::read() {
     auto sequence_number = std::uint64_t();
     return read(Beam::out(sequence_number));
   }
 
-  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
-  MoldUdp64Message MoldUdp64Client<C>::read(
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  MoldUdp64Message MoldUdp64Client<C, R>::read(
       Beam::Out<std::uint64_t> sequence_number) {
-    if(m_sequence_number == -1 ||
-        m_sequence_number == m_packet.m_sequence_number + m_packet.m_count) {
-      while(true) {
-        reset(m_buffer);
-        Beam::try_or_nest([&] {
-          m_channel->get_reader().read(Beam::out(m_buffer));
-          m_packet = MoldUdp64Packet::parse(
-            std::string_view(m_buffer.get_data(), m_buffer.get_size()));
-        }, Beam::IOException("Failed to read MoldUDP64 packet."));
-        if(m_packet.m_count != 0) {
-          m_sequence_number = m_packet.m_sequence_number;
-          m_source = m_packet.m_payload;
-          m_remaining_size =
-            m_buffer.get_size() - MoldUdp64Packet::PACKET_LENGTH;
-          break;
-        }
-      }
-    }
-    auto message = Beam::try_or_nest([&] {
-      return MoldUdp64Message::parse(
-        std::string_view(m_source, m_remaining_size));
-    }, Beam::IOException("Failed to read MoldUDP64 packet."));
-    auto message_size = message.m_length + sizeof(message.m_length);
-    m_remaining_size -= message_size;
-    m_source += message_size;
-    *sequence_number = m_sequence_number;
-    ++m_sequence_number;
+    auto message = MoldUdp64Message();
+    read_batch(std::span(&message, 1), Beam::out(*sequence_number));
     return message;
   }
 
-  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
-  void MoldUdp64Client<C>::close() {
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  std::size_t MoldUdp64Client<C, R>::read_batch(
+      std::span<MoldUdp64Message> messages,
+      Beam::Out<std::uint64_t> sequence_number) {
+    return Details::read_sequenced(m_sequencer, *m_retransmitter,
+      m_requested_gap, messages, Beam::out(*sequence_number),
+      [&] (bool is_blocking) {
+        auto packet = boost::optional<Beam::SharedBuffer>();
+        if(is_blocking) {
+          packet.emplace(m_sequencer.acquire());
+          Beam::try_or_nest([&] {
+            m_channel->get_reader().read(Beam::out(*packet));
+          }, Beam::IOException("Failed to read MoldUDP64 packet."));
+        }
+        return packet;
+      },
+      [] (const MoldUdp64Gap& gap) {
+        return false;
+      });
+  }
+
+  template<typename C, typename R> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      IsMoldUdp64Retransmitter<Beam::dereference_t<R>>
+  void MoldUdp64Client<C, R>::close() {
     if(m_open_state.set_closing()) {
       return;
     }
@@ -0,0 +1,48 @@
+#ifndef NEXUS_MOLD_UDP_64_GAP_EXCEPTION_HPP
+#define NEXUS_MOLD_UDP_64_GAP_EXCEPTION_HPP
+#include <cstdint>
+#include <string>
+#include <Beam/IO/IOException.hpp>
+
+namespace Nexus {
+
+  /** Indicates that a range of MoldUDP64 messages could not be recovered. */
+  class MoldUdp64GapException : public Beam::IOException {
+    public:
+
+      /**
+       * Constructs a MoldUdp64GapException.
+       * @param sequence_number The sequence number of the first lost message.
+       * @param count The number of messages lost.
+       */
+      MoldUdp64GapException(std::uint64_t sequence_number, std::uint64_t count);
+
+      /** Returns the sequence number of the first lost message. */
+      std::uint64_t get_sequence_number() const;
+
+      /** Returns the number of messages lost. */
+      std::uint64_t get_count() const;
+
+    private:
+      std::uint64_t m_sequence_number;
+      std::uint64_t m_count;
+  };
+
+  inline MoldUdp64GapException::MoldUdp64GapException(
+    std::uint64_t sequence_number, std::uint64_t count)
+    : Beam::IOException("Lost " + std::to_string(count) +
+        " MoldUDP64 message(s) starting at " +
+        std::to_string(sequence_number) + "."),
+      m_sequence_number(sequence_number),
+      m_count(count) {}
+
+  inline std::uint64_t MoldUdp64GapException::get_sequence_number() const {
+    return m_sequence_number;
+  }
+
+  inline std::uint64_t MoldUdp64GapException::get_count() const {
+    return m_count;
+  }
+}
+
+#endif
@@ -18,6 +18,9 @@ namespace Nexus {
     /** The length of a session field. */
     static const auto SESSION_FIELD_LENGTH = std::size_t(10);
 
+    /** The message count that marks the end of a session. */
+    static const auto END_OF_SESSION = std::uint16_t(0xFFFF);
+
     /** Identity of the session the payload relates to. */
     Beam::FixedString<SESSION_FIELD_LENGTH> m_session;
 
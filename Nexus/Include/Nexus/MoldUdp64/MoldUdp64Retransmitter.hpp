@@ -0,0 +1,113 @@
+#ifndef NEXUS_MOLD_UDP_64_RETRANSMITTER_HPP
+#define NEXUS_MOLD_UDP_64_RETRANSMITTER_HPP
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <Beam/IO/Buffer.hpp>
+#include <Beam/IO/Channel.hpp>
+#include <Beam/IO/SharedBuffer.hpp>
+#include <Beam/Pointers/Dereference.hpp>
+#include <Beam/Pointers/LocalPtr.hpp>
+#include <Beam/Pointers/Out.hpp>
+#include <Beam/Utilities/FixedString.hpp>
+#include <Beam/Utilities/TypeTraits.hpp>
+#include <boost/endian/conversion.hpp>
+#include "Nexus/MoldUdp64/MoldUdp64Packet.hpp"
+
+namespace Nexus {
+
+  /** The session identifier carried by MoldUDP64 packets. */
+  using MoldUdp64Session =
+    Beam::FixedString<MoldUdp64Packet::SESSION_FIELD_LENGTH>;
+
+  /**
+   * Concept for types that request the retransmission of MoldUDP64
+   * messages that were not received.
+   */
+  template<typename T>
+  concept IsMoldUdp64Retransmitter = requires(T& retransmitter,
+      const MoldUdp64Session& session) {
+    { retransmitter.request(session, std::uint64_t(), std::uint16_t()) } ->
+        std::same_as<void>;
+  };
+
+  /**
+   * Returns a MoldUDP64 request packet.
+   * @param session The session the messages belong to.
+   * @param sequence_number The sequence number of the first message to
+   *        retransmit.
+   * @param count The number of messages to retransmit.
+   * @param buffer The Buffer to store the packet in.
+   */
+  template<Beam::IsBuffer B>
+  void make_request_packet(const MoldUdp64Session& session,
+      std::uint64_t sequence_number, std::uint16_t count,
+      Beam::Out<B> buffer) {
+    auto session_length = std::strlen(session.get_data());
+    append(*buffer, session.get_data(), session_length);
+    for(auto i = session_length; i < MoldUdp64Packet::SESSION_FIELD_LENGTH;
+        ++i) {
+      append(*buffer, '\0');
+    }
+    append(*buffer, boost::endian::native_to_big(sequence_number));
+    append(*buffer, boost::endian::native_to_big(count));
+  }
+
+  /** A MoldUDP64 retransmitter that never requests retransmission. */
+  struct NullMoldUdp64Retransmitter {
+    void request(const MoldUdp64Session& session,
+      std::uint64_t sequence_number, std::uint16_t count);
+  };
+
+  /**
+   * Sends MoldUDP64 request packets over a Channel, typically to a
+   * re-request server.
+   * @param <C> The type of Channel to send requests over.
+   */
+  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
+  class ChannelMoldUdp64Retransmitter {
+    public:
+
+      /** The type of Channel to send requests over. */
+      using Channel = Beam::dereference_t<C>;
+
+      /**
+       * Constructs a ChannelMoldUdp64Retransmitter.
+       * @param channel The Channel to send requests over.
+       */
+      template<Beam::Initializes<C> CF>
+      explicit ChannelMoldUdp64Retransmitter(CF&& channel);
+
+      void request(const MoldUdp64Session& session,
+        std::uint64_t sequence_number, std::uint16_t count);
+
+    private:
+      Beam::local_ptr_t<C> m_channel;
+      Beam::SharedBuffer m_buffer;
+  };
+
+  template<typename C>
+  ChannelMoldUdp64Retransmitter(C&&) ->
+    ChannelMoldUdp64Retransmitter<std::remove_cvref_t<C>>;
+
+  inline void NullMoldUdp64Retransmitter::request(
+    const MoldUdp64Session& session, std::uint64_t sequence_number,
+    std::uint16_t count) {}
+
+  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
+  template<Beam::Initializes<C> CF>
+  ChannelMoldUdp64Retransmitter<C>::ChannelMoldUdp64Retransmitter(
+    CF&& channel)
+    : m_channel(std::forward<CF>(channel)) {}
+
+  template<typename C> requires Beam::IsChannel<Beam::dereference_t<C>>
+  void ChannelMoldUdp64Retransmitter<C>::request(
+      const MoldUdp64Session& session, std::uint64_t sequence_number,
+      std::uint16_t count) {
+    reset(m_buffer);
+    make_request_packet(session, sequence_number, count, Beam::out(m_buffer));
+    m_channel->get_writer().write(m_buffer);
+  }
+}
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef NEXUS_MOLD_UDP_64_SEQUENCER_HPP
+#define NEXUS_MOLD_UDP_64_SEQUENCER_HPP
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <Beam/IO/IOException.hpp>
+#include <Beam/IO/SharedBuffer.hpp>
+#include <Beam/Pointers/Out.hpp>
+#include <Beam/Utilities/Expect.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/throw_exception.hpp>
+#include "Nexus/MoldUdp64/MoldUdp64GapException.hpp"
+#include "Nexus/MoldUdp64/MoldUdp64Message.hpp"
+#include "Nexus/MoldUdp64/MoldUdp64Packet.hpp"
+#include "Nexus/MoldUdp64/MoldUdp64Retransmitter.hpp"
+
+namespace Nexus {
+
+  /** Stores a range of MoldUDP64 sequence numbers that have not arrived. */
+  struct MoldUdp64Gap {
+
+    /** The sequence number of the first missing message. */
+    std::uint64_t m_sequence_number;
+
+    /** The number of missing messages. */
+    std::uint64_t m_count;
+
+    bool operator ==(const MoldUdp64Gap&) const = default;
+  };
+
+  /**
+   * Orders MoldUDP64 packets received out of sequence or from redundant
+   * lines, emitting every message exactly once and in sequence.
+   */
+  class MoldUdp64Sequencer {
+    public:
+
+      /** The default number of out of sequence packets to buffer. */
+      static constexpr auto DEFAULT_CAPACITY = std::size_t(1024);
+
+      /**
+       * Constructs a MoldUdp64Sequencer that starts at the first message
+       * received.
+       */
+      MoldUdp64Sequencer();
+
+      /**
+       * Constructs a MoldUdp64Sequencer that starts at the first message
+       * received.
+       * @param capacity The number of out of sequence packets to buffer.
+       */
+      explicit MoldUdp64Sequencer(std::size_t capacity);
+
+      /** Returns the session of the packets received. */
+      const MoldUdp64Session& get_session() const;
+
+      /** Returns the sequence number of the next message to emit. */
+      std::uint64_t get_next_sequence_number() const;
+
+      /**
+       * Returns the messages that must arrive before the next message can be
+       * emitted, or <code>none</code> if there are none.
+       */
+      boost::optional<MoldUdp64Gap> get_gap() const;
+
+      /** Returns <code>true</code> iff no further packets can be buffered. */
+      bool is_full() const;
+
+      /**
+       * Returns <code>true</code> iff the end of the session was announced.
+       */
+      bool is_ended() const;
+
+      /**
+       * Adds a packet. Packets whose messages have all been emitted are
+       * discarded, and an end of session packet carries no messages.
+       * @param packet The packet to add.
+       */
+      void push(Beam::SharedBuffer packet);
+
+      /**
+       * Returns the next message in sequence. The message points into the
+       * packet it was received in and remains valid until the next call to
+       * release.
+       * @param sequence_number The message's sequence number.
+       * @return The next message, or <code>none</code> if it has not arrived.
+       */
+      boost::optional<MoldUdp64Message> pop(
+        Beam::Out<std::uint64_t> sequence_number);
+
+      /**
+       * Gives up on the current gap, skipping to the next message buffered.
+       * @return The messages skipped.
+       */
+      MoldUdp64Gap skip();
+
+      /**
+       * Returns an empty buffer to receive a packet into, reusing the
+       * packets that were released.
+       */
+      Beam::SharedBuffer acquire();
+
+      /**
+       * Releases the packets whose messages have all been popped,
+       * invalidating the messages that point into them.
+       */
+      void release();
+
+    private:
+      std::size_t m_capacity;
+      bool m_is_started;
+      bool m_is_ended;
+      MoldUdp64Session m_session;
+      std::uint64_t m_next_sequence_number;
+      std::uint64_t m_last_sequence_number;
+      std::map<std::uint64_t, Beam::SharedBuffer> m_packets;
+      Beam::SharedBuffer m_buffer;
+      std::vector<Beam::SharedBuffer> m_retained;
+      std::vector<Beam::SharedBuffer> m_free;
+      const char* m_source;
+      std::size_t m_remaining_size;
+      std::uint64_t m_sequence_number;
+      std::uint16_t m_remaining_count;
+
+      MoldUdp64Message next_message();
+  };
+
+  inline MoldUdp64Sequencer::MoldUdp64Sequencer()
+    : MoldUdp64Sequencer(DEFAULT_CAPACITY) {}
+
+  inline MoldUdp64Sequencer::MoldUdp64Sequencer(std::size_t capacity)
+    : m_capacity(std::max<std::size_t>(capacity, 1)),
+      m_is_started(false),
+      m_is_ended(false),
+      m_next_sequence_number(0),
+      m_last_sequence_number(0),
+      m_source(nullptr),
+      m_remaining_size(0),
+      m_sequence_number(0),
+      m_remaining_count(0) {}
+
+  inline const MoldUdp64Session& MoldUdp64Sequencer::get_session() const {
+    return m_session;
+  }
+
+  inline std::uint64_t MoldUdp64Sequencer::get_next_sequence_number() const {
+    return m_next_sequence_number;
+  }
+
+  inline boost::optional<MoldUdp64Gap> MoldUdp64Sequencer::get_gap() const {
+    if(!m_is_started || m_remaining_count != 0) {
+      return boost::none;
+    }
+    auto end = m_last_sequence_number;
+    if(!m_packets.empty()) {
+      end = m_packets.begin()->first;
+    }
+    if(end <= m_next_sequence_number) {
+      return boost::none;
+    }
+    return MoldUdp64Gap(m_next_sequence_number, end - m_next_sequence_number);
+  }
+
+  inline bool MoldUdp64Sequencer::is_full() const {
+    return m_packets.size() >= m_capacity;
+  }
+
+  inline bool MoldUdp64Sequencer::is_ended() const {
+    return m_is_ended;
+  }
+
+  inline void MoldUdp64Sequencer::push(Beam::SharedBuffer packet) {
+    auto header = MoldUdp64Packet::parse(
+      std::string_view(packet.get_data(), packet.get_size()));
+    if(header.m_count == MoldUdp64Packet::END_OF_SESSION) {
+      m_is_ended = true;
+      header.m_count = 0;
+    }
+    if(!m_is_started) {
+      if(header.m_count == 0) {
+        return;
+      }
+      m_is_started = true;
+      m_session = header.m_session;
+      m_next_sequence_number = header.m_sequence_number;
+    }
+    auto end = header.m_sequence_number + header.m_count;
+    m_last_sequence_number = std::max(m_last_sequence_number, end);
+    if(header.m_count == 0 || end <= m_next_sequence_number) {
+      return;
+    }
+    m_packets.try_emplace(header.m_sequence_number, std::move(packet));
+  }
+
+  inline boost::optional<MoldUdp64Message> MoldUdp64Sequencer::pop(
+      Beam::Out<std::uint64_t> sequence_number) {
+    while(m_remaining_count == 0) {
+      if(m_packets.empty() ||
+          m_packets.begin()->first > m_next_sequence_number) {
+        return boost::none;
+      }
+      auto node = m_packets.extract(m_packets.begin());
+      if(m_buffer.get_size() != 0) {
+        m_retained.push_back(std::move(m_buffer));
+      }
+      m_buffer = std::move(node.mapped());
+      auto header = MoldUdp64Packet::parse(
+        std::string_view(m_buffer.get_data(), m_buffer.get_size()));
+      m_source = header.m_payload;
+      m_remaining_size = m_buffer.get_size() - MoldUdp64Packet::PACKET_LENGTH;
+      m_sequence_number = header.m_sequence_number;
+      m_remaining_count = header.m_count;
+      while(m_remaining_count != 0 &&
+          m_sequence_number < m_next_sequence_number) {
+        next_message();
+      }
+    }
+    auto message = next_message();
+    *sequence_number = m_sequence_number - 1;
+    m_next_sequence_number = m_sequence_number;
+    return message;
+  }
+
+  inline MoldUdp64Gap MoldUdp64Sequencer::skip() {
+    auto gap = get_gap();
+    if(!gap) {
+      return MoldUdp64Gap(m_next_sequence_number, 0);
+    }
+    m_next_sequence_number += gap->m_count;
+    return *gap;
+  }
+
+  inline Beam::SharedBuffer MoldUdp64Sequencer::acquire() {
+    if(m_free.empty()) {
+      return Beam::SharedBuffer();
+    }
+    auto buffer = std::move(m_free.back());
+    m_free.pop_back();
+    reset(buffer);
+    return buffer;
+  }
+
+  inline void MoldUdp64Sequencer::release() {
+    for(auto& buffer : m_retained) {
+      m_free.push_back(std::move(buffer));
+    }
+    m_retained.clear();
+  }
+
+  inline MoldUdp64Message MoldUdp64Sequencer::next_message() {
+    auto message = [&] {
+      try {
+        return MoldUdp64Message::parse(
+          std::string_view(m_source, m_remaining_size));
+      } catch(const std::exception&) {
+        m_remaining_count = 0;
+        throw;
+      }
+    }();
+    auto message_size = message.m_length + sizeof(message.m_length);
+    m_remaining_size -= message_size;
+    m_source += message_size;
+    ++m_sequence_number;
+    --m_remaining_count;
+    return message;
+  }
+
+namespace Details {
+  template<IsMoldUdp64Retransmitter R, typename F, typename P>
+  std::size_t read_sequenced(MoldUdp64Sequencer& sequencer, R& retransmitter,
+      boost::optional<MoldUdp64Gap>& requested_gap,
+      std::span<MoldUdp64Message> messages,
+      Beam::Out<std::uint64_t> sequence_number, F&& read_packet,
+      P&& is_pending) {
+    constexpr auto IS_RETRANSMITTING =
+      !std::is_same_v<std::remove_cvref_t<R>, NullMoldUdp64Retransmitter>;
+    sequencer.release();
+    auto count = std::size_t(0);
+    while(true) {
+      Beam::try_or_nest([&] {
+        auto message_sequence_number = std::uint64_t();
+        while(count != messages.size()) {
+          auto message = sequencer.pop(Beam::out(message_sequence_number));
+          if(!message) {
+            break;
+          }
+          if(count == 0) {
+            *sequence_number = message_sequence_number;
+          }
+          messages[count] = *message;
+          ++count;
+        }
+      }, Beam::IOException("Failed to read MoldUDP64 packet."));
+      if(count == messages.size()) {
+        return count;
+      }
+      auto packet = boost::optional<Beam::SharedBuffer>();
+      if(count != 0) {
+        packet = read_packet(false);
+        if(!packet) {
+          return count;
+        }
+      } else {
+        auto gap = sequencer.get_gap();
+        if(gap && !IS_RETRANSMITTING && !sequencer.is_full()) {
+          packet = read_packet(false);
+        }
+        if(gap && !packet && (sequencer.is_full() ||
+            !IS_RETRANSMITTING && !is_pending(*gap))) {
+          sequencer.skip();
+          requested_gap = boost::none;
+          boost::throw_with_location(
+            MoldUdp64GapException(gap->m_sequence_number, gap->m_count));
+        } else if(gap && IS_RETRANSMITTING && (!requested_gap ||
+            gap->m_sequence_number < requested_gap->m_sequence_number ||
+            gap->m_sequence_number + gap->m_count >
+              requested_gap->m_sequence_number + requested_gap->m_count)) {
+          retransmitter.request(sequencer.get_session(),
+            gap->m_sequence_number, static_cast<std::uint16_t>(std::min<
+              std::uint64_t>(gap->m_count, UINT16_MAX)));
+          requested_gap = gap;
+        }
+        if(!packet) {
+          packet = read_packet(true);
+        }
+      }
+      Beam::try_or_nest([&] {
+        sequencer.push(std::move(*packet));
+      }, Beam::IOException("Failed to read MoldUDP64 packet."));
+    }
+  }
+}
+}
+
+#endif
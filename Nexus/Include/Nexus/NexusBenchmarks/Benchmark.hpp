@@ -0,0 +1,152 @@
+#ifndef NEXUS_BENCHMARK_HPP
+#define NEXUS_BENCHMARK_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Nexus::Benchmarks {
+
+  /**
+   * Prepares the state used by a benchmark outside of the timed region.
+   * @param iterations The number of iterations the returned operation runs.
+   * @return The operation to time, running all <i>iterations</i>.
+   */
+  using BenchmarkSetup =
+    std::function<std::function<void ()> (std::int64_t iterations)>;
+
+  /** Stores a registered benchmark. */
+  struct Benchmark {
+
+    /** The benchmark's name. */
+    std::string m_name;
+
+    /** The number of iterations timed by each sample. */
+    std::int64_t m_iterations;
+
+    /** Prepares each sample. */
+    BenchmarkSetup m_setup;
+  };
+
+  /** Stores the timings measured by a benchmark. */
+  struct BenchmarkResult {
+
+    /** The benchmark's name. */
+    std::string m_name;
+
+    /** The number of iterations timed by each sample. */
+    std::int64_t m_iterations;
+
+    /** The nanoseconds taken per iteration by each sample. */
+    std::vector<double> m_samples;
+  };
+
+  /** The seed used by every benchmark's random number generator. */
+  inline constexpr auto BENCHMARK_SEED = std::uint32_t(20250814);
+
+  /** Returns all registered benchmarks. */
+  inline std::vector<Benchmark>& get_benchmarks() {
+    static auto benchmarks = std::vector<Benchmark>();
+    return benchmarks;
+  }
+
+  /**
+   * Registers a benchmark, typically from a namespace scope constant.
+   * @param name The benchmark's name.
+   * @param iterations The number of iterations timed by each sample.
+   * @param setup Prepares each sample.
+   * @return <code>true</code>.
+   */
+  inline bool register_benchmark(
+      std::string name, std::int64_t iterations, BenchmarkSetup setup) {
+    get_benchmarks().push_back(
+      Benchmark(std::move(name), iterations, std::move(setup)));
+    return true;
+  }
+
+  /**
+   * Returns a random number generator seeded with the BENCHMARK_SEED so that
+   * the inputs of every run are identical.
+   */
+  inline std::mt19937 make_generator() {
+    return std::mt19937(BENCHMARK_SEED);
+  }
+
+  /**
+   * Prevents the compiler from eliding the computation of a value.
+   * @param value The value to keep.
+   */
+  template<typename T>
+  void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "m"(value) : "memory");
+#else
+    static auto volatile sink = static_cast<const volatile void*>(nullptr);
+    sink = &value;
+#endif
+  }
+
+  /**
+   * Runs a benchmark, preparing each sample outside of the timed region.
+   * @param benchmark The benchmark to run.
+   * @param samples The number of samples to time, following one untimed
+   *        warm up sample.
+   * @return The timings measured.
+   */
+  inline BenchmarkResult run(const Benchmark& benchmark, int samples) {
+    auto result = BenchmarkResult(benchmark.m_name, benchmark.m_iterations);
+    benchmark.m_setup(benchmark.m_iterations)();
+    for(auto i = 0; i != samples; ++i) {
+      auto operation = benchmark.m_setup(benchmark.m_iterations);
+      auto start = std::chrono::steady_clock::now();
+      operation();
+      auto end = std::chrono::steady_clock::now();
+      result.m_samples.push_back(
+        std::chrono::duration<double, std::nano>(end - start).count() /
+          static_cast<double>(benchmark.m_iterations));
+    }
+    return result;
+  }
+
+  /**
+   * Writes a list of results as JSON.
+   * @param out The stream to write to.
+   * @param results The results to write.
+   */
+  inline void write_json(
+      std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << "{\n  \"benchmarks\": [";
+    auto prefix = "\n";
+    for(auto& result : results) {
+      auto samples = result.m_samples;
+      std::sort(samples.begin(), samples.end());
+      auto mean = 0.0;
+      auto median = 0.0;
+      if(!samples.empty()) {
+        mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+          static_cast<double>(samples.size());
+        auto middle = samples.size() / 2;
+        if(samples.size() % 2 == 0) {
+          median = (samples[middle - 1] + samples[middle]) / 2;
+        } else {
+          median = samples[middle];
+        }
+      }
+      out << prefix << "    {\"name\": \"" << result.m_name <<
+        "\", \"iterations\": " << result.m_iterations << ", \"samples\": " <<
+        samples.size() << ", \"mean_ns\": " << mean << ", \"median_ns\": " <<
+        median << ", \"min_ns\": " << (samples.empty() ? 0 : samples.front()) <<
+        ", \"max_ns\": " << (samples.empty() ? 0 : samples.back()) << "}";
+      prefix = ",\n";
+    }
+    out << "\n  ]\n}\n";
+  }
+}
+
+#endif
@@ -1,10 +1,10 @@
 #ifndef NEXUS_BUYING_POWER_CHECK_HPP
 #define NEXUS_BUYING_POWER_CHECK_HPP
+#include <unordered_map>
 #include <Beam/Collections/SynchronizedMap.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queues/MultiQueueWriter.hpp>
 #include <Beam/Queues/StateQueue.hpp>
-#include <Beam/Routines/RoutineHandler.hpp>
 #include <Beam/ServiceLocator/DirectoryEntry.hpp>
 #include <Beam/Threading/Sync.hpp>
 #include <Beam/Utilities/TypeTraits.hpp>
@@ -14,6 +14,8 @@
 #include "Nexus/Definitions/BboQuote.hpp"
 #include "Nexus/Definitions/ExchangeRateTable.hpp"
 #include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/Definitions/TickerId.hpp"
+#include "Nexus/MarketDataService/BboQuoteCache.hpp"
 #include "Nexus/MarketDataService/TickerQuery.hpp"
 #include "Nexus/OrderExecutionService/ExecutionReport.hpp"
 #include "Nexus/OrderExecutionService/Order.hpp"
@@ -54,6 +56,19 @@ namespace Nexus {
       BuyingPowerCheck(const ExchangeRateTable& exchange_rates,
         AF&& administration_client, MF&& market_data_client);
 
+      /**
+       * Constructs a BuyingPowerCheck that prices Orders from a shared
+       * BboQuoteCache.
+       * @param exchange_rates The list of ExchangeRates.
+       * @param administration_client Initializes the AdministrationClient.
+       * @param market_data_client Initializes the MarketDataClient.
+       * @param bbo_quotes The BboQuoteCache used to price Orders.
+       */
+      template<Beam::Initializes<A> AF, Beam::Initializes<M> MF>
+      BuyingPowerCheck(const ExchangeRateTable& exchange_rates,
+        AF&& administration_client, MF&& market_data_client,
+        std::shared_ptr<BboQuoteCache> bbo_quotes);
+
       void submit(const OrderInfo& info) override;
       void restore(const Beam::DirectoryEntry& account,
         const InventorySnapshot& snapshot,
@@ -68,20 +83,22 @@ namespace Nexus {
           m_risk_parameters_queue;
         Beam::MultiQueueWriter<ExecutionReport> m_execution_report_queue;
         Beam::SynchronizedUnorderedMap<OrderId, CurrencyId> m_currencies;
+        Beam::Sync<std::unordered_map<TickerId, BboQuoteCache::Handle>>
+          m_bbo_quote_handles;
 
         BuyingPowerEntry();
       };
       ExchangeRateTable m_exchange_rates;
       Beam::local_ptr_t<A> m_administration_client;
       Beam::local_ptr_t<M> m_market_data_client;
+      std::shared_ptr<BboQuoteCache> m_bbo_quotes;
       Beam::SynchronizedUnorderedMap<Beam::DirectoryEntry,
         std::shared_ptr<BuyingPowerEntry>> m_buying_power_entries;
-      Beam::SynchronizedUnorderedMap<
-        Ticker, std::shared_ptr<Beam::StateQueue<BboQuote>>> m_bbo_quotes;
-      std::vector<Beam::RoutineHandler> m_query_routines;
 
-      BboQuote load_bbo_quote(const Ticker& ticker);
-      Money get_expected_price(const OrderFields& fields);
+      BboQuote load_bbo_quote(BuyingPowerEntry& buying_power_entry,
+        TickerId id, const Ticker& ticker);
+      Money get_expected_price(BuyingPowerEntry& buying_power_entry,
+        TickerId id, const OrderFields& fields);
       BuyingPowerEntry& load_buying_power_entry(
         const Beam::DirectoryEntry& account);
   };
@@ -101,6 +118,23 @@ namespace Nexus {
         std::forward<M>(market_data_client));
   }
 
+  /**
+   * Makes a BuyingPowerCheck that prices Orders from a shared BboQuoteCache.
+   * @param exchange_rates The list of ExchangeRates.
+   * @param administration_client Initializes the AdministrationClient.
+   * @param market_data_client Initializes the MarketDataClient.
+   * @param bbo_quotes The BboQuoteCache used to price Orders.
+   */
+  template<IsAdministrationClient A, IsMarketDataClient M>
+  auto make_buying_power_check(const ExchangeRateTable& exchange_rates,
+      A&& administration_client, M&& market_data_client,
+      std::shared_ptr<BboQuoteCache> bbo_quotes) {
+    return std::make_unique<
+      BuyingPowerCheck<std::remove_reference_t<A>, std::remove_reference_t<M>>>(
+        exchange_rates, std::forward<A>(administration_client),
+        std::forward<M>(market_data_client), std::move(bbo_quotes));
+  }
+
   template<typename A, typename M> requires
     IsAdministrationClient<Beam::dereference_t<A>> &&
       IsMarketDataClient<Beam::dereference_t<M>>
@@ -117,15 +151,30 @@ namespace Nexus {
     MF&& market_data_client)
     : m_exchange_rates(exchange_rates),
       m_administration_client(std::forward<AF>(administration_client)),
-      m_market_data_client(std::forward<MF>(market_data_client)) {}
+      m_market_data_client(std::forward<MF>(market_data_client)),
+      m_bbo_quotes(std::make_shared<BboQuoteCache>(
+        Nexus::MarketDataClient(&*m_market_data_client))) {}
+
+  template<typename A, typename M> requires
+    IsAdministrationClient<Beam::dereference_t<A>> &&
+      IsMarketDataClient<Beam::dereference_t<M>>
+  template<Beam::Initializes<A> AF, Beam::Initializes<M> MF>
+  BuyingPowerCheck<A, M>::BuyingPowerCheck(
+    const ExchangeRateTable& exchange_rates, AF&& administration_client,
+    MF&& market_data_client, std::shared_ptr<BboQuoteCache> bbo_quotes)
+    : m_exchange_rates(exchange_rates),
+      m_administration_client(std::forward<AF>(administration_client)),
+      m_market_data_client(std::forward<MF>(market_data_client)),
+      m_bbo_quotes(std::move(bbo_quotes)) {}
 
   template<typename A, typename M> requires
     IsAdministrationClient<Beam::dereference_t<A>> &&
       IsMarketDataClient<Beam::dereference_t<M>>
   void BuyingPowerCheck<A, M>::submit(const OrderInfo& info) {
     auto& fields = info.m_fields;
-    auto price = get_expected_price(fields);
     auto& buying_power_entry = load_buying_power_entry(fields.m_account);
+    auto ticker = get_ticker_id(info);
+    auto price = get_expected_price(buying_power_entry, ticker, fields);
     Beam::with(
       buying_power_entry.m_buying_power_model, [&] (auto& buying_power_model) {
         auto risk_parameters =
@@ -158,7 +207,7 @@ namespace Nexus {
         }
         buying_power_entry.m_currencies.insert(info.m_id, fields.m_currency);
         auto updated_buying_power = buying_power_model.submit(
-          info.m_id, converted_fields, converted_price);
+          info.m_id, ticker, converted_fields, converted_price);
         if(updated_buying_power > risk_parameters.m_buying_power) {
           auto report = ExecutionReport();
           report.m_id = info.m_id;
@@ -206,9 +255,11 @@ namespace Nexus {
   void BuyingPowerCheck<A, M>::add(const std::shared_ptr<Order>& order) {
     auto& buying_power_entry =
       load_buying_power_entry(order->get_info().m_fields.m_account);
+    auto ticker = get_ticker_id(order->get_info());
     auto price = [&] {
       try {
-        return get_expected_price(order->get_info().m_fields);
+        return get_expected_price(
+          buying_power_entry, ticker, order->get_info().m_fields);
       } catch(const std::exception&) {
         if(order->get_info().m_fields.m_type == OrderType::LIMIT) {
           return order->get_info().m_fields.m_price;
@@ -237,7 +288,7 @@ namespace Nexus {
           return;
         }
         buying_power_model.submit(
-          order->get_info().m_id, converted_fields, converted_price);
+          order->get_info().m_id, ticker, converted_fields, converted_price);
       });
     order->get_publisher().monitor(
       buying_power_entry.m_execution_report_queue.get_writer());
@@ -263,17 +314,22 @@ namespace Nexus {
   template<typename A, typename M> requires
     IsAdministrationClient<Beam::dereference_t<A>> &&
       IsMarketDataClient<Beam::dereference_t<M>>
-  BboQuote BuyingPowerCheck<A, M>::load_bbo_quote(const Ticker& ticker) {
-    auto publisher = m_bbo_quotes.get_or_insert(ticker, [&] {
-      auto publisher = std::make_shared<Beam::StateQueue<BboQuote>>();
-      m_query_routines.push_back(query_real_time_with_snapshot(
-        *m_market_data_client, ticker, publisher));
-      return publisher;
-    });
+  BboQuote BuyingPowerCheck<A, M>::load_bbo_quote(
+      BuyingPowerEntry& buying_power_entry, TickerId id, const Ticker& ticker) {
+    auto bbo_quote = Beam::with(
+      buying_power_entry.m_bbo_quote_handles, [&] (auto& handles) {
+        if(auto i = handles.find(id); i != handles.end()) {
+          return i->second;
+        }
+        return handles.emplace(id, m_bbo_quotes->get(ticker)).first->second;
+      });
     try {
-      return publisher->peek();
+      return bbo_quote.load();
     } catch(const Beam::PipeBrokenException&) {
-      m_bbo_quotes.erase(ticker);
+      Beam::with(
+        buying_power_entry.m_bbo_quote_handles, [&] (auto& handles) {
+          handles.erase(id);
+        });
       boost::throw_with_location(
         OrderSubmissionCheckException("No BBO quote available."));
     }
@@ -282,8 +338,10 @@ namespace Nexus {
   template<typename A, typename M> requires
     IsAdministrationClient<Beam::dereference_t<A>> &&
       IsMarketDataClient<Beam::dereference_t<M>>
-  Money BuyingPowerCheck<A, M>::get_expected_price(const OrderFields& fields) {
-    auto bbo = load_bbo_quote(fields.m_ticker);
+  Money BuyingPowerCheck<A, M>::get_expected_price(
+      BuyingPowerEntry& buying_power_entry, TickerId id,
+      const OrderFields& fields) {
+    auto bbo = load_bbo_quote(buying_power_entry, id, fields.m_ticker);
     if(fields.m_type == OrderType::LIMIT) {
       if(fields.m_price <= Money::ZERO) {
         boost::throw_with_location(
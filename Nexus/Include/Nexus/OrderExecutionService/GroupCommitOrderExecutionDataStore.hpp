@@ -0,0 +1,440 @@
+#ifndef NEXUS_GROUP_COMMIT_ORDER_EXECUTION_DATA_STORE_HPP
+#define NEXUS_GROUP_COMMIT_ORDER_EXECUTION_DATA_STORE_HPP
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <Beam/IO/OpenState.hpp>
+#include <Beam/Pointers/Dereference.hpp>
+#include <Beam/Pointers/LocalPtr.hpp>
+#include <Beam/Queues/RoutineTaskQueue.hpp>
+#include <Beam/Routines/Async.hpp>
+#include <Beam/Routines/RoutineHandler.hpp>
+#include <Beam/Threading/Mutex.hpp>
+#include <Beam/TimeService/Timer.hpp>
+#include <Beam/Utilities/ReportException.hpp>
+#include "Nexus/OrderExecutionService/LocalOrderExecutionDataStore.hpp"
+#include "Nexus/OrderExecutionService/OrderExecutionDataStore.hpp"
+
+namespace Nexus {
+
+  /**
+   * Accumulates submissions and execution reports in memory and commits them
+   * to an underlying OrderExecutionDataStore in batches. Uncommitted records
+   * remain visible to readers until their batch is committed. A batch that
+   * fails to commit is kept and retried before any later batch.
+   * @param <D> The type of OrderExecutionDataStore to commit to.
+   */
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  class GroupCommitOrderExecutionDataStore {
+    public:
+
+      /** The type of OrderExecutionDataStore to commit to. */
+      using OrderExecutionDataStore = Beam::dereference_t<D>;
+
+      /**
+       * Constructs a GroupCommitOrderExecutionDataStore.
+       * @param data_store Initializes the data store to commit to.
+       * @param batch_size The number of records that triggers a commit.
+       * @param commit_timer The Timer used to commit any pending records.
+       */
+      template<Beam::Initializes<D> DF>
+      GroupCommitOrderExecutionDataStore(DF&& data_store,
+        std::size_t batch_size, std::unique_ptr<Beam::Timer> commit_timer);
+
+      ~GroupCommitOrderExecutionDataStore();
+
+      boost::optional<SequencedAccountOrderRecord>
+        load_order_record(OrderId id);
+      std::vector<SequencedOrderRecord>
+        load_order_records(const AccountQuery& query);
+      void store(const SequencedAccountOrderInfo& info);
+      void store(const std::vector<SequencedAccountOrderInfo>& info);
+      std::vector<SequencedExecutionReport>
+        load_execution_reports(const AccountQuery& query);
+      void store(const SequencedAccountExecutionReport& report);
+      void store(const std::vector<SequencedAccountExecutionReport>& reports);
+      InventorySnapshot load_inventory_snapshot(
+        const Beam::DirectoryEntry& account);
+      void store(const Beam::DirectoryEntry& account,
+        const InventorySnapshot& snapshot);
+      void close();
+
+    private:
+      struct Batch {
+        std::vector<SequencedAccountOrderInfo> m_submissions;
+        std::vector<SequencedAccountExecutionReport> m_reports;
+        std::unordered_map<OrderId, std::vector<ExecutionReport>>
+          m_order_reports;
+        LocalOrderExecutionDataStore m_overlay;
+        bool m_is_commit_requested;
+
+        Batch();
+      };
+      Beam::local_ptr_t<D> m_data_store;
+      std::size_t m_batch_size;
+      std::unique_ptr<Beam::Timer> m_commit_timer;
+      mutable Beam::Mutex m_mutex;
+      std::shared_ptr<Batch> m_pending_batch;
+      std::shared_ptr<Batch> m_committing_batch;
+      Beam::OpenState m_open_state;
+      Beam::RoutineTaskQueue m_tasks;
+      Beam::RoutineHandler m_commit_loop;
+
+      GroupCommitOrderExecutionDataStore(
+        const GroupCommitOrderExecutionDataStore&) = delete;
+      GroupCommitOrderExecutionDataStore& operator =(
+        const GroupCommitOrderExecutionDataStore&) = delete;
+      template<typename T>
+      static void truncate(
+        std::vector<T>& values, const Beam::SnapshotLimit& limit);
+      std::vector<std::shared_ptr<Batch>> load_batches() const;
+      void merge(const std::vector<std::shared_ptr<Batch>>& batches,
+        OrderRecord& record) const;
+      template<typename F>
+      void append(F&& f);
+      void write(Batch& batch);
+      void commit();
+      void try_commit();
+      void commit_loop();
+  };
+
+  template<typename D>
+  GroupCommitOrderExecutionDataStore(
+    D&&, std::size_t, std::unique_ptr<Beam::Timer>) ->
+      GroupCommitOrderExecutionDataStore<std::remove_cvref_t<D>>;
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  GroupCommitOrderExecutionDataStore<D>::Batch::Batch()
+    : m_is_commit_requested(false) {}
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  template<Beam::Initializes<D> DF>
+  GroupCommitOrderExecutionDataStore<D>::GroupCommitOrderExecutionDataStore(
+      DF&& data_store, std::size_t batch_size,
+      std::unique_ptr<Beam::Timer> commit_timer)
+      : m_data_store(std::forward<DF>(data_store)),
+        m_batch_size(std::max<std::size_t>(batch_size, 1)),
+        m_commit_timer(std::move(commit_timer)),
+        m_pending_batch(std::make_shared<Batch>()) {
+    m_commit_loop = Beam::spawn(std::bind_front(
+      &GroupCommitOrderExecutionDataStore::commit_loop, this));
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  GroupCommitOrderExecutionDataStore<D>::~GroupCommitOrderExecutionDataStore() {
+    try {
+      close();
+    } catch(const std::exception&) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  boost::optional<SequencedAccountOrderRecord>
+      GroupCommitOrderExecutionDataStore<D>::load_order_record(OrderId id) {
+    auto batches = load_batches();
+    auto record = m_data_store->load_order_record(id);
+    for(auto& batch : batches) {
+      if(record) {
+        break;
+      }
+      record = batch->m_overlay.load_order_record(id);
+    }
+    if(record) {
+      merge(batches, ***record);
+    }
+    return record;
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  std::vector<SequencedOrderRecord>
+      GroupCommitOrderExecutionDataStore<D>::load_order_records(
+        const AccountQuery& query) {
+    auto batches = load_batches();
+    auto records = m_data_store->load_order_records(query);
+    for(auto& batch : batches) {
+      auto pending_records = batch->m_overlay.load_order_records(query);
+      if(pending_records.empty()) {
+        continue;
+      }
+      auto merged_records = std::vector<SequencedOrderRecord>();
+      std::ranges::set_union(records, pending_records,
+        std::back_inserter(merged_records), Beam::SequenceComparator());
+      records = std::move(merged_records);
+    }
+    for(auto& record : records) {
+      merge(batches, *record);
+    }
+    truncate(records, query.get_snapshot_limit());
+    return records;
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::store(
+      const SequencedAccountOrderInfo& info) {
+    append([&] (auto& batch) {
+      batch.m_submissions.push_back(info);
+      batch.m_overlay.store(info);
+    });
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::store(
+      const std::vector<SequencedAccountOrderInfo>& info) {
+    append([&] (auto& batch) {
+      batch.m_submissions.insert(
+        batch.m_submissions.end(), info.begin(), info.end());
+      batch.m_overlay.store(info);
+    });
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  std::vector<SequencedExecutionReport>
+      GroupCommitOrderExecutionDataStore<D>::load_execution_reports(
+        const AccountQuery& query) {
+    auto batches = load_batches();
+    auto reports = m_data_store->load_execution_reports(query);
+    for(auto& batch : batches) {
+      auto pending_reports = batch->m_overlay.load_execution_reports(query);
+      if(pending_reports.empty()) {
+        continue;
+      }
+      auto merged_reports = std::vector<SequencedExecutionReport>();
+      std::ranges::set_union(reports, pending_reports,
+        std::back_inserter(merged_reports), Beam::SequenceComparator());
+      reports = std::move(merged_reports);
+    }
+    truncate(reports, query.get_snapshot_limit());
+    return reports;
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::store(
+      const SequencedAccountExecutionReport& report) {
+    append([&] (auto& batch) {
+      batch.m_reports.push_back(report);
+      batch.m_order_reports[(*report)->m_id].push_back(**report);
+      batch.m_overlay.store(report);
+    });
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::store(
+      const std::vector<SequencedAccountExecutionReport>& reports) {
+    append([&] (auto& batch) {
+      batch.m_reports.insert(
+        batch.m_reports.end(), reports.begin(), reports.end());
+      for(auto& report : reports) {
+        batch.m_order_reports[(*report)->m_id].push_back(**report);
+      }
+      batch.m_overlay.store(reports);
+    });
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  InventorySnapshot
+      GroupCommitOrderExecutionDataStore<D>::load_inventory_snapshot(
+        const Beam::DirectoryEntry& account) {
+    return m_data_store->load_inventory_snapshot(account);
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::store(
+      const Beam::DirectoryEntry& account, const InventorySnapshot& snapshot) {
+    auto result = Beam::Async<void>();
+    m_tasks.push([&] {
+      try {
+        commit();
+        m_data_store->store(account, snapshot);
+        result.get_eval().set();
+      } catch(const std::exception&) {
+        result.get_eval().set_exception(std::current_exception());
+      }
+    });
+    result.get();
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::close() {
+    if(m_open_state.set_closing()) {
+      return;
+    }
+    m_commit_timer->cancel();
+    m_commit_loop.wait();
+    auto result = Beam::Async<void>();
+    m_tasks.push([&] {
+      try {
+        commit();
+        result.get_eval().set();
+      } catch(const std::exception&) {
+        result.get_eval().set_exception(std::current_exception());
+      }
+    });
+    m_tasks.close();
+    m_tasks.wait();
+    m_data_store->close();
+    m_open_state.close();
+    result.get();
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  template<typename T>
+  void GroupCommitOrderExecutionDataStore<D>::truncate(
+      std::vector<T>& values, const Beam::SnapshotLimit& limit) {
+    if(static_cast<int>(values.size()) <= limit.get_size()) {
+      return;
+    }
+    if(limit.get_type() == Beam::SnapshotLimit::Type::TAIL) {
+      values.erase(values.begin(), values.end() - limit.get_size());
+    } else {
+      values.erase(values.begin() + limit.get_size(), values.end());
+    }
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  std::vector<std::shared_ptr<
+      typename GroupCommitOrderExecutionDataStore<D>::Batch>>
+        GroupCommitOrderExecutionDataStore<D>::load_batches() const {
+    auto batches = std::vector<std::shared_ptr<Batch>>();
+    auto lock = std::lock_guard(m_mutex);
+    if(m_committing_batch) {
+      batches.push_back(m_committing_batch);
+    }
+    batches.push_back(m_pending_batch);
+    return batches;
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::merge(
+      const std::vector<std::shared_ptr<Batch>>& batches,
+      OrderRecord& record) const {
+    auto& reports = record.m_execution_reports;
+    auto lock = std::lock_guard(m_mutex);
+    for(auto& batch : batches) {
+      auto pending_reports = batch->m_order_reports.find(record.m_info.m_id);
+      if(pending_reports == batch->m_order_reports.end()) {
+        continue;
+      }
+      for(auto& report : pending_reports->second) {
+        auto position = std::lower_bound(reports.begin(), reports.end(),
+          report, [] (const auto& lhs, const auto& rhs) {
+            return lhs.m_sequence < rhs.m_sequence;
+          });
+        if(position == reports.end() ||
+            position->m_sequence != report.m_sequence) {
+          reports.insert(position, report);
+        }
+      }
+    }
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  template<typename F>
+  void GroupCommitOrderExecutionDataStore<D>::append(F&& f) {
+    auto is_full = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      std::forward<F>(f)(*m_pending_batch);
+      if(m_pending_batch->m_is_commit_requested ||
+          m_pending_batch->m_submissions.size() +
+            m_pending_batch->m_reports.size() < m_batch_size) {
+        return false;
+      }
+      m_pending_batch->m_is_commit_requested = true;
+      return true;
+    }();
+    if(is_full) {
+      m_tasks.push(
+        std::bind_front(&GroupCommitOrderExecutionDataStore::try_commit, this));
+    }
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::write(Batch& batch) {
+    if(!batch.m_submissions.empty()) {
+      m_data_store->store(batch.m_submissions);
+      batch.m_submissions.clear();
+    }
+    if(!batch.m_reports.empty()) {
+      m_data_store->store(batch.m_reports);
+      batch.m_reports.clear();
+    }
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::commit() {
+    auto failed_batch = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      return m_committing_batch;
+    }();
+    if(failed_batch) {
+      write(*failed_batch);
+      auto lock = std::lock_guard(m_mutex);
+      m_committing_batch = nullptr;
+    }
+    auto batch = [&] {
+      auto lock = std::lock_guard(m_mutex);
+      if(m_pending_batch->m_submissions.empty() &&
+          m_pending_batch->m_reports.empty()) {
+        return std::shared_ptr<Batch>();
+      }
+      m_committing_batch = std::move(m_pending_batch);
+      m_pending_batch = std::make_shared<Batch>();
+      return m_committing_batch;
+    }();
+    if(!batch) {
+      return;
+    }
+    write(*batch);
+    auto lock = std::lock_guard(m_mutex);
+    m_committing_batch = nullptr;
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::try_commit() {
+    try {
+      commit();
+    } catch(const std::exception&) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+  }
+
+  template<typename D> requires
+    IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void GroupCommitOrderExecutionDataStore<D>::commit_loop() {
+    while(m_open_state.is_open()) {
+      m_commit_timer->start();
+      m_commit_timer->wait();
+      if(!m_open_state.is_open()) {
+        break;
+      }
+      m_tasks.push(
+        std::bind_front(&GroupCommitOrderExecutionDataStore::try_commit, this));
+    }
+  }
+}
+
+#endif
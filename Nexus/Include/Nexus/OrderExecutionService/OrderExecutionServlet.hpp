@@ -2,12 +2,16 @@
 #define NEXUS_ORDER_EXECUTION_SERVLET_HPP
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
 #include <Beam/Collections/SynchronizedMap.hpp>
 #include <Beam/Collections/SynchronizedSet.hpp>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Queries/IndexedSubscriptions.hpp>
 #include <Beam/Queues/RoutineTaskQueue.hpp>
+#include <Beam/Routines/Async.hpp>
 #include <Beam/Serialization/JsonSender.hpp>
 #include <Beam/Threading/Mutex.hpp>
 #include <Beam/Threading/Sync.hpp>
@@ -21,6 +25,7 @@
 #include "Nexus/AdministrationService/AdministrationClient.hpp"
 #include "Nexus/AdministrationService/TradingGroup.hpp"
 #include "Nexus/Definitions/Destination.hpp"
+#include "Nexus/Definitions/TickerId.hpp"
 #include "Nexus/Definitions/Venue.hpp"
 #include "Nexus/OrderExecutionService/OrderExecutionDriver.hpp"
 #include "Nexus/OrderExecutionService/OrderExecutionServices.hpp"
@@ -95,6 +100,27 @@ namespace Nexus {
         UF&& uid_client, AF&& administration_client, OF&& driver,
         DF&& data_store);
 
+      /**
+       * Constructs an OrderExecutionServlet that processes execution reports
+       * on a set of dedicated workers. Reports are assigned to workers by
+       * hashing their account so that each account's reports are processed in
+       * order, while reports for different accounts are processed in parallel.
+       * Reports are persisted in batches by a separate writer.
+       * @param time_client Initializes the TimeClient.
+       * @param service_locator_client Initializes the ServiceLocatorClient.
+       * @param uid_client Initializes the UidClient.
+       * @param administration_client Initializes the AdministrationClient.
+       * @param driver Initializes the OrderExecutionDriver.
+       * @param data_store Initializes the OrderExecutionDataStore.
+       * @param worker_count The number of dedicated workers.
+       */
+      template<Beam::Initializes<T> TF, Beam::Initializes<S> SF,
+        Beam::Initializes<U> UF, Beam::Initializes<A> AF,
+        Beam::Initializes<O> OF, Beam::Initializes<D> DF>
+      OrderExecutionServlet(TF&& time_client, SF&& service_locator_client,
+        UF&& uid_client, AF&& administration_client, OF&& driver,
+        DF&& data_store, int worker_count);
+
       void register_services(
         Beam::Out<Beam::ServiceSlots<ServiceProtocolClient>> slots);
       void handle_accept(ServiceProtocolClient& client);
@@ -129,11 +155,22 @@ namespace Nexus {
       Beam::SynchronizedUnorderedMap<Beam::DirectoryEntry,
         std::shared_ptr<SyncSnapshotCheckpoint>> m_checkpoints;
       Beam::SynchronizedUnorderedSet<OrderId> m_live_orders;
+      Beam::Sync<std::vector<SequencedAccountExecutionReport>, Beam::Mutex>
+        m_pending_reports;
+      std::vector<SequencedAccountExecutionReport> m_unwritten_reports;
       Beam::OpenState m_open_state;
-      Beam::RoutineTaskQueue m_tasks;
+      std::vector<std::unique_ptr<Beam::RoutineTaskQueue>> m_tasks;
+      Beam::RoutineTaskQueue m_writer;
 
       OrderExecutionServlet(const OrderExecutionServlet&) = delete;
       OrderExecutionServlet& operator =(const OrderExecutionServlet&) = delete;
+      Beam::RoutineTaskQueue& get_tasks(const Beam::DirectoryEntry& account);
+      void persist(const SequencedAccountExecutionReport& report);
+      void persist(const Beam::DirectoryEntry& account,
+        const InventorySnapshot& snapshot);
+      void flush_reports();
+      void write_reports();
+      void wait_for_writes();
       void recover(const Beam::DirectoryEntry& account);
       void recover_trading_session();
       void on_execution_report(const ExecutionReport& report,
@@ -184,12 +221,35 @@ namespace Nexus {
   OrderExecutionServlet<C, T, S, U, A, O, D>::OrderExecutionServlet(
       TF&& time_client, SF&& service_locator_client, UF&& uid_client,
       AF&& administration_client, OF&& driver, DF&& data_store)
+    : OrderExecutionServlet(std::forward<TF>(time_client),
+        std::forward<SF>(service_locator_client), std::forward<UF>(uid_client),
+        std::forward<AF>(administration_client), std::forward<OF>(driver),
+        std::forward<DF>(data_store), 1) {}
+
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  template<Beam::Initializes<T> TF, Beam::Initializes<S> SF,
+    Beam::Initializes<U> UF, Beam::Initializes<A> AF, Beam::Initializes<O> OF,
+    Beam::Initializes<D> DF>
+  OrderExecutionServlet<C, T, S, U, A, O, D>::OrderExecutionServlet(
+      TF&& time_client, SF&& service_locator_client, UF&& uid_client,
+      AF&& administration_client, OF&& driver, DF&& data_store,
+      int worker_count)
     : m_time_client(std::forward<TF>(time_client)),
       m_service_locator_client(std::forward<SF>(service_locator_client)),
       m_uid_client(std::forward<UF>(uid_client)),
       m_administration_client(std::forward<AF>(administration_client)),
       m_driver(std::forward<OF>(driver)),
       m_data_store(std::forward<DF>(data_store)) {
+    for(auto i = 0; i < std::max(worker_count, 1); ++i) {
+      m_tasks.push_back(std::make_unique<Beam::RoutineTaskQueue>());
+    }
     try {
       auto accounts = m_service_locator_client->load_all_accounts();
       for(auto& account : accounts) {
@@ -291,8 +351,23 @@ namespace Nexus {
     if(m_open_state.set_closing()) {
       return;
     }
-    m_tasks.close();
-    m_tasks.wait();
+    for(auto& tasks : m_tasks) {
+      tasks->close();
+    }
+    for(auto& tasks : m_tasks) {
+      tasks->wait();
+    }
+    m_writer.close();
+    m_writer.wait();
+    try {
+      write_reports();
+    } catch(const std::exception&) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+      for(auto& report : m_unwritten_reports) {
+        std::cout << "\texecution_report: " << Beam::to_json(report) << "\n";
+      }
+      std::cout << std::flush;
+    }
     m_data_store->close();
     m_driver->close();
     m_shorting_models.clear();
@@ -300,6 +375,116 @@ namespace Nexus {
     m_open_state.close();
   }
 
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  Beam::RoutineTaskQueue& OrderExecutionServlet<C, T, S, U, A, O, D>::
+      get_tasks(const Beam::DirectoryEntry& account) {
+    return *m_tasks[std::hash<Beam::DirectoryEntry>()(account) %
+      m_tasks.size()];
+  }
+
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void OrderExecutionServlet<C, T, S, U, A, O, D>::persist(
+      const SequencedAccountExecutionReport& report) {
+    auto is_flush_pending = Beam::with(m_pending_reports, [&] (auto& reports) {
+      reports.push_back(report);
+      return reports.size() != 1;
+    });
+    if(!is_flush_pending) {
+      m_writer.push(
+        std::bind_front(&OrderExecutionServlet::flush_reports, this));
+    }
+  }
+
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void OrderExecutionServlet<C, T, S, U, A, O, D>::persist(
+      const Beam::DirectoryEntry& account, const InventorySnapshot& snapshot) {
+    m_writer.push([=, this] {
+      try {
+        write_reports();
+        m_data_store->store(account, snapshot);
+      } catch(const std::exception&) {
+        std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+        std::cout << "\taccount: " << Beam::to_json(account) << std::endl;
+      }
+    });
+  }
+
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void OrderExecutionServlet<C, T, S, U, A, O, D>::flush_reports() {
+    auto reports = std::vector<SequencedAccountExecutionReport>();
+    Beam::with(m_pending_reports, [&] (auto& pending_reports) {
+      reports.swap(pending_reports);
+    });
+    m_unwritten_reports.insert(m_unwritten_reports.end(),
+      std::make_move_iterator(reports.begin()),
+      std::make_move_iterator(reports.end()));
+    try {
+      write_reports();
+    } catch(const std::exception&) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+  }
+
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void OrderExecutionServlet<C, T, S, U, A, O, D>::write_reports() {
+    if(m_unwritten_reports.empty()) {
+      return;
+    }
+    m_data_store->store(m_unwritten_reports);
+    m_unwritten_reports.clear();
+  }
+
+  template<typename C, typename T, typename S, typename U, typename A,
+    typename O, typename D> requires
+      Beam::IsTimeClient<Beam::dereference_t<T>> &&
+        Beam::IsServiceLocatorClient<Beam::dereference_t<S>> &&
+          Beam::IsUidClient<Beam::dereference_t<U>> &&
+            IsAdministrationClient<Beam::dereference_t<A>> &&
+              IsOrderExecutionDriver<Beam::dereference_t<O>> &&
+                IsOrderExecutionDataStore<Beam::dereference_t<D>>
+  void OrderExecutionServlet<C, T, S, U, A, O, D>::wait_for_writes() {
+    auto flush = Beam::Async<void>();
+    m_writer.push([&] {
+      flush.get_eval().set();
+    });
+    flush.get();
+  }
+
   template<typename C, typename T, typename S, typename U, typename A,
     typename O, typename D> requires
       Beam::IsTimeClient<Beam::dereference_t<T>> &&
@@ -367,16 +552,17 @@ namespace Nexus {
       });
       order->get_publisher().with([&] {
         auto existing_reports = boost::optional<std::vector<ExecutionReport>>();
-        order->get_publisher().monitor(m_tasks.get_slot<ExecutionReport>(
-          std::bind(&OrderExecutionServlet::on_execution_report, this,
-            std::placeholders::_1, account, std::ref(shorting_model),
-            std::ref(*checkpoint))), Beam::out(existing_reports));
+        order->get_publisher().monitor(
+          get_tasks(account).get_slot<ExecutionReport>(
+            std::bind(&OrderExecutionServlet::on_execution_report, this,
+              std::placeholders::_1, account, std::ref(shorting_model),
+              std::ref(*checkpoint))), Beam::out(existing_reports));
         if(existing_reports) {
           existing_reports->erase(
             existing_reports->begin(), existing_reports->begin() +
               order_record->m_execution_reports.size());
           for(auto& report : *existing_reports) {
-            m_tasks.push(std::bind_front(
+            get_tasks(account).push(std::bind_front(
               &OrderExecutionServlet::on_execution_report, this, report,
               account, std::ref(shorting_model), std::ref(*checkpoint)));
           }
@@ -424,7 +610,7 @@ namespace Nexus {
           return load_initial_sequences(*m_data_store, account);
         },
         [&] (const auto& sequenced_report) {
-          m_data_store->store(sequenced_report);
+          persist(sequenced_report);
           m_order_subscriptions.publish(sequenced_report,
             [&] (const auto& clients) {
               Beam::broadcast_record_message<OrderUpdateMessage>(
@@ -439,7 +625,7 @@ namespace Nexus {
       Beam::with(checkpoint, [&] (auto& checkpoint) {
         checkpoint.m_model.update(report);
         if(report.m_timestamp - checkpoint.m_timestamp > SNAPSHOT_INTERVAL) {
-          m_data_store->store(account, checkpoint.m_model.make_snapshot());
+          persist(account, checkpoint.m_model.make_snapshot());
           checkpoint.m_timestamp = report.m_timestamp;
         }
       });
@@ -490,6 +676,7 @@ namespace Nexus {
     try {
       auto result = ExecutionReportQueryResult();
       result.m_id = subscription_id;
+      wait_for_writes();
       order = m_data_store->load_order_record(id);
       auto pending_reports = std::vector<ExecutionReport>();
       m_order_subscriptions.commit(
@@ -565,6 +752,7 @@ namespace Nexus {
     try {
       auto execution_report_result = ExecutionReportQueryResult();
       execution_report_result.m_id = subscription_id;
+      wait_for_writes();
       submission_result.m_snapshot =
         m_data_store->load_order_records(revised_query);
       auto pending_reports = std::vector<ExecutionReport>();
@@ -656,6 +844,7 @@ namespace Nexus {
     result.m_id = m_execution_report_subscriptions.init(
       revised_query.get_index(), request.get_client(),
       revised_query.get_range(), std::move(filter));
+    wait_for_writes();
     result.m_snapshot = m_data_store->load_execution_reports(revised_query);
     m_execution_report_subscriptions.commit(
       revised_query.get_index(), std::move(result), [&] (const auto& result) {
@@ -744,6 +933,7 @@ namespace Nexus {
         m_rejected_orders.push_back(order);
         return order;
       }
+      order_info.m_ticker_id = to_ticker_id(order_info.m_fields.m_ticker);
       return m_driver->submit(order_info);
     }();
     try {
@@ -773,16 +963,18 @@ namespace Nexus {
             });
         });
     } catch(...) {
-      order->get_publisher().monitor(m_tasks.get_slot<ExecutionReport>(
+      order->get_publisher().monitor(
+        get_tasks(order_info.m_fields.m_account).get_slot<ExecutionReport>(
+          std::bind(&OrderExecutionServlet::on_execution_report, this,
+            std::placeholders::_1, order_info.m_fields.m_account,
+            std::ref(*shorting_model), std::ref(*checkpoint))));
+      throw;
+    }
+    order->get_publisher().monitor(
+      get_tasks(order_info.m_fields.m_account).get_slot<ExecutionReport>(
         std::bind(&OrderExecutionServlet::on_execution_report, this,
           std::placeholders::_1, order_info.m_fields.m_account,
           std::ref(*shorting_model), std::ref(*checkpoint))));
-      throw;
-    }
-    order->get_publisher().monitor(m_tasks.get_slot<ExecutionReport>(
-      std::bind(&OrderExecutionServlet::on_execution_report, this,
-        std::placeholders::_1, order_info.m_fields.m_account,
-        std::ref(*shorting_model), std::ref(*checkpoint))));
   }
 
   template<typename C, typename T, typename S, typename U, typename A,
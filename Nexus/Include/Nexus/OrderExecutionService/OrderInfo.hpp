@@ -5,6 +5,7 @@
 #include <Beam/Serialization/ShuttleDateTime.hpp>
 #include <Beam/ServiceLocator/DirectoryEntry.hpp>
 #include <boost/date_time/posix_time/ptime.hpp>
+#include "Nexus/Definitions/TickerId.hpp"
 #include "Nexus/OrderExecutionService/ExecutionReport.hpp"
 #include "Nexus/OrderExecutionService/OrderFields.hpp"
 
@@ -28,6 +29,13 @@ namespace Nexus {
     /** The Order's timestamp. */
     boost::posix_time::ptime m_timestamp;
 
+    /**
+     * The TickerId of the Order's Ticker, interned when the Order is entered
+     * so that it needn't be interned again, or NONE if it hasn't been. The id
+     * is local to the process and is neither serialized nor compared.
+     */
+    TickerId m_ticker_id;
+
     /** Constructs an empty OrderInfo. */
     OrderInfo() noexcept;
 
@@ -64,7 +72,7 @@ namespace Nexus {
     OrderInfo(OrderFields fields, OrderId id,
       boost::posix_time::ptime timestamp) noexcept;
 
-    bool operator ==(const OrderInfo&) const = default;
+    bool operator ==(const OrderInfo& info) const;
   };
 
   inline std::ostream& operator <<(std::ostream& out, const OrderInfo& value) {
@@ -97,6 +105,25 @@ namespace Nexus {
   inline OrderInfo::OrderInfo(OrderFields fields, OrderId id,
     boost::posix_time::ptime timestamp) noexcept
     : OrderInfo(fields, id, false, timestamp) {}
+
+  inline bool OrderInfo::operator ==(const OrderInfo& info) const {
+    return m_fields == info.m_fields &&
+      m_submission_account == info.m_submission_account &&
+      m_id == info.m_id && m_shorting_flag == info.m_shorting_flag &&
+      m_timestamp == info.m_timestamp;
+  }
+
+  /**
+   * Returns the TickerId of an Order's Ticker, interning it only if it wasn't
+   * interned when the Order was entered.
+   * @param info The OrderInfo of the Order.
+   */
+  inline TickerId get_ticker_id(const OrderInfo& info) {
+    if(info.m_ticker_id) {
+      return info.m_ticker_id;
+    }
+    return to_ticker_id(info.m_fields.m_ticker);
+  }
 }
 
 namespace Beam {
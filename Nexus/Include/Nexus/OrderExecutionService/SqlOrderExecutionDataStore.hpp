@@ -1,5 +1,6 @@
 #ifndef NEXUS_SQL_ORDER_EXECUTION_DATA_STORE_HPP
 #define NEXUS_SQL_ORDER_EXECUTION_DATA_STORE_HPP
+#include <algorithm>
 #include <functional>
 #include <thread>
 #include <vector>
@@ -290,14 +291,23 @@ namespace Nexus {
   template<typename C>
   void SqlOrderExecutionDataStore<C>::store(
       const std::vector<SequencedAccountExecutionReport>& reports) {
-    for(auto& report : reports) {
-      if((*report)->m_text.size() > MAX_EXECUTION_REPORT_TEXT_SIZE) {
-        auto truncated_report = report;
-        (*truncated_report)->m_text.resize(MAX_EXECUTION_REPORT_TEXT_SIZE);
-        m_execution_reports_data_store.store(truncated_report);
-      } else {
-        m_execution_reports_data_store.store(report);
+    if(reports.empty()) {
+      return;
+    }
+    auto is_truncated = std::any_of(reports.begin(), reports.end(),
+      [] (const auto& report) {
+        return (*report)->m_text.size() > MAX_EXECUTION_REPORT_TEXT_SIZE;
+      });
+    if(is_truncated) {
+      auto truncated_reports = reports;
+      for(auto& report : truncated_reports) {
+        if((*report)->m_text.size() > MAX_EXECUTION_REPORT_TEXT_SIZE) {
+          (*report)->m_text.resize(MAX_EXECUTION_REPORT_TEXT_SIZE);
+        }
       }
+      m_execution_reports_data_store.store(truncated_reports);
+    } else {
+      m_execution_reports_data_store.store(reports);
     }
     auto terminal_ids = std::vector<Viper::Expression>();
     for(auto& report : reports) {
@@ -87,6 +87,8 @@ namespace Nexus::Python {
       def("load_account_roles", pybind11::overload_cast<
         const Beam::DirectoryEntry&, const Beam::DirectoryEntry&>(
           &C::load_account_roles)).
+      def("store", pybind11::overload_cast<
+        const Beam::DirectoryEntry&, AccountRoles>(&C::store)).
       def("load_parent_trading_group", &C::load_parent_trading_group).
       def("load_identity", &C::load_identity).
       def("store", pybind11::overload_cast<
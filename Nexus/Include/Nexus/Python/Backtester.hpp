@@ -10,6 +10,12 @@ namespace Nexus::Python {
    */
   void export_active_backtester_event(pybind11::module& module);
 
+  /**
+   * Exports the BacktestRunner class and its scenario types.
+   * @param module The module to export to.
+   */
+  void export_backtest_runner(pybind11::module& module);
+
   /**
    * Exports all of the backtester classes.
    * @param module The module to export to.
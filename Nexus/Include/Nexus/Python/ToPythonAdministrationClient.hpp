@@ -43,6 +43,8 @@ namespace Nexus {
       AccountRoles load_account_roles(const Beam::DirectoryEntry& account);
       AccountRoles load_account_roles(
         const Beam::DirectoryEntry& parent, const Beam::DirectoryEntry& child);
+      AccountRoles store(
+        const Beam::DirectoryEntry& account, AccountRoles roles);
       Beam::DirectoryEntry load_parent_trading_group(
         const Beam::DirectoryEntry& account);
       AccountIdentity load_identity(const Beam::DirectoryEntry& account);
@@ -204,6 +206,13 @@ namespace Nexus {
     return m_client->load_account_roles(parent, child);
   }
 
+  template<IsAdministrationClient C>
+  AccountRoles ToPythonAdministrationClient<C>::store(
+      const Beam::DirectoryEntry& account, AccountRoles roles) {
+    auto release = Beam::Python::GilRelease();
+    return m_client->store(account, roles);
+  }
+
   template<IsAdministrationClient C>
   Beam::DirectoryEntry
       ToPythonAdministrationClient<C>::load_parent_trading_group(
@@ -0,0 +1,376 @@
+#ifndef NEXUS_COMPILED_FILTER_HPP
+#define NEXUS_COMPILED_FILTER_HPP
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <Beam/Queries/AndExpression.hpp>
+#include <Beam/Queries/ConstantExpression.hpp>
+#include <Beam/Queries/Evaluator.hpp>
+#include <Beam/Queries/ExpressionVisitor.hpp>
+#include <Beam/Queries/FunctionExpression.hpp>
+#include <Beam/Queries/MemberAccessExpression.hpp>
+#include <Beam/Queries/NotExpression.hpp>
+#include <Beam/Queries/OrExpression.hpp>
+#include <Beam/Queries/ParameterExpression.hpp>
+#include <Beam/Queries/StandardFunctionExpressions.hpp>
+#include "Nexus/Definitions/BboQuote.hpp"
+#include "Nexus/Definitions/Quote.hpp"
+#include "Nexus/Definitions/TimeAndSale.hpp"
+#include "Nexus/OrderExecutionService/OrderInfo.hpp"
+#include "Nexus/Queries/EvaluatorTranslator.hpp"
+#include "Nexus/Queries/ExpressionVisitor.hpp"
+
+namespace Nexus {
+
+  /**
+   * A filter compiled into a predicate that accesses the members of the
+   * value it tests directly, rather than through an interpreted tree of
+   * evaluator nodes.
+   * @param <T> The type of value tested.
+   */
+  template<typename T>
+  using CompiledFilter = std::function<bool (const T&)>;
+
+namespace Details {
+  template<typename U, typename F>
+  bool with_member(std::type_identity<U>, const std::string& name, F&& f) {
+    return false;
+  }
+
+  template<typename F>
+  bool with_member(
+      std::type_identity<Quote>, const std::string& name, F&& f) {
+    if(name == "price") {
+      return f(&Quote::m_price);
+    } else if(name == "size") {
+      return f(&Quote::m_size);
+    } else if(name == "side") {
+      return f(&Quote::m_side);
+    }
+    return false;
+  }
+
+  template<typename F>
+  bool with_member(
+      std::type_identity<BboQuote>, const std::string& name, F&& f) {
+    if(name == "bid") {
+      return f(&BboQuote::m_bid);
+    } else if(name == "ask") {
+      return f(&BboQuote::m_ask);
+    } else if(name == "timestamp") {
+      return f(&BboQuote::m_timestamp);
+    }
+    return false;
+  }
+
+  template<typename F>
+  bool with_member(
+      std::type_identity<TimeAndSale>, const std::string& name, F&& f) {
+    if(name == "timestamp") {
+      return f(&TimeAndSale::m_timestamp);
+    } else if(name == "price") {
+      return f(&TimeAndSale::m_price);
+    } else if(name == "size") {
+      return f(&TimeAndSale::m_size);
+    } else if(name == "market_center") {
+      return f(&TimeAndSale::m_market_center);
+    } else if(name == "buyer_mpid") {
+      return f(&TimeAndSale::m_buyer_mpid);
+    } else if(name == "seller_mpid") {
+      return f(&TimeAndSale::m_seller_mpid);
+    }
+    return false;
+  }
+
+  template<typename F>
+  bool with_member(
+      std::type_identity<OrderFields>, const std::string& name, F&& f) {
+    if(name == "ticker") {
+      return f(&OrderFields::m_ticker);
+    }
+    return false;
+  }
+
+  template<typename F>
+  bool with_member(
+      std::type_identity<OrderInfo>, const std::string& name, F&& f) {
+    if(name == "fields") {
+      return f(&OrderInfo::m_fields);
+    } else if(name == "order_id") {
+      return f(&OrderInfo::m_id);
+    } else if(name == "shorting_flag") {
+      return f(&OrderInfo::m_shorting_flag);
+    } else if(name == "timestamp") {
+      return f(&OrderInfo::m_timestamp);
+    }
+    return false;
+  }
+
+  template<typename T, typename U, typename G, typename F>
+  bool with_path(const std::vector<std::string>& path, std::size_t index,
+      const G& get, F& f) {
+    if(index == path.size()) {
+      return f(get);
+    }
+    return with_member(std::type_identity<U>(), path[index],
+      [&] (auto member) {
+        using Member =
+          std::remove_cvref_t<decltype(std::declval<const U&>().*member)>;
+        return with_path<T, Member>(path, index + 1,
+          [=] (const T& value) -> const Member& {
+            return get(value).*member;
+          }, f);
+      });
+  }
+
+  template<typename T>
+  class FilterCompiler :
+      public Beam::ExpressionVisitor, public ExpressionVisitor {
+    public:
+      CompiledFilter<T> compile(const Beam::Expression& expression);
+
+    protected:
+      void visit(const Beam::AndExpression& expression) override;
+      void visit(const Beam::ConstantExpression& expression) override;
+      void visit(const Beam::FunctionExpression& expression) override;
+      void visit(const Beam::MemberAccessExpression& expression) override;
+      void visit(const Beam::NotExpression& expression) override;
+      void visit(const Beam::OrExpression& expression) override;
+      void visit(const Beam::ParameterExpression& expression) override;
+      void visit(const Beam::VirtualExpression& expression) override;
+
+    private:
+      CompiledFilter<T> m_filter;
+      std::vector<std::string> m_path;
+      const Beam::ConstantExpression* m_constant;
+      bool m_is_parameter;
+
+      bool compile_comparison(const std::string& name,
+        const std::vector<std::string>& path,
+        const Beam::ConstantExpression& value, bool is_reversed);
+  };
+
+  template<typename T>
+  CompiledFilter<T> FilterCompiler<T>::compile(
+      const Beam::Expression& expression) {
+    m_filter = nullptr;
+    m_path.clear();
+    m_constant = nullptr;
+    m_is_parameter = false;
+    expression.apply(*this);
+    return std::move(m_filter);
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::AndExpression& expression) {
+    auto left = FilterCompiler().compile(expression.get_left());
+    if(!left) {
+      return;
+    }
+    auto right = FilterCompiler().compile(expression.get_right());
+    if(!right) {
+      return;
+    }
+    m_filter = [left = std::move(left), right = std::move(right)] (
+        const T& value) {
+      return left(value) && right(value);
+    };
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::ConstantExpression& expression) {
+    m_constant = &expression;
+    if(expression.get_type() == typeid(bool)) {
+      m_filter = [value = expression.get_value().template as<bool>()] (
+          const T&) {
+        return value;
+      };
+    }
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::FunctionExpression& expression) {
+    auto& parameters = expression.get_parameters();
+    if(parameters.size() != 2) {
+      return;
+    }
+    auto left = FilterCompiler();
+    left.compile(parameters[0]);
+    auto right = FilterCompiler();
+    right.compile(parameters[1]);
+    if(left.m_is_parameter && right.m_constant) {
+      compile_comparison(
+        expression.get_name(), left.m_path, *right.m_constant, false);
+    } else if(left.m_constant && right.m_is_parameter) {
+      compile_comparison(
+        expression.get_name(), right.m_path, *left.m_constant, true);
+    }
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(
+      const Beam::MemberAccessExpression& expression) {
+    expression.get_expression().apply(*this);
+    if(m_is_parameter) {
+      m_path.push_back(expression.get_name());
+    }
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::NotExpression& expression) {
+    auto operand = FilterCompiler().compile(expression.get_operand());
+    if(!operand) {
+      return;
+    }
+    m_filter = [operand = std::move(operand)] (const T& value) {
+      return !operand(value);
+    };
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::OrExpression& expression) {
+    auto left = FilterCompiler().compile(expression.get_left());
+    if(!left) {
+      return;
+    }
+    auto right = FilterCompiler().compile(expression.get_right());
+    if(!right) {
+      return;
+    }
+    m_filter = [left = std::move(left), right = std::move(right)] (
+        const T& value) {
+      return left(value) || right(value);
+    };
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::ParameterExpression& expression) {
+    m_is_parameter =
+      expression.get_index() == 0 && expression.get_type() == typeid(T);
+  }
+
+  template<typename T>
+  void FilterCompiler<T>::visit(const Beam::VirtualExpression& expression) {}
+
+  template<typename T>
+  bool FilterCompiler<T>::compile_comparison(const std::string& name,
+      const std::vector<std::string>& path,
+      const Beam::ConstantExpression& value, bool is_reversed) {
+    auto make_comparison = [&] (const auto& get) {
+      using Field =
+        std::remove_cvref_t<decltype(get(std::declval<const T&>()))>;
+      if(value.get_value().get_type() != typeid(Field)) {
+        return false;
+      }
+      auto constant = value.get_value().template as<Field>();
+      auto compare = [&] (auto comparator) {
+        m_filter = [=] (const T& tested) {
+          if(is_reversed) {
+            return comparator(constant, get(tested));
+          }
+          return comparator(get(tested), constant);
+        };
+        return true;
+      };
+      if constexpr(std::equality_comparable<Field>) {
+        if(name == Beam::EQUALS_NAME) {
+          return compare(std::equal_to<>());
+        } else if(name == Beam::NOT_EQUALS_NAME) {
+          return compare(std::not_equal_to<>());
+        }
+      }
+      if constexpr(std::totally_ordered<Field>) {
+        if(name == Beam::LESS_NAME) {
+          return compare(std::less<>());
+        } else if(name == Beam::LESS_EQUALS_NAME) {
+          return compare(std::less_equal<>());
+        } else if(name == Beam::GREATER_NAME) {
+          return compare(std::greater<>());
+        } else if(name == Beam::GREATER_EQUALS_NAME) {
+          return compare(std::greater_equal<>());
+        }
+      }
+      return false;
+    };
+    return with_path<T, T>(path, 0, [] (const T& value) -> const T& {
+      return value;
+    }, make_comparison);
+  }
+}
+
+  /**
+   * Compiles a filter into a predicate. Comparisons between a member of the
+   * filtered value and a constant, and conjunctions, disjunctions and
+   * negations of them, are supported for TimeAndSales, BboQuotes, Quotes and
+   * OrderInfo.
+   * @param <T> The type of value to filter.
+   * @param filter The filter to compile.
+   * @return The compiled filter, or an empty function if the filter has a
+   *         form that can not be compiled.
+   */
+  template<typename T>
+  CompiledFilter<T> compile_filter(const Beam::Expression& filter) {
+    return Details::FilterCompiler<T>().compile(filter);
+  }
+
+  /**
+   * Tests values against a query's filter, using a CompiledFilter when the
+   * filter can be compiled and an interpreted Evaluator otherwise.
+   * @param <T> The type of value to test.
+   */
+  template<typename T>
+  class QueryFilter {
+    public:
+
+      /** The type of value to test. */
+      using Type = T;
+
+      /**
+       * Constructs a QueryFilter.
+       * @param filter The filter to test values against.
+       */
+      explicit QueryFilter(const Beam::Expression& filter);
+
+      /** Returns <code>true</code> iff the filter was compiled. */
+      bool is_compiled() const;
+
+      /**
+       * Tests a value against the filter.
+       * @param value The value to test.
+       * @return <code>true</code> iff the value satisfies the filter.
+       */
+      bool operator ()(const Type& value) const;
+
+    private:
+      CompiledFilter<Type> m_filter;
+      std::unique_ptr<Beam::Evaluator> m_evaluator;
+  };
+
+  template<typename T>
+  QueryFilter<T>::QueryFilter(const Beam::Expression& filter)
+      : m_filter(compile_filter<Type>(filter)) {
+    if(!m_filter) {
+      m_evaluator = Beam::translate<EvaluatorTranslator>(filter);
+    }
+  }
+
+  template<typename T>
+  bool QueryFilter<T>::is_compiled() const {
+    return static_cast<bool>(m_filter);
+  }
+
+  template<typename T>
+  bool QueryFilter<T>::operator ()(const Type& value) const {
+    if(m_filter) {
+      return m_filter(value);
+    }
+    return Beam::test_filter(*m_evaluator, value);
+  }
+}
+
+#endif
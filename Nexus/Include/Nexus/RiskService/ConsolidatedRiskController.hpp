@@ -104,6 +104,7 @@ namespace Nexus {
         std::unique_ptr<TransitionTimer>, TimeClient*, RiskDataStore*>;
       Beam::local_ptr_t<A> m_administration_client;
       Beam::local_ptr_t<M> m_market_data_client;
+      std::shared_ptr<BboQuoteCache> m_bbo_quotes;
       Beam::local_ptr_t<O> m_order_execution_client;
       TransitionTimerFactory m_transition_timer_factory;
       Beam::local_ptr_t<T> m_time_client;
@@ -150,6 +151,8 @@ namespace Nexus {
   BEAM_SUPPRESS_THIS_INITIALIZER()
     : m_administration_client(std::forward<AF>(administration_client)),
       m_market_data_client(std::forward<MF>(market_data_client)),
+      m_bbo_quotes(std::make_shared<BboQuoteCache>(
+        Nexus::MarketDataClient(&*m_market_data_client))),
       m_order_execution_client(std::forward<OF>(order_execution_client)),
       m_transition_timer_factory(std::move(transition_timer_factory)),
       m_time_client(std::forward<TF>(time_client)),
@@ -194,8 +197,9 @@ namespace Nexus {
       try {
         return std::make_unique<RiskController>(
           account, &*m_administration_client, &*m_market_data_client,
-          &*m_order_execution_client, m_transition_timer_factory(),
-          &*m_time_client, &*m_data_store, m_exchange_rates);
+          m_bbo_quotes, &*m_order_execution_client,
+          m_transition_timer_factory(), &*m_time_client, &*m_data_store,
+          m_exchange_rates);
       } catch(const std::exception&) {
         std::cerr << "Unable to load risk controller:\n\t" <<
           "Account: " << account << "\n\t" <<
@@ -17,6 +17,7 @@
 #include "Nexus/Accounting/PortfolioController.hpp"
 #include "Nexus/AdministrationService/AdministrationClient.hpp"
 #include "Nexus/Definitions/ExchangeRateTable.hpp"
+#include "Nexus/MarketDataService/BboQuoteCache.hpp"
 #include "Nexus/MarketDataService/MarketDataClient.hpp"
 #include "Nexus/OrderExecutionService/OrderExecutionClient.hpp"
 #include "Nexus/OrderExecutionService/StandardQueries.hpp"
@@ -91,6 +92,27 @@ namespace Nexus {
         RF&& transition_timer, TF&& time_client, DF&& data_store,
         const ExchangeRateTable& exchange_rates);
 
+      /**
+       * Constructs a RiskController that values the account's Portfolio using
+       * a shared BboQuoteCache.
+       * @param account The account whose risk is being controlled.
+       * @param administration_client Initializes the AdministrationClient.
+       * @param market_data_client Initializes the MarketDataClient.
+       * @param bbo_quotes The BboQuoteCache used to value the Portfolio.
+       * @param order_execution_client Initializes the OrderExecutionClient.
+       * @param transition_timer Initializes the transition Timer.
+       * @param time_client Initializes the TimeClient.
+       * @param data_store Initializes the RiskDataStore.
+       * @param exchange_rates The exchange rates.
+       */
+      template<Beam::Initializes<A> AF, Beam::Initializes<M> MF,
+        Beam::Initializes<O> OF, Beam::Initializes<R> RF,
+        Beam::Initializes<T> TF, Beam::Initializes<D> DF>
+      RiskController(Beam::DirectoryEntry account, AF&& administration_client,
+        MF&& market_data_client, std::shared_ptr<BboQuoteCache> bbo_quotes,
+        OF&& order_execution_client, RF&& transition_timer, TF&& time_client,
+        DF&& data_store, const ExchangeRateTable& exchange_rates);
+
       /** Returns a Publisher for the account's RiskState. */
       const Beam::Publisher<RiskState>& get_risk_state_publisher() const;
 
@@ -139,6 +161,36 @@ namespace Nexus {
         std::remove_reference_t<O>, std::remove_reference_t<R>,
         std::remove_reference_t<T>, std::remove_reference_t<D>>;
 
+  template<typename A, typename M, typename O, typename R, typename T,
+    typename D>
+  RiskController(const Beam::DirectoryEntry&, A&&, M&&,
+    std::shared_ptr<BboQuoteCache>, O&&, R&&, T&&, D&&,
+    const ExchangeRateTable&) ->
+      RiskController<std::remove_reference_t<A>, std::remove_reference_t<M>,
+        std::remove_reference_t<O>, std::remove_reference_t<R>,
+        std::remove_reference_t<T>, std::remove_reference_t<D>>;
+
+  template<typename A, typename M, typename O, typename R, typename T,
+    typename D> requires IsAdministrationClient<Beam::dereference_t<A>> &&
+      IsMarketDataClient<Beam::dereference_t<M>> &&
+        IsOrderExecutionClient<Beam::dereference_t<O>> &&
+          Beam::IsTimer<Beam::dereference_t<R>> &&
+            Beam::IsTimeClient<Beam::dereference_t<T>> &&
+              IsRiskDataStore<Beam::dereference_t<D>>
+  template<Beam::Initializes<A> AF, Beam::Initializes<M> MF,
+    Beam::Initializes<O> OF, Beam::Initializes<R> RF,
+    Beam::Initializes<T> TF, Beam::Initializes<D> DF>
+  RiskController<A, M, O, R, T, D>::RiskController(Beam::DirectoryEntry account,
+    AF&& administration_client, MF&& market_data_client,
+    OF&& order_execution_client, RF&& transition_timer, TF&& time_client,
+    DF&& data_store, const ExchangeRateTable& exchange_rates)
+    : RiskController(std::move(account),
+        std::forward<AF>(administration_client),
+        std::forward<MF>(market_data_client), nullptr,
+        std::forward<OF>(order_execution_client),
+        std::forward<RF>(transition_timer), std::forward<TF>(time_client),
+        std::forward<DF>(data_store), exchange_rates) {}
+
   template<typename A, typename M, typename O, typename R, typename T,
     typename D> requires IsAdministrationClient<Beam::dereference_t<A>> &&
       IsMarketDataClient<Beam::dereference_t<M>> &&
@@ -151,8 +203,9 @@ namespace Nexus {
     Beam::Initializes<T> TF, Beam::Initializes<D> DF>
   RiskController<A, M, O, R, T, D>::RiskController(Beam::DirectoryEntry account,
       AF&& administration_client, MF&& market_data_client,
-      OF&& order_execution_client, RF&& transition_timer, TF&& time_client,
-      DF&& data_store, const ExchangeRateTable& exchange_rates)
+      std::shared_ptr<BboQuoteCache> bbo_quotes, OF&& order_execution_client,
+      RF&& transition_timer, TF&& time_client, DF&& data_store,
+      const ExchangeRateTable& exchange_rates)
       : m_account(std::move(account)),
         m_administration_client(std::forward<AF>(administration_client)),
         m_order_execution_client(std::forward<OF>(order_execution_client)),
@@ -180,7 +233,8 @@ namespace Nexus {
     }
     m_order_execution_client->query(real_time_query, real_time_queue);
     m_portfolio_controller.emplace(&m_state_model->get_portfolio(),
-      std::forward<MF>(market_data_client), real_time_queue);
+      std::forward<MF>(market_data_client), std::move(bbo_quotes),
+      real_time_queue);
     m_transition_model.emplace(m_account, std::move(inventories),
       m_state_model->get_risk_state(), &*m_order_execution_client);
     m_order_execution_client->query(real_time_query,
@@ -1,14 +1,13 @@
 #ifndef NEXUS_TICKER_ORDER_SIMULATOR_HPP
 #define NEXUS_TICKER_ORDER_SIMULATOR_HPP
 #include <algorithm>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <string_view>
-#include <tuple>
 #include <unordered_map>
 #include <vector>
+#include <boost/container/small_vector.hpp>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
 #include <Beam/Threading/Mutex.hpp>
@@ -163,8 +162,21 @@ namespace Details {
       void update(const BookQuote& book_quote);
 
     private:
-      using Level = std::tuple<Venue, Side, Money>;
-      using Listing = std::tuple<Venue, Side, Money, std::string>;
+      struct Listing {
+        std::string m_mpid;
+        Quantity m_size;
+      };
+      struct PriceLevel {
+        Money m_price;
+        Quantity m_size;
+        boost::container::small_vector<Listing, 4> m_listings;
+        std::vector<std::shared_ptr<PrimitiveOrder>> m_orders;
+      };
+      struct VenueBook {
+        Venue m_venue;
+        std::vector<PriceLevel> m_bids;
+        std::vector<PriceLevel> m_asks;
+      };
       struct OrderEntry {
         OrderStatus m_status;
         Quantity m_remaining_quantity;
@@ -188,14 +200,19 @@ namespace Details {
       std::vector<std::shared_ptr<PrimitiveOrder>> m_orders;
       std::unordered_map<OrderId, OrderEntry> m_entries;
       std::unordered_map<OrderId, PeggedOrderEntry> m_pegged_entries;
-      std::map<Listing, Quantity> m_listings;
-      std::map<Level, Quantity> m_levels;
+      std::vector<VenueBook> m_books;
       BboQuote m_bbo;
       Beam::Mutex m_mutex;
 
       TickerOrderSimulator(const TickerOrderSimulator&) = delete;
       TickerOrderSimulator& operator =(const TickerOrderSimulator&) = delete;
       void set_session_timestamps(boost::posix_time::ptime timestamp);
+      void clear_book();
+      std::vector<PriceLevel>* find_levels(Venue venue, Side side);
+      std::vector<PriceLevel>& get_levels(Venue venue, Side side);
+      PriceLevel* find_level(Venue venue, Side side, Money price);
+      PriceLevel& get_level(Venue venue, Side side, Money price);
+      void prune(Venue venue, Side side, Money price);
       void submit_pegged(const PrimitiveOrder& order);
       void enqueue(const std::shared_ptr<PrimitiveOrder>& order,
         OrderStatus status, boost::posix_time::ptime timestamp,
@@ -214,12 +231,13 @@ namespace Details {
       OrderEntry make_entry(const PrimitiveOrder& order, OrderStatus status,
         Quantity remaining_quantity);
       Quantity apply(const BookQuote& book_quote);
-      void advance(const Level& level, Quantity delta);
+      void advance(Venue venue, Side side, Money price, Quantity delta);
       Quantity allocate(
         const std::shared_ptr<PrimitiveOrder>& order, Quantity available);
       bool match(const TimeAndSale& time_and_sale, Side side, Venue venue,
         Quantity size);
       void match(const TimeAndSale& time_and_sale);
+      void post(const std::shared_ptr<PrimitiveOrder>& order);
       void erase(const std::shared_ptr<PrimitiveOrder>& order);
   };
 
@@ -241,8 +259,7 @@ namespace Details {
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
   void TickerOrderSimulator<T>::initialize(const TickerSnapshot& snapshot) {
     auto lock = std::lock_guard(m_mutex);
-    m_listings.clear();
-    m_levels.clear();
+    clear_book();
     for(auto& quote : snapshot.m_bids) {
       apply(*quote);
     }
@@ -274,8 +291,8 @@ namespace Details {
       m_entries.erase(order->get_info().m_id);
       return;
     }
-    m_orders.push_back(order);
     m_entries[order->get_info().m_id].m_status = next_status;
+    post(order);
   }
 
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
@@ -303,8 +320,8 @@ namespace Details {
       m_entries.erase(order->get_info().m_id);
       return;
     }
-    m_orders.push_back(order);
     m_entries[order->get_info().m_id].m_status = next_status;
+    post(order);
   }
 
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
@@ -458,16 +475,15 @@ namespace Details {
     if(delta == 0) {
       return;
     }
-    advance(Level(book_quote.m_venue, book_quote.m_quote.m_side,
-      book_quote.m_quote.m_price), delta);
+    advance(book_quote.m_venue, book_quote.m_quote.m_side,
+      book_quote.m_quote.m_price, delta);
   }
 
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
   void TickerOrderSimulator<T>::set_session_timestamps(
       boost::posix_time::ptime timestamp) {
     m_date = timestamp.date();
-    m_listings.clear();
-    m_levels.clear();
+    clear_book();
     auto venue = m_ticker.get_venue();
     m_venue_close_time = venue_to_utc(venue, boost::posix_time::ptime(
       utc_to_venue(venue, timestamp).date(), boost::posix_time::hours(16)));
@@ -475,6 +491,84 @@ namespace Details {
       !m_venue_close_time.is_special() && timestamp < m_venue_close_time;
   }
 
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  void TickerOrderSimulator<T>::clear_book() {
+    for(auto& book : m_books) {
+      for(auto* levels : {&book.m_bids, &book.m_asks}) {
+        std::erase_if(*levels, [] (auto& level) {
+          level.m_size = 0;
+          level.m_listings.clear();
+          return level.m_orders.empty();
+        });
+      }
+    }
+  }
+
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  std::vector<typename TickerOrderSimulator<T>::PriceLevel>*
+      TickerOrderSimulator<T>::find_levels(Venue venue, Side side) {
+    for(auto& book : m_books) {
+      if(book.m_venue == venue) {
+        return &pick(side, book.m_asks, book.m_bids);
+      }
+    }
+    return nullptr;
+  }
+
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  std::vector<typename TickerOrderSimulator<T>::PriceLevel>&
+      TickerOrderSimulator<T>::get_levels(Venue venue, Side side) {
+    if(auto levels = find_levels(venue, side)) {
+      return *levels;
+    }
+    auto& book = m_books.emplace_back();
+    book.m_venue = venue;
+    return pick(side, book.m_asks, book.m_bids);
+  }
+
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  typename TickerOrderSimulator<T>::PriceLevel*
+      TickerOrderSimulator<T>::find_level(Venue venue, Side side, Money price) {
+    auto levels = find_levels(venue, side);
+    if(!levels) {
+      return nullptr;
+    }
+    auto i = std::lower_bound(levels->begin(), levels->end(), price,
+      [] (const auto& level, auto price) {
+        return level.m_price < price;
+      });
+    if(i == levels->end() || i->m_price != price) {
+      return nullptr;
+    }
+    return &*i;
+  }
+
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  typename TickerOrderSimulator<T>::PriceLevel&
+      TickerOrderSimulator<T>::get_level(Venue venue, Side side, Money price) {
+    auto& levels = get_levels(venue, side);
+    auto i = std::lower_bound(levels.begin(), levels.end(), price,
+      [] (const auto& level, auto price) {
+        return level.m_price < price;
+      });
+    if(i == levels.end() || i->m_price != price) {
+      i = levels.insert(i, PriceLevel());
+      i->m_price = price;
+      i->m_size = 0;
+    }
+    return *i;
+  }
+
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  void TickerOrderSimulator<T>::prune(Venue venue, Side side, Money price) {
+    auto level = find_level(venue, side, price);
+    if(!level || !level->m_listings.empty() || !level->m_orders.empty()) {
+      return;
+    }
+    auto& levels = *find_levels(venue, side);
+    levels.erase(levels.begin() + (level - levels.data()));
+  }
+
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
   void TickerOrderSimulator<T>::submit_pegged(const PrimitiveOrder& order) {
     auto& fields = order.get_info().m_fields;
@@ -649,10 +743,9 @@ namespace Details {
     entry.m_venue =
       Details::get_posting_venue(fields.m_destination, m_ticker.get_venue());
     if(entry.m_venue) {
-      auto i =
-        m_levels.find(Level(entry.m_venue, fields.m_side, fields.m_price));
-      if(i != m_levels.end()) {
-        entry.m_queue_quantity = i->second;
+      if(auto level =
+          find_level(entry.m_venue, fields.m_side, fields.m_price)) {
+        entry.m_queue_quantity = level->m_size;
       }
     }
     return entry;
@@ -660,45 +753,51 @@ namespace Details {
 
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
   Quantity TickerOrderSimulator<T>::apply(const BookQuote& book_quote) {
-    auto listing = Listing(book_quote.m_venue, book_quote.m_quote.m_side,
-      book_quote.m_quote.m_price, book_quote.m_mpid);
-    auto previous = [&] {
-      auto i = m_listings.find(listing);
-      if(i == m_listings.end()) {
-        return Quantity(0);
-      }
-      return i->second;
-    }();
+    auto venue = book_quote.m_venue;
+    auto side = book_quote.m_quote.m_side;
+    auto price = book_quote.m_quote.m_price;
     auto quantity = std::max(Quantity(0), book_quote.m_quote.m_size);
+    auto level = find_level(venue, side, price);
+    if(!level) {
+      if(quantity == 0) {
+        return 0;
+      }
+      level = &get_level(venue, side, price);
+    }
+    auto listing = std::lower_bound(level->m_listings.begin(),
+      level->m_listings.end(), book_quote.m_mpid,
+      [] (const auto& listing, const auto& mpid) {
+        return listing.m_mpid < mpid;
+      });
+    auto is_listed = listing != level->m_listings.end() &&
+      listing->m_mpid == book_quote.m_mpid;
+    auto previous = is_listed ? listing->m_size : Quantity(0);
     auto delta = quantity - previous;
     if(delta == 0) {
       return 0;
     }
-    if(quantity <= 0) {
-      m_listings.erase(listing);
+    if(quantity == 0) {
+      level->m_listings.erase(listing);
+    } else if(is_listed) {
+      listing->m_size = quantity;
     } else {
-      m_listings[listing] = quantity;
-    }
-    auto level = Level(book_quote.m_venue, book_quote.m_quote.m_side,
-      book_quote.m_quote.m_price);
-    auto size = m_levels[level] + delta;
-    if(size <= 0) {
-      m_levels.erase(level);
-    } else {
-      m_levels[level] = size;
+      level->m_listings.insert(listing, Listing(book_quote.m_mpid, quantity));
     }
+    level->m_size += delta;
+    prune(venue, side, price);
     return delta;
   }
 
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
-  void TickerOrderSimulator<T>::advance(const Level& level, Quantity delta) {
-    for(auto& order : m_orders) {
+  void TickerOrderSimulator<T>::advance(
+      Venue venue, Side side, Money price, Quantity delta) {
+    auto level = find_level(venue, side, price);
+    if(!level) {
+      return;
+    }
+    for(auto& order : level->m_orders) {
       auto i = m_entries.find(order->get_info().m_id);
-      if(i == m_entries.end() || !i->second.m_venue) {
-        continue;
-      }
-      auto& fields = order->get_info().m_fields;
-      if(Level(i->second.m_venue, fields.m_side, fields.m_price) != level) {
+      if(i == m_entries.end()) {
         continue;
       }
       auto& entry = i->second;
@@ -764,18 +863,16 @@ namespace Details {
       return has_update;
     }
     while(available > 0) {
+      auto level = find_level(venue, side, time_and_sale.m_price);
+      if(!level) {
+        break;
+      }
       auto selection = std::shared_ptr<PrimitiveOrder>();
-      for(auto& order : m_orders) {
-        auto& fields = order->get_info().m_fields;
-        if(fields.m_side != side || fields.m_type != OrderType::LIMIT ||
-            fields.m_time_in_force.get_type() == TimeInForce::Type::MOC ||
-            time_and_sale.m_price != fields.m_price) {
-          continue;
-        }
+      for(auto& order : level->m_orders) {
         auto i = m_entries.find(order->get_info().m_id);
         if(i == m_entries.end() ||
             i->second.m_status == OrderStatus::PENDING_NEW ||
-            is_terminal(i->second.m_status) || i->second.m_venue != venue ||
+            is_terminal(i->second.m_status) ||
             i->second.m_queue_quantity > 0) {
           continue;
         }
@@ -816,9 +913,30 @@ namespace Details {
     }
   }
 
+  template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
+  void TickerOrderSimulator<T>::post(
+      const std::shared_ptr<PrimitiveOrder>& order) {
+    m_orders.push_back(order);
+    auto& entry = m_entries[order->get_info().m_id];
+    if(entry.m_venue) {
+      auto& fields = order->get_info().m_fields;
+      auto& level = get_level(entry.m_venue, fields.m_side, fields.m_price);
+      level.m_orders.push_back(order);
+    }
+  }
+
   template<typename T> requires Beam::IsTimeClient<Beam::dereference_t<T>>
   void TickerOrderSimulator<T>::erase(
       const std::shared_ptr<PrimitiveOrder>& order) {
+    auto i = m_entries.find(order->get_info().m_id);
+    if(i != m_entries.end() && i->second.m_venue) {
+      auto& fields = order->get_info().m_fields;
+      auto venue = i->second.m_venue;
+      if(auto level = find_level(venue, fields.m_side, fields.m_price)) {
+        std::erase(level->m_orders, order);
+        prune(venue, fields.m_side, fields.m_price);
+      }
+    }
     m_pegged_entries.erase(order->get_info().m_id);
     m_entries.erase(order->get_info().m_id);
     std::erase(m_orders, order);
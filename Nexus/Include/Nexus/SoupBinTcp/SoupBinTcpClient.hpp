@@ -1,13 +1,16 @@
 #ifndef NEXUS_SOUP_BIN_TCP_CLIENT_HPP
 #define NEXUS_SOUP_BIN_TCP_CLIENT_HPP
 #include <cstdint>
+#include <span>
 #include <string_view>
+#include <utility>
 #include <Beam/IO/Channel.hpp>
 #include <Beam/IO/ConnectException.hpp>
 #include <Beam/IO/OpenState.hpp>
 #include <Beam/IO/SharedBuffer.hpp>
 #include <Beam/Pointers/Dereference.hpp>
 #include <Beam/Pointers/LocalPtr.hpp>
+#include <Beam/Pointers/Ref.hpp>
 #include <Beam/Queues/Queue.hpp>
 #include <Beam/Routines/RoutineHandler.hpp>
 #include <Beam/TimeService/Timer.hpp>
@@ -16,6 +19,7 @@
 #include <boost/throw_exception.hpp>
 #include "Nexus/SoupBinTcp/HeartbeatPackets.hpp"
 #include "Nexus/SoupBinTcp/LoginPackets.hpp"
+#include "Nexus/SoupBinTcp/SoupBinTcpJournal.hpp"
 #include "Nexus/SoupBinTcp/SoupBinTcpPacket.hpp"
 
 namespace Nexus {
@@ -63,11 +67,40 @@ namespace Nexus {
         std::string_view session, std::uint64_t sequence_number, CF&& channel,
         TF&& timer);
 
+      /**
+       * Constructs a SoupBinTcpClient that resumes from a journal. Packets
+       * already journaled from the <i>sequence_number</i> onward are read
+       * from the journal, and only the packets that follow them are requested
+       * from the server. Packets received are journaled and flushed with
+       * every batch read.
+       * @param username The username.
+       * @param password The password.
+       * @param session The existing session to log into, if empty the
+       *        journal is opened for the session the server accepts.
+       * @param sequence_number The next sequence number to read.
+       * @param journal The journal of sequenced data packets received.
+       * @param channel The Channel connected to the SoupBinTCP server.
+       * @param timer The Timer used for heartbeats.
+       */
+      template<Beam::Initializes<C> CF, Beam::Initializes<T> TF>
+      SoupBinTcpClient(std::string_view username, std::string_view password,
+        std::string_view session, std::uint64_t sequence_number,
+        Beam::Ref<SoupBinTcpJournal> journal, CF&& channel, TF&& timer);
+
       ~SoupBinTcpClient();
 
       /** Reads the next SoupBinTcpPacket. */
       SoupBinTcpPacket read();
 
+      /**
+       * Reads every complete SoupBinTcpPacket received, up to the size of
+       * <i>packets</i>, without copying their payloads. The payloads point
+       * into the receive buffer and remain valid until the next read.
+       * @param packets Stores the packets read.
+       * @return The number of packets read, at least one.
+       */
+      std::size_t read_batch(std::span<SoupBinTcpPacket> packets);
+
       /** Closes the connection to the server. */
       void close();
 
@@ -75,6 +108,11 @@ namespace Nexus {
       Beam::local_ptr_t<C> m_channel;
       Beam::local_ptr_t<T> m_timer;
       Beam::SharedBuffer m_buffer;
+      Beam::SharedBuffer m_remainder;
+      std::size_t m_offset;
+      SoupBinTcpJournal* m_journal;
+      std::uint64_t m_replay_sequence_number;
+      std::uint64_t m_replay_end;
       std::string m_session;
       std::uint64_t m_sequence_number;
       Beam::RoutineHandler m_heartbeat_loop;
@@ -83,6 +121,10 @@ namespace Nexus {
 
       SoupBinTcpClient(const SoupBinTcpClient&) = delete;
       SoupBinTcpClient& operator =(const SoupBinTcpClient&) = delete;
+      template<Beam::Initializes<C> CF, Beam::Initializes<T> TF>
+      SoupBinTcpClient(std::string_view username, std::string_view password,
+        std::string_view session, std::uint64_t sequence_number,
+        SoupBinTcpJournal* journal, CF&& channel, TF&& timer);
       void heartbeat_loop();
   };
 
@@ -95,6 +137,11 @@ namespace Nexus {
     std::uint64_t, C&&, T&&) ->
       SoupBinTcpClient<std::remove_cvref_t<C>, std::remove_cvref_t<T>>;
 
+  template<typename C, typename T>
+  SoupBinTcpClient(std::string_view, std::string_view, std::string_view,
+    std::uint64_t, Beam::Ref<SoupBinTcpJournal>, C&&, T&&) ->
+      SoupBinTcpClient<std::remove_cvref_t<C>, std::remove_cvref_t<T>>;
+
   template<typename C, typename T> requires
     Beam::IsChannel<Beam::dereference_t<C>> &&
       Beam::IsTimer<Beam::dereference_t<T>>
@@ -104,21 +151,58 @@ namespace Nexus {
     : SoupBinTcpClient(username, password, {}, 1, std::forward<CF>(channel),
         std::forward<TF>(timer)) {}
 
+  template<typename C, typename T> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      Beam::IsTimer<Beam::dereference_t<T>>
+  template<Beam::Initializes<C> CF, Beam::Initializes<T> TF>
+  SoupBinTcpClient<C, T>::SoupBinTcpClient(std::string_view username,
+    std::string_view password, std::string_view session,
+    std::uint64_t sequence_number, CF&& channel, TF&& timer)
+    : SoupBinTcpClient(username, password, session, sequence_number,
+        static_cast<SoupBinTcpJournal*>(nullptr), std::forward<CF>(channel),
+        std::forward<TF>(timer)) {}
+
+  template<typename C, typename T> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      Beam::IsTimer<Beam::dereference_t<T>>
+  template<Beam::Initializes<C> CF, Beam::Initializes<T> TF>
+  SoupBinTcpClient<C, T>::SoupBinTcpClient(std::string_view username,
+    std::string_view password, std::string_view session,
+    std::uint64_t sequence_number, Beam::Ref<SoupBinTcpJournal> journal,
+    CF&& channel, TF&& timer)
+    : SoupBinTcpClient(username, password, session, sequence_number,
+        journal.get(), std::forward<CF>(channel), std::forward<TF>(timer)) {}
+
   template<typename C, typename T> requires
     Beam::IsChannel<Beam::dereference_t<C>> &&
       Beam::IsTimer<Beam::dereference_t<T>>
   template<Beam::Initializes<C> CF, Beam::Initializes<T> TF>
   SoupBinTcpClient<C, T>::SoupBinTcpClient(std::string_view username,
       std::string_view password, std::string_view session,
-      std::uint64_t sequence_number, CF&& channel, TF&& timer)
+      std::uint64_t sequence_number, SoupBinTcpJournal* journal, CF&& channel,
+      TF&& timer)
       try : m_channel(std::forward<CF>(channel)),
             m_timer(std::forward<TF>(timer)),
+            m_offset(0),
+            m_journal(journal),
+            m_replay_sequence_number(0),
+            m_replay_end(0),
             m_timer_queue(
               std::make_shared<Beam::Queue<Beam::Timer::Result>>()) {
     m_timer->get_publisher().monitor(m_timer_queue);
     try {
-      make_login_request_packet(
-        username, password, session, sequence_number, Beam::out(m_buffer));
+      auto login_sequence_number = sequence_number;
+      if(m_journal && !session.empty() && sequence_number != 0) {
+        m_journal->open(session, sequence_number);
+        if(sequence_number >= m_journal->get_first_sequence_number() &&
+            sequence_number < m_journal->get_next_sequence_number()) {
+          m_replay_sequence_number = sequence_number;
+          m_replay_end = m_journal->get_next_sequence_number();
+          login_sequence_number = m_replay_end;
+        }
+      }
+      make_login_request_packet(username, password, session,
+        login_sequence_number, Beam::out(m_buffer));
       m_channel->get_writer().write(m_buffer);
       auto login_response = SoupBinTcpPacket();
       while(true)  {
@@ -148,6 +232,13 @@ namespace Nexus {
       auto login_accepted_packet = parse_login_accepted_packet(login_response);
       m_session = login_accepted_packet.m_session;
       m_sequence_number = login_accepted_packet.m_sequence_number;
+      if(m_journal && (!m_journal->is_open() ||
+          m_journal->get_session() != m_session)) {
+        m_journal->open(m_session, m_sequence_number);
+        m_replay_sequence_number = 0;
+        m_replay_end = 0;
+      }
+      reset(m_buffer);
       m_timer->start();
       m_heartbeat_loop = Beam::spawn(
         std::bind_front(&SoupBinTcpClient::heartbeat_loop, this));
@@ -171,10 +262,66 @@ namespace Nexus {
     Beam::IsChannel<Beam::dereference_t<C>> &&
       Beam::IsTimer<Beam::dereference_t<T>>
   SoupBinTcpPacket SoupBinTcpClient<C, T>::read() {
-    reset(m_buffer);
-    return Beam::try_or_nest([&] {
-      return read_packet(m_channel->get_reader(), Beam::out(m_buffer));
-    }, Beam::IOException("Failed to read SoupBinTCP packet."));
+    auto packet = SoupBinTcpPacket();
+    read_batch(std::span(&packet, 1));
+    return packet;
+  }
+
+  template<typename C, typename T> requires
+    Beam::IsChannel<Beam::dereference_t<C>> &&
+      Beam::IsTimer<Beam::dereference_t<T>>
+  std::size_t SoupBinTcpClient<C, T>::read_batch(
+      std::span<SoupBinTcpPacket> packets) {
+    auto count = std::size_t(0);
+    if(m_replay_sequence_number != m_replay_end) {
+      while(count != packets.size() &&
+          m_replay_sequence_number != m_replay_end) {
+        packets[count] = m_journal->load(m_replay_sequence_number);
+        ++m_replay_sequence_number;
+        ++count;
+      }
+      return count;
+    }
+    while(true) {
+      auto is_journaled = false;
+      Beam::try_or_nest([&] {
+        while(count != packets.size()) {
+          auto size = parse_packet(std::string_view(
+            m_buffer.get_data() + m_offset, m_buffer.get_size() - m_offset),
+            Beam::out(packets[count]));
+          if(size == 0) {
+            break;
+          }
+          m_offset += size;
+          if(packets[count].m_type == 'S') {
+            if(m_journal) {
+              m_journal->append(m_sequence_number, packets[count]);
+              is_journaled = true;
+            }
+            ++m_sequence_number;
+          }
+          ++count;
+        }
+        if(is_journaled) {
+          m_journal->flush();
+        }
+      }, Beam::IOException("Failed to read SoupBinTCP packet."));
+      if(count != 0 || packets.empty()) {
+        return count;
+      }
+      if(m_offset == m_buffer.get_size()) {
+        reset(m_buffer);
+      } else if(m_offset != 0) {
+        reset(m_remainder);
+        append(m_remainder, m_buffer.get_data() + m_offset,
+          m_buffer.get_size() - m_offset);
+        std::swap(m_buffer, m_remainder);
+      }
+      m_offset = 0;
+      Beam::try_or_nest([&] {
+        m_channel->get_reader().read(Beam::out(m_buffer));
+      }, Beam::IOException("Failed to read SoupBinTCP packet."));
+    }
   }
 
   template<typename C, typename T> requires
@@ -185,6 +332,9 @@ namespace Nexus {
       return;
     }
     m_channel->get_connection().close();
+    if(m_journal) {
+      m_journal->flush();
+    }
     m_timer->cancel();
     m_timer_queue->close();
     m_heartbeat_loop.wait();
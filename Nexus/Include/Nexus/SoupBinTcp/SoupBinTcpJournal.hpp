@@ -0,0 +1,291 @@
+#ifndef NEXUS_SOUP_BIN_TCP_JOURNAL_HPP
+#define NEXUS_SOUP_BIN_TCP_JOURNAL_HPP
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <Beam/IO/IOException.hpp>
+#include <boost/endian.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/throw_exception.hpp>
+#include "Nexus/SoupBinTcp/SoupBinTcpPacket.hpp"
+
+namespace Nexus {
+
+  /**
+   * Keeps an append-only journal of the sequenced data packets received for
+   * a SoupBinTCP session, so that a client can resume from its last position
+   * without requesting those packets from the server again. Each session is
+   * stored in its own file, consisting of the sequence number of the first
+   * packet followed by the logical packets exactly as received. Packets
+   * journaled before the session was opened are served from a memory-mapped
+   * view of the file.
+   */
+  class SoupBinTcpJournal {
+    public:
+
+      /**
+       * Constructs a SoupBinTcpJournal.
+       * @param root The directory to store the session journals in.
+       */
+      explicit SoupBinTcpJournal(std::filesystem::path root);
+
+      ~SoupBinTcpJournal();
+
+      /** Returns <code>true</code> iff a session is open. */
+      bool is_open() const;
+
+      /** Returns the open session. */
+      const std::string& get_session() const;
+
+      /** Returns the sequence number of the first packet journaled. */
+      std::uint64_t get_first_sequence_number() const;
+
+      /** Returns the sequence number of the next packet to journal. */
+      std::uint64_t get_next_sequence_number() const;
+
+      /**
+       * Returns the end of the sequence numbers that were journaled before
+       * the session was opened and can be loaded.
+       */
+      std::uint64_t get_recovered_sequence_number() const;
+
+      /**
+       * Opens the journal for a session, creating it if it does not exist. A
+       * partially written trailing packet is discarded.
+       * @param session The session to open.
+       * @param sequence_number The sequence number of the first packet to
+       *        journal, used only if the journal is created.
+       */
+      void open(std::string_view session, std::uint64_t sequence_number);
+
+      /**
+       * Loads a packet journaled before the session was opened. The packet's
+       * payload points into the journal and remains valid until it is closed.
+       * @param sequence_number The packet's sequence number, must be at least
+       *        the first sequence number and less than the recovered sequence
+       *        number.
+       * @return The packet with the specified <i>sequence_number</i>.
+       */
+      SoupBinTcpPacket load(std::uint64_t sequence_number) const;
+
+      /**
+       * Appends a sequenced data packet. Packets before the next sequence
+       * number are ignored. A packet past it restarts the journal at its
+       * sequence number, since the packets in between can not be journaled,
+       * invalidating the packets loaded.
+       * @param sequence_number The packet's sequence number.
+       * @param packet The packet to append.
+       */
+      void append(
+        std::uint64_t sequence_number, const SoupBinTcpPacket& packet);
+
+      /** Writes all appended packets to the file. */
+      void flush();
+
+      /** Closes the open session. */
+      void close();
+
+    private:
+      static constexpr auto HEADER_LENGTH = sizeof(std::uint64_t);
+      std::filesystem::path m_root;
+      std::string m_session;
+      std::uint64_t m_first_sequence_number;
+      std::uint64_t m_next_sequence_number;
+      boost::interprocess::mapped_region m_region;
+      std::vector<std::uint64_t> m_offsets;
+      std::ofstream m_file;
+
+      SoupBinTcpJournal(const SoupBinTcpJournal&) = delete;
+      SoupBinTcpJournal& operator =(const SoupBinTcpJournal&) = delete;
+      std::filesystem::path get_path(std::string_view session) const;
+      void create(
+        const std::filesystem::path& path, std::uint64_t sequence_number);
+      void restart(std::uint64_t sequence_number);
+  };
+
+  inline SoupBinTcpJournal::SoupBinTcpJournal(std::filesystem::path root)
+    : m_root(std::move(root)),
+      m_first_sequence_number(0),
+      m_next_sequence_number(0) {}
+
+  inline SoupBinTcpJournal::~SoupBinTcpJournal() {
+    close();
+  }
+
+  inline bool SoupBinTcpJournal::is_open() const {
+    return m_file.is_open();
+  }
+
+  inline const std::string& SoupBinTcpJournal::get_session() const {
+    return m_session;
+  }
+
+  inline std::uint64_t SoupBinTcpJournal::get_first_sequence_number() const {
+    return m_first_sequence_number;
+  }
+
+  inline std::uint64_t SoupBinTcpJournal::get_next_sequence_number() const {
+    return m_next_sequence_number;
+  }
+
+  inline std::uint64_t
+      SoupBinTcpJournal::get_recovered_sequence_number() const {
+    return m_first_sequence_number + m_offsets.size();
+  }
+
+  inline void SoupBinTcpJournal::open(
+      std::string_view session, std::uint64_t sequence_number) {
+    close();
+    auto path = get_path(session);
+    try {
+      std::filesystem::create_directories(m_root);
+      auto size = std::uintmax_t(0);
+      if(std::filesystem::exists(path)) {
+        size = std::filesystem::file_size(path);
+      }
+      if(size < HEADER_LENGTH) {
+        create(path, sequence_number);
+      } else {
+        auto mapping = boost::interprocess::file_mapping(
+          path.string().c_str(), boost::interprocess::read_only);
+        m_region = boost::interprocess::mapped_region(
+          mapping, boost::interprocess::read_only, 0, size);
+        auto data = static_cast<const char*>(m_region.get_address());
+        auto header = std::uint64_t();
+        std::memcpy(&header, data, sizeof(header));
+        m_first_sequence_number = boost::endian::little_to_native(header);
+        auto offset = std::uintmax_t(HEADER_LENGTH);
+        while(true) {
+          auto packet = SoupBinTcpPacket();
+          auto packet_size = std::size_t(0);
+          try {
+            packet_size = parse_packet(std::string_view(
+              data + offset, size - offset), Beam::out(packet));
+          } catch(const SoupBinTcpParserException&) {}
+          if(packet_size == 0) {
+            break;
+          }
+          m_offsets.push_back(offset);
+          offset += packet_size;
+        }
+        if(offset != size) {
+          m_region = boost::interprocess::mapped_region();
+          std::filesystem::resize_file(path, offset);
+          m_region = boost::interprocess::mapped_region(
+            mapping, boost::interprocess::read_only, 0, offset);
+        }
+      }
+      m_file.open(path, std::ios::binary | std::ios::app);
+      if(!m_file) {
+        boost::throw_with_location(
+          Beam::IOException("Unable to open SoupBinTCP journal."));
+      }
+    } catch(const std::exception&) {
+      m_region = boost::interprocess::mapped_region();
+      m_offsets.clear();
+      std::throw_with_nested(
+        Beam::IOException("Unable to open SoupBinTCP journal."));
+    }
+    m_session = session;
+    m_next_sequence_number = m_first_sequence_number + m_offsets.size();
+  }
+
+  inline SoupBinTcpPacket SoupBinTcpJournal::load(
+      std::uint64_t sequence_number) const {
+    if(sequence_number < m_first_sequence_number ||
+        sequence_number >= get_recovered_sequence_number()) {
+      boost::throw_with_location(
+        Beam::IOException("Sequence number not journaled."));
+    }
+    auto data = static_cast<const char*>(m_region.get_address());
+    auto offset = m_offsets[sequence_number - m_first_sequence_number];
+    auto packet = SoupBinTcpPacket();
+    parse_packet(std::string_view(data + offset,
+      m_region.get_size() - offset), Beam::out(packet));
+    return packet;
+  }
+
+  inline void SoupBinTcpJournal::append(
+      std::uint64_t sequence_number, const SoupBinTcpPacket& packet) {
+    if(!is_open() || sequence_number < m_next_sequence_number) {
+      return;
+    } else if(sequence_number != m_next_sequence_number) {
+      restart(sequence_number);
+    }
+    auto length = boost::endian::native_to_big(packet.m_length);
+    m_file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    m_file.put(static_cast<char>(packet.m_type));
+    m_file.write(packet.m_payload, packet.m_length - 1);
+    if(!m_file) {
+      boost::throw_with_location(
+        Beam::IOException("Unable to write SoupBinTCP journal."));
+    }
+    ++m_next_sequence_number;
+  }
+
+  inline void SoupBinTcpJournal::flush() {
+    if(is_open()) {
+      m_file.flush();
+    }
+  }
+
+  inline void SoupBinTcpJournal::close() {
+    if(!is_open()) {
+      return;
+    }
+    m_file.close();
+    m_region = boost::interprocess::mapped_region();
+    m_offsets.clear();
+    m_session.clear();
+    m_first_sequence_number = 0;
+    m_next_sequence_number = 0;
+  }
+
+  inline std::filesystem::path SoupBinTcpJournal::get_path(
+      std::string_view session) const {
+    return m_root / (std::string(session) + ".journal");
+  }
+
+  inline void SoupBinTcpJournal::create(
+      const std::filesystem::path& path, std::uint64_t sequence_number) {
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    auto header = boost::endian::native_to_little(sequence_number);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if(!file) {
+      boost::throw_with_location(
+        Beam::IOException("Unable to create SoupBinTCP journal."));
+    }
+    m_first_sequence_number = sequence_number;
+  }
+
+  inline void SoupBinTcpJournal::restart(std::uint64_t sequence_number) {
+    auto path = get_path(m_session);
+    m_file.close();
+    m_region = boost::interprocess::mapped_region();
+    m_offsets.clear();
+    try {
+      create(path, sequence_number);
+      m_file.open(path, std::ios::binary | std::ios::app);
+      if(!m_file) {
+        boost::throw_with_location(
+          Beam::IOException("Unable to open SoupBinTCP journal."));
+      }
+    } catch(const std::exception&) {
+      m_session.clear();
+      m_first_sequence_number = 0;
+      m_next_sequence_number = 0;
+      std::throw_with_nested(
+        Beam::IOException("Unable to restart SoupBinTCP journal."));
+    }
+    m_next_sequence_number = sequence_number;
+  }
+}
+
+#endif
@@ -1,7 +1,9 @@
 #ifndef NEXUS_SOUP_BIN_TCP_PACKET_HPP
 #define NEXUS_SOUP_BIN_TCP_PACKET_HPP
 #include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <Beam/IO/Buffer.hpp>
 #include <Beam/IO/Reader.hpp>
 #include <Beam/Pointers/Out.hpp>
@@ -59,6 +61,38 @@ namespace Nexus {
     packet.m_payload = payload->get_data();
     return packet;
   }
+
+  /**
+   * Parses a logical packet in place, without copying its payload.
+   * @param source The bytes to parse the logical packet from.
+   * @param packet Stores the logical packet, its payload points into the
+   *        <i>source</i>.
+   * @return The number of bytes the logical packet occupies in the
+   *         <i>source</i>, or 0 if the <i>source</i> does not contain a
+   *         complete packet.
+   */
+  inline std::size_t parse_packet(
+      std::string_view source, Beam::Out<SoupBinTcpPacket> packet) {
+    static const auto HEADER_LENGTH =
+      sizeof(packet->m_length) + sizeof(packet->m_type);
+    if(source.size() < HEADER_LENGTH) {
+      return 0;
+    }
+    auto length = std::uint16_t();
+    std::memcpy(&length, source.data(), sizeof(length));
+    length = boost::endian::big_to_native(length);
+    if(length == 0) {
+      boost::throw_with_location(
+        SoupBinTcpParserException("Invalid packet length."));
+    }
+    if(source.size() < sizeof(length) + length) {
+      return 0;
+    }
+    packet->m_length = length;
+    packet->m_type = static_cast<std::uint8_t>(source[sizeof(length)]);
+    packet->m_payload = source.data() + HEADER_LENGTH;
+    return sizeof(length) + length;
+  }
 }
 
 #endif
@@ -6,6 +6,7 @@
 #include <Beam/Utilities/FixedString.hpp>
 #include <boost/throw_exception.hpp>
 #include "Nexus/Stamp/StampParserException.hpp"
+#include "Nexus/Stamp/StampScanning.hpp"
 
 namespace Nexus {
 
@@ -88,8 +89,8 @@ namespace Nexus {
 
   inline StampHeader StampHeader::parse(
       Beam::Out<const char*> token, std::size_t size) {
-    static const auto LENGTH_LENGTH = 4;
-    static const auto SEQUENCE_LENGTH = 9;
+    static constexpr auto LENGTH_LENGTH = std::size_t(4);
+    static constexpr auto SEQUENCE_LENGTH = std::size_t(9);
     static const auto SERVICE_ID_LENGTH = 3;
     static const auto MESSAGE_TYPE_LENGTH = 2;
     static const auto EXCHANGE_IDENTIFIER_LENGTH = 2;
@@ -98,29 +99,20 @@ namespace Nexus {
         StampParserException("STAMP header too short."));
     }
     auto header = StampHeader();
-    header.m_length = 0;
-    for(int i = 0; i < LENGTH_LENGTH; ++i) {
-      if(!std::isdigit(**token)) {
-        boost::throw_with_location(
-          StampParserException("Invalid length field."));
-      }
-      header.m_length = 10 * header.m_length + **token - '0';
-      ++*token;
+    auto length = std::uint32_t();
+    if(!parse_stamp_digits<LENGTH_LENGTH>(*token, Beam::out(length))) {
+      boost::throw_with_location(
+        StampParserException("Invalid length field."));
     }
+    header.m_length = static_cast<std::uint16_t>(length);
+    *token += LENGTH_LENGTH;
     header.m_sequence_number = 0;
-    if(std::isspace(**token)) {
-      *token += SEQUENCE_LENGTH;
-    } else {
-      for(int i = 0; i < SEQUENCE_LENGTH; ++i) {
-        if(!std::isdigit(**token)) {
-          boost::throw_with_location(
-            StampParserException("Invalid sequence field."));
-        }
-        header.m_sequence_number =
-          10 * header.m_sequence_number + **token - '0';
-        ++*token;
-      }
+    if(!std::isspace(**token) && !parse_stamp_digits<SEQUENCE_LENGTH>(
+        *token, Beam::out(header.m_sequence_number))) {
+      boost::throw_with_location(
+        StampParserException("Invalid sequence field."));
     }
+    *token += SEQUENCE_LENGTH;
     header.m_service_id = *token;
     *token += SERVICE_ID_LENGTH;
     if(**token == '0') {
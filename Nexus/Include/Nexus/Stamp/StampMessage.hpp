@@ -10,6 +10,7 @@
 #include "Nexus/Definitions/Side.hpp"
 #include "Nexus/Stamp/StampMessage.hpp"
 #include "Nexus/Stamp/StampPacket.hpp"
+#include "Nexus/Stamp/StampScanning.hpp"
 
 namespace Nexus {
 namespace Details {
@@ -46,10 +47,7 @@ namespace Details {
       return false;
     }
     *value_start = field + length;
-    *value_end = std::strpbrk(*value_start, "\x1e\x03");
-    if(!*value_end) {
-      *value_end = source + source_size;
-    }
+    *value_end = find_stamp_delimiter(*value_start, source + source_size);
     return true;
   }
 
@@ -0,0 +1,111 @@
+#ifndef NEXUS_STAMP_SCANNING_HPP
+#define NEXUS_STAMP_SCANNING_HPP
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <Beam/Pointers/Out.hpp>
+#include <boost/endian/conversion.hpp>
+#if defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define NEXUS_STAMP_SSE2
+#endif
+
+namespace Nexus {
+
+  /** The STAMP field separator. */
+  static constexpr auto STAMP_FIELD_SEPARATOR = '\x1e';
+
+  /** The STAMP end of packet token. */
+  static constexpr auto STAMP_END_TOKEN = '\x03';
+
+namespace Details {
+  inline std::uint64_t load_stamp_word(const char* source) {
+    auto word = std::uint64_t();
+    std::memcpy(&word, source, sizeof(word));
+    return boost::endian::little_to_native(word);
+  }
+
+  inline bool is_stamp_digits(std::uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0) |
+      (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+        0x3333333333333333;
+  }
+
+  inline std::uint32_t to_stamp_number(std::uint64_t word) {
+    word = ((word & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+    word = ((word & 0x0000FFFF0000FFFF) * 42949672960001) >> 32;
+    return static_cast<std::uint32_t>(word);
+  }
+
+  inline const char* find_stamp_delimiter_scalar(
+      const char* first, const char* last) {
+    while(first != last && *first != STAMP_FIELD_SEPARATOR &&
+        *first != STAMP_END_TOKEN) {
+      ++first;
+    }
+    return first;
+  }
+}
+
+  /**
+   * Parses a fixed-width decimal field, converting eight digits at a time.
+   * @param <N> The width of the field, at most 9.
+   * @param source The first character of the field.
+   * @param value Stores the value parsed.
+   * @return <code>true</code> iff every character of the field is a digit.
+   */
+  template<std::size_t N>
+  bool parse_stamp_digits(const char* source, Beam::Out<std::uint32_t> value) {
+    static_assert(N != 0 && N <= 9, "Field too wide.");
+    auto word = std::uint64_t();
+    if constexpr(N >= 8) {
+      word = Details::load_stamp_word(source + N - 8);
+    } else {
+      char digits[8];
+      std::memset(digits, '0', sizeof(digits) - N);
+      std::memcpy(digits + sizeof(digits) - N, source, N);
+      word = Details::load_stamp_word(digits);
+    }
+    if(!Details::is_stamp_digits(word)) {
+      return false;
+    }
+    auto result = Details::to_stamp_number(word);
+    if constexpr(N == 9) {
+      if(*source < '0' || *source > '9') {
+        return false;
+      }
+      result += 100000000 * static_cast<std::uint32_t>(*source - '0');
+    }
+    *value = result;
+    return true;
+  }
+
+  /**
+   * Finds the next STAMP field separator or end token, sixteen bytes at a
+   * time where SSE2 is available.
+   * @param first The first character to search.
+   * @param last One past the last character to search.
+   * @return The first delimiter found, or <i>last</i> if there is none.
+   */
+  inline const char* find_stamp_delimiter(
+      const char* first, const char* last) {
+#ifdef NEXUS_STAMP_SSE2
+    auto separator = _mm_set1_epi8(STAMP_FIELD_SEPARATOR);
+    auto end_token = _mm_set1_epi8(STAMP_END_TOKEN);
+    while(last - first >= 16) {
+      auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      auto mask = _mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(block, separator), _mm_cmpeq_epi8(block, end_token)));
+      if(mask != 0) {
+        return first + std::countr_zero(static_cast<unsigned int>(mask));
+      }
+      first += 16;
+    }
+#endif
+    return Details::find_stamp_delimiter_scalar(first, last);
+  }
+}
+
+#endif
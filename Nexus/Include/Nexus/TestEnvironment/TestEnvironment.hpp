@@ -221,7 +221,7 @@ namespace Nexus {
         m_market_data_environment->make_registry_client(
           Beam::Ref(m_service_locator_client)));
       m_charting_environment.emplace(
-        m_service_locator_client, *m_market_data_client);
+        m_service_locator_client, *m_market_data_client, m_time_client);
       m_compliance_environment.emplace(
         m_service_locator_client, m_administration_client, m_time_client);
       auto definitions_client = m_definitions_environment.make_client(
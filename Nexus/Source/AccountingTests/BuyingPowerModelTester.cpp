@@ -251,4 +251,34 @@ TEST_SUITE("BuyingPowerModel") {
     model.update(TST, CAD, 50, 500 * Money::ONE);
     REQUIRE(model.get_buying_power(CAD) == 1500 * Money::ONE);
   }
+
+  TEST_CASE("ticker_id") {
+    auto model = BuyingPowerModel();
+    auto ticker = to_ticker_id(TST);
+    model.update(ticker, CAD, 100, 1000 * Money::ONE);
+    auto fields = make_order_fields(TST, CAD, Side::ASK, 50, 11 * Money::ONE);
+    model.submit(1, ticker, fields, 11 * Money::ONE);
+    REQUIRE(model.get_buying_power(CAD) == 1000 * Money::ONE);
+    model.update(
+      make_execution_report(1, OrderStatus::FILLED, 50, 11 * Money::ONE));
+    REQUIRE(model.get_buying_power(CAD) == 500 * Money::ONE);
+    model.update(TST, CAD, -50, -500 * Money::ONE);
+    REQUIRE(model.get_buying_power(CAD) == Money::ZERO);
+  }
+
+  TEST_CASE("terminal_orders") {
+    auto model = BuyingPowerModel();
+    for(auto i = 1; i <= 100; ++i) {
+      auto fields =
+        make_order_fields(TST, CAD, Side::BID, 100, 10 * Money::ONE);
+      model.submit(i, fields, 10 * Money::ONE);
+      model.update(
+        make_execution_report(i, OrderStatus::CANCELED, 0, Money::ZERO));
+    }
+    REQUIRE(model.has_order(100));
+    REQUIRE(model.get_buying_power(CAD) == Money::ZERO);
+    auto fields = make_order_fields(TST, CAD, Side::BID, 100, 10 * Money::ONE);
+    model.submit(101, fields, 10 * Money::ONE);
+    REQUIRE(model.get_buying_power(CAD) == 1000 * Money::ONE);
+  }
 }
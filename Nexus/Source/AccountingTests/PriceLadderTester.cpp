@@ -0,0 +1,55 @@
+#include <doctest/doctest.h>
+#include "Nexus/Accounting/PriceLadder.hpp"
+
+using namespace Nexus;
+
+TEST_SUITE("PriceLadder") {
+  TEST_CASE("empty_ladder") {
+    auto ladder = PriceLadder(Side::ASK);
+    REQUIRE(ladder.get_quantity() == 0);
+    REQUIRE(ladder.get_notional() == Money::ZERO);
+    REQUIRE(ladder.get_notional(100) == Money::ZERO);
+  }
+
+  TEST_CASE("ask_offset") {
+    auto ladder = PriceLadder(Side::ASK);
+    ladder.add(3 * Money::ONE, 100);
+    ladder.add(Money::ONE, 100);
+    ladder.add(2 * Money::ONE, 100);
+    REQUIRE(ladder.get_quantity() == 300);
+    REQUIRE(ladder.get_notional() == 600 * Money::ONE);
+    REQUIRE(ladder.get_notional(0) == 600 * Money::ONE);
+    REQUIRE(ladder.get_notional(50) == 550 * Money::ONE);
+    REQUIRE(ladder.get_notional(100) == 500 * Money::ONE);
+    REQUIRE(ladder.get_notional(250) == 150 * Money::ONE);
+    REQUIRE(ladder.get_notional(400) == Money::ZERO);
+  }
+
+  TEST_CASE("bid_offset") {
+    auto ladder = PriceLadder(Side::BID);
+    ladder.add(Money::ONE, 100);
+    ladder.add(3 * Money::ONE, 100);
+    ladder.add(2 * Money::ONE, 100);
+    REQUIRE(ladder.get_notional(50) == 450 * Money::ONE);
+    REQUIRE(ladder.get_notional(150) == 200 * Money::ONE);
+  }
+
+  TEST_CASE("remove_levels") {
+    auto ladder = PriceLadder(Side::ASK);
+    for(auto i = 1; i <= 100; ++i) {
+      ladder.add(i * Money::ONE, 10);
+    }
+    for(auto i = 1; i <= 100; i += 2) {
+      ladder.add(i * Money::ONE, -10);
+    }
+    REQUIRE(ladder.get_quantity() == 500);
+    REQUIRE(ladder.get_notional(10) == 25500 * Money::ONE - 20 * Money::ONE);
+    ladder.add(Money::CENT, -10);
+    REQUIRE(ladder.get_quantity() == 500);
+    for(auto i = 2; i <= 100; i += 2) {
+      ladder.add(i * Money::ONE, -20);
+    }
+    REQUIRE(ladder.get_quantity() == 0);
+    REQUIRE(ladder.get_notional() == Money::ZERO);
+  }
+}
@@ -308,6 +308,32 @@ TEST_SUITE("AdministrationServlet") {
     REQUIRE(!roles.test(AccountRole::MANAGER));
   }
 
+  TEST_CASE("store_account_roles") {
+    auto fixture = Fixture();
+    auto roles = AccountRoles();
+    roles.set(AccountRole::TRADER);
+    roles.set(AccountRole::MANAGER);
+    auto result = fixture.m_manager_client->send_request<
+      StoreAccountRolesService>(fixture.m_trader_account, roles);
+    REQUIRE(result == roles);
+    REQUIRE(fixture.m_admin_client->send_request<LoadAccountRolesService>(
+      fixture.m_trader_account) == roles);
+    auto trading_group = fixture.m_admin_client->send_request<
+      LoadTradingGroupService>(fixture.m_trading_group.get_entry());
+    REQUIRE(std::ranges::contains(
+      trading_group.get_managers(), fixture.m_trader_account));
+    roles.reset(AccountRole::TRADER);
+    result = fixture.m_admin_client->send_request<StoreAccountRolesService>(
+      fixture.m_trader_account, roles);
+    REQUIRE(result == roles);
+    REQUIRE_THROWS_AS(fixture.m_trader_client->send_request<
+      StoreAccountRolesService>(fixture.m_manager_account, AccountRoles()),
+      ServiceRequestException);
+    REQUIRE_THROWS_AS(fixture.m_manager_client->send_request<
+      StoreAccountRolesService>(fixture.m_admin_account, AccountRoles()),
+      ServiceRequestException);
+  }
+
   TEST_CASE("load_parent_trading_group") {
     auto fixture = Fixture();
     auto parent_group = fixture.m_admin_client->send_request<
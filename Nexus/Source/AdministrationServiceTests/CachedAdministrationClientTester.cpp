@@ -0,0 +1,136 @@
+#include <atomic>
+#include <memory>
+#include <Beam/ServicesTests/ServiceClientFixture.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/AdministrationService/CachedAdministrationClient.hpp"
+#include "Nexus/AdministrationService/ServiceAdministrationClient.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace Nexus;
+
+namespace {
+  struct Fixture : ServiceClientFixture {
+    using TestServiceAdministrationClient =
+      ServiceAdministrationClient<TestServiceProtocolClientBuilder>;
+    using TestCachedAdministrationClient =
+      CachedAdministrationClient<TestServiceAdministrationClient*>;
+    std::unique_ptr<TestServiceAdministrationClient> m_service_client;
+    std::unique_ptr<TestCachedAdministrationClient> m_client;
+    TestServiceProtocolServer::ServiceProtocolClient* m_server_side_client;
+
+    Fixture()
+        : m_server_side_client(nullptr) {
+      Nexus::register_query_types(out(m_server.get_slots().get_registry()));
+      register_administration_services(out(m_server.get_slots()));
+      register_administration_messages(out(m_server.get_slots()));
+      on_request<MonitorAccountUpdatesService>([&] (auto& request) {
+        m_server_side_client = &request.get_client();
+        request.set();
+      });
+      m_service_client = make_client<TestServiceAdministrationClient>();
+      m_client = std::make_unique<TestCachedAdministrationClient>(
+        m_service_client.get());
+    }
+  };
+}
+
+TEST_SUITE("CachedAdministrationClient") {
+  TEST_CASE("load_account_roles") {
+    auto fixture = Fixture();
+    auto account = DirectoryEntry::make_account(5, "account");
+    auto roles = AccountRoles();
+    roles.set(AccountRole::TRADER);
+    auto request_count = std::atomic_int(0);
+    fixture.on_request<LoadAccountRolesService>(
+      [&] (auto& request, const auto& received_account) {
+        REQUIRE(received_account == account);
+        ++request_count;
+        request.set(roles);
+      });
+    REQUIRE(fixture.m_client->load_account_roles(account) == roles);
+    REQUIRE(fixture.m_client->load_account_roles(account) == roles);
+    REQUIRE(request_count == 1);
+    roles.reset(AccountRole::TRADER);
+    REQUIRE(fixture.m_server_side_client);
+    send_record_message<AccountUpdateMessage>(
+      *fixture.m_server_side_client, account);
+    while(fixture.m_client->load_account_roles(account).test(
+      AccountRole::TRADER)) {}
+    REQUIRE(request_count >= 2);
+  }
+
+  TEST_CASE("store_account_roles") {
+    auto fixture = Fixture();
+    auto account = DirectoryEntry::make_account(5, "account");
+    auto roles = AccountRoles();
+    auto request_count = std::atomic_int(0);
+    fixture.on_request<LoadAccountRolesService>(
+      [&] (auto& request, const auto& received_account) {
+        ++request_count;
+        request.set(roles);
+      });
+    fixture.on_request<StoreAccountRolesService>(
+      [&] (auto& request, const auto& received_account,
+          const auto& received_roles) {
+        REQUIRE(received_account == account);
+        roles = received_roles;
+        request.set(roles);
+      });
+    REQUIRE(fixture.m_client->load_account_roles(account) == AccountRoles());
+    auto manager_roles = AccountRoles();
+    manager_roles.set(AccountRole::MANAGER);
+    REQUIRE(fixture.m_client->store(account, manager_roles) == manager_roles);
+    REQUIRE(fixture.m_client->load_account_roles(account) == manager_roles);
+    REQUIRE(request_count == 2);
+  }
+
+  TEST_CASE("entitlement_database_update") {
+    auto fixture = Fixture();
+    auto database = EntitlementDatabase();
+    auto request_count = std::atomic_int(0);
+    fixture.on_request<LoadEntitlementsService>([&] (auto& request) {
+      ++request_count;
+      request.set(database);
+    });
+    REQUIRE(fixture.m_client->load_entitlements().get_entries().empty());
+    REQUIRE(fixture.m_client->load_entitlements().get_entries().empty());
+    REQUIRE(request_count == 1);
+    auto entry = EntitlementDatabase::Entry();
+    entry.m_name = "TSX";
+    entry.m_group_entry = DirectoryEntry::make_directory(100, "tsx");
+    database.add(entry);
+    REQUIRE(fixture.m_server_side_client);
+    send_record_message<AccountUpdateMessage>(
+      *fixture.m_server_side_client, DirectoryEntry());
+    while(fixture.m_client->load_entitlements().get_entries().empty()) {}
+    REQUIRE(request_count >= 2);
+  }
+
+  TEST_CASE("account_update") {
+    auto fixture = Fixture();
+    auto account = DirectoryEntry::make_account(6, "account");
+    auto entitlement = DirectoryEntry::make_directory(100, "entitlement");
+    auto entitlements = std::vector<DirectoryEntry>();
+    auto request_count = std::atomic_int(0);
+    fixture.on_request<LoadAccountEntitlementsService>(
+      [&] (auto& request, const auto& received_account) {
+        REQUIRE(received_account == account);
+        ++request_count;
+        request.set(entitlements);
+      });
+    REQUIRE(fixture.m_client->load_entitlements(account).empty());
+    REQUIRE(fixture.m_client->load_entitlements(account).empty());
+    REQUIRE(request_count == 1);
+    entitlements.push_back(entitlement);
+    REQUIRE(fixture.m_server_side_client);
+    send_record_message<AccountUpdateMessage>(
+      *fixture.m_server_side_client, account);
+    while(fixture.m_client->load_entitlements(account).empty()) {}
+    REQUIRE(request_count >= 2);
+    auto count = request_count.load();
+    REQUIRE(fixture.m_client->load_entitlements(account) ==
+      std::vector{entitlement});
+    REQUIRE(request_count == count);
+  }
+}
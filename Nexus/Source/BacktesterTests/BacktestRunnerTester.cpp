@@ -0,0 +1,160 @@
+#include <doctest/doctest.h>
+#include "Nexus/Backtester/BacktestRunner.hpp"
+#include "Nexus/MarketDataService/LocalHistoricalDataStore.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+
+namespace {
+  auto make_data_store(const Ticker& ticker, ptime start_time) {
+    auto data_store = std::make_shared<LocalHistoricalDataStore>();
+    auto timestamp = start_time - seconds(1);
+    data_store->store(SequencedValue(IndexedValue(BboQuote(
+      make_bid(99 * Money::CENT, 100), make_ask(Money::ONE, 100), timestamp),
+      ticker), encode(timestamp, Beam::Sequence(1))));
+    timestamp = start_time + seconds(1);
+    data_store->store(SequencedValue(IndexedValue(BboQuote(
+      make_bid(98 * Money::CENT, 100), make_ask(99 * Money::CENT, 100),
+      timestamp), ticker), encode(timestamp, Beam::Sequence(2))));
+    return data_store;
+  }
+
+  auto make_oscillating_data_store(
+      const Ticker& ticker, ptime start_time, int count) {
+    auto data_store = std::make_shared<LocalHistoricalDataStore>();
+    for(auto i = 0; i != count; ++i) {
+      auto timestamp = start_time + seconds(i - 1);
+      auto bid = (95 + i % 5) * Money::CENT;
+      data_store->store(SequencedValue(IndexedValue(BboQuote(
+        make_bid(bid, 100), make_ask(bid + Money::CENT, 100), timestamp),
+        ticker), encode(timestamp, Beam::Sequence(i + 1))));
+    }
+    return data_store;
+  }
+
+  auto make_trading_scenario(std::string name, const Ticker& ticker,
+      ptime start_time, Side side, std::vector<int> prices) {
+    return BacktestScenario(std::move(name), start_time,
+      start_time + hours(1), [=] (BacktesterEnvironment& environment) {
+        auto clients = BacktesterClients(Ref(environment));
+        for(auto i = std::size_t(0); i != prices.size(); ++i) {
+          auto order_side = i % 2 == 0 ? side : get_opposite(side);
+          clients.get_order_execution_client().submit(
+            make_limit_order_fields(
+              ticker, order_side, 100, prices[i] * Money::CENT));
+        }
+      });
+  }
+
+  void require_equal(
+      const BacktestSummary& left, const BacktestSummary& right) {
+    REQUIRE(left.m_name == right.m_name);
+    REQUIRE(left.m_currency == right.m_currency);
+    REQUIRE(left.m_realized_profit_and_loss ==
+      right.m_realized_profit_and_loss);
+    REQUIRE(left.m_unrealized_profit_and_loss ==
+      right.m_unrealized_profit_and_loss);
+    REQUIRE(left.m_fees == right.m_fees);
+    REQUIRE(left.m_volume == right.m_volume);
+    REQUIRE(left.m_transaction_count == right.m_transaction_count);
+    REQUIRE(left.m_error == right.m_error);
+  }
+}
+
+TEST_SUITE("BacktestRunner") {
+  TEST_CASE("run") {
+    auto start_time = time_from_string("2020-12-11 00:00:10");
+    auto ticker = parse_ticker("TST.TSXV");
+    auto data_store = make_data_store(ticker, start_time);
+    auto runner = BacktestRunner(MarketDataSlice(HistoricalDataStore(
+      data_store.get())), 2);
+    REQUIRE(runner.get_concurrency() == 2);
+    auto scenarios = std::vector<BacktestScenario>();
+    for(auto i = 98; i <= 100; ++i) {
+      scenarios.push_back(BacktestScenario("bid_" + std::to_string(i),
+        start_time, start_time + hours(1),
+        [=] (BacktesterEnvironment& environment) {
+          auto clients = BacktesterClients(Ref(environment));
+          clients.get_order_execution_client().submit(make_limit_order_fields(
+            ticker, Side::BID, 100, i * Money::CENT));
+        }));
+    }
+    scenarios.push_back(
+      BacktestScenario("idle", start_time, start_time + hours(1), {}));
+    auto results = runner.run(scenarios);
+    REQUIRE(results.size() == 4);
+    for(auto i = 0; i != 4; ++i) {
+      REQUIRE(results[i].m_name == scenarios[i].m_name);
+      REQUIRE(results[i].m_error.empty());
+    }
+    auto get_quantity = [&] (const BacktestResult& result) {
+      return result.m_portfolio.get_bookkeeper().get_inventory(
+        ticker).m_position.m_quantity;
+    };
+    REQUIRE(get_quantity(results[0]) == 0);
+    REQUIRE(get_quantity(results[1]) == 100);
+    REQUIRE(get_quantity(results[2]) == 100);
+    REQUIRE(get_quantity(results[3]) == 0);
+    auto summary = summarize(results);
+    REQUIRE(summary.back().m_name == "idle");
+    REQUIRE(summary.back().m_currency == CurrencyId::NONE);
+    REQUIRE(summary.back().m_transaction_count == 0);
+    auto filled = std::find_if(summary.begin(), summary.end(),
+      [] (const auto& row) {
+        return row.m_name == "bid_99";
+      });
+    REQUIRE(filled != summary.end());
+    REQUIRE(filled->m_currency != CurrencyId::NONE);
+    REQUIRE(filled->m_volume == 100);
+    REQUIRE(filled->m_transaction_count == 1);
+  }
+
+  TEST_CASE("concurrent_scenarios") {
+    auto start_time = time_from_string("2020-12-11 00:00:10");
+    auto ticker = parse_ticker("TST.TSXV");
+    auto data_store = make_oscillating_data_store(ticker, start_time, 200);
+    auto scenarios = std::vector<BacktestScenario>();
+    scenarios.push_back(make_trading_scenario("buyer", ticker, start_time,
+      Side::BID, {96, 100, 97, 99, 98, 101}));
+    scenarios.push_back(make_trading_scenario("seller", ticker, start_time,
+      Side::ASK, {99, 95, 98, 96, 97, 94}));
+    auto expected = std::vector<BacktestSummary>();
+    for(auto& scenario : scenarios) {
+      auto runner = BacktestRunner(MarketDataSlice(HistoricalDataStore(
+        data_store.get())), 1);
+      auto summary =
+        summarize(runner.run(std::vector<BacktestScenario>{scenario}));
+      REQUIRE(summary.size() == 1);
+      REQUIRE(summary.front().m_error.empty());
+      REQUIRE(summary.front().m_transaction_count != 0);
+      expected.push_back(summary.front());
+    }
+    auto interleaved = std::vector<BacktestScenario>();
+    for(auto i = 0; i != 4; ++i) {
+      interleaved.insert(
+        interleaved.end(), scenarios.begin(), scenarios.end());
+    }
+    auto runner = BacktestRunner(MarketDataSlice(HistoricalDataStore(
+      data_store.get())), interleaved.size());
+    auto summary = summarize(runner.run(interleaved));
+    REQUIRE(summary.size() == interleaved.size());
+    for(auto i = std::size_t(0); i != summary.size(); ++i) {
+      require_equal(summary[i], expected[i % expected.size()]);
+    }
+  }
+
+  TEST_CASE("read_only") {
+    auto data_store = LocalHistoricalDataStore();
+    auto slice = MarketDataSlice(HistoricalDataStore(&data_store));
+    auto timestamp = time_from_string("2020-12-11 00:00:10");
+    REQUIRE_THROWS_AS(slice.store(SequencedValue(IndexedValue(BboQuote(
+      make_bid(Money::ONE, 100), make_ask(Money::ONE, 100), timestamp),
+      parse_ticker("TST.TSXV")), Beam::Sequence(1))),
+      HistoricalDataStoreException);
+    slice.close();
+    REQUIRE(slice.load_bbo_quotes(
+      make_current_query(parse_ticker("TST.TSXV"))).empty());
+  }
+}
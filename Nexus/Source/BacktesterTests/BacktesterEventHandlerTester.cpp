@@ -39,6 +39,24 @@ namespace {
       complete();
     }
   };
+
+  struct RepeatingEvent : BacktesterEvent {
+    int m_remaining;
+    std::atomic_int m_count;
+
+    RepeatingEvent(ptime timestamp, int count)
+      : BacktesterEvent(timestamp),
+        m_remaining(count),
+        m_count(0) {}
+
+    void execute() override {
+      ++m_count;
+      --m_remaining;
+      if(m_remaining != 0) {
+        reschedule(get_timestamp() + minutes(1));
+      }
+    }
+  };
 }
 
 TEST_SUITE("BacktesterEventHandler") {
@@ -228,4 +246,52 @@ TEST_SUITE("BacktesterEventHandler") {
     handler.wait();
     REQUIRE(handler.get_time() >= end);
   }
+
+  TEST_CASE("interleaved_runs") {
+    auto handler =
+      BacktesterEventHandler(time_from_string("2025-08-12 09:00:00.000"),
+        time_from_string("2025-08-12 16:00:00.000"));
+    auto active_count = std::atomic_int(0);
+    handler.suspend();
+    auto make_event = [&] (const char* timestamp) {
+      return std::make_shared<ActiveEvent>(
+        time_from_string(timestamp), active_count);
+    };
+    auto a1 = make_event("2025-08-12 10:00:00.000");
+    auto a2 = make_event("2025-08-12 10:02:00.000");
+    auto a3 = make_event("2025-08-12 10:04:00.000");
+    auto b1 = make_event("2025-08-12 10:01:00.000");
+    auto b2 = make_event("2025-08-12 10:02:00.000");
+    auto c1 = make_event("2025-08-12 10:02:00.000");
+    handler.add(std::vector<std::shared_ptr<BacktesterEvent>>{a1, a2, a3});
+    handler.add(std::vector<std::shared_ptr<BacktesterEvent>>{b1, b2});
+    handler.add(c1);
+    auto expected = std::vector<std::shared_ptr<BacktesterEvent>>{
+      a1, b1, a2, b2, c1, a3};
+    for(auto& event : expected) {
+      REQUIRE(handler.advance() == event);
+    }
+    REQUIRE(handler.advance() == nullptr);
+    handler.resume();
+  }
+
+  TEST_CASE("reschedule") {
+    auto handler =
+      BacktesterEventHandler(time_from_string("2025-08-12 09:00:00.000"),
+        time_from_string("2025-08-12 16:00:00.000"));
+    auto active_count = std::atomic_int(0);
+    auto event = std::make_shared<RepeatingEvent>(
+      time_from_string("2025-08-12 10:00:00.000"), 3);
+    auto other = std::make_shared<ActiveEvent>(
+      time_from_string("2025-08-12 10:01:30.000"), active_count);
+    handler.add(event);
+    handler.add(other);
+    event->wait();
+    REQUIRE(event->m_count == 3);
+    REQUIRE(event->get_timestamp() ==
+      time_from_string("2025-08-12 10:02:00.000"));
+    other->wait();
+    REQUIRE(active_count == 1);
+    REQUIRE(handler.get_time() == time_from_string("2025-08-12 10:02:00.000"));
+  }
 }
@@ -0,0 +1,116 @@
+#include <doctest/doctest.h>
+#include "Nexus/ChartingService/CandlestickRollup.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+
+namespace {
+  auto make_time_and_sales(ptime start, int count, time_duration spacing) {
+    auto time_and_sales = std::vector<SequencedTimeAndSale>();
+    for(auto i = 0; i != count; ++i) {
+      time_and_sales.push_back(SequencedTimeAndSale(TimeAndSale(
+        start + spacing * i, Money::ONE + ((i * 7) % 13) * Money::CENT,
+        100 + i, TimeAndSale::Condition(), "TSX", "", ""),
+        Beam::Sequence(i + 1)));
+    }
+    return time_and_sales;
+  }
+
+  auto load_directly(const std::vector<SequencedTimeAndSale>& time_and_sales,
+      ptime start_time, ptime end_time, time_duration interval) {
+    auto result = PriceQueryResult();
+    for(auto current_start = start_time; current_start <= end_time;
+        current_start += interval) {
+      auto candlestick =
+        PriceCandlestick(current_start, current_start + interval);
+      auto has_point = false;
+      for(auto& time_and_sale : time_and_sales) {
+        if(time_and_sale->m_timestamp >= current_start &&
+            time_and_sale->m_timestamp < current_start + interval &&
+            time_and_sale->m_timestamp <= end_time) {
+          if(!has_point && result.series.empty()) {
+            result.start = time_and_sale.get_sequence();
+          }
+          result.end = time_and_sale.get_sequence();
+          candlestick.update(time_and_sale->m_price, time_and_sale->m_size);
+          has_point = true;
+        }
+      }
+      if(has_point) {
+        result.series.push_back(candlestick);
+      }
+    }
+    return result;
+  }
+
+  void require_equal(const PriceQueryResult& left,
+      const PriceQueryResult& right) {
+    REQUIRE(left.start == right.start);
+    REQUIRE(left.end == right.end);
+    REQUIRE(left.series.size() == right.series.size());
+    for(auto i = std::size_t(0); i != left.series.size(); ++i) {
+      REQUIRE(left.series[i].get_start() == right.series[i].get_start());
+      REQUIRE(left.series[i].get_end() == right.series[i].get_end());
+      REQUIRE(left.series[i].get_open() == right.series[i].get_open());
+      REQUIRE(left.series[i].get_close() == right.series[i].get_close());
+      REQUIRE(left.series[i].get_high() == right.series[i].get_high());
+      REQUIRE(left.series[i].get_low() == right.series[i].get_low());
+      REQUIRE(left.series[i].get_volume() == right.series[i].get_volume());
+    }
+  }
+}
+
+TEST_SUITE("CandlestickRollup") {
+  TEST_CASE("load") {
+    auto start = time_from_string("2024-07-09 09:30:00");
+    auto time_and_sales = make_time_and_sales(start, 2000, seconds(7));
+    auto rollup = CandlestickRollup();
+    rollup.extend(CandlestickRollup::get_alignment(start), time_and_sales);
+    REQUIRE(rollup.get_start() == time_from_string("2024-07-09 00:00:00"));
+    auto loads = 0;
+    auto loader = [&] (ptime start_time, ptime end_time) {
+      ++loads;
+      auto matches = std::vector<SequencedTimeAndSale>();
+      for(auto& time_and_sale : time_and_sales) {
+        if(time_and_sale->m_timestamp >= start_time &&
+            time_and_sale->m_timestamp <= end_time) {
+          matches.push_back(time_and_sale);
+        }
+      }
+      return matches;
+    };
+    auto check = [&] (ptime start_time, ptime end_time,
+        time_duration interval) {
+      require_equal(rollup.load(start_time, end_time, interval, loader),
+        load_directly(time_and_sales, start_time, end_time, interval));
+    };
+    check(start, start + hours(4), minutes(1));
+    check(start, start + hours(3) + seconds(17), minutes(5));
+    check(start + minutes(3), start + hours(2), seconds(90));
+    check(time_from_string("2024-07-09 00:00:00"),
+      time_from_string("2024-07-09 23:59:59"), hours(1));
+    REQUIRE(loads == 0);
+    check(start + milliseconds(500), start + minutes(30), minutes(1));
+    REQUIRE(loads == 1);
+  }
+
+  TEST_CASE("update") {
+    auto start = time_from_string("2024-07-09 09:30:00");
+    auto time_and_sales = make_time_and_sales(start, 100, seconds(20));
+    auto rollup = CandlestickRollup();
+    rollup.update(time_and_sales[0]);
+    rollup.extend(CandlestickRollup::get_alignment(start),
+      std::vector(time_and_sales.begin(), time_and_sales.begin() + 50));
+    for(auto& time_and_sale : time_and_sales) {
+      rollup.update(time_and_sale);
+    }
+    auto result = rollup.load(start, start + hours(1), minutes(5),
+      [] (ptime, ptime) {
+        return std::vector<SequencedTimeAndSale>();
+      });
+    require_equal(result,
+      load_directly(time_and_sales, start, start + hours(1), minutes(5)));
+  }
+}
@@ -0,0 +1,96 @@
+#include <vector>
+#include <doctest/doctest.h>
+#include "Nexus/Definitions/TickerId.hpp"
+
+using namespace Nexus;
+using namespace Nexus::Venues;
+
+TEST_SUITE("TickerId") {
+  TEST_CASE("default") {
+    auto id = TickerId();
+    REQUIRE(id == TickerId::NONE);
+    REQUIRE(!id);
+    REQUIRE(static_cast<bool>(TickerId(0)));
+  }
+
+  TEST_CASE("intern") {
+    auto table = TickerTable();
+    REQUIRE(table.get_size() == 0);
+    REQUIRE(table.find(Ticker("TD", TSX)) == TickerId::NONE);
+    auto td = table.intern(Ticker("TD", TSX));
+    auto ry = table.intern(Ticker("RY", TSX));
+    REQUIRE(td == TickerId(0));
+    REQUIRE(ry == TickerId(1));
+    REQUIRE(table.intern(Ticker("TD", TSX)) == td);
+    REQUIRE(table.find(Ticker("RY", TSX)) == ry);
+    REQUIRE(table.get_size() == 2);
+    REQUIRE(table.from(td) == Ticker("TD", TSX));
+    REQUIRE(table.from(ry) == Ticker("RY", TSX));
+    REQUIRE(table.from(TickerId(2)) == Ticker());
+    REQUIRE(table.from(TickerId::NONE) == Ticker());
+  }
+
+  TEST_CASE("process_table") {
+    auto ticker = Ticker("SHOP", TSX);
+    auto id = to_ticker_id(ticker);
+    REQUIRE(to_ticker_id(Ticker("SHOP", TSX)) == id);
+    REQUIRE(to_ticker(id) == ticker);
+  }
+
+  TEST_CASE("map") {
+    auto map = TickerIdMap<int>();
+    REQUIRE(map.empty());
+    REQUIRE(map.find(TickerId(3)) == nullptr);
+    REQUIRE(!map.contains(TickerId::NONE));
+    REQUIRE_THROWS_AS(map.at(TickerId(3)), std::out_of_range);
+    REQUIRE_THROWS_AS(map[TickerId::NONE], std::out_of_range);
+    auto& three = map[TickerId(3)];
+    REQUIRE(three == 0);
+    three = 30;
+    auto result = map.try_emplace(TickerId(1), 10);
+    REQUIRE(result.second);
+    REQUIRE(*result.first == 10);
+    result = map.try_emplace(TickerId(3), 5);
+    REQUIRE(!result.second);
+    REQUIRE(result.first == &three);
+    REQUIRE(three == 30);
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.contains(TickerId(1)));
+    REQUIRE(!map.contains(TickerId(2)));
+    REQUIRE(map.at(TickerId(3)) == 30);
+    for(auto i = 100; i != 200; ++i) {
+      map[TickerId(i)] = i;
+    }
+    REQUIRE(map.at(TickerId(3)) == 30);
+    REQUIRE(&map.at(TickerId(3)) == &three);
+    auto ids = std::vector<TickerId>();
+    for(auto& entry : map) {
+      ids.push_back(entry.first);
+    }
+    REQUIRE(ids.size() == 102);
+    REQUIRE(ids[0] == TickerId(3));
+    REQUIRE(ids[1] == TickerId(1));
+    REQUIRE(ids[2] == TickerId(100));
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(!map.contains(TickerId(3)));
+  }
+
+  TEST_CASE("sparse_map") {
+    auto map = TickerIdMap<int>();
+    auto large_id = TickerId(std::uint32_t(1) << 30);
+    map[large_id] = 1;
+    map[TickerId(0)] = 2;
+    for(auto i = 0; i != 1000; ++i) {
+      map[TickerId(static_cast<std::uint32_t>(i * 4096 + 1))] = i;
+    }
+    REQUIRE(map.size() == 1002);
+    REQUIRE(map.at(large_id) == 1);
+    REQUIRE(map.at(TickerId(0)) == 2);
+    for(auto i = 0; i != 1000; ++i) {
+      REQUIRE(map.at(TickerId(static_cast<std::uint32_t>(i * 4096 + 1))) == i);
+    }
+    REQUIRE(!map.contains(TickerId(2)));
+    REQUIRE(!map.contains(TickerId::NONE));
+  }
+}
@@ -0,0 +1,101 @@
+#include <Beam/Queues/Queue.hpp>
+#include <Beam/ServiceLocatorTests/ServiceLocatorTestEnvironment.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/AdministrationServiceTests/AdministrationServiceTestEnvironment.hpp"
+#include "Nexus/MarketDataService/BboQuoteCache.hpp"
+#include "Nexus/MarketDataServiceTests/MarketDataServiceTestEnvironment.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace Nexus;
+using namespace Nexus::Tests;
+
+namespace {
+  const auto TST = parse_ticker("TST.TSX");
+
+  struct Fixture {
+    ServiceLocatorTestEnvironment m_service_locator_environment;
+    AdministrationServiceTestEnvironment m_administration_environment;
+    MarketDataServiceTestEnvironment m_market_data_environment;
+
+    Fixture()
+      : m_administration_environment(
+          make_administration_service_test_environment(
+            m_service_locator_environment)),
+        m_market_data_environment(make_market_data_service_test_environment(
+          m_service_locator_environment, m_administration_environment)) {}
+  };
+}
+
+TEST_SUITE("BboQuoteCache") {
+  TEST_CASE("load") {
+    auto fixture = Fixture();
+    fixture.m_market_data_environment.update_bbo(
+      TST, Money::ONE, Money::ONE + Money::CENT);
+    auto cache = BboQuoteCache(MarketDataClient(
+      &fixture.m_market_data_environment.get_registry_client()));
+    auto handle = cache.get(TST);
+    auto bbo = handle.load();
+    REQUIRE(bbo.m_bid.m_price == Money::ONE);
+    REQUIRE(bbo.m_ask.m_price == Money::ONE + Money::CENT);
+    auto updates = std::make_shared<Queue<BboQuote>>();
+    cache.monitor(TST, updates);
+    REQUIRE(updates->pop().m_bid.m_price == Money::ONE);
+    fixture.m_market_data_environment.update_bbo(
+      TST, 2 * Money::ONE, 2 * Money::ONE + Money::CENT);
+    REQUIRE(updates->pop().m_bid.m_price == 2 * Money::ONE);
+    REQUIRE(handle.load().m_bid.m_price == 2 * Money::ONE);
+  }
+
+  TEST_CASE("load_without_quotes") {
+    auto fixture = Fixture();
+    auto cache = BboQuoteCache(MarketDataClient(
+      &fixture.m_market_data_environment.get_registry_client()));
+    auto handle = cache.get(TST);
+    REQUIRE_THROWS_AS(handle.load(), PipeBrokenException);
+    auto updates = std::make_shared<Queue<BboQuote>>();
+    cache.monitor(TST, updates);
+    fixture.m_market_data_environment.update_bbo(TST, Money::ONE);
+    REQUIRE(updates->pop().m_bid.m_price == Money::ONE);
+    REQUIRE(handle.load().m_bid.m_price == Money::ONE);
+  }
+
+  TEST_CASE("shared_monitors") {
+    auto fixture = Fixture();
+    fixture.m_market_data_environment.update_bbo(TST, Money::ONE);
+    auto cache = BboQuoteCache(MarketDataClient(
+      &fixture.m_market_data_environment.get_registry_client()));
+    auto updates_a = std::make_shared<Queue<BboQuote>>();
+    auto updates_b = std::make_shared<Queue<BboQuote>>();
+    cache.monitor(TST, updates_a);
+    cache.monitor(TST, updates_b);
+    REQUIRE(updates_a->pop().m_bid.m_price == Money::ONE);
+    REQUIRE(updates_b->pop().m_bid.m_price == Money::ONE);
+    updates_a->close();
+    fixture.m_market_data_environment.update_bbo(TST, 2 * Money::ONE);
+    REQUIRE(updates_b->pop().m_bid.m_price == 2 * Money::ONE);
+    updates_b->close();
+    fixture.m_market_data_environment.update_bbo(TST, 3 * Money::ONE);
+    auto updates_c = std::make_shared<Queue<BboQuote>>();
+    cache.monitor(TST, updates_c);
+    REQUIRE(updates_c->pop().m_bid.m_price >= 2 * Money::ONE);
+  }
+
+  TEST_CASE("release_handles") {
+    auto fixture = Fixture();
+    fixture.m_market_data_environment.update_bbo(TST, Money::ONE);
+    auto cache = BboQuoteCache(MarketDataClient(
+      &fixture.m_market_data_environment.get_registry_client()));
+    {
+      auto handle_a = cache.get(TST);
+      auto handle_b = handle_a;
+      REQUIRE(handle_a.load().m_bid.m_price == Money::ONE);
+      REQUIRE(handle_b.load().m_bid.m_price == Money::ONE);
+    }
+    fixture.m_market_data_environment.update_bbo(TST, 2 * Money::ONE);
+    auto handle = cache.get(TST);
+    REQUIRE(handle.load().m_bid.m_price == 2 * Money::ONE);
+    cache.close();
+    REQUIRE_THROWS_AS(handle.load(), PipeBrokenException);
+  }
+}
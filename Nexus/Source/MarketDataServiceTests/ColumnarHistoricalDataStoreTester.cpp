@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <boost/uuid/random_generator.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/MarketDataService/ColumnarHistoricalDataStore.hpp"
+#include "Nexus/MarketDataServiceTests/HistoricalDataStoreTestSuite.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Tests;
+
+namespace {
+  auto make_root() {
+    return std::filesystem::temp_directory_path() /
+      ("nexus_columnar_historical_data_store_" +
+        uuids::to_string(uuids::random_generator()()));
+  }
+
+  struct Builder {
+    auto operator ()() const {
+      return ColumnarHistoricalDataStore(make_root(), 2);
+    }
+  };
+
+  auto make_time_and_sale(ptime timestamp, Money price) {
+    return TimeAndSale(timestamp, price, 100,
+      TimeAndSale::Condition(TimeAndSale::Condition::Type::REGULAR, "@"),
+      "TSX", "B1", "S1");
+  }
+}
+
+TEST_SUITE("ColumnarHistoricalDataStore") {
+  TEST_CASE_TEMPLATE_INVOKE(HistoricalDataStoreTestSuite, Builder);
+
+  TEST_CASE("reopen") {
+    auto root = make_root();
+    auto ticker = parse_ticker("TST.TSX");
+    auto info = TickerInfo();
+    info.m_ticker = ticker;
+    info.m_name = "Test Inc.";
+    info.m_sector = "Technology";
+    info.m_board_lot = 100;
+    auto time_and_sales = std::vector<SequencedTickerTimeAndSale>();
+    for(auto i = 0; i != 5; ++i) {
+      time_and_sales.push_back(SequencedTickerTimeAndSale(TickerTimeAndSale(
+        make_time_and_sale(time_from_string("2024-07-09 10:00:00") +
+          seconds(i), Money::ONE + i * Money::CENT), ticker),
+        Beam::Sequence(i + 1)));
+    }
+    {
+      auto data_store = ColumnarHistoricalDataStore(root, 2);
+      data_store.store(info);
+      data_store.store(time_and_sales);
+    }
+    auto data_store = ColumnarHistoricalDataStore(root, 2);
+    auto info_query = TickerInfoQuery();
+    info_query.set_index(ticker);
+    info_query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    auto loaded_info = data_store.load_ticker_info(info_query);
+    REQUIRE(loaded_info.size() == 1);
+    REQUIRE(loaded_info[0] == info);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    auto results = data_store.load_time_and_sales(query);
+    REQUIRE(results.size() == 5);
+    for(auto i = 0; i != 5; ++i) {
+      REQUIRE(results[i].get_sequence() == time_and_sales[i].get_sequence());
+      REQUIRE(*results[i] == **time_and_sales[i]);
+    }
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("day_partitions") {
+    auto root = make_root();
+    auto data_store = ColumnarHistoricalDataStore(root, 2);
+    auto ticker = parse_ticker("TST.TSX");
+    auto quotes = std::vector<SequencedTickerBboQuote>();
+    for(auto i = 0; i != 6; ++i) {
+      auto bbo = BboQuote(make_bid(Money::ONE, 100 + i),
+        make_ask(Money::ONE + Money::CENT, 100),
+        time_from_string("2024-07-09 10:00:00") + hours(24 * (i / 2)));
+      quotes.push_back(SequencedTickerBboQuote(
+        TickerBboQuote(bbo, ticker), Beam::Sequence(i + 1)));
+    }
+    data_store.store(quotes);
+    data_store.flush();
+    auto tail_query = TickerQuery();
+    tail_query.set_index(ticker);
+    tail_query.set_range(Range::TOTAL);
+    tail_query.set_snapshot_limit(SnapshotLimit::from_tail(3));
+    auto tail = data_store.load_bbo_quotes(tail_query);
+    REQUIRE(tail.size() == 3);
+    REQUIRE(tail[0].get_sequence() == Beam::Sequence(4));
+    REQUIRE(tail[2].get_sequence() == Beam::Sequence(6));
+    auto day_query = TickerQuery();
+    day_query.set_index(ticker);
+    day_query.set_range(time_from_string("2024-07-10 00:00:00"),
+      time_from_string("2024-07-10 23:59:59"));
+    day_query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    auto day = data_store.load_bbo_quotes(day_query);
+    REQUIRE(day.size() == 2);
+    REQUIRE(day[0].get_sequence() == Beam::Sequence(3));
+    REQUIRE(day[1].get_sequence() == Beam::Sequence(4));
+    data_store.close();
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("block_snapshot_limits") {
+    auto root = make_root();
+    auto data_store = ColumnarHistoricalDataStore(root, 2);
+    auto ticker = parse_ticker("TST.TSX");
+    auto time_and_sales = std::vector<SequencedTickerTimeAndSale>();
+    for(auto i = 0; i != 7; ++i) {
+      time_and_sales.push_back(SequencedTickerTimeAndSale(TickerTimeAndSale(
+        make_time_and_sale(time_from_string("2024-07-09 10:00:00") +
+          seconds(i), Money::ONE + i * Money::CENT), ticker),
+        Beam::Sequence(i + 1)));
+    }
+    data_store.store(time_and_sales);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::from_head(3));
+    auto head = data_store.load_time_and_sales(query);
+    REQUIRE(head.size() == 3);
+    for(auto i = 0; i != 3; ++i) {
+      REQUIRE(head[i].get_sequence() == Beam::Sequence(i + 1));
+    }
+    query.set_snapshot_limit(SnapshotLimit::from_tail(4));
+    auto tail = data_store.load_time_and_sales(query);
+    REQUIRE(tail.size() == 4);
+    for(auto i = 0; i != 4; ++i) {
+      REQUIRE(tail[i].get_sequence() == Beam::Sequence(i + 4));
+    }
+    query.set_snapshot_limit(SnapshotLimit::from_head(7));
+    REQUIRE(data_store.load_time_and_sales(query).size() == 7);
+    data_store.close();
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("concurrent_store_and_load") {
+    auto root = make_root();
+    auto data_store = ColumnarHistoricalDataStore(root, 2);
+    auto ticker = parse_ticker("TST.TSX");
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    auto writer = std::thread([&] {
+      for(auto i = 0; i != 200; ++i) {
+        data_store.store(SequencedTickerTimeAndSale(TickerTimeAndSale(
+          make_time_and_sale(time_from_string("2024-07-09 10:00:00") +
+            seconds(i), Money::ONE), ticker), Beam::Sequence(i + 1)));
+      }
+    });
+    auto count = std::size_t(0);
+    while(count != 200) {
+      auto results = data_store.load_time_and_sales(query);
+      REQUIRE(results.size() >= count);
+      for(auto i = std::size_t(0); i != results.size(); ++i) {
+        REQUIRE(results[i].get_sequence() == Beam::Sequence(i + 1));
+      }
+      count = results.size();
+    }
+    writer.join();
+    data_store.close();
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("ticker_info_updates") {
+    auto root = make_root();
+    auto ticker = parse_ticker("TST.TSX");
+    auto info = TickerInfo();
+    info.m_ticker = ticker;
+    info.m_name = "Test Inc.";
+    info.m_board_lot = 100;
+    auto other_info = TickerInfo();
+    other_info.m_ticker = parse_ticker("ABC.TSX");
+    other_info.m_name = "ABC Inc.";
+    other_info.m_board_lot = 100;
+    {
+      auto data_store = ColumnarHistoricalDataStore(root, 2);
+      data_store.store(info);
+      data_store.store(other_info);
+      info.m_board_lot = 500;
+      data_store.store(info);
+    }
+    auto query = TickerInfoQuery();
+    query.set_index(Scope::GLOBAL);
+    query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    for(auto i = 0; i != 2; ++i) {
+      auto data_store = ColumnarHistoricalDataStore(root, 2);
+      auto loaded_info = data_store.load_ticker_info(query);
+      REQUIRE(loaded_info.size() == 2);
+      REQUIRE(std::find(
+        loaded_info.begin(), loaded_info.end(), info) != loaded_info.end());
+      REQUIRE(std::find(loaded_info.begin(), loaded_info.end(), other_info) !=
+        loaded_info.end());
+    }
+    std::filesystem::remove_all(root);
+  }
+}
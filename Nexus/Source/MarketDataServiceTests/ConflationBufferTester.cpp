@@ -0,0 +1,88 @@
+#include <doctest/doctest.h>
+#include "Nexus/MarketDataService/ConflationBuffer.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Venues;
+
+namespace {
+  auto make_bbo_quote(const Ticker& ticker, Money bid, int sequence) {
+    return SequencedTickerBboQuote(TickerBboQuote(
+      BboQuote(make_bid(bid, 100), make_ask(bid + Money::CENT, 100),
+        time_from_string("2024-07-11 13:00:00")), ticker),
+      Beam::Sequence(sequence));
+  }
+
+  auto make_book_quote(const Ticker& ticker, std::string mpid, Money price,
+      Quantity size, int sequence) {
+    return SequencedTickerBookQuote(TickerBookQuote(
+      BookQuote(std::move(mpid), false, TSX, make_bid(price, size),
+        time_from_string("2024-07-11 13:00:00")), ticker),
+      Beam::Sequence(sequence));
+  }
+}
+
+TEST_SUITE("ConflationBuffer") {
+  TEST_CASE("set_window") {
+    auto buffer = ConflationBuffer();
+    REQUIRE(!buffer.is_enabled());
+    REQUIRE(buffer.get_statistics() == ConflationStatistics());
+    buffer.set_window(milliseconds(100));
+    REQUIRE(buffer.is_enabled());
+    REQUIRE(buffer.get_statistics().m_window == milliseconds(100));
+    buffer.set_window(seconds(0));
+    REQUIRE(!buffer.is_enabled());
+  }
+
+  TEST_CASE("conflate_bbo_quotes") {
+    auto buffer = ConflationBuffer();
+    buffer.set_window(milliseconds(100));
+    auto a = parse_ticker("A.TSX");
+    auto b = parse_ticker("B.TSX");
+    buffer.push(make_bbo_quote(a, Money::ONE, 1));
+    buffer.push(make_bbo_quote(b, Money::ONE, 2));
+    buffer.push(make_bbo_quote(a, 2 * Money::ONE, 3));
+    auto updates = buffer.flush();
+    REQUIRE(updates.m_bbo_quotes.size() == 2);
+    REQUIRE(updates.m_bbo_quotes[0]->get_index() == b);
+    REQUIRE(updates.m_bbo_quotes[1]->get_index() == a);
+    REQUIRE((*updates.m_bbo_quotes[1])->m_bid.m_price == 2 * Money::ONE);
+    REQUIRE(buffer.get_statistics().m_dropped_bbo_quote_count == 1);
+    REQUIRE(buffer.flush().m_bbo_quotes.empty());
+  }
+
+  TEST_CASE("conflate_book_quotes") {
+    auto buffer = ConflationBuffer();
+    buffer.set_window(milliseconds(100));
+    auto a = parse_ticker("A.TSX");
+    buffer.push(make_book_quote(a, "MP1", Money::ONE, 100, 1));
+    buffer.push(make_book_quote(a, "MP2", Money::ONE, 200, 2));
+    buffer.push(make_book_quote(a, "MP1", Money::ONE, 0, 3));
+    buffer.push(make_book_quote(a, "MP1", 2 * Money::ONE, 300, 4));
+    auto updates = buffer.flush();
+    REQUIRE(updates.m_book_quotes.size() == 3);
+    REQUIRE((*updates.m_book_quotes[0])->m_mpid == "MP2");
+    REQUIRE((*updates.m_book_quotes[1])->m_quote.m_size == 0);
+    REQUIRE((*updates.m_book_quotes[2])->m_quote.m_price == 2 * Money::ONE);
+    auto statistics = buffer.get_statistics();
+    REQUIRE(statistics.m_dropped_bbo_quote_count == 0);
+    REQUIRE(statistics.m_dropped_book_quote_count == 1);
+  }
+
+  TEST_CASE("push_disabled") {
+    auto buffer = ConflationBuffer();
+    auto a = parse_ticker("A.TSX");
+    REQUIRE(!buffer.push(make_bbo_quote(a, Money::ONE, 1)));
+    REQUIRE(!buffer.push(make_book_quote(a, "MP1", Money::ONE, 100, 2)));
+    buffer.set_window(milliseconds(100));
+    REQUIRE(buffer.push(make_bbo_quote(a, Money::ONE, 3)));
+    buffer.set_window(seconds(0));
+    REQUIRE(!buffer.push(make_bbo_quote(a, 2 * Money::ONE, 4)));
+    auto updates = buffer.flush();
+    REQUIRE(updates.m_bbo_quotes.size() == 1);
+    REQUIRE(updates.m_bbo_quotes[0].get_sequence() == Beam::Sequence(3));
+    REQUIRE(updates.m_book_quotes.empty());
+  }
+}
@@ -0,0 +1,84 @@
+#include <functional>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Nexus/Definitions/StandardVenues.hpp"
+#include "Nexus/MarketDataService/EntitlementMatrix.hpp"
+
+using namespace Beam;
+using namespace Nexus;
+using namespace Nexus::Venues;
+
+namespace {
+  auto make_database() {
+    auto database = EntitlementDatabase();
+    auto entry = EntitlementDatabase::Entry();
+    entry.m_name = "TSX";
+    entry.m_group_entry = DirectoryEntry::make_directory(100, "tsx");
+    entry.m_applicability[EntitlementKey(TSX)] =
+      MarketDataTypeSet(MarketDataType::BBO_QUOTE);
+    entry.m_applicability[EntitlementKey(TSX, CHIC)] =
+      MarketDataTypeSet(MarketDataType::BOOK_QUOTE);
+    entry.m_applicability[EntitlementKey(Venue(), OMGA)] =
+      MarketDataTypeSet(MarketDataType::TIME_AND_SALE);
+    database.add(entry);
+    return database;
+  }
+}
+
+TEST_SUITE("EntitlementMatrix") {
+  TEST_CASE("index") {
+    auto index = EntitlementIndex(make_database());
+    REQUIRE(index.get_index(TSX) != 0);
+    REQUIRE(index.get_index(CHIC) != 0);
+    REQUIRE(index.get_index(OMGA) != 0);
+    REQUIRE(index.get_index(ASX) == 0);
+    REQUIRE(index.get_venue(index.get_index(TSX)) == TSX);
+    REQUIRE(index.get_cell(EntitlementKey(TSX, CHIC)) !=
+      index.get_cell(EntitlementKey(CHIC, TSX)));
+  }
+
+  TEST_CASE("contains") {
+    auto index = EntitlementIndex(make_database());
+    auto entitlements = EntitlementSet();
+    for(auto& entry : make_database().get_entries()) {
+      for(auto& applicability : entry.m_applicability) {
+        entitlements.grant(applicability.first, applicability.second);
+      }
+    }
+    auto matrix = EntitlementMatrix(index, entitlements);
+    auto keys = std::vector{EntitlementKey(TSX), EntitlementKey(TSX, CHIC),
+      EntitlementKey(CHIC, TSX), EntitlementKey(TSX, OMGA),
+      EntitlementKey(ASX, OMGA), EntitlementKey(ASX, TSX),
+      EntitlementKey(TSX, ASX), EntitlementKey(ASX)};
+    auto types = std::vector{MarketDataType::BBO_QUOTE,
+      MarketDataType::BOOK_QUOTE, MarketDataType::TIME_AND_SALE};
+    for(auto& key : keys) {
+      for(auto type : types) {
+        REQUIRE(matrix.contains(index.get_cell(key), type) ==
+          entitlements.contains(key, type));
+      }
+    }
+    REQUIRE(matrix.contains(index.get_cell(EntitlementKey(ASX, OMGA)),
+      MarketDataType::TIME_AND_SALE));
+  }
+
+  TEST_CASE("empty") {
+    auto index = EntitlementIndex(make_database());
+    auto matrix = EntitlementMatrix(index, EntitlementSet());
+    REQUIRE(!matrix.contains(
+      index.get_cell(EntitlementKey(TSX)), MarketDataType::BBO_QUOTE));
+    REQUIRE(matrix == EntitlementMatrix(index, EntitlementSet()));
+    REQUIRE(!EntitlementMatrix().contains(0, MarketDataType::BBO_QUOTE));
+  }
+
+  TEST_CASE("hash") {
+    auto index = EntitlementIndex(make_database());
+    auto entitlements = EntitlementSet();
+    entitlements.grant(
+      EntitlementKey(TSX), MarketDataTypeSet(MarketDataType::BBO_QUOTE));
+    auto matrix = EntitlementMatrix(index, entitlements);
+    auto hash = std::hash<EntitlementMatrix>();
+    REQUIRE(hash(matrix) == hash(EntitlementMatrix(index, entitlements)));
+    REQUIRE(hash(matrix) != hash(EntitlementMatrix(index, EntitlementSet())));
+  }
+}
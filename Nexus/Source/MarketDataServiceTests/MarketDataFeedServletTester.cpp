@@ -1,3 +1,4 @@
+#include <unordered_map>
 #include <Beam/Services/ServiceProtocolClient.hpp>
 #include <Beam/Services/ServiceProtocolServletContainer.hpp>
 #include <Beam/ServicesTests/TestServices.hpp>
@@ -65,9 +66,9 @@ namespace {
     optional<ServletContainer> m_container;
     std::unique_ptr<TestServiceProtocolClient> m_client;
 
-    Fixture()
+    explicit Fixture(int worker_count = 0)
         : m_server_connection(std::make_shared<LocalServerConnection>()) {
-      m_container.emplace(init(&m_registry), m_server_connection,
+      m_container.emplace(init(&m_registry, worker_count), m_server_connection,
         factory<std::unique_ptr<TriggerTimer>>());
       m_client = std::make_unique<TestServiceProtocolClient>(
         std::make_unique<LocalClientChannel>("test", *m_server_connection),
@@ -243,4 +244,55 @@ TEST_SUITE("MarketDataFeedServlet") {
     fixture.m_client->close();
     completion_token.get();
   }
+
+  TEST_CASE("dedicated_workers") {
+    auto fixture = Fixture(3);
+    auto tickers = std::vector<Ticker>();
+    for(auto symbol : {"A", "B", "C", "D", "E"}) {
+      tickers.push_back(Ticker(symbol, TSX));
+    }
+    auto messages = std::vector<MarketDataFeedMessage>();
+    for(auto i = 0; i != 4; ++i) {
+      for(auto& ticker : tickers) {
+        messages.push_back(TickerBboQuote(
+          BboQuote(make_bid(Money::CENT, 100 + i),
+            make_ask(2 * Money::CENT, 200),
+            time_from_string("2024-07-14 12:00:00")), ticker));
+      }
+    }
+    auto received = std::unordered_map<Ticker, std::vector<Quantity>>();
+    auto remaining = messages.size();
+    auto completion_token = Async<void>();
+    fixture.m_registry.m_bbo_quote_slot =
+      [&] (const auto& received_quote, auto source_id) {
+        received[received_quote.get_index()].push_back(
+          received_quote->m_bid.m_size);
+        --remaining;
+        if(remaining == 0) {
+          completion_token.get_eval().set();
+        }
+      };
+    send_record_message<SendMarketDataFeedMessages>(
+      *fixture.m_client, messages);
+    completion_token.get();
+    for(auto& ticker : tickers) {
+      REQUIRE(received[ticker] == std::vector<Quantity>{100, 101, 102, 103});
+    }
+    auto clear_token = Async<void>();
+    fixture.m_registry.m_clear_slot = [&] (auto source_id) {
+      clear_token.get_eval().set();
+    };
+    fixture.m_client->close();
+    clear_token.get();
+  }
+
+  TEST_CASE("close_with_dedicated_workers") {
+    auto fixture = Fixture(2);
+    auto clear_token = Async<void>();
+    fixture.m_registry.m_clear_slot = [&] (auto source_id) {
+      clear_token.get_eval().set();
+    };
+    fixture.m_container->close();
+    clear_token.get();
+  }
 }
@@ -0,0 +1,82 @@
+#include <Beam/SerializationTests/ValueShuttleTests.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/MarketDataService/MarketDataRegistryServices.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Venues;
+
+namespace {
+  auto make_time_and_sale(const Ticker& ticker, std::string buyer_mpid,
+      std::string seller_mpid, int sequence) {
+    return SequencedTickerTimeAndSale(TickerTimeAndSale(
+      TimeAndSale(time_from_string("2024-07-11 13:00:00") + seconds(sequence),
+        Money::ONE + sequence * Money::CENT, 100 * sequence,
+        TimeAndSale::Condition(TimeAndSale::Condition::Type::REGULAR, "@"),
+        "TSX", std::move(buyer_mpid), std::move(seller_mpid)), ticker),
+      Beam::Sequence(sequence));
+  }
+
+  auto make_book_quote(const Ticker& ticker, std::string mpid, Money price,
+      int sequence) {
+    return SequencedTickerBookQuote(TickerBookQuote(
+      BookQuote(std::move(mpid), sequence % 2 == 0, TSX, make_bid(price, 100),
+        time_from_string("2024-07-11 13:00:00")), ticker),
+      Beam::Sequence(sequence));
+  }
+}
+
+TEST_SUITE("MarketDataFrame") {
+  TEST_CASE("empty") {
+    auto frame = TimeAndSaleFrame(std::vector<SequencedTickerTimeAndSale>());
+    REQUIRE(frame.is_empty());
+    REQUIRE(frame.decode().empty());
+    REQUIRE(frame == TimeAndSaleFrame());
+  }
+
+  TEST_CASE("time_and_sales") {
+    auto a = parse_ticker("A.TSX");
+    auto b = parse_ticker("B.TSXV");
+    auto time_and_sales = std::vector<SequencedTickerTimeAndSale>();
+    for(auto i = 1; i <= 50; ++i) {
+      time_and_sales.push_back(make_time_and_sale(i % 3 == 0 ? b : a,
+        i % 2 == 0 ? "RBC" : "TD", "CIBC", i));
+    }
+    auto frame = TimeAndSaleFrame(time_and_sales);
+    REQUIRE(!frame.is_empty());
+    REQUIRE(frame.decode() == time_and_sales);
+  }
+
+  TEST_CASE("book_quotes") {
+    auto ticker = parse_ticker("TST.TSX");
+    auto book_quotes = std::vector<SequencedTickerBookQuote>{
+      make_book_quote(ticker, "ABC", Money::ONE, 1),
+      make_book_quote(ticker, "DEF", Money::ONE + Money::CENT, 2),
+      make_book_quote(ticker, "ABC", Money::ONE - Money::CENT, 3)};
+    auto frame = BookQuoteFrame(book_quotes);
+    REQUIRE(frame.decode() == book_quotes);
+  }
+
+  TEST_CASE("dictionary") {
+    auto ticker = parse_ticker("TST.TSX");
+    auto repeated = std::vector<SequencedTickerTimeAndSale>();
+    auto distinct = std::vector<SequencedTickerTimeAndSale>();
+    for(auto i = 1; i <= 100; ++i) {
+      repeated.push_back(make_time_and_sale(ticker, "BUYER", "SELLER", i));
+      distinct.push_back(make_time_and_sale(ticker,
+        "BUYER" + std::to_string(i), "SELLER" + std::to_string(i), i));
+    }
+    REQUIRE(TimeAndSaleFrame(repeated).get_size() + 100 * 10 <
+      TimeAndSaleFrame(distinct).get_size());
+  }
+
+  TEST_CASE("shuttle") {
+    auto ticker = parse_ticker("TST.TSX");
+    test_round_trip_shuttle(BookQuoteFrame({
+      make_book_quote(ticker, "ABC", Money::ONE, 1),
+      make_book_quote(ticker, "DEF", Money::ONE, 2)}));
+  }
+}
@@ -1,3 +1,4 @@
+#include <Beam/Queries/StandardFunctionExpressions.hpp>
 #include <Beam/SerializationTests/ValueShuttleTests.hpp>
 #include <Beam/ServiceLocator/SessionAuthenticator.hpp>
 #include <Beam/ServiceLocatorTests/ServiceLocatorTestEnvironment.hpp>
@@ -5,6 +6,7 @@
 #include <Beam/Services/ServiceProtocolServletContainer.hpp>
 #include <Beam/ServicesTests/TestServices.hpp>
 #include <Beam/TimeService/FixedTimeClient.hpp>
+#include <Beam/TimeService/TriggerTimer.hpp>
 #include <boost/functional/factory.hpp>
 #include <doctest/doctest.h>
 #include "Nexus/AdministrationServiceTests/AdministrationServiceTestEnvironment.hpp"
@@ -13,6 +15,7 @@
 #include "Nexus/MarketDataService/LocalHistoricalDataStore.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistry.hpp"
 #include "Nexus/MarketDataService/MarketDataRegistryServlet.hpp"
+#include "Nexus/Queries/TimeAndSaleAccessor.hpp"
 
 using namespace Beam;
 using namespace Beam::Tests;
@@ -34,6 +37,7 @@ namespace {
     optional<AdministrationClient> m_servlet_administration_client;
     MarketDataRegistry m_registry;
     LocalHistoricalDataStore m_data_store;
+    TriggerTimer m_conflation_timer;
     optional<ServletContainer::Servlet::Servlet> m_servlet;
     std::shared_ptr<LocalServerConnection> m_server_connection;
     optional<ServletContainer> m_container;
@@ -77,8 +81,9 @@ namespace {
       m_servlet_administration_client.emplace(
         m_administration_environment.make_client(
           Ref(*m_servlet_service_locator_client)));
-      m_servlet.emplace(
-        *m_servlet_administration_client, &m_registry, &m_data_store);
+      m_servlet.emplace(*m_servlet_administration_client, &m_registry,
+        &m_data_store, milliseconds(100),
+        std::make_unique<Timer>(&m_conflation_timer));
       m_container.emplace(init(
         *m_servlet_service_locator_client, &*m_servlet), m_server_connection,
         factory<std::unique_ptr<TriggerTimer>>());
@@ -305,4 +310,235 @@ TEST_SUITE("MarketDataRegistryServlet") {
         return record.time_and_sale;
       });
   }
+
+  TEST_CASE("conflate_bbo_quotes") {
+    auto fixture = Fixture();
+    auto ticker = parse_ticker("A.TSX");
+    auto info = TickerInfo(ticker, "TICKER A", "", 100);
+    fixture.m_registry.add(info);
+    REQUIRE(fixture.m_client->send_request<SetConflationService>(true) ==
+      milliseconds(100));
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::REAL_TIME);
+    auto result = fixture.m_client->send_request<QueryBboQuotesService>(query);
+    REQUIRE(result.m_id != -1);
+    for(auto i = 1; i <= 3; ++i) {
+      fixture.m_servlet->publish(TickerBboQuote(
+        BboQuote(make_bid(i * Money::CENT, 100),
+          make_ask((i + 1) * Money::CENT, 100),
+          fixture.m_time_client.get_time()), ticker), 1);
+    }
+    auto statistics =
+      fixture.m_client->send_request<LoadConflationStatisticsService>();
+    REQUIRE(statistics.m_window == milliseconds(100));
+    REQUIRE(statistics.m_dropped_bbo_quote_count == 2);
+    fixture.m_conflation_timer.trigger();
+    auto message = fixture.m_client->read_message();
+    auto received_message = std::dynamic_pointer_cast<
+      RecordMessage<BboQuoteMessage, TestServiceProtocolClient>>(message);
+    REQUIRE(received_message);
+    auto& quote = received_message->get_record().bbo_quote;
+    REQUIRE((*quote)->m_bid.m_price == 3 * Money::CENT);
+    REQUIRE(fixture.m_client->send_request<SetConflationService>(false) ==
+      seconds(0));
+    fixture.m_servlet->publish(TickerBboQuote(
+      BboQuote(make_bid(Money::ONE, 100), make_ask(2 * Money::ONE, 100),
+        fixture.m_time_client.get_time()), ticker), 1);
+    message = fixture.m_client->read_message();
+    received_message = std::dynamic_pointer_cast<
+      RecordMessage<BboQuoteMessage, TestServiceProtocolClient>>(message);
+    REQUIRE(received_message);
+    REQUIRE(
+      (*received_message->get_record().bbo_quote)->m_bid.m_price == Money::ONE);
+  }
+
+  TEST_CASE("conflate_bbo_quote_batches") {
+    auto fixture = Fixture();
+    auto ticker = parse_ticker("A.TSX");
+    auto info = TickerInfo(ticker, "TICKER A", "", 100);
+    fixture.m_registry.add(info);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::REAL_TIME);
+    auto result = fixture.m_client->send_request<QueryBboQuotesService>(query);
+    REQUIRE(result.m_id != -1);
+    REQUIRE(fixture.m_client->send_request<SetConflationService>(true) ==
+      milliseconds(100));
+    auto make_messages = [&] (int first, int last) {
+      auto messages = std::vector<MarketDataFeedMessage>();
+      for(auto i = first; i <= last; ++i) {
+        messages.push_back(TickerBboQuote(
+          BboQuote(make_bid(i * Money::CENT, 100),
+            make_ask((i + 1) * Money::CENT, 100),
+            fixture.m_time_client.get_time()), ticker));
+      }
+      return messages;
+    };
+    fixture.m_servlet->publish(make_messages(1, 3), 1);
+    auto statistics =
+      fixture.m_client->send_request<LoadConflationStatisticsService>();
+    REQUIRE(statistics.m_dropped_bbo_quote_count == 2);
+    REQUIRE(fixture.m_client->send_request<SetConflationService>(false) ==
+      seconds(0));
+    fixture.m_servlet->publish(make_messages(4, 4), 1);
+    auto message = fixture.m_client->read_message();
+    auto received_message = std::dynamic_pointer_cast<
+      RecordMessage<BboQuoteMessage, TestServiceProtocolClient>>(message);
+    REQUIRE(received_message);
+    REQUIRE((*received_message->get_record().bbo_quote)->m_bid.m_price ==
+      3 * Money::CENT);
+    message = fixture.m_client->read_message();
+    received_message = std::dynamic_pointer_cast<
+      RecordMessage<BboQuoteMessage, TestServiceProtocolClient>>(message);
+    REQUIRE(received_message);
+    REQUIRE((*received_message->get_record().bbo_quote)->m_bid.m_price ==
+      4 * Money::CENT);
+  }
+
+  TEST_CASE("publish_batch") {
+    auto fixture = Fixture();
+    auto ticker = parse_ticker("A.TSX");
+    auto info = TickerInfo(ticker, "TICKER A", "", 100);
+    fixture.m_registry.add(info);
+    send_record_message<SetBatchingMessage>(*fixture.m_client, true);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::REAL_TIME);
+    auto result = fixture.m_client->send_request<QueryBboQuotesService>(query);
+    REQUIRE(result.m_id != -1);
+    auto messages = std::vector<MarketDataFeedMessage>();
+    for(auto i = 1; i <= 3; ++i) {
+      messages.push_back(TickerBboQuote(
+        BboQuote(make_bid(i * Money::CENT, 100),
+          make_ask((i + 1) * Money::CENT, 100),
+          fixture.m_time_client.get_time()), ticker));
+    }
+    fixture.m_servlet->publish(messages, 1);
+    auto message = fixture.m_client->read_message();
+    auto received_message = std::dynamic_pointer_cast<
+      RecordMessage<BboQuotesMessage, TestServiceProtocolClient>>(message);
+    REQUIRE(received_message);
+    auto& quotes = received_message->get_record().bbo_quotes;
+    REQUIRE(quotes.size() == 3);
+    for(auto i = 0; i != 3; ++i) {
+      REQUIRE((*quotes[i])->m_bid.m_price == (i + 1) * Money::CENT);
+    }
+  }
+
+  TEST_CASE("shared_filter") {
+    auto fixture = Fixture();
+    auto ticker = parse_ticker("A.TSX");
+    auto info = TickerInfo(ticker, "TICKER A", "", 100);
+    fixture.m_registry.add(info);
+    auto client_account =
+      fixture.make_account("client2", DirectoryEntry::STAR_DIRECTORY);
+    fixture.m_administration_environment.grant_all_entitlements(
+      client_account);
+    auto client = std::unique_ptr<TestServiceProtocolClient>();
+    std::tie(client_account, client) = fixture.make_client("client2");
+    auto make_query = [&] (const std::string& market_center) {
+      auto query = TickerQuery();
+      query.set_index(ticker);
+      query.set_range(Range::REAL_TIME);
+      query.set_filter(
+        TimeAndSaleAccessor::from_parameter(0).get_market_center() ==
+          ConstantExpression(market_center));
+      return query;
+    };
+    REQUIRE(fixture.m_client->send_request<QueryTimeAndSalesService>(
+      make_query("TSX")).m_id != -1);
+    REQUIRE(client->send_request<QueryTimeAndSalesService>(
+      make_query("TSX")).m_id != -1);
+    REQUIRE(client->send_request<QueryTimeAndSalesService>(
+      make_query("CHX")).m_id != -1);
+    auto make_time_and_sale = [&] (const std::string& market_center) {
+      return TickerTimeAndSale(
+        TimeAndSale(fixture.m_time_client.get_time(), Money::ONE, 100,
+          TimeAndSale::Condition(), market_center, "", ""), ticker);
+    };
+    fixture.m_servlet->publish(make_time_and_sale("CHX"), 1);
+    fixture.m_servlet->publish(make_time_and_sale("TSX"), 1);
+    auto read_market_center = [] (auto& client) {
+      auto message = std::dynamic_pointer_cast<
+        RecordMessage<TimeAndSaleMessage, TestServiceProtocolClient>>(
+          client.read_message());
+      REQUIRE(message);
+      return message->get_record().time_and_sale->m_market_center;
+    };
+    REQUIRE(read_market_center(*fixture.m_client) == "TSX");
+    REQUIRE(read_market_center(*client) == "CHX");
+    REQUIRE(read_market_center(*client) == "TSX");
+  }
+
+  TEST_CASE("publish_batch_without_batching") {
+    auto fixture = Fixture();
+    auto ticker = parse_ticker("A.TSX");
+    auto info = TickerInfo(ticker, "TICKER A", "", 100);
+    fixture.m_registry.add(info);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::REAL_TIME);
+    auto result = fixture.m_client->send_request<QueryBboQuotesService>(query);
+    REQUIRE(result.m_id != -1);
+    auto messages = std::vector<MarketDataFeedMessage>();
+    for(auto i = 1; i <= 3; ++i) {
+      messages.push_back(TickerBboQuote(
+        BboQuote(make_bid(i * Money::CENT, 100),
+          make_ask((i + 1) * Money::CENT, 100),
+          fixture.m_time_client.get_time()), ticker));
+    }
+    fixture.m_servlet->publish(messages, 1);
+    for(auto i = 1; i <= 3; ++i) {
+      auto message = fixture.m_client->read_message();
+      auto received_message = std::dynamic_pointer_cast<
+        RecordMessage<BboQuoteMessage, TestServiceProtocolClient>>(message);
+      REQUIRE(received_message);
+      REQUIRE((*received_message->get_record().bbo_quote)->m_bid.m_price ==
+        i * Money::CENT);
+    }
+  }
+
+  TEST_CASE("publish_time_and_sale_frames") {
+    auto fixture = Fixture();
+    auto ticker = parse_ticker("A.TSX");
+    auto info = TickerInfo(ticker, "TICKER A", "", 100);
+    fixture.m_registry.add(info);
+    auto client_account =
+      fixture.make_account("client2", DirectoryEntry::STAR_DIRECTORY);
+    fixture.m_administration_environment.grant_all_entitlements(
+      client_account);
+    auto client = std::unique_ptr<TestServiceProtocolClient>();
+    std::tie(client_account, client) = fixture.make_client("client2");
+    send_record_message<SetBatchingMessage>(*fixture.m_client, true);
+    auto query = TickerQuery();
+    query.set_index(ticker);
+    query.set_range(Range::REAL_TIME);
+    REQUIRE(fixture.m_client->send_request<QueryTimeAndSalesService>(
+      query).m_id != -1);
+    REQUIRE(client->send_request<QueryTimeAndSalesService>(query).m_id != -1);
+    auto messages = std::vector<MarketDataFeedMessage>();
+    for(auto market_center : {"TSX", "CHX"}) {
+      messages.push_back(TickerTimeAndSale(
+        TimeAndSale(fixture.m_time_client.get_time(), Money::ONE, 100,
+          TimeAndSale::Condition(), market_center, "", ""), ticker));
+    }
+    fixture.m_servlet->publish(messages, 1);
+    auto frame = std::dynamic_pointer_cast<
+      RecordMessage<TimeAndSalesMessage, TestServiceProtocolClient>>(
+        fixture.m_client->read_message());
+    REQUIRE(frame);
+    auto time_and_sales = frame->get_record().time_and_sales.decode();
+    REQUIRE(time_and_sales.size() == 2);
+    REQUIRE(time_and_sales[0]->m_market_center == "TSX");
+    REQUIRE(time_and_sales[1]->m_market_center == "CHX");
+    for(auto market_center : {"TSX", "CHX"}) {
+      auto message = std::dynamic_pointer_cast<
+        RecordMessage<TimeAndSaleMessage, TestServiceProtocolClient>>(
+          client->read_message());
+      REQUIRE(message);
+      REQUIRE(message->get_record().time_and_sale->m_market_center ==
+        market_center);
+    }
+  }
 }
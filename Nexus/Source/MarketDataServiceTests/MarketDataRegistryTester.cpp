@@ -99,6 +99,28 @@ TEST_SUITE("MarketDataRegistry") {
     REQUIRE(published);
   }
 
+  TEST_CASE("publish_after_listing_change") {
+    auto data_store = LocalHistoricalDataStore();
+    auto registry = MarketDataRegistry();
+    auto ticker_ry_chic = parse_ticker("RY.CHIC");
+    auto publish = [&] (Money price) {
+      auto book_quote = TickerBookQuote(
+        BookQuote("MP1", false, CHIC, make_bid(price, 100),
+          time_from_string("2024-07-12 13:00:00")), ticker_ry_chic);
+      auto index = Ticker();
+      registry.publish(book_quote, 1, data_store,
+        [&] (const auto& sequenced_quote) {
+          index = sequenced_quote->get_index();
+        });
+      return index;
+    };
+    REQUIRE(publish(Money::CENT) == ticker_ry_chic);
+    REQUIRE(publish(2 * Money::CENT) == ticker_ry_chic);
+    auto ticker_ry_tsx = parse_ticker("RY.TSX");
+    registry.add(TickerInfo(ticker_ry_tsx, "Royal Bank", "Financial", 100));
+    REQUIRE(publish(3 * Money::CENT) == ticker_ry_tsx);
+  }
+
   TEST_CASE("publish_ticker_status") {
     auto data_store = LocalHistoricalDataStore();
     auto registry = MarketDataRegistry();
@@ -129,4 +151,42 @@ TEST_SUITE("MarketDataRegistry") {
       });
     REQUIRE(published);
   }
+
+  TEST_CASE("sharded_publish") {
+    auto data_store = LocalHistoricalDataStore();
+    auto registry = MarketDataRegistry(4);
+    REQUIRE(registry.get_shard_count() == 4);
+    auto ticker_ry_tsx = parse_ticker("RY.TSX");
+    registry.add(TickerInfo(ticker_ry_tsx, "Royal Bank", "Financial", 100));
+    REQUIRE(registry.get_primary_listing(parse_ticker("RY.CHIC")) ==
+      ticker_ry_tsx);
+    REQUIRE(registry.get_shard(parse_ticker("RY.CHIC")) ==
+      registry.get_shard(ticker_ry_tsx));
+    auto tickers = std::vector<Ticker>();
+    for(auto symbol : {"A", "B", "C", "D", "E", "F", "G", "H"}) {
+      tickers.push_back(Ticker(symbol, TSX));
+    }
+    for(auto& ticker : tickers) {
+      auto shard = registry.get_shard(ticker);
+      REQUIRE(shard >= 0);
+      REQUIRE(shard < registry.get_shard_count());
+      auto bbo_quote = TickerBboQuote(
+        BboQuote(make_bid(Money::CENT, 100), make_ask(2 * Money::CENT, 200),
+          time_from_string("2024-07-12 13:00:00")), ticker);
+      auto published = false;
+      registry.publish(bbo_quote, 1, data_store,
+        [&] (const auto& sequenced_quote) {
+          REQUIRE(*sequenced_quote == bbo_quote);
+          published = true;
+        });
+      REQUIRE(published);
+    }
+    for(auto& ticker : tickers) {
+      auto snapshot = registry.find_snapshot(ticker);
+      REQUIRE(snapshot);
+      REQUIRE(snapshot->m_ticker == ticker);
+      REQUIRE(snapshot->m_bbo_quote->m_bid.m_size == 100);
+    }
+    REQUIRE(!registry.find_snapshot(Ticker("Z", TSX)));
+  }
 }
@@ -0,0 +1,96 @@
+#include <doctest/doctest.h>
+#include "Nexus/MarketDataService/PriceLevelBook.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Venues;
+
+namespace {
+  auto make_book_quote(
+      std::string mpid, Money price, Quantity size, Side side) {
+    return BookQuote(std::move(mpid), false, TSX, Quote(price, size, side),
+      time_from_string("2024-07-11 13:00:00"));
+  }
+}
+
+TEST_SUITE("PriceLevelBook") {
+  TEST_CASE("aggregate_levels") {
+    auto sequencer = Beam::Sequencer(Beam::Sequence(10));
+    auto book = PriceLevelBook(Side::BID);
+    REQUIRE(book.publish(
+      make_book_quote("MP1", Money::ONE, 100, Side::BID), 1, sequencer));
+    REQUIRE(book.publish(
+      make_book_quote("MP2", Money::ONE, 200, Side::BID), 1, sequencer));
+    REQUIRE(book.publish(make_book_quote(
+      "MP1", Money::ONE + Money::CENT, 300, Side::BID), 1, sequencer));
+    REQUIRE(book.publish(make_book_quote(
+      "MP3", Money::ONE - Money::CENT, 400, Side::BID), 1, sequencer));
+    auto& levels = book.get_levels();
+    REQUIRE(levels.size() == 3);
+    REQUIRE(levels[0].m_price == Money::ONE - Money::CENT);
+    REQUIRE(levels[0].m_size == 400);
+    REQUIRE(levels[1].m_price == Money::ONE);
+    REQUIRE(levels[1].m_size == 300);
+    REQUIRE(levels[1].m_slots.size() == 2);
+    REQUIRE(levels[1].m_slots[0].m_quote->m_mpid == "MP1");
+    REQUIRE(levels[1].m_slots[1].m_quote->m_mpid == "MP2");
+    REQUIRE(levels[2].m_price == Money::ONE + Money::CENT);
+    REQUIRE(levels[2].m_size == 300);
+    auto quotes = std::vector<SequencedBookQuote>();
+    book.append(quotes);
+    REQUIRE(quotes.size() == 4);
+    REQUIRE(quotes[0]->m_quote.m_price == Money::ONE + Money::CENT);
+    REQUIRE(quotes[1]->m_mpid == "MP1");
+    REQUIRE(quotes[2]->m_mpid == "MP2");
+    REQUIRE(quotes[3]->m_quote.m_price == Money::ONE - Money::CENT);
+  }
+
+  TEST_CASE("update_and_remove") {
+    auto sequencer = Beam::Sequencer(Beam::Sequence(10));
+    auto book = PriceLevelBook(Side::ASK);
+    auto result1 = book.publish(
+      make_book_quote("MP1", Money::ONE, 100, Side::ASK), 1, sequencer);
+    REQUIRE(result1);
+    REQUIRE(result1->get_sequence() == Beam::Sequence(10));
+    auto result2 = book.publish(
+      make_book_quote("MP1", Money::ONE, 50, Side::ASK), 1, sequencer);
+    REQUIRE(result2);
+    REQUIRE((*result2)->m_quote.m_size == 150);
+    REQUIRE(result2->get_sequence() == Beam::Sequence(11));
+    REQUIRE(book.get_levels().front().m_size == 150);
+    auto result3 = book.publish(
+      make_book_quote("MP1", Money::ONE, -200, Side::ASK), 1, sequencer);
+    REQUIRE(result3);
+    REQUIRE((*result3)->m_quote.m_size == 0);
+    REQUIRE(result3->get_sequence() == Beam::Sequence(12));
+    REQUIRE(book.get_levels().empty());
+    REQUIRE(!book.publish(
+      make_book_quote("MP1", Money::ONE, -100, Side::ASK), 1, sequencer));
+    REQUIRE(!book.publish(
+      make_book_quote("MP2", Money::ONE, 0, Side::ASK), 1, sequencer));
+    REQUIRE(book.get_levels().empty());
+  }
+
+  TEST_CASE("clear") {
+    auto sequencer = Beam::Sequencer(Beam::Sequence(10));
+    auto book = PriceLevelBook(Side::ASK);
+    book.publish(
+      make_book_quote("MP1", Money::ONE, 100, Side::ASK), 1, sequencer);
+    book.publish(
+      make_book_quote("MP2", Money::ONE, 200, Side::ASK), 2, sequencer);
+    book.publish(make_book_quote(
+      "MP1", Money::ONE + Money::CENT, 300, Side::ASK), 1, sequencer);
+    book.clear(1);
+    auto& levels = book.get_levels();
+    REQUIRE(levels.size() == 1);
+    REQUIRE(levels.front().m_price == Money::ONE);
+    REQUIRE(levels.front().m_size == 200);
+    REQUIRE(levels.front().m_slots.size() == 1);
+    auto quotes = std::vector<SequencedBookQuote>();
+    book.append(quotes);
+    REQUIRE(quotes.size() == 1);
+    REQUIRE(quotes.front()->m_mpid == "MP2");
+  }
+}
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <Beam/Queues/Queue.hpp>
 #include <Beam/ServicesTests/ServiceClientFixture.hpp>
 #include <doctest/doctest.h>
@@ -18,11 +19,17 @@ namespace {
     using TestMarketDataClient =
       ServiceMarketDataClient<TestServiceProtocolClientBuilder>;
     std::unique_ptr<TestMarketDataClient> m_client;
+    std::atomic_bool m_is_batching;
 
-    Fixture() {
+    Fixture()
+        : m_is_batching(false) {
       Nexus::register_query_types(out(m_server.get_slots().get_registry()));
       register_market_data_registry_services(out(m_server.get_slots()));
       register_market_data_registry_messages(out(m_server.get_slots()));
+      add_message_slot<SetBatchingMessage>(out(m_server.get_slots()),
+        [this] (auto& client, auto is_enabled) {
+          m_is_batching = is_enabled;
+        });
       m_client = make_client<TestMarketDataClient>();
     }
   };
@@ -53,6 +60,65 @@ TEST_SUITE("ServiceMarketDataClient") {
     REQUIRE(updated_bbo == bbo);
   }
 
+  TEST_CASE("real_time_bbo_quote_batch") {
+    auto fixture = Fixture();
+    auto query = TickerQuery();
+    query.set_index(TICKER_A);
+    query.set_range(Range::REAL_TIME);
+    auto bbo_quotes = std::make_shared<Queue<BboQuote>>();
+    auto bbo1 = BboQuote(
+      make_bid(Money::ONE, 100), make_ask(Money::ONE + Money::CENT, 200),
+      time_from_string("2021-01-11 15:30:05.000"));
+    auto bbo2 = BboQuote(
+      make_bid(Money::ONE, 300), make_ask(Money::ONE + Money::CENT, 400),
+      time_from_string("2021-01-11 15:30:06.000"));
+    fixture.on_request<QueryBboQuotesService>(
+      [&] (auto& request, const auto& query) {
+        REQUIRE(fixture.m_is_batching);
+        auto response = BboQuoteQueryResult();
+        response.m_id = 123;
+        request.set(response);
+        send_record_message<BboQuotesMessage>(request.get_client(),
+          std::vector{
+            SequencedValue(IndexedValue(bbo1, TICKER_A), Beam::Sequence(1)),
+            SequencedValue(IndexedValue(bbo2, TICKER_A), Beam::Sequence(2))});
+      });
+    fixture.m_client->query(query, bbo_quotes);
+    REQUIRE(bbo_quotes->pop() == bbo1);
+    REQUIRE(bbo_quotes->pop() == bbo2);
+  }
+
+  TEST_CASE("real_time_time_and_sale_batch") {
+    auto fixture = Fixture();
+    auto query = TickerQuery();
+    query.set_index(TICKER_A);
+    query.set_range(Range::REAL_TIME);
+    auto time_and_sales = std::make_shared<Queue<TimeAndSale>>();
+    auto time_and_sale1 = TimeAndSale(
+      time_from_string("2021-01-11 15:30:05.000"), Money::ONE, 100,
+      TimeAndSale::Condition(TimeAndSale::Condition::Type::REGULAR, "@"),
+      "TSX", "BUY", "SELL");
+    auto time_and_sale2 = TimeAndSale(
+      time_from_string("2021-01-11 15:30:06.000"), Money::CENT, 200,
+      TimeAndSale::Condition(TimeAndSale::Condition::Type::REGULAR, "@"),
+      "TSX", "SELL", "BUY");
+    fixture.on_request<QueryTimeAndSalesService>(
+      [&] (auto& request, const auto& query) {
+        auto response = TimeAndSaleQueryResult();
+        response.m_id = 123;
+        request.set(response);
+        send_record_message<TimeAndSalesMessage>(request.get_client(),
+          TimeAndSaleFrame(std::vector{
+            SequencedValue(
+              IndexedValue(time_and_sale1, TICKER_A), Beam::Sequence(1)),
+            SequencedValue(
+              IndexedValue(time_and_sale2, TICKER_A), Beam::Sequence(2))}));
+      });
+    fixture.m_client->query(query, time_and_sales);
+    REQUIRE(time_and_sales->pop() == time_and_sale1);
+    REQUIRE(time_and_sales->pop() == time_and_sale2);
+  }
+
   TEST_CASE("real_time_ticker_status_query") {
     auto fixture = Fixture();
     auto query = TickerQuery();
@@ -163,6 +163,38 @@ TEST_SUITE("TickerEntry") {
     REQUIRE(**entry.get_bbo_quote() == expected_snapshot.m_bbo_quote);
   }
 
+  TEST_CASE("remove_book_quote") {
+    auto initial_sequences = TickerEntry::InitialSequences();
+    initial_sequences.m_next_book_quote_sequence = Beam::Sequence(20);
+    auto ticker = parse_ticker("TST.TSX");
+    auto entry = TickerEntry(ticker, Money::ONE, initial_sequences);
+    auto bid1 = BookQuote("MP1", false, TSX, make_bid(10 * Money::CENT, 100),
+      time_from_string("2024-07-11 13:00:00"));
+    entry.publish(bid1, 1);
+    auto bid2 = BookQuote("MP2", false, TSX, make_bid(10 * Money::CENT, 200),
+      time_from_string("2024-07-11 13:00:01"));
+    auto result_bid2 = entry.publish(bid2, 1);
+    REQUIRE(entry.get_book(Side::BID).get_levels().size() == 1);
+    REQUIRE(entry.get_book(Side::BID).get_levels().front().m_size == 300);
+    auto removal = BookQuote("MP1", false, TSX,
+      make_bid(10 * Money::CENT, -100),
+      time_from_string("2024-07-11 13:00:02"));
+    auto result_removal = entry.publish(removal, 1);
+    REQUIRE(result_removal);
+    REQUIRE((**result_removal)->m_quote.m_size == 0);
+    REQUIRE((*result_removal)->get_index() == ticker);
+    REQUIRE(result_removal->get_sequence() == Beam::Sequence(22));
+    REQUIRE(entry.get_book(Side::BID).get_levels().front().m_size == 200);
+    auto snapshot = entry.load_snapshot();
+    REQUIRE(snapshot);
+    REQUIRE(snapshot->m_bids.size() == 1);
+    REQUIRE(snapshot->m_bids.front().get_sequence() ==
+      result_bid2->get_sequence());
+    entry.clear(1);
+    REQUIRE(entry.get_book(Side::BID).get_levels().empty());
+    REQUIRE(entry.load_snapshot()->m_bids.empty());
+  }
+
   TEST_CASE("session_technicals") {
     auto initial_sequences = TickerEntry::InitialSequences();
     auto ticker = parse_ticker("TST.TSX");
@@ -0,0 +1,139 @@
+#include <future>
+#include <Beam/IO/LocalServerConnection.hpp>
+#include <Beam/IO/SharedBuffer.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/MoldUdp64/ArbitratedMoldUdp64Client.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::endian;
+using namespace Nexus;
+
+namespace {
+  struct Line {
+    LocalServerConnection m_server;
+    optional<LocalClientChannel> m_client_channel;
+    std::unique_ptr<LocalServerChannel> m_server_channel;
+
+    Line() {
+      auto server_channel_async = std::async(std::launch::async, [&] {
+        return m_server.accept();
+      });
+      m_client_channel.emplace("mold_udp", m_server);
+      m_server_channel = server_channel_async.get();
+    }
+
+    void transmit(const std::vector<SharedBuffer>& packets,
+        const std::vector<std::size_t>& order) {
+      for(auto i : order) {
+        m_server_channel->get_writer().write(packets[i]);
+      }
+    }
+  };
+
+  auto make_feed(std::uint64_t sequence_number, int count) {
+    auto packets = std::vector<SharedBuffer>();
+    for(auto i = 0; i != count; ++i) {
+      auto data = std::to_string(sequence_number + i);
+      auto buffer = SharedBuffer();
+      append(buffer, "SESSION01", 9);
+      append(buffer, std::uint8_t(0));
+      append(buffer, native_to_big(sequence_number + i));
+      append(buffer, native_to_big(std::uint16_t(1)));
+      append(buffer, native_to_big(std::uint16_t(1 + data.size())));
+      append(buffer, std::uint8_t(0xE0));
+      append(buffer, data.c_str(), data.size());
+      packets.push_back(std::move(buffer));
+    }
+    return packets;
+  }
+
+  struct RecordingRetransmitter {
+    std::vector<MoldUdp64Gap> m_requests;
+
+    void request(const MoldUdp64Session& session,
+        std::uint64_t sequence_number, std::uint16_t count) {
+      m_requests.push_back(MoldUdp64Gap(sequence_number, count));
+    }
+  };
+}
+
+TEST_SUITE("ArbitratedMoldUdp64Client") {
+  TEST_CASE("arbitrate") {
+    auto a = Line();
+    auto b = Line();
+    auto retransmitter = RecordingRetransmitter();
+    auto client = ArbitratedMoldUdp64Client(
+      &*a.m_client_channel, &*b.m_client_channel, &retransmitter);
+    auto packets = make_feed(1, 8);
+    a.transmit(packets, {0, 3, 5, 7});
+    b.transmit(packets, {0, 2, 1, 4, 3, 6, 5, 7});
+    for(auto i = std::uint64_t(1); i <= 8; ++i) {
+      auto sequence_number = std::uint64_t(0);
+      auto message = client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+      REQUIRE(std::string(message.m_data, message.m_length - 1) ==
+        std::to_string(i));
+    }
+  }
+
+  TEST_CASE("gap_on_both_lines") {
+    auto a = Line();
+    auto b = Line();
+    auto retransmitter = RecordingRetransmitter();
+    auto client = ArbitratedMoldUdp64Client(
+      &*a.m_client_channel, &*b.m_client_channel, &retransmitter, 2);
+    auto packets = make_feed(1, 6);
+    a.transmit(packets, {0, 3, 4, 5});
+    b.transmit(packets, {0, 3, 4, 5});
+    auto sequence_number = std::uint64_t(0);
+    client.read(out(sequence_number));
+    REQUIRE(sequence_number == 1);
+    REQUIRE_THROWS_AS(client.read(out(sequence_number)),
+      MoldUdp64GapException);
+    REQUIRE(retransmitter.m_requests.front() == MoldUdp64Gap(2, 2));
+    for(auto i = std::uint64_t(4); i <= 6; ++i) {
+      client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+    }
+  }
+
+  TEST_CASE("gap_filled_by_other_line") {
+    auto a = Line();
+    auto b = Line();
+    auto client =
+      ArbitratedMoldUdp64Client(&*a.m_client_channel, &*b.m_client_channel);
+    auto packets = make_feed(1, 4);
+    a.transmit(packets, {0, 2, 3});
+    b.transmit(packets, {0, 1, 2, 3});
+    for(auto i = std::uint64_t(1); i <= 4; ++i) {
+      auto sequence_number = std::uint64_t(0);
+      client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+    }
+  }
+
+  TEST_CASE("gap_without_retransmitter") {
+    auto a = Line();
+    auto b = Line();
+    auto client =
+      ArbitratedMoldUdp64Client(&*a.m_client_channel, &*b.m_client_channel);
+    auto packets = make_feed(1, 4);
+    a.transmit(packets, {0, 2, 3});
+    b.transmit(packets, {0, 2, 3});
+    auto sequence_number = std::uint64_t(0);
+    client.read(out(sequence_number));
+    REQUIRE(sequence_number == 1);
+    try {
+      client.read(out(sequence_number));
+      FAIL("Expected MoldUdp64GapException.");
+    } catch(const MoldUdp64GapException& e) {
+      REQUIRE(e.get_sequence_number() == 2);
+      REQUIRE(e.get_count() == 1);
+    }
+    for(auto i = std::uint64_t(3); i <= 4; ++i) {
+      client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+    }
+  }
+}
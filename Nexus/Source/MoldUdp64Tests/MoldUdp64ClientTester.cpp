@@ -1,3 +1,4 @@
+#include <array>
 #include <future>
 #include <Beam/IO/LocalServerConnection.hpp>
 #include <Beam/IO/SharedBuffer.hpp>
@@ -58,6 +59,43 @@ namespace {
   auto is_equal(const char* data, const char* expected) {
     return std::memcmp(data, expected, std::strlen(expected)) == 0;
   }
+
+  auto make_feed(std::uint64_t sequence_number, int count) {
+    auto packets = std::vector<SharedBuffer>();
+    for(auto i = 0; i != count; ++i) {
+      packets.push_back(make_packet_buffer("SESSION01", sequence_number + i,
+        {make_message_buffer(0xE0, std::to_string(sequence_number + i))}));
+    }
+    return packets;
+  }
+
+  void transmit(LocalServerChannel& channel,
+      const std::vector<SharedBuffer>& packets,
+      const std::vector<std::size_t>& order) {
+    for(auto i : order) {
+      channel.get_writer().write(packets[i]);
+    }
+  }
+
+  struct TestRetransmitter {
+    LocalServerChannel* m_channel;
+    std::vector<SharedBuffer> m_packets;
+    std::vector<MoldUdp64Gap> m_requests;
+
+    void request(const MoldUdp64Session& session,
+        std::uint64_t sequence_number, std::uint16_t count) {
+      REQUIRE(std::string(session.get_data()) == "SESSION01");
+      m_requests.push_back(MoldUdp64Gap(sequence_number, count));
+      for(auto& packet : m_packets) {
+        auto header = MoldUdp64Packet::parse(
+          std::string_view(packet.get_data(), packet.get_size()));
+        if(header.m_sequence_number >= sequence_number &&
+            header.m_sequence_number < sequence_number + count) {
+          m_channel->get_writer().write(packet);
+        }
+      }
+    }
+  };
 }
 
 TEST_SUITE("MoldUdp64Client") {
@@ -103,4 +141,98 @@ TEST_SUITE("MoldUdp64Client") {
     REQUIRE(expected_sequence == 201);
     REQUIRE(is_equal(message.m_data, "REAL"));
   }
+
+  TEST_CASE("reorder") {
+    auto fixture = Fixture();
+    auto retransmitter = TestRetransmitter();
+    retransmitter.m_channel = fixture.m_server_channel.get();
+    auto client =
+      MoldUdp64Client(&*fixture.m_client_channel, &retransmitter);
+    auto packets = make_feed(1, 5);
+    transmit(*fixture.m_server_channel, packets, {0, 2, 1, 4, 3});
+    for(auto i = std::uint64_t(1); i <= 5; ++i) {
+      auto sequence_number = std::uint64_t(0);
+      auto message = client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+      REQUIRE(is_equal(message.m_data, std::to_string(i).c_str()));
+    }
+  }
+
+  TEST_CASE("retransmission") {
+    auto fixture = Fixture();
+    auto retransmitter = TestRetransmitter();
+    retransmitter.m_channel = fixture.m_server_channel.get();
+    retransmitter.m_packets = make_feed(1, 6);
+    auto client =
+      MoldUdp64Client(&*fixture.m_client_channel, &retransmitter);
+    transmit(*fixture.m_server_channel, retransmitter.m_packets,
+      {0, 3, 4, 5});
+    for(auto i = std::uint64_t(1); i <= 6; ++i) {
+      auto sequence_number = std::uint64_t(0);
+      client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+    }
+    REQUIRE(retransmitter.m_requests ==
+      std::vector<MoldUdp64Gap>{MoldUdp64Gap(2, 2)});
+  }
+
+  TEST_CASE("unrecoverable_gap") {
+    auto fixture = Fixture();
+    auto client = MoldUdp64Client(
+      &*fixture.m_client_channel, NullMoldUdp64Retransmitter(), 2);
+    auto packets = make_feed(1, 6);
+    transmit(*fixture.m_server_channel, packets, {0, 3, 4, 5});
+    auto sequence_number = std::uint64_t(0);
+    client.read(out(sequence_number));
+    REQUIRE(sequence_number == 1);
+    try {
+      client.read(out(sequence_number));
+      FAIL("Expected MoldUdp64GapException.");
+    } catch(const MoldUdp64GapException& e) {
+      REQUIRE(e.get_sequence_number() == 2);
+      REQUIRE(e.get_count() == 2);
+    }
+    for(auto i = std::uint64_t(4); i <= 6; ++i) {
+      client.read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+    }
+  }
+
+  TEST_CASE("gap_without_retransmitter") {
+    auto fixture = Fixture();
+    auto packets = make_feed(1, 4);
+    transmit(*fixture.m_server_channel, packets, {0, 2, 3});
+    auto sequence_number = std::uint64_t(0);
+    fixture.m_client->read(out(sequence_number));
+    REQUIRE(sequence_number == 1);
+    try {
+      fixture.m_client->read(out(sequence_number));
+      FAIL("Expected MoldUdp64GapException.");
+    } catch(const MoldUdp64GapException& e) {
+      REQUIRE(e.get_sequence_number() == 2);
+      REQUIRE(e.get_count() == 1);
+    }
+    for(auto i = std::uint64_t(3); i <= 4; ++i) {
+      fixture.m_client->read(out(sequence_number));
+      REQUIRE(sequence_number == i);
+    }
+  }
+
+  TEST_CASE("read_batch") {
+    auto fixture = Fixture();
+    auto packet = make_packet_buffer("SESSION01", 10,
+      {make_message_buffer(0xC1, "ONE"), make_message_buffer(0xC2, "TWO"),
+        make_message_buffer(0xC3, "THREE")});
+    fixture.m_server_channel->get_writer().write(packet);
+    auto messages = std::array<MoldUdp64Message, 2>();
+    auto sequence_number = std::uint64_t(0);
+    REQUIRE(fixture.m_client->read_batch(messages, out(sequence_number)) == 2);
+    REQUIRE(sequence_number == 10);
+    REQUIRE(is_equal(messages[0].m_data, "ONE"));
+    REQUIRE(is_equal(messages[1].m_data, "TWO"));
+    REQUIRE(fixture.m_client->read_batch(messages, out(sequence_number)) == 1);
+    REQUIRE(sequence_number == 12);
+    REQUIRE(messages[0].m_message_type == 0xC3);
+    REQUIRE(is_equal(messages[0].m_data, "THREE"));
+  }
 }
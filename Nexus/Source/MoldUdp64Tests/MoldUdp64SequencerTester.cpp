@@ -0,0 +1,111 @@
+#include <Beam/IO/SharedBuffer.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/MoldUdp64/MoldUdp64Sequencer.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::endian;
+using namespace Nexus;
+
+namespace {
+  auto make_packet_buffer(std::uint64_t sequence_number, int count) {
+    auto buffer = SharedBuffer();
+    append(buffer, "SESSION01", 9);
+    append(buffer, std::uint8_t(0));
+    append(buffer, native_to_big(sequence_number));
+    append(buffer, native_to_big(std::uint16_t(count)));
+    for(auto i = 0; i != count; ++i) {
+      append(buffer, native_to_big(std::uint16_t(2)));
+      append(buffer, std::uint8_t(0xA0));
+      append(buffer, static_cast<char>('a' + (sequence_number + i) % 26));
+    }
+    return buffer;
+  }
+
+  auto pop_all(MoldUdp64Sequencer& sequencer) {
+    auto sequence_numbers = std::vector<std::uint64_t>();
+    auto sequence_number = std::uint64_t();
+    while(auto message = sequencer.pop(out(sequence_number))) {
+      REQUIRE(message->m_data[0] ==
+        static_cast<char>('a' + sequence_number % 26));
+      sequence_numbers.push_back(sequence_number);
+    }
+    return sequence_numbers;
+  }
+}
+
+TEST_SUITE("MoldUdp64Sequencer") {
+  TEST_CASE("in_order") {
+    auto sequencer = MoldUdp64Sequencer();
+    sequencer.push(make_packet_buffer(10, 2));
+    sequencer.push(make_packet_buffer(12, 1));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{10, 11, 12});
+    REQUIRE(sequencer.get_next_sequence_number() == 13);
+    REQUIRE(!sequencer.get_gap());
+    REQUIRE(std::string(sequencer.get_session().get_data()) == "SESSION01");
+  }
+
+  TEST_CASE("reorder") {
+    auto sequencer = MoldUdp64Sequencer();
+    sequencer.push(make_packet_buffer(1, 2));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{1, 2});
+    sequencer.push(make_packet_buffer(5, 1));
+    sequencer.push(make_packet_buffer(4, 1));
+    REQUIRE(pop_all(sequencer).empty());
+    REQUIRE(sequencer.get_gap() == MoldUdp64Gap(3, 1));
+    sequencer.push(make_packet_buffer(3, 1));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{3, 4, 5});
+    REQUIRE(!sequencer.get_gap());
+  }
+
+  TEST_CASE("duplicates") {
+    auto sequencer = MoldUdp64Sequencer();
+    sequencer.push(make_packet_buffer(1, 3));
+    sequencer.push(make_packet_buffer(1, 3));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{1, 2, 3});
+    sequencer.push(make_packet_buffer(1, 3));
+    sequencer.push(make_packet_buffer(2, 4));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{4, 5});
+  }
+
+  TEST_CASE("heartbeat_gap") {
+    auto sequencer = MoldUdp64Sequencer();
+    sequencer.push(make_packet_buffer(7, 0));
+    REQUIRE(!sequencer.get_gap());
+    sequencer.push(make_packet_buffer(7, 1));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{7});
+    sequencer.push(make_packet_buffer(11, 0));
+    REQUIRE(sequencer.get_gap() == MoldUdp64Gap(8, 3));
+  }
+
+  TEST_CASE("end_of_session") {
+    auto sequencer = MoldUdp64Sequencer();
+    sequencer.push(make_packet_buffer(1, 2));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{1, 2});
+    REQUIRE(!sequencer.is_ended());
+    auto end = SharedBuffer();
+    append(end, "SESSION01", 9);
+    append(end, std::uint8_t(0));
+    append(end, native_to_big(std::uint64_t(3)));
+    append(end, native_to_big(MoldUdp64Packet::END_OF_SESSION));
+    sequencer.push(end);
+    REQUIRE(sequencer.is_ended());
+    REQUIRE(!sequencer.get_gap());
+    REQUIRE(pop_all(sequencer).empty());
+    REQUIRE(sequencer.get_next_sequence_number() == 3);
+  }
+
+  TEST_CASE("skip") {
+    auto sequencer = MoldUdp64Sequencer(2);
+    sequencer.push(make_packet_buffer(1, 1));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{1});
+    sequencer.push(make_packet_buffer(4, 1));
+    REQUIRE(!sequencer.is_full());
+    sequencer.push(make_packet_buffer(5, 1));
+    REQUIRE(sequencer.is_full());
+    REQUIRE(sequencer.skip() == MoldUdp64Gap(2, 2));
+    REQUIRE(pop_all(sequencer) == std::vector<std::uint64_t>{4, 5});
+    sequencer.push(make_packet_buffer(2, 3));
+    REQUIRE(pop_all(sequencer).empty());
+  }
+}
@@ -0,0 +1,84 @@
+#include <memory>
+#include <vector>
+#include "Nexus/Accounting/BuyingPowerModel.hpp"
+#include "Nexus/Accounting/TrueAverageBookkeeper.hpp"
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/Definitions/TickerId.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+using namespace Nexus::Currencies;
+using namespace Nexus::Venues;
+
+namespace {
+  const auto TICKER_COUNT = 64;
+
+  auto make_tickers() {
+    auto tickers = std::vector<Ticker>();
+    for(auto i = 0; i != TICKER_COUNT; ++i) {
+      tickers.push_back(Ticker("T" + std::to_string(i), TSX));
+    }
+    return tickers;
+  }
+
+  auto make_order_fields(std::int64_t count) {
+    auto generator = make_generator();
+    auto tickers = make_tickers();
+    auto orders = std::vector<OrderFields>();
+    orders.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto fields = OrderFields();
+      fields.m_ticker = tickers[generator() % tickers.size()];
+      fields.m_currency = CAD;
+      fields.m_side = generator() % 2 == 0 ? Side::BID : Side::ASK;
+      fields.m_quantity = static_cast<Quantity>(100 * (1 + generator() % 10));
+      fields.m_price =
+        Money::ONE + static_cast<int>(generator() % 100) * Money::CENT;
+      orders.push_back(std::move(fields));
+    }
+    return orders;
+  }
+
+  const auto BUYING_POWER_MODEL_SUBMIT_AND_FILL = register_benchmark(
+    "BuyingPowerModel/submit_and_fill", 100000, [] (std::int64_t iterations) {
+      auto model = std::make_shared<BuyingPowerModel>();
+      auto orders = make_order_fields(iterations);
+      auto tickers = std::vector<TickerId>();
+      tickers.reserve(orders.size());
+      for(auto& fields : orders) {
+        tickers.push_back(to_ticker_id(fields.m_ticker));
+      }
+      return [model, orders = std::move(orders),
+          tickers = std::move(tickers)] {
+        auto id = OrderId(1);
+        for(auto i = std::size_t(0); i != orders.size(); ++i) {
+          auto& fields = orders[i];
+          do_not_optimize(
+            model->submit(id, tickers[i], fields, fields.m_price));
+          auto report = ExecutionReport();
+          report.m_id = id;
+          report.m_status = OrderStatus::FILLED;
+          report.m_last_quantity = fields.m_quantity;
+          report.m_last_price = fields.m_price;
+          model->update(report);
+          ++id;
+        }
+        do_not_optimize(model->get_buying_power(CAD));
+      };
+    });
+
+  const auto TRUE_AVERAGE_BOOKKEEPER_RECORD = register_benchmark(
+    "TrueAverageBookkeeper/record", 200000, [] (std::int64_t iterations) {
+      auto bookkeeper = std::make_shared<TrueAverageBookkeeper>();
+      return [bookkeeper, orders = make_order_fields(iterations)] {
+        for(auto& fields : orders) {
+          auto quantity = fields.m_side == Side::BID ?
+            fields.m_quantity : -fields.m_quantity;
+          bookkeeper->record(fields.m_ticker, fields.m_currency, quantity,
+            quantity * fields.m_price, Money::CENT);
+        }
+        do_not_optimize(bookkeeper->get_total(CAD));
+      };
+    });
+}
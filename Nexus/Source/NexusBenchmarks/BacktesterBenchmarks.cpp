@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "Nexus/Backtester/BacktesterEventHandler.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+
+namespace {
+  const auto START = time_from_string("2025-08-14 09:30:00");
+  const auto END = time_from_string("2025-08-14 16:00:00");
+  const auto RUN_LENGTH = 256;
+
+  struct PassiveEvent : BacktesterEvent {
+    using BacktesterEvent::BacktesterEvent;
+
+    bool is_passive() const override {
+      return true;
+    }
+
+    void execute() override {
+      complete();
+    }
+  };
+
+  auto make_events(std::int64_t count) {
+    auto generator = make_generator();
+    auto span = (END - START).total_milliseconds();
+    auto events = std::vector<std::shared_ptr<BacktesterEvent>>();
+    events.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      events.push_back(std::make_shared<PassiveEvent>(
+        START + milliseconds(static_cast<std::int64_t>(generator() % span))));
+    }
+    return events;
+  }
+
+  struct Scheduler {
+    BacktesterEventHandler m_handler;
+
+    Scheduler()
+        : m_handler(START, END) {
+      m_handler.suspend();
+    }
+
+    ~Scheduler() {
+      m_handler.resume();
+    }
+  };
+
+  void advance_events(Scheduler& scheduler, std::int64_t count) {
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      do_not_optimize(scheduler.m_handler.advance());
+    }
+  }
+
+  const auto BACKTESTER_EVENT_HANDLER_UNSORTED = register_benchmark(
+    "BacktesterEventHandler/add_and_advance_unsorted", 100000,
+    [] (std::int64_t iterations) {
+      auto scheduler = std::make_shared<Scheduler>();
+      return [scheduler, events = make_events(iterations)] {
+        for(auto& event : events) {
+          scheduler->m_handler.add(event);
+        }
+        advance_events(*scheduler, static_cast<std::int64_t>(events.size()));
+      };
+    });
+
+  const auto BACKTESTER_EVENT_HANDLER_SORTED_RUNS = register_benchmark(
+    "BacktesterEventHandler/add_and_advance_sorted_runs", 100000,
+    [] (std::int64_t iterations) {
+      auto scheduler = std::make_shared<Scheduler>();
+      auto events = make_events(iterations);
+      auto runs = std::vector<std::vector<std::shared_ptr<BacktesterEvent>>>();
+      for(auto i = std::size_t(0); i < events.size(); i += RUN_LENGTH) {
+        auto& run = runs.emplace_back(events.begin() + i,
+          events.begin() + std::min(i + RUN_LENGTH, events.size()));
+        std::stable_sort(run.begin(), run.end(),
+          [] (const auto& left, const auto& right) {
+            return left->get_timestamp() < right->get_timestamp();
+          });
+      }
+      return [scheduler, runs = std::move(runs), iterations] {
+        for(auto& run : runs) {
+          scheduler->m_handler.add(run);
+        }
+        advance_events(*scheduler, iterations);
+      };
+    });
+}
@@ -0,0 +1,90 @@
+#include <future>
+#include <memory>
+#include <vector>
+#include <Beam/ServiceLocatorTests/ServiceLocatorTestEnvironment.hpp>
+#include "Nexus/Compliance/ComplianceRuleSet.hpp"
+#include "Nexus/ComplianceTests/TestComplianceClient.hpp"
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+#include "Nexus/OrderExecutionService/PrimitiveOrder.hpp"
+
+using namespace Beam;
+using namespace Beam::Tests;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+using namespace Nexus::Currencies;
+using namespace Nexus::Tests;
+
+namespace {
+  using TestComplianceRuleSet =
+    ComplianceRuleSet<TestComplianceClient*, ServiceLocatorClient>;
+
+  const auto RULE_COUNT = 8;
+
+  struct PassingRule final : ComplianceRule {
+    void submit(const std::shared_ptr<Order>& order) override {
+      do_not_optimize(order->get_info().m_fields.m_quantity);
+    }
+
+    void cancel(const std::shared_ptr<Order>&) override {}
+
+    void add(const std::shared_ptr<Order>&) override {}
+  };
+
+  struct Fixture {
+    ServiceLocatorTestEnvironment m_service_locator_environment;
+    std::shared_ptr<TestComplianceClient::Queue> m_operations;
+    TestComplianceClient m_client;
+    DirectoryEntry m_account;
+    std::unique_ptr<TestComplianceRuleSet> m_rule_set;
+
+    Fixture()
+        : m_operations(std::make_shared<TestComplianceClient::Queue>()),
+          m_client(m_operations) {
+      m_account = m_service_locator_environment.get_root().make_account(
+        "user", "pw", DirectoryEntry::STAR_DIRECTORY);
+      m_rule_set = std::make_unique<TestComplianceRuleSet>(&m_client,
+        m_service_locator_environment.make_client("user", "pw"),
+        [] (const ComplianceRuleEntry&) {
+          return std::make_unique<PassingRule>();
+        });
+      auto entries = std::vector<ComplianceRuleEntry>();
+      for(auto i = 0; i != RULE_COUNT; ++i) {
+        entries.push_back(ComplianceRuleEntry(i + 1, m_account,
+          ComplianceRuleEntry::State::ACTIVE,
+          ComplianceRuleSchema("passing_rule", {})));
+      }
+      auto submission = std::async(std::launch::async, [&] {
+        m_rule_set->submit(make_order(0));
+      });
+      auto operation = m_operations->pop();
+      std::get<TestComplianceClient::MonitorComplianceRuleEntriesOperation>(
+        *operation).m_result.set(std::move(entries));
+      submission.get();
+    }
+
+    std::shared_ptr<PrimitiveOrder> make_order(OrderId id) const {
+      return std::make_shared<PrimitiveOrder>(OrderInfo(
+        make_limit_order_fields(m_account, parse_ticker("TST.TSX"), CAD,
+          Side::BID, "TSX", 100, Money::ONE), id,
+        time_from_string("2025-08-14 09:30:00")));
+    }
+  };
+
+  const auto COMPLIANCE_RULE_SET_SUBMIT = register_benchmark(
+    "ComplianceRuleSet/submit", 100000, [] (std::int64_t iterations) {
+      auto fixture = std::make_shared<Fixture>();
+      auto orders = std::vector<std::shared_ptr<Order>>();
+      orders.reserve(iterations);
+      for(auto i = std::int64_t(0); i != iterations; ++i) {
+        orders.push_back(fixture->make_order(i + 1));
+      }
+      return [fixture, orders = std::move(orders)] {
+        for(auto& order : orders) {
+          fixture->m_rule_set->submit(order);
+        }
+      };
+    });
+}
@@ -0,0 +1,103 @@
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "Nexus/FeeHandling/ConsolidatedTmxFeeTable.hpp"
+#include "Nexus/FeeHandlingTests/FeeTableTestUtilities.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+#include "Nexus/OrderExecutionService/PrimitiveOrder.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+using namespace Nexus::Currencies;
+using namespace Nexus::Tests;
+using namespace Nexus::Venues;
+
+namespace {
+  const auto TIMESTAMP = time_from_string("2025-08-14 09:30:00");
+  const auto ORDER_COUNT = 64;
+
+  auto make_fee_table() {
+    std::srand(BENCHMARK_SEED);
+    auto table = ConsolidatedTmxFeeTable();
+    table.m_spire_fee = Money(1);
+    table.m_iiroc_fee = Money(2);
+    table.m_cds_fee = Money(3);
+    table.m_cds_cap = 2;
+    table.m_clearing_fee = Money(4);
+    table.m_per_order_fee = Money(5);
+    table.m_per_order_cap = Money(20);
+    populate_fee_table(out(table.m_tsx_fee_table.m_continuous_fee_table));
+    populate_fee_table(out(table.m_tsx_fee_table.m_auction_fee_table));
+    populate_fee_table(out(table.m_tsx_fee_table.m_odd_lot_fee_list));
+    populate_fee_table(out(table.m_tsxv_fee_table.m_continuous_fee_table));
+    populate_fee_table(out(table.m_tsxv_fee_table.m_auction_fee_table));
+    populate_fee_table(out(table.m_tsxv_fee_table.m_odd_lot_fee_list));
+    populate_fee_table(out(table.m_xats_fee_table.m_general_fee_table));
+    populate_fee_table(out(table.m_xats_fee_table.m_etf_fee_table));
+    table.m_xats_fee_table.m_intraspread_dark_to_dark_max_fee = Money(10);
+    table.m_xats_fee_table.m_intraspread_dark_to_dark_subdollar_max_fee =
+      Money(20);
+    populate_fee_table(out(table.m_chic_fee_table.m_fee_table));
+    populate_fee_table(out(table.m_lynx_fee_table.m_fee_table));
+    populate_fee_table(out(table.m_omga_fee_table.m_fee_table));
+    table.m_etfs.insert(Ticker("ETF", TSX));
+    return table;
+  }
+
+  auto make_orders() {
+    auto generator = make_generator();
+    auto orders = std::vector<std::shared_ptr<PrimitiveOrder>>();
+    for(auto i = 0; i != ORDER_COUNT; ++i) {
+      auto ticker = i % 8 == 0 ? Ticker("ETF", TSX) : Ticker("TST", TSX);
+      auto price = Money::ONE + static_cast<int>(generator() % 100) *
+        Money::CENT;
+      auto fields = make_limit_order_fields(DirectoryEntry::ROOT_ACCOUNT,
+        ticker, CAD, Side::BID, Destinations::TSX, 1000, price);
+      orders.push_back(std::make_shared<PrimitiveOrder>(OrderInfo(
+        fields, fields.m_account, i + 1, false, TIMESTAMP)));
+    }
+    return orders;
+  }
+
+  struct Fill {
+    std::shared_ptr<PrimitiveOrder> m_order;
+    ExecutionReport m_report;
+  };
+
+  auto make_fills(std::int64_t count) {
+    auto generator = make_generator();
+    auto orders = make_orders();
+    auto liquidity_flags = std::vector<std::string>{"A", "P"};
+    auto last_markets =
+      std::vector<std::string>{"XTSE", "XATS", "CHIC", "LYNX", "OMGA"};
+    auto fills = std::vector<Fill>();
+    fills.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto& order = orders[generator() % orders.size()];
+      auto report = ExecutionReport(order->get_info().m_id, TIMESTAMP);
+      report.m_last_price = order->get_info().m_fields.m_price;
+      report.m_last_quantity = static_cast<Quantity>(1 + generator() % 100);
+      report.m_liquidity_flag =
+        liquidity_flags[generator() % liquidity_flags.size()];
+      report.m_last_market = last_markets[generator() % last_markets.size()];
+      fills.push_back(Fill(order, std::move(report)));
+    }
+    return fills;
+  }
+
+  const auto CONSOLIDATED_TMX_FEE_TABLE_CALCULATE_FEE = register_benchmark(
+    "ConsolidatedTmxFeeTable/calculate_fee", 200000,
+    [] (std::int64_t iterations) {
+      auto table = std::make_shared<ConsolidatedTmxFeeTable>(make_fee_table());
+      auto state = std::make_shared<ConsolidatedTmxFeeTable::State>();
+      return [table, state, fills = make_fills(iterations)] {
+        for(auto& fill : fills) {
+          do_not_optimize(
+            calculate_fee(*table, *state, *fill.m_order, fill.m_report));
+        }
+      };
+    });
+}
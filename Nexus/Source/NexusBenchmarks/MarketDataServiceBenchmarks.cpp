@@ -0,0 +1,131 @@
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Nexus/Definitions/StandardVenues.hpp"
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/MarketDataService/LocalHistoricalDataStore.hpp"
+#include "Nexus/MarketDataService/MarketDataRegistry.hpp"
+#include "Nexus/MarketDataService/TickerEntry.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+using namespace Nexus::Venues;
+
+namespace {
+  const auto TST = parse_ticker("TST.TSX");
+  const auto TIMESTAMP = time_from_string("2025-08-14 09:30:00");
+  const auto THREAD_COUNT = 4;
+  const auto TICKER_COUNT = 16;
+
+  auto make_bbo_quotes(std::int64_t count) {
+    auto generator = make_generator();
+    auto quotes = std::vector<BboQuote>();
+    quotes.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto bid = Money::ONE + static_cast<int>(generator() % 50) * Money::CENT;
+      quotes.push_back(BboQuote(make_bid(bid, 100 * (1 + generator() % 10)),
+        make_ask(bid + Money::CENT, 100 * (1 + generator() % 10)),
+        TIMESTAMP + microseconds(i)));
+    }
+    return quotes;
+  }
+
+  auto make_book_quotes(std::int64_t count) {
+    auto generator = make_generator();
+    auto quotes = std::vector<BookQuote>();
+    quotes.reserve(count);
+    auto mpids = std::vector<std::string>{"MP1", "MP2", "MP3", "MP4"};
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto price =
+        Money::ONE + static_cast<int>(generator() % 20) * Money::CENT;
+      auto size = static_cast<Quantity>(100 * (generator() % 5));
+      auto side = generator() % 2 == 0 ? Side::BID : Side::ASK;
+      quotes.push_back(BookQuote(mpids[generator() % mpids.size()], false, TSX,
+        Quote(price, size, side), TIMESTAMP + microseconds(i)));
+    }
+    return quotes;
+  }
+
+  auto make_tickers() {
+    auto tickers = std::vector<Ticker>();
+    for(auto i = 0; i != TICKER_COUNT; ++i) {
+      tickers.push_back(Ticker("T" + std::to_string(i), TSX));
+    }
+    return tickers;
+  }
+
+  const auto TICKER_ENTRY_PUBLISH_BBO_QUOTE = register_benchmark(
+    "TickerEntry/publish_bbo_quote", 200000, [] (std::int64_t iterations) {
+      auto entry = std::make_shared<TickerEntry>(
+        TST, Money::ONE, TickerEntry::InitialSequences());
+      return [entry, quotes = make_bbo_quotes(iterations)] {
+        for(auto& quote : quotes) {
+          do_not_optimize(entry->publish(quote, 1));
+        }
+      };
+    });
+
+  const auto TICKER_ENTRY_BOOK_QUOTE_REPLAY = register_benchmark(
+    "TickerEntry/book_quote_replay", 200000, [] (std::int64_t iterations) {
+      auto entry = std::make_shared<TickerEntry>(
+        TST, Money::ONE, TickerEntry::InitialSequences());
+      return [entry, quotes = make_book_quotes(iterations)] {
+        for(auto& quote : quotes) {
+          do_not_optimize(entry->publish(quote, 1));
+        }
+      };
+    });
+
+  const auto TICKER_ENTRY_LOAD_SNAPSHOT = register_benchmark(
+    "TickerEntry/load_snapshot", 20000, [] (std::int64_t iterations) {
+      auto entry = std::make_shared<TickerEntry>(
+        TST, Money::ONE, TickerEntry::InitialSequences());
+      for(auto& quote : make_book_quotes(1000)) {
+        entry->publish(quote, 1);
+      }
+      return [entry, iterations] {
+        for(auto i = std::int64_t(0); i != iterations; ++i) {
+          do_not_optimize(entry->load_snapshot());
+        }
+      };
+    });
+
+  const auto MARKET_DATA_REGISTRY_PUBLISH_CONTENDED = register_benchmark(
+    "MarketDataRegistry/publish_bbo_quote_contended", 200000,
+    [] (std::int64_t iterations) {
+      auto data_store = std::make_shared<LocalHistoricalDataStore>();
+      auto registry = std::make_shared<MarketDataRegistry>(TICKER_COUNT);
+      auto tickers = make_tickers();
+      for(auto& ticker : tickers) {
+        registry->publish(TickerBboQuote(BboQuote(make_bid(Money::ONE, 100),
+          make_ask(Money::ONE + Money::CENT, 100), TIMESTAMP), ticker), 1,
+          *data_store, [] (const auto&) {});
+      }
+      auto quotes = std::vector<TickerBboQuote>();
+      auto i = std::size_t(0);
+      for(auto& quote : make_bbo_quotes(iterations)) {
+        quotes.push_back(TickerBboQuote(quote, tickers[i % tickers.size()]));
+        ++i;
+      }
+      return [data_store, registry, quotes = std::move(quotes)] {
+        auto threads = std::vector<std::thread>();
+        for(auto t = 0; t != THREAD_COUNT; ++t) {
+          threads.emplace_back([&, t] {
+            for(auto j = t; j < static_cast<int>(quotes.size());
+                j += THREAD_COUNT) {
+              registry->publish(quotes[j], 1, *data_store,
+                [] (const auto& quote) {
+                  do_not_optimize(quote);
+                });
+            }
+          });
+        }
+        for(auto& thread : threads) {
+          thread.join();
+        }
+      };
+    });
+}
@@ -0,0 +1,68 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <Beam/Queries/AndExpression.hpp>
+#include <Beam/Queries/ConstantExpression.hpp>
+#include <Beam/Queries/NotExpression.hpp>
+#include <Beam/Queries/OrExpression.hpp>
+#include <Beam/Queries/StandardFunctionExpressions.hpp>
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+#include "Nexus/Queries/CompiledFilter.hpp"
+#include "Nexus/Queries/EvaluatorTranslator.hpp"
+#include "Nexus/Queries/TimeAndSaleAccessor.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+
+namespace {
+  Expression make_filter() {
+    auto accessor = TimeAndSaleAccessor::from_parameter(0);
+    return OrExpression(
+      AndExpression(accessor.get_price() > ConstantExpression(Money::ONE),
+        NotExpression(accessor.get_market_center() ==
+          ConstantExpression(std::string("CHX")))),
+      accessor.get_market_center() == ConstantExpression(std::string("NEO")));
+  }
+
+  auto make_time_and_sales(std::int64_t count) {
+    auto generator = make_generator();
+    auto timestamp = time_from_string("2025-08-14 09:30:00");
+    auto market_centers = std::vector<std::string>{"TSX", "CHX", "NEO"};
+    auto time_and_sales = std::vector<TimeAndSale>();
+    time_and_sales.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto price =
+        Money::ONE + (static_cast<int>(generator() % 3) - 1) * Money::CENT;
+      time_and_sales.push_back(TimeAndSale(timestamp + microseconds(i), price,
+        100, TimeAndSale::Condition(),
+        market_centers[generator() % market_centers.size()], "", ""));
+    }
+    return time_and_sales;
+  }
+
+  const auto QUERY_FILTER_COMPILED = register_benchmark(
+    "QueryFilter/time_and_sale_compiled", 500000,
+    [] (std::int64_t iterations) {
+      auto filter = std::make_shared<QueryFilter<TimeAndSale>>(make_filter());
+      return [filter, time_and_sales = make_time_and_sales(iterations)] {
+        for(auto& time_and_sale : time_and_sales) {
+          do_not_optimize((*filter)(time_and_sale));
+        }
+      };
+    });
+
+  const auto QUERY_FILTER_INTERPRETED = register_benchmark(
+    "QueryFilter/time_and_sale_interpreted", 500000,
+    [] (std::int64_t iterations) {
+      auto evaluator = std::shared_ptr<Evaluator>(
+        translate<EvaluatorTranslator>(make_filter()));
+      return [evaluator, time_and_sales = make_time_and_sales(iterations)] {
+        for(auto& time_and_sale : time_and_sales) {
+          do_not_optimize(test_filter(*evaluator, time_and_sale));
+        }
+      };
+    });
+}
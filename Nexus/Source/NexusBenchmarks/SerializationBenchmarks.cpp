@@ -0,0 +1,67 @@
+#include <vector>
+#include <Beam/IO/SharedBuffer.hpp>
+#include <Beam/Serialization/BinaryReceiver.hpp>
+#include <Beam/Serialization/BinarySender.hpp>
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/MarketDataService/TickerQuery.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+
+namespace {
+  auto make_quotes(std::int64_t count) {
+    auto generator = make_generator();
+    auto ticker = parse_ticker("TST.TSX");
+    auto timestamp = time_from_string("2025-08-14 09:30:00");
+    auto quotes = std::vector<SequencedTickerBboQuote>();
+    quotes.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto bid = Money::ONE + static_cast<int>(generator() % 50) * Money::CENT;
+      quotes.push_back(SequencedTickerBboQuote(TickerBboQuote(BboQuote(
+        make_bid(bid, 100), make_ask(bid + Money::CENT, 100),
+        timestamp + microseconds(i)), ticker), Beam::Sequence(i + 1)));
+    }
+    return quotes;
+  }
+
+  const auto SEQUENCED_TICKER_BBO_QUOTE_SEND = register_benchmark(
+    "Serialization/send_sequenced_ticker_bbo_quote", 200000,
+    [] (std::int64_t iterations) {
+      return [quotes = make_quotes(iterations)] {
+        auto buffer = SharedBuffer();
+        auto sender = BinarySender<SharedBuffer>();
+        for(auto& quote : quotes) {
+          reset(buffer);
+          sender.set(Ref(buffer));
+          sender.shuttle(quote);
+          do_not_optimize(buffer);
+        }
+      };
+    });
+
+  const auto SEQUENCED_TICKER_BBO_QUOTE_RECEIVE = register_benchmark(
+    "Serialization/receive_sequenced_ticker_bbo_quote", 200000,
+    [] (std::int64_t iterations) {
+      auto buffers = std::vector<SharedBuffer>();
+      buffers.reserve(iterations);
+      auto sender = BinarySender<SharedBuffer>();
+      for(auto& quote : make_quotes(iterations)) {
+        auto& buffer = buffers.emplace_back();
+        sender.set(Ref(buffer));
+        sender.shuttle(quote);
+      }
+      return [buffers = std::move(buffers)] {
+        auto receiver = BinaryReceiver<SharedBuffer>();
+        auto quote = SequencedTickerBboQuote();
+        for(auto& buffer : buffers) {
+          receiver.set(Ref(buffer));
+          receiver.shuttle(quote);
+          do_not_optimize(quote);
+        }
+      };
+    });
+}
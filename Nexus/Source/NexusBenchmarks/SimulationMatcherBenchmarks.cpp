@@ -0,0 +1,82 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <Beam/TimeService/FixedTimeClient.hpp>
+#include "Nexus/Definitions/BookQuote.hpp"
+#include "Nexus/Definitions/StandardVenues.hpp"
+#include "Nexus/Definitions/Ticker.hpp"
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+#include "Nexus/SimulationMatcher/TickerOrderSimulator.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+using namespace Nexus::Venues;
+
+namespace {
+  using Simulator = TickerOrderSimulator<FixedTimeClient>;
+
+  const auto ABX = parse_ticker("ABX.TSX");
+  const auto TIMESTAMP = time_from_string("2025-08-14 09:30:00");
+  const auto LEVEL_COUNT = 10;
+  const auto ORDERS_PER_LEVEL = 4;
+
+  auto make_simulator() {
+    auto reports = std::make_shared<SimulationExecutionReportQueue>();
+    auto simulator =
+      std::make_shared<Simulator>(ABX, FixedTimeClient(TIMESTAMP), reports);
+    auto snapshot = TickerSnapshot(ABX);
+    snapshot.m_bbo_quote = SequencedBboQuote(BboQuote(
+      make_bid(Money::ONE, 100), make_ask(Money::ONE + Money::CENT, 100),
+      TIMESTAMP), Beam::Sequence(1));
+    simulator->initialize(snapshot);
+    auto id = OrderId(1);
+    for(auto level = 0; level != LEVEL_COUNT; ++level) {
+      for(auto i = 0; i != ORDERS_PER_LEVEL; ++i) {
+        for(auto side : {Side::BID, Side::ASK}) {
+          auto price = side == Side::BID ?
+            Money::ONE - level * Money::CENT :
+            Money::ONE + (level + 1) * Money::CENT;
+          auto info = OrderInfo();
+          info.m_fields = make_limit_order_fields(ABX, side, 100, price);
+          info.m_id = id;
+          info.m_timestamp = TIMESTAMP;
+          simulator->submit(std::make_shared<PrimitiveOrder>(info));
+          ++id;
+        }
+      }
+    }
+    reports->flush();
+    return simulator;
+  }
+
+  auto make_book_quotes(std::int64_t count) {
+    auto generator = make_generator();
+    auto mpids = std::vector<std::string>{"MP1", "MP2", "MP3", "MP4"};
+    auto quotes = std::vector<BookQuote>();
+    quotes.reserve(count);
+    for(auto i = std::int64_t(0); i != count; ++i) {
+      auto level = static_cast<int>(generator() % LEVEL_COUNT);
+      auto side = generator() % 2 == 0 ? Side::BID : Side::ASK;
+      auto price = side == Side::BID ? Money::ONE - level * Money::CENT :
+        Money::ONE + (level + 1) * Money::CENT;
+      auto size = static_cast<Quantity>(100 * (generator() % 5));
+      quotes.push_back(BookQuote(mpids[generator() % mpids.size()], false, TSX,
+        Quote(price, size, side), TIMESTAMP));
+    }
+    return quotes;
+  }
+
+  const auto TICKER_ORDER_SIMULATOR_BOOK_QUOTE_REPLAY = register_benchmark(
+    "TickerOrderSimulator/book_quote_replay", 200000,
+    [] (std::int64_t iterations) {
+      return [simulator = make_simulator(),
+          quotes = make_book_quotes(iterations)] {
+        for(auto& quote : quotes) {
+          simulator->update(quote);
+        }
+      };
+    });
+}
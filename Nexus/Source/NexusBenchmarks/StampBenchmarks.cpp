@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+#include "Nexus/Stamp/StampScanning.hpp"
+
+using namespace Beam;
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+
+namespace {
+  const auto FIELD_COUNT = 24;
+
+  std::string make_message() {
+    auto generator = make_generator();
+    auto message = std::string();
+    for(auto i = 0; i != FIELD_COUNT; ++i) {
+      if(i != 0) {
+        message += STAMP_FIELD_SEPARATOR;
+      }
+      message += std::to_string(1000 + i) + '=';
+      auto length = 1 + generator() % 24;
+      for(auto j = 0u; j != length; ++j) {
+        message += static_cast<char>('A' + generator() % 26);
+      }
+    }
+    message += STAMP_END_TOKEN;
+    return message;
+  }
+
+  auto make_digits(std::int64_t count) {
+    auto generator = make_generator();
+    auto digits = std::string();
+    digits.reserve(8 * count);
+    for(auto i = std::int64_t(0); i != 8 * count; ++i) {
+      digits += static_cast<char>('0' + generator() % 10);
+    }
+    return digits;
+  }
+
+  template<typename F>
+  auto scan_fields(std::int64_t iterations, F find) {
+    return [message = make_message(), iterations, find] {
+      auto last = message.data() + message.size();
+      for(auto i = std::int64_t(0); i != iterations; ++i) {
+        auto first = message.data();
+        while(first != last) {
+          first = find(first, last);
+          do_not_optimize(first);
+          if(first != last) {
+            ++first;
+          }
+        }
+      }
+    };
+  }
+
+  const auto FIND_STAMP_DELIMITER = register_benchmark(
+    "Stamp/find_stamp_delimiter", 100000, [] (std::int64_t iterations) {
+      return scan_fields(iterations, &find_stamp_delimiter);
+    });
+
+  const auto FIND_STAMP_DELIMITER_SCALAR = register_benchmark(
+    "Stamp/find_stamp_delimiter_scalar", 100000,
+    [] (std::int64_t iterations) {
+      return scan_fields(iterations, &Details::find_stamp_delimiter_scalar);
+    });
+
+  const auto PARSE_STAMP_DIGITS = register_benchmark(
+    "Stamp/parse_stamp_digits", 1000000, [] (std::int64_t iterations) {
+      return [digits = make_digits(iterations), iterations] {
+        auto value = std::uint32_t();
+        for(auto i = std::int64_t(0); i != iterations; ++i) {
+          do_not_optimize(parse_stamp_digits<8>(digits.data() + 8 * i,
+            out(value)));
+          do_not_optimize(value);
+        }
+      };
+    });
+}
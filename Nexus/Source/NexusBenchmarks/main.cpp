@@ -0,0 +1,54 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Nexus/NexusBenchmarks/Benchmark.hpp"
+
+using namespace Nexus;
+using namespace Nexus::Benchmarks;
+
+int main(int argc, const char** argv) {
+  auto filter = std::string();
+  auto samples = 5;
+  auto output = std::string();
+  for(auto i = 1; i < argc; ++i) {
+    auto argument = std::string_view(argv[i]);
+    if(argument.starts_with("--filter=")) {
+      filter = argument.substr(9);
+    } else if(argument.starts_with("--samples=")) {
+      samples = std::stoi(std::string(argument.substr(10)));
+    } else if(argument.starts_with("--output=")) {
+      output = argument.substr(9);
+    } else {
+      std::cerr << "Usage: " << argv[0] <<
+        " [--filter=<substring>] [--samples=<count>] [--output=<path>]\n";
+      return 1;
+    }
+  }
+  auto benchmarks = get_benchmarks();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+    [] (const auto& left, const auto& right) {
+      return left.m_name < right.m_name;
+    });
+  auto results = std::vector<BenchmarkResult>();
+  for(auto& benchmark : benchmarks) {
+    if(benchmark.m_name.find(filter) == std::string::npos) {
+      continue;
+    }
+    std::cerr << benchmark.m_name << std::endl;
+    results.push_back(run(benchmark, samples));
+  }
+  if(output.empty()) {
+    write_json(std::cout, results);
+  } else {
+    auto file = std::ofstream(output);
+    write_json(file, results);
+    if(!file) {
+      std::cerr << "Unable to write " << output << ".\n";
+      return 1;
+    }
+  }
+  return 0;
+}
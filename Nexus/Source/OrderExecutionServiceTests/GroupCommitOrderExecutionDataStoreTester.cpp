@@ -0,0 +1,173 @@
+#include <stdexcept>
+#include <Beam/TimeService/TriggerTimer.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/OrderExecutionService/GroupCommitOrderExecutionDataStore.hpp"
+#include "Nexus/OrderExecutionService/LocalOrderExecutionDataStore.hpp"
+#include "Nexus/OrderExecutionServiceTests/OrderExecutionDataStoreTestSuite.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+using namespace Nexus::Currencies;
+using namespace Nexus::Tests;
+
+namespace {
+  struct Builder {
+    auto operator ()() const {
+      return GroupCommitOrderExecutionDataStore<LocalOrderExecutionDataStore>(
+        init(), 100, std::make_unique<Timer>(std::in_place_type<TriggerTimer>));
+    }
+  };
+
+  struct FailingDataStore {
+    LocalOrderExecutionDataStore m_data_store;
+    bool m_is_failing = false;
+
+    boost::optional<SequencedAccountOrderRecord> load_order_record(
+        OrderId id) {
+      return m_data_store.load_order_record(id);
+    }
+
+    std::vector<SequencedOrderRecord> load_order_records(
+        const AccountQuery& query) {
+      return m_data_store.load_order_records(query);
+    }
+
+    void store(const SequencedAccountOrderInfo& info) {
+      store(std::vector{info});
+    }
+
+    void store(const std::vector<SequencedAccountOrderInfo>& info) {
+      if(m_is_failing) {
+        throw std::runtime_error("Store failed.");
+      }
+      m_data_store.store(info);
+    }
+
+    std::vector<SequencedExecutionReport> load_execution_reports(
+        const AccountQuery& query) {
+      return m_data_store.load_execution_reports(query);
+    }
+
+    void store(const SequencedAccountExecutionReport& report) {
+      store(std::vector{report});
+    }
+
+    void store(const std::vector<SequencedAccountExecutionReport>& reports) {
+      if(m_is_failing) {
+        throw std::runtime_error("Store failed.");
+      }
+      m_data_store.store(reports);
+    }
+
+    InventorySnapshot load_inventory_snapshot(const DirectoryEntry& account) {
+      return m_data_store.load_inventory_snapshot(account);
+    }
+
+    void store(
+        const DirectoryEntry& account, const InventorySnapshot& snapshot) {
+      m_data_store.store(account, snapshot);
+    }
+
+    void close() {
+      m_data_store.close();
+    }
+  };
+
+  auto make_info(const DirectoryEntry& account, OrderId id) {
+    auto fields = make_limit_order_fields(account, parse_ticker("TST.TSX"),
+      CAD, Side::BID, "TSX", 100, Money::ONE);
+    return SequencedAccountOrderInfo(IndexedValue(
+      OrderInfo(fields, id, time_from_string("2024-07-17 10:00:00")), account),
+      Beam::Sequence(id));
+  }
+}
+
+TEST_SUITE("GroupCommitOrderExecutionDataStore") {
+  TEST_CASE_TEMPLATE_INVOKE(OrderExecutionDataStoreTestSuite, Builder);
+
+  TEST_CASE("commit_batch") {
+    auto account = DirectoryEntry::make_account(123, "user_a");
+    auto timer = TriggerTimer();
+    auto committed_data_store = LocalOrderExecutionDataStore();
+    auto data_store = GroupCommitOrderExecutionDataStore(
+      &committed_data_store, 3, std::make_unique<Timer>(&timer));
+    data_store.store(make_info(account, 1));
+    auto report = ExecutionReport(1, time_from_string("2024-07-17 10:00:00"));
+    data_store.store(SequencedAccountExecutionReport(
+      IndexedValue(report, account), Beam::Sequence(2)));
+    REQUIRE(!committed_data_store.load_order_record(1));
+    auto record = data_store.load_order_record(1);
+    REQUIRE(record);
+    REQUIRE((**record)->m_execution_reports.size() == 1);
+    data_store.store(make_info(account, 3));
+    data_store.store(make_info(account, 4));
+    auto query = AccountQuery();
+    query.set_index(account);
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::from_tail(2));
+    auto records = data_store.load_order_records(query);
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].get_sequence() == Beam::Sequence(3));
+    REQUIRE(records[1].get_sequence() == Beam::Sequence(4));
+    data_store.close();
+    REQUIRE(committed_data_store.load_order_submissions().size() == 3);
+    REQUIRE(committed_data_store.load_execution_reports().size() == 1);
+  }
+
+  TEST_CASE("commit_full_batch") {
+    auto account = DirectoryEntry::make_account(123, "user_a");
+    auto timer = TriggerTimer();
+    auto committed_data_store = LocalOrderExecutionDataStore();
+    auto data_store = GroupCommitOrderExecutionDataStore(
+      &committed_data_store, 3, std::make_unique<Timer>(&timer));
+    data_store.store(make_info(account, 1));
+    data_store.store(make_info(account, 2));
+    flush_pending_routines();
+    REQUIRE(committed_data_store.load_order_submissions().empty());
+    data_store.store(make_info(account, 3));
+    flush_pending_routines();
+    REQUIRE(committed_data_store.load_order_submissions().size() == 3);
+    data_store.close();
+  }
+
+  TEST_CASE("retry_failed_commit") {
+    auto account = DirectoryEntry::make_account(123, "user_a");
+    auto timer = TriggerTimer();
+    auto committed_data_store = FailingDataStore();
+    committed_data_store.m_is_failing = true;
+    auto data_store = GroupCommitOrderExecutionDataStore(
+      &committed_data_store, 2, std::make_unique<Timer>(&timer));
+    data_store.store(make_info(account, 1));
+    auto report = ExecutionReport(1, time_from_string("2024-07-17 10:00:00"));
+    data_store.store(SequencedAccountExecutionReport(
+      IndexedValue(report, account), Beam::Sequence(2)));
+    flush_pending_routines();
+    REQUIRE(committed_data_store.m_data_store.load_order_submissions().empty());
+    auto record = data_store.load_order_record(1);
+    REQUIRE(record);
+    REQUIRE((**record)->m_execution_reports.size() == 1);
+    REQUIRE_THROWS(data_store.store(account, InventorySnapshot()));
+    data_store.store(make_info(account, 3));
+    committed_data_store.m_is_failing = false;
+    timer.trigger();
+    flush_pending_routines();
+    REQUIRE(
+      committed_data_store.m_data_store.load_order_submissions().size() == 2);
+    REQUIRE(
+      committed_data_store.m_data_store.load_execution_reports().size() == 1);
+    data_store.close();
+  }
+
+  TEST_CASE("close_with_failed_commit") {
+    auto account = DirectoryEntry::make_account(123, "user_a");
+    auto timer = TriggerTimer();
+    auto committed_data_store = FailingDataStore();
+    committed_data_store.m_is_failing = true;
+    auto data_store = GroupCommitOrderExecutionDataStore(
+      &committed_data_store, 100, std::make_unique<Timer>(&timer));
+    data_store.store(make_info(account, 1));
+    REQUIRE_THROWS(data_store.close());
+  }
+}
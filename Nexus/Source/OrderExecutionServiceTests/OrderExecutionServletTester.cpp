@@ -1,6 +1,9 @@
 #include <algorithm>
+#include <atomic>
 #include <future>
+#include <stdexcept>
 #include <type_traits>
+#include <variant>
 #include <Beam/IO/LocalClientChannel.hpp>
 #include <Beam/Queues/Queue.hpp>
 #include <Beam/ServiceLocator/SessionAuthenticator.hpp>
@@ -35,6 +38,21 @@ using namespace Nexus::Venues;
 namespace {
   const auto TST = parse_ticker("TST.TSX");
 
+  struct FailingDataStore : LocalOrderExecutionDataStore {
+    std::atomic_bool m_is_failing = false;
+    std::atomic_int m_failure_count = 0;
+
+    using LocalOrderExecutionDataStore::store;
+
+    void store(const std::vector<SequencedAccountExecutionReport>& reports) {
+      if(m_is_failing) {
+        ++m_failure_count;
+        throw std::runtime_error("Store failed.");
+      }
+      LocalOrderExecutionDataStore::store(reports);
+    }
+  };
+
   template<typename D = LocalOrderExecutionDataStore>
   struct Fixture {
     using DataStore = D;
@@ -202,6 +220,30 @@ TEST_SUITE("OrderExecutionServlet") {
       fixture.m_client_account) == InventorySnapshot());
   }
 
+  TEST_CASE("retry_failed_execution_report_store") {
+    auto fixture = Fixture<FailingDataStore>();
+    fixture.start();
+    fixture.m_data_store.m_is_failing = true;
+    auto first_order = submit_and_fill(fixture,
+      make_limit_order_fields(TST, CAD, Side::BID, "TSX", 100, Money::ONE));
+    while(fixture.m_data_store.m_failure_count == 0) {}
+    fixture.m_data_store.m_is_failing = false;
+    auto second_order = submit_and_fill(fixture,
+      make_limit_order_fields(TST, CAD, Side::BID, "TSX", 200, Money::ONE));
+    fixture.m_container->close();
+    auto query = AccountQuery();
+    query.set_index(fixture.m_client_account);
+    query.set_range(Range::TOTAL);
+    query.set_snapshot_limit(SnapshotLimit::UNLIMITED);
+    auto reports = fixture.m_data_store.load_execution_reports(query);
+    for(auto& order : {first_order, second_order}) {
+      REQUIRE(std::ranges::any_of(reports, [&] (const auto& report) {
+        return report->m_id == order->get_info().m_id &&
+          report->m_status == OrderStatus::FILLED;
+      }));
+    }
+  }
+
   TEST_CASE("load_snapshot_on_start") {
     auto fixture = Fixture();
     auto seed = InventorySnapshot();
@@ -712,6 +754,7 @@ TEST_SUITE("OrderExecutionServlet") {
     fill(*driver_order, 100);
     submit_and_fill(fixture,
       make_limit_order_fields(TST, CAD, Side::BID, "TSX", 200, Money::ONE));
+    fixture.m_container->close();
     auto record = data_store.load_order_record(driver_order->get_info().m_id);
     REQUIRE(record);
     auto& reports = (**record)->m_execution_reports;
@@ -720,4 +763,44 @@ TEST_SUITE("OrderExecutionServlet") {
     REQUIRE(reports[1].m_status == OrderStatus::NEW);
     REQUIRE(reports[2].m_status == OrderStatus::FILLED);
   }
+
+  TEST_CASE("publish_reports_while_store_is_held") {
+    auto operations = std::make_shared<TestOrderExecutionDataStore::Queue>();
+    auto data_store = LocalOrderExecutionDataStore();
+    auto held = std::make_shared<TestOrderExecutionDataStore::Queue>();
+    auto store_count = std::atomic_int(0);
+    auto servicer = std::async(std::launch::async, [&] {
+      try {
+        while(true) {
+          auto operation = operations->pop();
+          if(std::holds_alternative<
+              TestOrderExecutionDataStore::StoreExecutionReportListOperation>(
+                *operation)) {
+            ++store_count;
+            if(store_count == 1) {
+              held->push(operation);
+              continue;
+            }
+          }
+          service(*operation, data_store);
+        }
+      } catch(const std::exception&) {}
+    });
+    auto fixture = Fixture<TestOrderExecutionDataStore>(operations);
+    fixture.start();
+    auto first = submit_and_fill(fixture,
+      make_limit_order_fields(TST, CAD, Side::BID, "TSX", 100, Money::ONE));
+    auto second = submit_and_fill(fixture,
+      make_limit_order_fields(TST, CAD, Side::BID, "TSX", 200, Money::ONE));
+    service(*held->pop(), data_store);
+    fixture.m_container->close();
+    REQUIRE(store_count == 2);
+    for(auto& order : {first, second}) {
+      auto record = data_store.load_order_record(order->get_info().m_id);
+      REQUIRE(record);
+      auto& reports = (**record)->m_execution_reports;
+      REQUIRE(reports.size() == 3);
+      REQUIRE(reports.back().m_status == OrderStatus::FILLED);
+    }
+  }
 }
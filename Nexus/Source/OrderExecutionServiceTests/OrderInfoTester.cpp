@@ -34,6 +34,7 @@ TEST_SUITE("OrderInfo") {
     REQUIRE(info.m_id == static_cast<OrderId>(-1));
     REQUIRE(!info.m_shorting_flag);
     REQUIRE(info.m_timestamp == ptime());
+    REQUIRE(info.m_ticker_id == TickerId::NONE);
   }
 
   TEST_CASE("constructor") {
@@ -89,4 +90,15 @@ TEST_SUITE("OrderInfo") {
       " 1.00 DAY []) (ACCOUNT 456 submit) 123 1 2024-May-21 01:02:03)");
     test_round_trip_shuttle(info);
   }
+
+  TEST_CASE("ticker_id") {
+    auto fields = make_test_order_fields();
+    auto info = OrderInfo(fields, OrderId(123), ptime());
+    REQUIRE(get_ticker_id(info) == to_ticker_id(fields.m_ticker));
+    auto interned_info = info;
+    interned_info.m_ticker_id = to_ticker_id(fields.m_ticker);
+    REQUIRE(get_ticker_id(interned_info) == interned_info.m_ticker_id);
+    REQUIRE(interned_info == info);
+    test_round_trip_shuttle(interned_info);
+  }
 }
@@ -70,7 +70,8 @@ void Nexus::Python::export_buying_power_model(module& module) {
     def("has_order", &BuyingPowerModel::has_order, arg("id")).
     def(
       "get_buying_power", &BuyingPowerModel::get_buying_power, arg("currency")).
-    def("submit", &BuyingPowerModel::submit, arg("id"), arg("fields"),
+    def("submit", overload_cast<OrderId, const OrderFields&, Money>(
+      &BuyingPowerModel::submit), arg("id"), arg("fields"),
       arg("expected_price")).
     def("update", overload_cast<const ExecutionReport&>(
       &BuyingPowerModel::update), arg("report")).
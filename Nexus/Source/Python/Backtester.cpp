@@ -1,9 +1,11 @@
 #include "Nexus/Python/Backtester.hpp"
 #include <Beam/Python/Beam.hpp>
 #include "Nexus/Backtester/ActiveBacktesterEvent.hpp"
+#include "Nexus/Backtester/BacktestRunner.hpp"
 #include "Nexus/Backtester/BacktesterClients.hpp"
 #include "Nexus/Backtester/BacktesterEnvironment.hpp"
 #include "Nexus/Backtester/BacktesterEventHandler.hpp"
+#include "Nexus/Backtester/MarketDataSlice.hpp"
 #include "Nexus/Python/Clients.hpp"
 #include "Nexus/Python/ToPythonClients.hpp"
 
@@ -28,7 +30,53 @@ void Nexus::Python::export_active_backtester_event(module& module) {
     def(init<ptime>());
 }
 
+void Nexus::Python::export_backtest_runner(module& module) {
+  class_<MarketDataSlice>(module, "MarketDataSlice").
+    def(init([] (const std::string& root) {
+      return MarketDataSlice(root);
+    })).
+    def(init<HistoricalDataStore>());
+  class_<BacktestScenario>(module, "BacktestScenario").
+    def(init()).
+    def(init([] (std::string name, ptime start, ptime end,
+        std::function<void (BacktesterEnvironment&)> strategy) {
+      return BacktestScenario(
+        std::move(name), start, end, std::move(strategy));
+    })).
+    def_readwrite("name", &BacktestScenario::m_name).
+    def_readwrite("start", &BacktestScenario::m_start).
+    def_readwrite("end", &BacktestScenario::m_end).
+    def_readwrite("strategy", &BacktestScenario::m_strategy);
+  class_<BacktestResult>(module, "BacktestResult").
+    def(init()).
+    def_readwrite("name", &BacktestResult::m_name).
+    def_readwrite("portfolio", &BacktestResult::m_portfolio).
+    def_readwrite("error", &BacktestResult::m_error).
+    def_readwrite("run_time", &BacktestResult::m_run_time);
+  class_<BacktestSummary>(module, "BacktestSummary").
+    def(init()).
+    def_readwrite("name", &BacktestSummary::m_name).
+    def_readwrite("currency", &BacktestSummary::m_currency).
+    def_readwrite("realized_profit_and_loss",
+      &BacktestSummary::m_realized_profit_and_loss).
+    def_readwrite("unrealized_profit_and_loss",
+      &BacktestSummary::m_unrealized_profit_and_loss).
+    def_readwrite("fees", &BacktestSummary::m_fees).
+    def_readwrite("volume", &BacktestSummary::m_volume).
+    def_readwrite("transaction_count", &BacktestSummary::m_transaction_count).
+    def_readwrite("error", &BacktestSummary::m_error).
+    def_readwrite("run_time", &BacktestSummary::m_run_time);
+  class_<BacktestRunner>(module, "BacktestRunner").
+    def(init<MarketDataSlice>()).
+    def(init<MarketDataSlice, std::size_t>()).
+    def_property_readonly("concurrency", &BacktestRunner::get_concurrency).
+    def("run", overload_cast<const std::vector<BacktestScenario>&>(
+      &BacktestRunner::run), call_guard<GilRelease>());
+  module.def("summarize", &summarize);
+}
+
 void Nexus::Python::export_backtester(module& module) {
+  export_backtest_runner(module);
   export_backtester_clients(module);
   export_backtester_environment(module);
   export_backtester_event(module);
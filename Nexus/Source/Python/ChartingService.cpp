@@ -47,8 +47,8 @@ void Nexus::Python::export_charting_service_test_environment(module& module) {
       std::shared_ptr<ChartingServiceTestEnvironment>>(module,
         "ChartingServiceTestEnvironment").
     def(pybind11::init(&make_python_shared<ChartingServiceTestEnvironment,
-      ServiceLocatorClient&, MarketDataClient&>), keep_alive<1, 2>(),
-      keep_alive<1, 3>()).
+      ServiceLocatorClient&, MarketDataClient&, TimeClient&>),
+      keep_alive<1, 2>(), keep_alive<1, 3>()).
     def("make_client",
       [] (ChartingServiceTestEnvironment& self, ServiceLocatorClient& client) {
         return ToPythonChartingClient(self.make_client(Ref(client)));
@@ -0,0 +1,99 @@
+#include <Beam/Queries/AndExpression.hpp>
+#include <Beam/Queries/ConstantExpression.hpp>
+#include <Beam/Queries/NotExpression.hpp>
+#include <Beam/Queries/OrExpression.hpp>
+#include <Beam/Queries/StandardFunctionExpressions.hpp>
+#include <doctest/doctest.h>
+#include "Nexus/Queries/BboQuoteAccessor.hpp"
+#include "Nexus/Queries/BookQuoteAccessor.hpp"
+#include "Nexus/Queries/CompiledFilter.hpp"
+#include "Nexus/Queries/OrderInfoAccessor.hpp"
+#include "Nexus/Queries/QuoteAccessor.hpp"
+#include "Nexus/Queries/TimeAndSaleAccessor.hpp"
+
+using namespace Beam;
+using namespace boost;
+using namespace boost::posix_time;
+using namespace Nexus;
+
+namespace {
+  auto make_time_and_sale(Money price, const std::string& market_center) {
+    return TimeAndSale(time_from_string("2026-05-08 09:30:00"), price, 100,
+      TimeAndSale::Condition(), market_center, "", "");
+  }
+}
+
+TEST_SUITE("CompiledFilter") {
+  TEST_CASE("constant") {
+    auto filter = QueryFilter<TimeAndSale>(ConstantExpression(false));
+    REQUIRE(filter.is_compiled());
+    REQUIRE(!filter(make_time_and_sale(Money::ONE, "TSX")));
+  }
+
+  TEST_CASE("time_and_sale_market_center") {
+    auto filter = QueryFilter<TimeAndSale>(
+      TimeAndSaleAccessor::from_parameter(0).get_market_center() ==
+        ConstantExpression(std::string("TSX")));
+    REQUIRE(filter.is_compiled());
+    REQUIRE(filter(make_time_and_sale(Money::ONE, "TSX")));
+    REQUIRE(!filter(make_time_and_sale(Money::ONE, "CHX")));
+  }
+
+  TEST_CASE("reversed_comparison") {
+    auto filter = QueryFilter<TimeAndSale>(ConstantExpression(Money::ONE) <
+      TimeAndSaleAccessor::from_parameter(0).get_price());
+    REQUIRE(filter.is_compiled());
+    REQUIRE(filter(make_time_and_sale(2 * Money::ONE, "TSX")));
+    REQUIRE(!filter(make_time_and_sale(Money::ONE, "TSX")));
+  }
+
+  TEST_CASE("bbo_quote_bid_price") {
+    auto filter = QueryFilter<BboQuote>(
+      QuoteAccessor(BboQuoteAccessor::from_parameter(0).get_bid()).
+        get_price() >= ConstantExpression(Money::ONE));
+    REQUIRE(filter.is_compiled());
+    auto timestamp = time_from_string("2026-05-08 09:30:00");
+    REQUIRE(filter(BboQuote(make_bid(Money::ONE, 100),
+      make_ask(2 * Money::ONE, 100), timestamp)));
+    REQUIRE(!filter(BboQuote(make_bid(Money::ONE - Money::CENT, 100),
+      make_ask(2 * Money::ONE, 100), timestamp)));
+  }
+
+  TEST_CASE("logical_operators") {
+    auto accessor = TimeAndSaleAccessor::from_parameter(0);
+    auto filter = QueryFilter<TimeAndSale>(OrExpression(
+      AndExpression(accessor.get_price() > ConstantExpression(Money::ONE),
+        NotExpression(accessor.get_market_center() ==
+          ConstantExpression(std::string("CHX")))),
+      accessor.get_market_center() == ConstantExpression(std::string("NEO"))));
+    REQUIRE(filter.is_compiled());
+    REQUIRE(filter(make_time_and_sale(2 * Money::ONE, "TSX")));
+    REQUIRE(!filter(make_time_and_sale(2 * Money::ONE, "CHX")));
+    REQUIRE(!filter(make_time_and_sale(Money::ONE, "TSX")));
+    REQUIRE(filter(make_time_and_sale(Money::ONE, "NEO")));
+  }
+
+  TEST_CASE("order_info_shorting_flag") {
+    auto filter = QueryFilter<OrderInfo>(
+      OrderInfoAccessor::from_parameter(0).get_shorting_flag() ==
+        ConstantExpression(true));
+    REQUIRE(filter.is_compiled());
+    auto info = OrderInfo();
+    info.m_shorting_flag = true;
+    REQUIRE(filter(info));
+    info.m_shorting_flag = false;
+    REQUIRE(!filter(info));
+  }
+
+  TEST_CASE("interpreted_fallback") {
+    auto filter = QueryFilter<BookQuote>(
+      BookQuoteAccessor::from_parameter(0).get_mpid() ==
+        ConstantExpression(std::string("MM01")));
+    REQUIRE(!filter.is_compiled());
+    auto timestamp = time_from_string("2026-05-08 09:30:00");
+    REQUIRE(filter(BookQuote("MM01", true, Venues::TSX,
+      make_bid(Money::ONE, 100), timestamp)));
+    REQUIRE(!filter(BookQuote("MM02", true, Venues::TSX,
+      make_bid(Money::ONE, 100), timestamp)));
+  }
+}
@@ -995,6 +995,34 @@ TEST_SUITE("TickerOrderSimulator") {
     REQUIRE(report.m_last_quantity == 100);
   }
 
+  TEST_CASE("book_quote_advances_every_order_at_the_level") {
+    auto fixture = Fixture();
+    auto simulator = make_simulator(fixture);
+    simulator.initialize(
+      make_snapshot(parse_money("1.00"), parse_money("1.01")));
+    publish_book_quote(fixture, simulator, "A", Venues::TSX, Side::BID,
+      parse_money("0.99"), 500);
+    auto first = submit_limit_order(
+      fixture, simulator, 1, Side::BID, 100, parse_money("0.99"), "TSX");
+    auto second = submit_limit_order(
+      fixture, simulator, 2, Side::BID, 100, parse_money("0.99"), "TSX");
+    auto first_reports = monitor_reports(first);
+    auto second_reports = monitor_reports(second);
+    fixture.m_environment.advance(minutes(1));
+    publish_time_and_sale(fixture, simulator, parse_money("0.99"), 200);
+    REQUIRE(!first_reports->try_pop());
+    REQUIRE(!second_reports->try_pop());
+    publish_book_quote(
+      fixture, simulator, "A", Venues::TSX, Side::BID, parse_money("0.99"), 0);
+    publish_time_and_sale(fixture, simulator, parse_money("0.99"), 200);
+    auto report = first_reports->pop();
+    REQUIRE(report.m_status == OrderStatus::FILLED);
+    REQUIRE(report.m_last_quantity == 100);
+    report = second_reports->pop();
+    REQUIRE(report.m_status == OrderStatus::FILLED);
+    REQUIRE(report.m_last_quantity == 100);
+  }
+
   TEST_CASE("book_quote_negative_size") {
     auto fixture = Fixture();
     auto simulator = make_simulator(fixture);
@@ -1,3 +1,5 @@
+#include <array>
+#include <filesystem>
 #include <future>
 #include <Beam/IO/SharedBuffer.hpp>
 #include <Beam/IO/LocalServerConnection.hpp>
@@ -133,4 +135,119 @@ TEST_SUITE("SoupBinTcpClient") {
     REQUIRE(std::string(packet.m_payload, 7) == "PAYLOAD");
     server_future.get();
   }
+
+  TEST_CASE("read_batch") {
+    auto fixture = Fixture();
+    auto server_future = std::async(std::launch::async, [&] {
+      auto buffer = SharedBuffer();
+      fixture.m_server_channel->get_reader().read(out(buffer));
+      auto accepted = make_login_accepted_packet("SESSION", 1);
+      fixture.m_server_channel->get_writer().write(accepted);
+    });
+    auto client = SoupBinTcpClient(
+      "user", "pass", &*fixture.m_client_channel, &fixture.m_timer);
+    server_future.get();
+    auto data = SharedBuffer();
+    append(data, make_data_packet('S', "ONE"));
+    append(data, make_data_packet('S', "TWO"));
+    auto third = make_data_packet('S', "THREE");
+    append(data, third.get_data(), 4);
+    fixture.m_server_channel->get_writer().write(data);
+    auto packets = std::array<SoupBinTcpPacket, 4>();
+    REQUIRE(client.read_batch(packets) == 2);
+    REQUIRE(std::string(packets[0].m_payload, 3) == "ONE");
+    REQUIRE(std::string(packets[1].m_payload, 3) == "TWO");
+    auto rest = SharedBuffer();
+    append(rest, third.get_data() + 4, third.get_size() - 4);
+    append(rest, make_data_packet('S', "FOUR"));
+    fixture.m_server_channel->get_writer().write(rest);
+    auto count = client.read_batch(packets);
+    REQUIRE(std::string(packets[0].m_payload, 5) == "THREE");
+    if(count == 1) {
+      REQUIRE(client.read_batch(packets) == 1);
+      REQUIRE(std::string(packets[0].m_payload, 4) == "FOUR");
+    } else {
+      REQUIRE(count == 2);
+      REQUIRE(std::string(packets[1].m_payload, 4) == "FOUR");
+    }
+  }
+
+  TEST_CASE("resume_from_journal") {
+    auto root =
+      std::filesystem::temp_directory_path() / "nexus_soup_bin_tcp_client";
+    std::filesystem::remove_all(root);
+    auto journal = SoupBinTcpJournal(root);
+    journal.open("SESSION", 1);
+    for(auto payload : {"ONE", "TWO", "THREE"}) {
+      auto packet = SoupBinTcpPacket();
+      packet.m_length = static_cast<std::uint16_t>(1 + std::strlen(payload));
+      packet.m_type = 'S';
+      packet.m_payload = payload;
+      journal.append(journal.get_next_sequence_number(), packet);
+    }
+    journal.close();
+    auto fixture = Fixture();
+    auto server_future = std::async(std::launch::async, [&] {
+      auto buffer = SharedBuffer();
+      fixture.m_server_channel->get_reader().read(out(buffer));
+      auto request = std::string(buffer.get_data(), buffer.get_size());
+      REQUIRE(request.substr(request.size() - 20).find_first_not_of(' ') ==
+        19);
+      REQUIRE(request.back() == '4');
+      auto accepted = make_login_accepted_packet("SESSION", 4);
+      fixture.m_server_channel->get_writer().write(accepted);
+      auto data_packet = make_data_packet('S', "FOUR");
+      fixture.m_server_channel->get_writer().write(data_packet);
+    });
+    auto client = SoupBinTcpClient("user", "pass", "SESSION", 2, Ref(journal),
+      &*fixture.m_client_channel, &fixture.m_timer);
+    server_future.get();
+    auto packets = std::array<SoupBinTcpPacket, 4>();
+    REQUIRE(client.read_batch(packets) == 2);
+    REQUIRE(std::string(packets[0].m_payload, 3) == "TWO");
+    REQUIRE(std::string(packets[1].m_payload, 5) == "THREE");
+    auto packet = client.read();
+    REQUIRE(packet.m_type == 'S');
+    REQUIRE(std::string(packet.m_payload, 4) == "FOUR");
+    REQUIRE(journal.get_next_sequence_number() == 5);
+    client.close();
+    journal.close();
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("resume_into_new_session") {
+    auto root =
+      std::filesystem::temp_directory_path() / "nexus_soup_bin_tcp_client";
+    std::filesystem::remove_all(root);
+    auto journal = SoupBinTcpJournal(root);
+    journal.open("SESSION", 1);
+    for(auto payload : {"ONE", "TWO", "THREE"}) {
+      auto packet = SoupBinTcpPacket();
+      packet.m_length = static_cast<std::uint16_t>(1 + std::strlen(payload));
+      packet.m_type = 'S';
+      packet.m_payload = payload;
+      journal.append(journal.get_next_sequence_number(), packet);
+    }
+    journal.close();
+    auto fixture = Fixture();
+    auto server_future = std::async(std::launch::async, [&] {
+      auto buffer = SharedBuffer();
+      fixture.m_server_channel->get_reader().read(out(buffer));
+      auto accepted = make_login_accepted_packet("OTHER", 1);
+      fixture.m_server_channel->get_writer().write(accepted);
+      auto data_packet = make_data_packet('S', "NEW");
+      fixture.m_server_channel->get_writer().write(data_packet);
+    });
+    auto client = SoupBinTcpClient("user", "pass", "SESSION", 2, Ref(journal),
+      &*fixture.m_client_channel, &fixture.m_timer);
+    server_future.get();
+    auto packet = client.read();
+    REQUIRE(packet.m_type == 'S');
+    REQUIRE(std::string(packet.m_payload, 3) == "NEW");
+    REQUIRE(journal.get_session() == "OTHER");
+    REQUIRE(journal.get_next_sequence_number() == 2);
+    client.close();
+    journal.close();
+    std::filesystem::remove_all(root);
+  }
 }
@@ -0,0 +1,95 @@
+#include <filesystem>
+#include <fstream>
+#include <doctest/doctest.h>
+#include "Nexus/SoupBinTcp/SoupBinTcpJournal.hpp"
+
+using namespace Beam;
+using namespace Nexus;
+
+namespace {
+  auto make_root() {
+    auto root =
+      std::filesystem::temp_directory_path() / "nexus_soup_bin_tcp_journal";
+    std::filesystem::remove_all(root);
+    return root;
+  }
+
+  auto make_packet(const char* payload) {
+    auto packet = SoupBinTcpPacket();
+    packet.m_length = static_cast<std::uint16_t>(1 + std::strlen(payload));
+    packet.m_type = 'S';
+    packet.m_payload = payload;
+    return packet;
+  }
+}
+
+TEST_SUITE("SoupBinTcpJournal") {
+  TEST_CASE("append_and_recover") {
+    auto root = make_root();
+    {
+      auto journal = SoupBinTcpJournal(root);
+      journal.open("SESSION", 5);
+      REQUIRE(journal.get_first_sequence_number() == 5);
+      REQUIRE(journal.get_recovered_sequence_number() == 5);
+      journal.append(5, make_packet("A"));
+      journal.append(6, make_packet("BB"));
+      journal.append(8, make_packet("D"));
+      journal.append(7, make_packet("CCC"));
+      REQUIRE(journal.get_next_sequence_number() == 8);
+    }
+    auto journal = SoupBinTcpJournal(root);
+    journal.open("SESSION", 1);
+    REQUIRE(journal.get_first_sequence_number() == 5);
+    REQUIRE(journal.get_recovered_sequence_number() == 8);
+    auto packet = journal.load(6);
+    REQUIRE(packet.m_type == 'S');
+    REQUIRE(packet.m_length == 3);
+    REQUIRE(std::string(packet.m_payload, 2) == "BB");
+    REQUIRE_THROWS_AS(journal.load(8), IOException);
+    journal.close();
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("truncated_packet") {
+    auto root = make_root();
+    {
+      auto journal = SoupBinTcpJournal(root);
+      journal.open("SESSION", 1);
+      journal.append(1, make_packet("A"));
+    }
+    {
+      auto file = std::ofstream(root / "SESSION.journal",
+        std::ios::binary | std::ios::app);
+      file.write("\0\x09S12", 5);
+    }
+    auto journal = SoupBinTcpJournal(root);
+    journal.open("SESSION", 1);
+    REQUIRE(journal.get_next_sequence_number() == 2);
+    journal.append(2, make_packet("B"));
+    journal.close();
+    journal.open("SESSION", 1);
+    REQUIRE(journal.get_recovered_sequence_number() == 3);
+    REQUIRE(std::string(journal.load(2).m_payload, 1) == "B");
+    journal.close();
+    std::filesystem::remove_all(root);
+  }
+
+  TEST_CASE("append_past_gap") {
+    auto root = make_root();
+    {
+      auto journal = SoupBinTcpJournal(root);
+      journal.open("SESSION", 5);
+      journal.append(5, make_packet("A"));
+      journal.append(9, make_packet("B"));
+      REQUIRE(journal.get_first_sequence_number() == 9);
+      REQUIRE(journal.get_next_sequence_number() == 10);
+    }
+    auto journal = SoupBinTcpJournal(root);
+    journal.open("SESSION", 1);
+    REQUIRE(journal.get_first_sequence_number() == 9);
+    REQUIRE(journal.get_recovered_sequence_number() == 10);
+    REQUIRE(std::string(journal.load(9).m_payload, 1) == "B");
+    journal.close();
+    std::filesystem::remove_all(root);
+  }
+}
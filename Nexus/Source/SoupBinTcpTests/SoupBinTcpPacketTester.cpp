@@ -55,4 +55,22 @@ TEST_SUITE("SoupBinTcpPacket") {
     REQUIRE(payload.get_size() == 0);
     REQUIRE(packet.m_payload == payload.get_data());
   }
+
+  TEST_CASE("parse_packet") {
+    auto buffer = SharedBuffer();
+    append(buffer, native_to_big(std::uint16_t(3)));
+    append(buffer, 'S');
+    append(buffer, "AB", 2);
+    append(buffer, native_to_big(std::uint16_t(4)));
+    append(buffer, 'U');
+    append(buffer, "C", 1);
+    auto source = std::string_view(buffer.get_data(), buffer.get_size());
+    auto packet = SoupBinTcpPacket();
+    REQUIRE(parse_packet(source, out(packet)) == 5);
+    REQUIRE(packet.m_length == 3);
+    REQUIRE(packet.m_type == 'S');
+    REQUIRE(packet.m_payload == buffer.get_data() + 3);
+    REQUIRE(parse_packet(source.substr(5), out(packet)) == 0);
+    REQUIRE(parse_packet(source.substr(0, 2), out(packet)) == 0);
+  }
 }
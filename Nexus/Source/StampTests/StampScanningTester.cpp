@@ -0,0 +1,94 @@
+#include <random>
+#include <string>
+#include <doctest/doctest.h>
+#include "Nexus/Stamp/StampScanning.hpp"
+
+using namespace Beam;
+using namespace Nexus;
+
+namespace {
+  template<std::size_t N>
+  bool parse_digits_directly(const char* source, std::uint32_t& value) {
+    value = 0;
+    for(auto i = std::size_t(0); i != N; ++i) {
+      if(source[i] < '0' || source[i] > '9') {
+        return false;
+      }
+      value = 10 * value + source[i] - '0';
+    }
+    return true;
+  }
+
+  template<std::size_t N>
+  void require_equivalent_digits(std::mt19937& random) {
+    auto characters = std::uniform_int_distribution<int>(0, 255);
+    auto digits = std::uniform_int_distribution<int>('0', '9');
+    auto corruptions = std::uniform_int_distribution<int>(0, 3);
+    for(auto i = 0; i != 10000; ++i) {
+      auto field = std::string(N, '0');
+      for(auto& c : field) {
+        c = static_cast<char>(digits(random));
+      }
+      if(corruptions(random) == 0) {
+        field[random() % N] = static_cast<char>(characters(random));
+      }
+      auto expected = std::uint32_t();
+      auto is_expected_valid =
+        parse_digits_directly<N>(field.data(), expected);
+      auto value = std::uint32_t();
+      REQUIRE(parse_stamp_digits<N>(field.data(), out(value)) ==
+        is_expected_valid);
+      if(is_expected_valid) {
+        REQUIRE(value == expected);
+      }
+    }
+  }
+}
+
+TEST_SUITE("StampScanning") {
+  TEST_CASE("parse_stamp_digits") {
+    auto value = std::uint32_t();
+    REQUIRE(parse_stamp_digits<4>("0025", out(value)));
+    REQUIRE(value == 25);
+    REQUIRE(parse_stamp_digits<9>("123456789", out(value)));
+    REQUIRE(value == 123456789);
+    REQUIRE(parse_stamp_digits<9>("999999999", out(value)));
+    REQUIRE(value == 999999999);
+    REQUIRE(!parse_stamp_digits<4>("00/5", out(value)));
+    REQUIRE(!parse_stamp_digits<9>(":00000000", out(value)));
+    REQUIRE(!parse_stamp_digits<9>(" 00000000", out(value)));
+  }
+
+  TEST_CASE("fuzz_stamp_digits") {
+    auto random = std::mt19937(20240709);
+    require_equivalent_digits<1>(random);
+    require_equivalent_digits<4>(random);
+    require_equivalent_digits<8>(random);
+    require_equivalent_digits<9>(random);
+  }
+
+  TEST_CASE("fuzz_find_stamp_delimiter") {
+    auto random = std::mt19937(1337);
+    auto sizes = std::uniform_int_distribution<int>(0, 100);
+    auto characters = std::uniform_int_distribution<int>(0, 63);
+    for(auto i = 0; i != 10000; ++i) {
+      auto buffer = std::string(sizes(random), ' ');
+      for(auto& c : buffer) {
+        c = static_cast<char>('0' + characters(random));
+        if(characters(random) == 0) {
+          c = STAMP_FIELD_SEPARATOR;
+        } else if(characters(random) == 0) {
+          c = STAMP_END_TOKEN;
+        }
+      }
+      auto first = buffer.data();
+      auto last = buffer.data() + buffer.size();
+      auto expected = first;
+      while(expected != last && *expected != STAMP_FIELD_SEPARATOR &&
+          *expected != STAMP_END_TOKEN) {
+        ++expected;
+      }
+      REQUIRE(find_stamp_delimiter(first, last) == expected);
+    }
+  }
+}